@@ -1,34 +1,19 @@
 #include "WeaR_AudioManager.h"
+#include "Core/WeaR_Log.h"
+#include "Core/WeaR_Trace.h"
 
-#include <QMediaDevices>
-#include <QThread>
-
-#include <iostream>
 #include <format>
 #include <chrono>
 #include <thread>
+#include <algorithm>
 
 namespace WeaR {
 
-// =============================================================================
-// SINGLETON INSTANCE
-// =============================================================================
-
-WeaR_AudioManager& WeaR_AudioManager::get() {
-    static WeaR_AudioManager instance;
-    return instance;
-}
-
 // =============================================================================
 // CONSTRUCTOR / DESTRUCTOR
 // =============================================================================
 
-WeaR_AudioManager::WeaR_AudioManager() : QObject(nullptr) {
-    // Setup format
-    m_format.setSampleRate(AudioConstants::SAMPLE_RATE);
-    m_format.setChannelCount(AudioConstants::CHANNELS);
-    m_format.setSampleFormat(QAudioFormat::Int16);
-}
+WeaR_AudioManager::WeaR_AudioManager() = default;
 
 WeaR_AudioManager::~WeaR_AudioManager() {
     shutdown();
@@ -43,26 +28,17 @@ bool WeaR_AudioManager::init() {
     
     std::lock_guard<std::mutex> lock(m_mutex);
     
-    // Get default audio output device
-    m_outputDevice = QMediaDevices::defaultAudioOutput();
-    
-    if (m_outputDevice.isNull()) {
-        std::cerr << "[Audio] No audio output device found\n";
-        // Continue anyway - we'll just not output audio
-    } else {
-        std::cout << std::format("[Audio] Using device: {}\n", 
-                                  m_outputDevice.description().toStdString());
-    }
-    
-    // Check format support
-    if (!m_outputDevice.isNull() && !m_outputDevice.isFormatSupported(m_format)) {
-        std::cerr << "[Audio] Default format not supported, trying nearest\n";
-        // Qt will use nearest supported format
+    // Only the device backend needs a host audio API. The core may come up
+    // on a startup thread before the frontend installs its factory, so the
+    // backend is left alone; createPortSink() paces with a null sink until then
+    if (m_backend.backend == AudioBackend::Device && !m_deviceFactory) {
+        WEAR_LOG_DEBUG(LogCategory::Audio, "No audio device sink installed yet");
     }
     
     m_initialized = true;
-    std::cout << std::format("[Audio] Initialized ({}Hz, {} channels, 16-bit)\n",
-                              AudioConstants::SAMPLE_RATE, AudioConstants::CHANNELS);
+    WEAR_LOG_INFO(LogCategory::Audio, "Initialized ({}Hz, {} channels, 16-bit, backend={})",
+                  AudioConstants::SAMPLE_RATE, AudioConstants::CHANNELS,
+                  getAudioBackendName(m_backend.backend));
     return true;
 }
 
@@ -72,7 +48,7 @@ void WeaR_AudioManager::shutdown() {
     // Close all ports
     for (auto& [handle, port] : m_ports) {
         if (port && port->sink) {
-            port->sink->stop();
+            port->sink->close();
         }
     }
     m_ports.clear();
@@ -96,6 +72,25 @@ AudioPort* WeaR_AudioManager::getPort(int32_t handle) {
     return nullptr;
 }
 
+std::unique_ptr<WeaR_AudioSink> WeaR_AudioManager::createPortSink(const AudioSinkFormat& format) {
+    std::unique_ptr<WeaR_AudioSink> sink;
+    if (m_backend.backend == AudioBackend::Device) {
+        // No factory installed: keep real-time pacing without output
+        sink = m_deviceFactory ? m_deviceFactory(format)
+                               : std::make_unique<WeaR_NullAudioSink>(true);
+    } else {
+        sink = createAudioSink(m_backend);
+    }
+    
+    if (sink && !sink->open(format)) {
+        WEAR_LOG_WARN(LogCategory::Audio, "Backend '{}' failed for handle {}, using null sink",
+                      sink->name(), format.handle);
+        sink = std::make_unique<WeaR_NullAudioSink>(true);
+        (void)sink->open(format);
+    }
+    return sink;
+}
+
 int32_t WeaR_AudioManager::openPort(
     int32_t type,
     int32_t index,
@@ -118,31 +113,26 @@ int32_t WeaR_AudioManager::openPort(
     port->sampleCount = sampleCount > 0 ? sampleCount : 256;
     port->grain = port->sampleCount;
     port->isOpen = true;
-    port->volume = m_masterVolume;
+    port->volume = 1.0f;    // Master volume is applied on top, in effectiveVolume()
     
-    // Create audio sink if we have a valid device
-    if (!m_outputDevice.isNull()) {
-        QAudioFormat format = m_format;
-        if (sampleRate > 0 && sampleRate != AudioConstants::SAMPLE_RATE) {
-            format.setSampleRate(sampleRate);
-        }
-        
-        port->sink = std::make_unique<QAudioSink>(m_outputDevice, format);
-        port->sink->setBufferSize(port->sampleCount * AudioConstants::FRAME_SIZE * 4);
-        port->ioDevice = port->sink->start();
-        
-        if (!port->ioDevice) {
-            std::cerr << std::format("[Audio] Failed to start sink for handle {}\n", port->handle);
-        }
+    // Create the backend sink for this port
+    AudioSinkFormat format;
+    format.handle = port->handle;
+    format.sampleRate = sampleRate > 0 ? sampleRate : AudioConstants::SAMPLE_RATE;
+    format.channels = AudioConstants::CHANNELS;
+    format.grainFrames = port->sampleCount;
+    
+    port->sink = createPortSink(format);
+    if (port->sink) {
+        port->sink->setVolume(effectiveVolume(*port));
     }
     
     int32_t handle = port->handle;
     m_ports[handle] = std::move(port);
     
-    std::cout << std::format("[Audio] Opened port: handle={}, type={}, samples={}\n",
-                              handle, type, sampleCount);
+    WEAR_LOG_INFO(LogCategory::Audio, "Opened port: handle={}, type={}, samples={}",
+                  handle, type, sampleCount);
     
-    emit portOpened(handle);
     return handle;
 }
 
@@ -155,11 +145,10 @@ int32_t WeaR_AudioManager::closePort(int32_t handle) {
     }
     
     if (it->second->sink) {
-        it->second->sink->stop();
+        it->second->sink->close();
     }
     
     m_ports.erase(it);
-    emit portClosed(handle);
     
     return 0;
 }
@@ -168,37 +157,63 @@ int32_t WeaR_AudioManager::closePort(int32_t handle) {
 // AUDIO OUTPUT
 // =============================================================================
 
-int32_t WeaR_AudioManager::output(int32_t handle, const void* pcmData, size_t dataSize) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+void WeaR_AudioManager::writePort(AudioPort& port, const void* pcmData, size_t dataSize) {
+    // Write audio data (for simplicity, we output raw PCM)
+    if (!port.sink || !pcmData || dataSize == 0 || m_masterMuted || port.isMuted) {
+        return;
+    }
     
-    AudioPort* port = getPort(handle);
-    if (!port || !port->isOpen) {
+    size_t written = port.sink->write(static_cast<const uint8_t*>(pcmData), dataSize);
+    if (written > 0) {
+        uint64_t frames = written / AudioConstants::FRAME_SIZE;
+        port.framesOutput += frames;
+        m_totalFramesOutput += frames;
+    }
+}
+
+int32_t WeaR_AudioManager::output(int32_t handle, const void* pcmData, size_t dataSize) {
+    AudioOutputParam param{handle, pcmData, dataSize};
+    return outputs(&param, 1);
+}
+
+int32_t WeaR_AudioManager::outputs(const AudioOutputParam* params, size_t count) {
+    if (!params || count == 0 || count > AudioConstants::MAX_OUTPUTS_PORTS) {
         return -1;
     }
     
-    // Write audio data
-    if (port->ioDevice && pcmData && dataSize > 0 && !m_masterMuted && !port->isMuted) {
-        // Apply volume if needed (for simplicity, we output raw PCM)
-        qint64 written = port->ioDevice->write(
-            static_cast<const char*>(pcmData), 
-            static_cast<qint64>(dataSize)
-        );
+    AudioPort* ports[AudioConstants::MAX_OUTPUTS_PORTS] = {};
+    auto deadline = WeaR_AudioSink::Clock::now();
+    
+    {
+        WEAR_TRACE_SCOPE_ARG(TraceCategory::Audio, "audio_mix", "ports", count);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        // Validate the whole batch first so it is queued all-or-nothing
+        for (size_t i = 0; i < count; ++i) {
+            ports[i] = getPort(params[i].handle);
+            if (!ports[i] || !ports[i]->isOpen) {
+                return -1;
+            }
+        }
+        
+        for (size_t i = 0; i < count; ++i) {
+            writePort(*ports[i], params[i].pcmData, params[i].dataSize);
+        }
         
-        if (written > 0) {
-            uint64_t frames = written / AudioConstants::FRAME_SIZE;
-            port->framesOutput += frames;
-            m_totalFramesOutput += frames;
+        // Simulate blocking behavior - every port advances its own grain
+        // clock, and the batch waits for the latest of them
+        // This prevents the game from running audio too fast
+        for (size_t i = 0; i < count; ++i) {
+            if (ports[i]->sink) {
+                deadline = std::max(deadline, ports[i]->sink->nextGrainDeadline(
+                    static_cast<uint32_t>(ports[i]->sampleCount)));
+            }
         }
     }
     
-    // Simulate blocking behavior - sleep for audio duration
-    // This prevents the game from running audio too fast
-    if (port->sampleCount > 0) {
-        // Calculate duration in microseconds
-        double durationMs = (static_cast<double>(port->sampleCount) / AudioConstants::SAMPLE_RATE) * 1000.0;
-        // Sleep for ~80% of the duration to account for processing time
-        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int>(durationMs * 800)));
-    }
+    // Block once, outside the lock, so other ports and threads are not serialised
+    WEAR_TRACE_SCOPE(TraceCategory::Audio, "audio_wait");
+    std::this_thread::sleep_until(deadline);
     
     return 0;
 }
@@ -215,7 +230,7 @@ int32_t WeaR_AudioManager::setVolume(int32_t handle, float volume) {
     
     // Apply to sink if available
     if (port->sink) {
-        port->sink->setVolume(port->volume * m_masterVolume);
+        port->sink->setVolume(effectiveVolume(*port));
     }
     
     return 0;
@@ -235,10 +250,35 @@ int32_t WeaR_AudioManager::getPortParam(int32_t handle, int32_t* outSampleCount,
     return 0;
 }
 
+// =============================================================================
+// BACKEND SELECTION
+// =============================================================================
+
+void WeaR_AudioManager::setBackend(const AudioBackendConfig& config) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_backend = config;
+    
+    WEAR_LOG_INFO(LogCategory::Audio, "Backend set to {}", getAudioBackendName(config.backend));
+}
+
+AudioBackendConfig WeaR_AudioManager::getBackend() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_backend;
+}
+
+void WeaR_AudioManager::setDeviceSinkFactory(AudioSinkFactory factory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_deviceFactory = std::move(factory);
+}
+
 // =============================================================================
 // GLOBAL CONTROLS
 // =============================================================================
 
+float WeaR_AudioManager::effectiveVolume(const AudioPort& port) const {
+    return m_masterMuted ? 0.0f : port.volume * m_masterVolume;
+}
+
 void WeaR_AudioManager::setMasterMute(bool muted) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_masterMuted = muted;
@@ -246,7 +286,7 @@ void WeaR_AudioManager::setMasterMute(bool muted) {
     // Apply to all sinks
     for (auto& [handle, port] : m_ports) {
         if (port->sink) {
-            port->sink->setVolume(muted ? 0.0f : port->volume * m_masterVolume);
+            port->sink->setVolume(effectiveVolume(*port));
         }
     }
 }
@@ -258,7 +298,7 @@ void WeaR_AudioManager::setMasterVolume(float volume) {
     // Apply to all sinks
     for (auto& [handle, port] : m_ports) {
         if (port->sink) {
-            port->sink->setVolume(port->volume * m_masterVolume);
+            port->sink->setVolume(effectiveVolume(*port));
         }
     }
 }
@@ -272,4 +312,17 @@ size_t WeaR_AudioManager::getOpenPortCount() const {
     return m_ports.size();
 }
 
+float WeaR_AudioManager::getBufferFill() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // The emptiest port is the one closest to an audible underrun
+    float fill = -1.0f;
+    for (const auto& [handle, port] : m_ports) {
+        if (!port->isOpen || !port->sink) continue;
+        float portFill = port->sink->getBufferFill();
+        fill = fill < 0.0f ? portFill : std::min(fill, portFill);
+    }
+    return fill;
+}
+
 } // namespace WeaR
@@ -2,16 +2,15 @@
 
 /**
  * @file WeaR_AudioManager.h
- * @brief PS4 Audio Output Emulation via Qt6 Multimedia
+ * @brief PS4 Audio Output Emulation
  * 
  * Handles sceAudioOut syscalls and provides PCM audio output.
+ * PCM is routed through a selectable WeaR_AudioSink backend. The manager
+ * itself has no host audio dependency: the Device backend uses whatever
+ * sink factory the frontend installs (Qt Multimedia in the GUI).
  */
 
-#include <QObject>
-#include <QAudioSink>
-#include <QAudioFormat>
-#include <QAudioDevice>
-#include <QIODevice>
+#include "WeaR_AudioSink.h"
 
 #include <map>
 #include <mutex>
@@ -38,6 +37,9 @@ namespace AudioConstants {
     constexpr int32_t AUDIOOUT_PORT_TYPE_VOICE = 2;
     constexpr int32_t AUDIOOUT_PORT_TYPE_PERSONAL = 3;
     constexpr int32_t AUDIOOUT_PORT_TYPE_PADSPK = 4;
+    
+    // Upper bound on ports submitted by one sceAudioOutOutputs call
+    constexpr size_t MAX_OUTPUTS_PORTS = 16;
 }
 
 // =============================================================================
@@ -50,8 +52,7 @@ struct AudioPort {
     int32_t sampleCount = 0;    // Samples per buffer
     int32_t grain = 256;        // Typical PS4 grain size
     
-    std::unique_ptr<QAudioSink> sink;
-    QIODevice* ioDevice = nullptr;
+    std::unique_ptr<WeaR_AudioSink> sink;
     
     bool isOpen = false;
     bool isMuted = false;
@@ -60,21 +61,29 @@ struct AudioPort {
     uint64_t framesOutput = 0;
 };
 
+/**
+ * @brief One entry of a batched multi-port output
+ */
+struct AudioOutputParam {
+    int32_t handle = -1;
+    const void* pcmData = nullptr;
+    size_t dataSize = 0;
+};
+
 // =============================================================================
 // AUDIO MANAGER CLASS
 // =============================================================================
 
 /**
- * @brief Audio Manager singleton (QObject for Qt integration)
+ * @brief Audio Manager (one per emulation context)
  */
-class WeaR_AudioManager : public QObject {
-    Q_OBJECT
-
+class WeaR_AudioManager {
 public:
-    /**
-     * @brief Get singleton instance
-     */
-    static WeaR_AudioManager& get();
+    WeaR_AudioManager();
+    ~WeaR_AudioManager();
+
+    WeaR_AudioManager(const WeaR_AudioManager&) = delete;
+    WeaR_AudioManager& operator=(const WeaR_AudioManager&) = delete;
 
     /**
      * @brief Initialize audio subsystem
@@ -121,6 +130,19 @@ public:
      */
     int32_t output(int32_t handle, const void* pcmData, size_t dataSize);
 
+    /**
+     * @brief Output audio data to several ports in one step
+     * 
+     * All buffers are queued under a single lock acquisition, then the
+     * caller blocks once until the latest grain deadline of the batch.
+     * Fails without writing anything if any handle is invalid.
+     * 
+     * @param params Array of port/buffer pairs
+     * @param count Number of entries
+     * @return 0 on success, negative error code on failure
+     */
+    int32_t outputs(const AudioOutputParam* params, size_t count);
+
     /**
      * @brief Set port volume
      * @param handle Port handle
@@ -133,6 +155,26 @@ public:
      */
     int32_t getPortParam(int32_t handle, int32_t* outSampleCount, int32_t* outGrain);
 
+    // =========================================================================
+    // BACKEND SELECTION
+    // =========================================================================
+
+    /**
+     * @brief Select the output backend
+     *
+     * Applies to ports opened afterwards; already open ports keep their sink.
+     */
+    void setBackend(const AudioBackendConfig& config);
+    [[nodiscard]] AudioBackendConfig getBackend() const;
+
+    /**
+     * @brief Install the sink factory used by AudioBackend::Device
+     *
+     * Without a factory the Device backend falls back to the real-time
+     * null sink, which keeps guest pacing but produces no sound.
+     */
+    void setDeviceSinkFactory(AudioSinkFactory factory);
+
     // =========================================================================
     // GLOBAL CONTROLS
     // =========================================================================
@@ -154,26 +196,27 @@ public:
     // =========================================================================
 
     [[nodiscard]] size_t getOpenPortCount() const;
+
+    /**
+     * @brief Lowest buffer fill across open ports (0.0 - 1.0)
+     * @return Negative if no port is open
+     */
+    [[nodiscard]] float getBufferFill() const;
     [[nodiscard]] uint64_t getTotalFramesOutput() const { return m_totalFramesOutput; }
     [[nodiscard]] bool isInitialized() const { return m_initialized; }
 
-signals:
-    void audioError(const QString& message);
-    void portOpened(int32_t handle);
-    void portClosed(int32_t handle);
-
 private:
-    WeaR_AudioManager();
-    ~WeaR_AudioManager();
-
     [[nodiscard]] int32_t allocateHandle();
     [[nodiscard]] AudioPort* getPort(int32_t handle);
+    [[nodiscard]] std::unique_ptr<WeaR_AudioSink> createPortSink(const AudioSinkFormat& format);
+    void writePort(AudioPort& port, const void* pcmData, size_t dataSize);
+    [[nodiscard]] float effectiveVolume(const AudioPort& port) const;    // Port x master, 0 when muted
 
     std::map<int32_t, std::unique_ptr<AudioPort>> m_ports;
     mutable std::mutex m_mutex;
     
-    QAudioFormat m_format;
-    QAudioDevice m_outputDevice;
+    AudioBackendConfig m_backend;
+    AudioSinkFactory m_deviceFactory;
     
     bool m_initialized = false;
     bool m_masterMuted = false;
@@ -0,0 +1,195 @@
+#include "WeaR_AudioSink.h"
+#include "Core/WeaR_Log.h"
+#include "Core/WeaR_Simd.h"
+
+#include <format>
+#include <filesystem>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace WeaR {
+
+// =============================================================================
+// BACKEND NAMES
+// =============================================================================
+
+const char* getAudioBackendName(AudioBackend backend) {
+    switch (backend) {
+        case AudioBackend::Device:          return "device";
+        case AudioBackend::NullRealtime:    return "null";
+        case AudioBackend::NullUnthrottled: return "null-unthrottled";
+        case AudioBackend::WavFile:         return "wav";
+        default:                            return "unknown";
+    }
+}
+
+std::optional<AudioBackend> parseAudioBackend(std::string_view name) {
+    if (name == "device")           return AudioBackend::Device;
+    if (name == "null")             return AudioBackend::NullRealtime;
+    if (name == "null-unthrottled") return AudioBackend::NullUnthrottled;
+    if (name == "wav")              return AudioBackend::WavFile;
+    return std::nullopt;
+}
+
+// =============================================================================
+// NULL SINK
+// =============================================================================
+
+bool WeaR_NullAudioSink::open(const AudioSinkFormat& format) {
+    m_sampleRate = format.sampleRate > 0 ? format.sampleRate : 48000;
+    m_framesQueued = 0;
+    m_start = Clock::now();
+    return true;
+}
+
+size_t WeaR_NullAudioSink::write(const uint8_t* data, size_t bytes) {
+    (void)data;
+    return bytes;
+}
+
+WeaR_AudioSink::Clock::time_point WeaR_NullAudioSink::nextGrainDeadline(uint32_t frames) {
+    if (!m_realtime) {
+        return Clock::now();
+    }
+
+    m_framesQueued += frames;
+
+    // Deadline is the wall-clock position of the last queued frame
+    auto elapsed = std::chrono::microseconds(m_framesQueued * 1'000'000ull / m_sampleRate);
+    auto deadline = m_start + elapsed;
+
+    // If the guest fell behind (e.g. paused), restart the clock instead of
+    // letting it burst through the backlog
+    auto now = Clock::now();
+    if (deadline < now - std::chrono::milliseconds(100)) {
+        m_start = now;
+        m_framesQueued = 0;
+        return now;
+    }
+    return deadline;
+}
+
+// =============================================================================
+// WAV FILE SINK
+// =============================================================================
+
+namespace {
+
+void putLE16(std::ofstream& out, uint16_t v) {
+    const char b[2] = { static_cast<char>(v & 0xFF), static_cast<char>(v >> 8) };
+    out.write(b, 2);
+}
+
+void putLE32(std::ofstream& out, uint32_t v) {
+    const char b[4] = {
+        static_cast<char>(v & 0xFF), static_cast<char>((v >> 8) & 0xFF),
+        static_cast<char>((v >> 16) & 0xFF), static_cast<char>((v >> 24) & 0xFF)
+    };
+    out.write(b, 4);
+}
+
+// Handles are reused after close; the sequence keeps every dump
+std::atomic<uint32_t> g_wavSequence{0};
+
+} // anonymous namespace
+
+bool WeaR_WavAudioSink::open(const AudioSinkFormat& format) {
+    m_format = format;
+    m_dataBytes = 0;
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+
+    m_path = (std::filesystem::path(m_directory) /
+              std::format("audio_{:04}_port{}.wav", g_wavSequence.fetch_add(1) + 1, format.handle)).string();
+
+    m_file.open(m_path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        WEAR_LOG_ERROR(LogCategory::Audio, "Cannot create WAV file: {}", m_path);
+        return false;
+    }
+
+    writeHeader(0);
+    WEAR_LOG_INFO(LogCategory::Audio, "Writing port {} to {}", format.handle, m_path);
+    return true;
+}
+
+void WeaR_WavAudioSink::close() {
+    if (!m_file.is_open()) return;
+
+    // Patch RIFF and data chunk sizes (clamped to the 4 GB RIFF limit)
+    uint64_t limit = std::numeric_limits<uint32_t>::max() - 36;
+    uint32_t dataBytes = static_cast<uint32_t>(std::min(m_dataBytes, limit));
+
+    m_file.seekp(0);
+    writeHeader(dataBytes);
+    m_file.close();
+}
+
+size_t WeaR_WavAudioSink::write(const uint8_t* data, size_t bytes) {
+    if (!m_file.is_open() || !data) return 0;
+
+    const char* out = reinterpret_cast<const char*>(data);
+    if (m_gainQ15 != INT16_MAX) {
+        // Scale a copy; the guest buffer is not ours to modify
+        m_scratch.resize(bytes / sizeof(int16_t));
+        std::memcpy(m_scratch.data(), data, m_scratch.size() * sizeof(int16_t));
+        getSimdKernels().scalePcm16(m_scratch.data(), m_scratch.size(), m_gainQ15);
+        out = reinterpret_cast<const char*>(m_scratch.data());
+        bytes = m_scratch.size() * sizeof(int16_t);
+    }
+
+    m_file.write(out, static_cast<std::streamsize>(bytes));
+    if (!m_file) return 0;
+
+    m_dataBytes += bytes;
+    return bytes;
+}
+
+void WeaR_WavAudioSink::setVolume(float volume) {
+    m_gainQ15 = toGainQ15(volume);
+}
+
+void WeaR_WavAudioSink::writeHeader(uint32_t dataBytes) {
+    const uint16_t channels = static_cast<uint16_t>(m_format.channels);
+    const uint32_t sampleRate = static_cast<uint32_t>(m_format.sampleRate);
+    const uint16_t blockAlign = static_cast<uint16_t>(channels * 2);
+
+    m_file.write("RIFF", 4);
+    putLE32(m_file, 36 + dataBytes);
+    m_file.write("WAVE", 4);
+
+    m_file.write("fmt ", 4);
+    putLE32(m_file, 16);                        // PCM fmt chunk size
+    putLE16(m_file, 1);                         // WAVE_FORMAT_PCM
+    putLE16(m_file, channels);
+    putLE32(m_file, sampleRate);
+    putLE32(m_file, sampleRate * blockAlign);   // Byte rate
+    putLE16(m_file, blockAlign);
+    putLE16(m_file, 16);                        // Bits per sample
+
+    m_file.write("data", 4);
+    putLE32(m_file, dataBytes);
+}
+
+// =============================================================================
+// FACTORY
+// =============================================================================
+
+std::unique_ptr<WeaR_AudioSink> createAudioSink(const AudioBackendConfig& config) {
+    switch (config.backend) {
+        case AudioBackend::NullRealtime:
+            return std::make_unique<WeaR_NullAudioSink>(true);
+        case AudioBackend::NullUnthrottled:
+            return std::make_unique<WeaR_NullAudioSink>(false);
+        case AudioBackend::WavFile:
+            return std::make_unique<WeaR_WavAudioSink>(config.wavDirectory);
+        case AudioBackend::Device:
+        default:
+            return nullptr;
+    }
+}
+
+} // namespace WeaR
@@ -0,0 +1,204 @@
+#pragma once
+
+/**
+ * @file WeaR_AudioSink.h
+ * @brief Pluggable PCM output backends for WeaR_AudioManager
+ *
+ * Each open audio port owns one sink. The sink consumes interleaved
+ * 16-bit PCM and tells the manager when the guest may submit the next
+ * grain, so pacing is a property of the backend:
+ *   - Device:          host audio device (factory installed by the frontend)
+ *   - NullRealtime:    discards samples, paced at the real sample rate
+ *   - NullUnthrottled: discards samples, never blocks (faster than real time)
+ *   - WavFile:         streams each port to a .wav file, never blocks
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace WeaR {
+
+// =============================================================================
+// BACKEND SELECTION
+// =============================================================================
+
+enum class AudioBackend : uint8_t {
+    Device,
+    NullRealtime,
+    NullUnthrottled,
+    WavFile
+};
+
+/**
+ * @brief Backend configuration applied to ports opened after it is set
+ */
+struct AudioBackendConfig {
+    AudioBackend backend = AudioBackend::Device;
+    std::string wavDirectory = ".";     // Output directory for WavFile
+};
+
+/**
+ * @brief Stable name used by settings and command-line flags
+ */
+[[nodiscard]] const char* getAudioBackendName(AudioBackend backend);
+
+/**
+ * @brief Parse a backend name ("device", "null", "null-unthrottled", "wav")
+ */
+[[nodiscard]] std::optional<AudioBackend> parseAudioBackend(std::string_view name);
+
+/**
+ * @brief Stream format of a single port
+ */
+struct AudioSinkFormat {
+    int32_t handle = -1;            // Owning port handle (used for file naming)
+    int32_t sampleRate = 48000;
+    int32_t channels = 2;
+    int32_t grainFrames = 256;
+};
+
+// =============================================================================
+// SINK INTERFACE
+// =============================================================================
+
+/**
+ * @brief Abstract PCM sink
+ */
+class WeaR_AudioSink {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    virtual ~WeaR_AudioSink() = default;
+
+    /**
+     * @brief Start the stream
+     * @return false if the backend could not be opened
+     */
+    [[nodiscard]] virtual bool open(const AudioSinkFormat& format) = 0;
+
+    /**
+     * @brief Stop the stream and release backend resources
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief Push interleaved PCM
+     * @return Bytes accepted
+     */
+    virtual size_t write(const uint8_t* data, size_t bytes) = 0;
+
+    /**
+     * @brief Set effective output volume (0.0 - 1.0)
+     */
+    virtual void setVolume(float volume) { (void)volume; }
+
+    /**
+     * @brief Point in time when the guest may submit the next grain
+     *
+     * Called after every write with the number of frames just queued.
+     * The manager sleeps until the returned time outside of its lock.
+     * Returning "now" means the backend never throttles.
+     */
+    [[nodiscard]] virtual Clock::time_point nextGrainDeadline(uint32_t frames) {
+        (void)frames;
+        return Clock::now();
+    }
+
+    /**
+     * @brief Fraction of the backend's output buffer currently queued (0.0 - 1.0)
+     *
+     * Backends without a device buffer report 1.0 (never starved).
+     */
+    [[nodiscard]] virtual float getBufferFill() const { return 1.0f; }
+
+    [[nodiscard]] virtual const char* name() const = 0;
+};
+
+// =============================================================================
+// NULL SINK
+// =============================================================================
+
+/**
+ * @brief Discards PCM; optionally paced to the real sample rate
+ *
+ * Real-time pacing accumulates a frame-accurate deadline from the stream
+ * start, so sleep overshoot does not drift the guest audio clock.
+ */
+class WeaR_NullAudioSink final : public WeaR_AudioSink {
+public:
+    explicit WeaR_NullAudioSink(bool realtime) : m_realtime(realtime) {}
+
+    [[nodiscard]] bool open(const AudioSinkFormat& format) override;
+    void close() override {}
+    size_t write(const uint8_t* data, size_t bytes) override;
+    [[nodiscard]] Clock::time_point nextGrainDeadline(uint32_t frames) override;
+    [[nodiscard]] const char* name() const override {
+        return m_realtime ? "null" : "null-unthrottled";
+    }
+
+private:
+    bool m_realtime;
+    int32_t m_sampleRate = 48000;
+    uint64_t m_framesQueued = 0;
+    Clock::time_point m_start{};
+};
+
+// =============================================================================
+// WAV FILE SINK
+// =============================================================================
+
+/**
+ * @brief Streams PCM to a RIFF/WAVE file
+ *
+ * The header is written with zero sizes on open and patched on close,
+ * so the file is valid as long as the port is closed cleanly.
+ */
+class WeaR_WavAudioSink final : public WeaR_AudioSink {
+public:
+    explicit WeaR_WavAudioSink(std::string directory) : m_directory(std::move(directory)) {}
+    ~WeaR_WavAudioSink() override { close(); }
+
+    [[nodiscard]] bool open(const AudioSinkFormat& format) override;
+    void close() override;
+    size_t write(const uint8_t* data, size_t bytes) override;
+    void setVolume(float volume) override;
+    [[nodiscard]] const char* name() const override { return "wav"; }
+
+    [[nodiscard]] const std::string& getPath() const { return m_path; }
+
+private:
+    void writeHeader(uint32_t dataBytes);
+
+    std::string m_directory;
+    std::string m_path;
+    std::ofstream m_file;
+    AudioSinkFormat m_format{};
+    uint64_t m_dataBytes = 0;
+    int16_t m_gainQ15 = INT16_MAX;      // Port volume, applied to the captured PCM
+    std::vector<int16_t> m_scratch;
+};
+
+/**
+ * @brief Creates the sink for one port of the Device backend
+ *
+ * The core has no audio device of its own; the frontend installs a factory
+ * (see WeaR_AudioManager::setDeviceSinkFactory) for its host audio API.
+ */
+using AudioSinkFactory = std::function<std::unique_ptr<WeaR_AudioSink>(const AudioSinkFormat&)>;
+
+/**
+ * @brief Create a built-in sink for the given backend
+ * @return nullptr for AudioBackend::Device (created by the device factory)
+ */
+[[nodiscard]] std::unique_ptr<WeaR_AudioSink> createAudioSink(const AudioBackendConfig& config);
+
+} // namespace WeaR
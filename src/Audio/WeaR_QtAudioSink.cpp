@@ -0,0 +1,77 @@
+#include "WeaR_QtAudioSink.h"
+#include "Core/WeaR_Log.h"
+
+#include <QMediaDevices>
+
+#include <format>
+
+namespace WeaR {
+
+bool WeaR_QtAudioSink::open(const AudioSinkFormat& format) {
+    if (m_device.isNull()) {
+        return false;
+    }
+
+    QAudioFormat qtFormat;
+    qtFormat.setSampleRate(format.sampleRate);
+    qtFormat.setChannelCount(format.channels);
+    qtFormat.setSampleFormat(QAudioFormat::Int16);
+    m_sampleRate = format.sampleRate;
+
+    m_sink = std::make_unique<QAudioSink>(m_device, qtFormat);
+    m_sink->setBufferSize(format.grainFrames * format.channels * 2 * 4);
+    m_ioDevice = m_sink->start();
+
+    if (!m_ioDevice) {
+        WEAR_LOG_ERROR(LogCategory::Audio, "Failed to start sink for handle {}", format.handle);
+        return false;
+    }
+    WEAR_LOG_INFO(LogCategory::Audio, "Handle {} using device: {}",
+                  format.handle, m_device.description().toStdString());
+    return true;
+}
+
+void WeaR_QtAudioSink::close() {
+    if (m_sink) {
+        m_sink->stop();
+        m_sink.reset();
+    }
+    m_ioDevice = nullptr;
+}
+
+size_t WeaR_QtAudioSink::write(const uint8_t* data, size_t bytes) {
+    if (!m_ioDevice || !data || bytes == 0) return 0;
+
+    qint64 written = m_ioDevice->write(
+        reinterpret_cast<const char*>(data),
+        static_cast<qint64>(bytes)
+    );
+    return written > 0 ? static_cast<size_t>(written) : 0;
+}
+
+void WeaR_QtAudioSink::setVolume(float volume) {
+    if (m_sink) {
+        m_sink->setVolume(volume);
+    }
+}
+
+WeaR_AudioSink::Clock::time_point WeaR_QtAudioSink::nextGrainDeadline(uint32_t frames) {
+    // Sleep for ~80% of the grain duration to account for processing time
+    double durationUs = (static_cast<double>(frames) / m_sampleRate) * 1'000'000.0;
+    return Clock::now() + std::chrono::microseconds(static_cast<int64_t>(durationUs * 0.8));
+}
+
+float WeaR_QtAudioSink::getBufferFill() const {
+    if (!m_sink || m_sink->bufferSize() <= 0) return 0.0f;
+    qsizetype queued = m_sink->bufferSize() - m_sink->bytesFree();
+    return static_cast<float>(queued) / static_cast<float>(m_sink->bufferSize());
+}
+
+AudioSinkFactory createQtAudioSinkFactory() {
+    return [](const AudioSinkFormat&) -> std::unique_ptr<WeaR_AudioSink> {
+        // A null device fails open(), and the manager falls back to the null sink
+        return std::make_unique<WeaR_QtAudioSink>(QMediaDevices::defaultAudioOutput());
+    };
+}
+
+} // namespace WeaR
@@ -0,0 +1,57 @@
+#pragma once
+
+/**
+ * @file WeaR_QtAudioSink.h
+ * @brief Host audio device sink via Qt6 Multimedia (QAudioSink)
+ *
+ * Frontend-only: the Qt GUI installs createQtAudioSinkFactory() as the
+ * AudioBackend::Device factory. wear_core never includes this header.
+ */
+
+#include "WeaR_AudioSink.h"
+
+#include <QAudioSink>
+#include <QAudioFormat>
+#include <QAudioDevice>
+#include <QIODevice>
+
+#include <memory>
+
+namespace WeaR {
+
+/**
+ * @brief Plays PCM on a QAudioDevice
+ *
+ * Pacing keeps the original heuristic: the guest may submit the next
+ * grain after ~80% of the grain duration, leaving headroom for the
+ * device buffer so it never underruns.
+ */
+class WeaR_QtAudioSink final : public WeaR_AudioSink {
+public:
+    explicit WeaR_QtAudioSink(const QAudioDevice& device) : m_device(device) {}
+    ~WeaR_QtAudioSink() override { close(); }
+
+    [[nodiscard]] bool open(const AudioSinkFormat& format) override;
+    void close() override;
+    size_t write(const uint8_t* data, size_t bytes) override;
+    void setVolume(float volume) override;
+    [[nodiscard]] Clock::time_point nextGrainDeadline(uint32_t frames) override;
+    [[nodiscard]] float getBufferFill() const override;
+    [[nodiscard]] const char* name() const override { return "device"; }
+
+private:
+    QAudioDevice m_device;
+    std::unique_ptr<QAudioSink> m_sink;
+    QIODevice* m_ioDevice = nullptr;
+    int32_t m_sampleRate = 48000;
+};
+
+/**
+ * @brief Device sink factory playing each port on the default output device
+ *
+ * The device is looked up per port, so a port opened after the user
+ * switches outputs follows the new default.
+ */
+[[nodiscard]] AudioSinkFactory createQtAudioSinkFactory();
+
+} // namespace WeaR
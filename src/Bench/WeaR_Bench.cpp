@@ -0,0 +1,247 @@
+#include "WeaR_Bench.h"
+#include "Core/WeaR_HostCpu.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace WeaR {
+
+namespace {
+
+// Calibration stops growing the iteration count past this
+constexpr uint64_t MAX_ITERATIONS = 1ULL << 34;
+
+double toNs(BenchState::Clock::duration d) {
+    return std::chrono::duration<double, std::nano>(d).count();
+}
+
+std::string formatRate(double perSecond, const char* unit) {
+    if (perSecond >= 1e9) return std::format("{:.2f} G{}/s", perSecond / 1e9, unit);
+    if (perSecond >= 1e6) return std::format("{:.2f} M{}/s", perSecond / 1e6, unit);
+    if (perSecond >= 1e3) return std::format("{:.2f} k{}/s", perSecond / 1e3, unit);
+    return std::format("{:.2f} {}/s", perSecond, unit);
+}
+
+/**
+ * @brief Extract the value following "key": on a single JSON line
+ */
+std::string_view findField(std::string_view line, std::string_view key) {
+    std::string pattern = std::format("\"{}\": ", key);
+    size_t pos = line.find(pattern);
+    if (pos == std::string_view::npos) return {};
+    std::string_view value = line.substr(pos + pattern.size());
+    if (!value.empty() && value.front() == '"') {
+        value.remove_prefix(1);
+        return value.substr(0, value.find('"'));
+    }
+    return value.substr(0, value.find_first_of(",}"));
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+void WeaR_BenchRunner::add(std::string name, BenchFunction function) {
+    m_cases.push_back({ std::move(name), std::move(function) });
+}
+
+std::vector<std::string> WeaR_BenchRunner::getNames() const {
+    std::vector<std::string> names;
+    names.reserve(m_cases.size());
+    for (const auto& benchCase : m_cases) {
+        names.push_back(benchCase.name);
+    }
+    return names;
+}
+
+// =============================================================================
+// EXECUTION
+// =============================================================================
+
+BenchResult WeaR_BenchRunner::runCase(const Case& benchCase, const BenchOptions& options) const {
+    BenchResult result;
+    result.name = benchCase.name;
+
+    // Calibrate: grow the iteration count until one run reaches the minimum time
+    const double targetNs = options.minTimeSeconds * 1e9;
+    uint64_t iterations = 1;
+    while (true) {
+        BenchState state(iterations);
+        benchCase.function(state);
+        if (!state.failReason().empty()) {
+            result.failed = state.failReason();
+            return result;
+        }
+        if (!state.skipReason().empty()) {
+            result.skipped = state.skipReason();
+            return result;
+        }
+
+        double ns = toNs(state.elapsed());
+        if (ns >= targetNs || iterations >= MAX_ITERATIONS) break;
+
+        double scale = ns > 0.0 ? (targetNs * 1.2) / ns : 100.0;
+        scale = std::clamp(scale, 2.0, 100.0);
+        iterations = std::min(MAX_ITERATIONS, static_cast<uint64_t>(std::ceil(iterations * scale)));
+    }
+
+    // Measure
+    std::vector<double> samples;
+    uint64_t bytesPerIteration = 0;
+    uint64_t itemsPerIteration = 1;
+    for (uint32_t rep = 0; rep < std::max(options.repetitions, 1u); ++rep) {
+        BenchState state(iterations);
+        benchCase.function(state);
+        if (!state.failReason().empty()) {
+            result.failed = state.failReason();
+            return result;
+        }
+        samples.push_back(toNs(state.elapsed()) / static_cast<double>(iterations));
+        bytesPerIteration = state.bytesPerIteration();
+        itemsPerIteration = state.itemsPerIteration();
+    }
+    std::sort(samples.begin(), samples.end());
+
+    result.iterations = iterations;
+    result.repetitions = static_cast<uint32_t>(samples.size());
+    result.nsPerOp = samples[samples.size() / 2];
+    result.minNsPerOp = samples.front();
+    result.maxNsPerOp = samples.back();
+    if (result.nsPerOp > 0.0) {
+        result.bytesPerSecond = bytesPerIteration * 1e9 / result.nsPerOp;
+        result.itemsPerSecond = itemsPerIteration * 1e9 / result.nsPerOp;
+    }
+    return result;
+}
+
+std::vector<BenchResult> WeaR_BenchRunner::run(const BenchOptions& options) const {
+    std::vector<BenchResult> results;
+
+    for (const auto& benchCase : m_cases) {
+        if (!options.filter.empty() && benchCase.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        BenchResult result = runCase(benchCase, options);
+        if (!result.failed.empty()) {
+            std::cout << std::format("{:<36} FAILED: {}\n", result.name, result.failed);
+        } else if (!result.skipped.empty()) {
+            std::cout << std::format("{:<36} skipped: {}\n", result.name, result.skipped);
+        } else {
+            std::string throughput = result.bytesPerSecond > 0.0
+                ? formatRate(result.bytesPerSecond, "B")
+                : formatRate(result.itemsPerSecond, "op");
+            std::cout << std::format("{:<36} {:>12.2f} ns/op  (min {:.2f}, max {:.2f})  {}\n",
+                                     result.name, result.nsPerOp, result.minNsPerOp,
+                                     result.maxNsPerOp, throughput);
+        }
+        std::cout.flush();
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+// =============================================================================
+// JSON OUTPUT
+// =============================================================================
+
+std::string WeaR_BenchRunner::toJson(const std::vector<BenchResult>& results, const std::string& label) {
+    auto escape = [](std::string_view text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+        }
+        return escaped;
+    };
+
+    // Host identity, so results from different machines are not compared blindly
+    const HostCpuInfo& cpu = getHostCpuInfo();
+
+    std::string out = "{\n";
+    out += std::format("  \"label\": \"{}\",\n", escape(label));
+    out += std::format("  \"host\": {{\"cpu\": \"{}\", \"cores\": {}, \"threads\": {}, \"simd\": \"{}\"}},\n",
+                       escape(cpu.brand.empty() ? cpu.vendor : cpu.brand), cpu.physicalCores,
+                       cpu.logicalProcessors, getSimdLevelName(cpu.simdLevel));
+    out += "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out += std::format(
+            "    {{\"name\": \"{}\", \"iterations\": {}, \"repetitions\": {}, "
+            "\"ns_per_op\": {:.3f}, \"min_ns_per_op\": {:.3f}, \"max_ns_per_op\": {:.3f}, "
+            "\"bytes_per_second\": {:.1f}, \"items_per_second\": {:.1f}, \"skipped\": {}, \"failed\": {}}}{}\n",
+            r.name, r.iterations, r.repetitions, r.nsPerOp, r.minNsPerOp, r.maxNsPerOp,
+            r.bytesPerSecond, r.itemsPerSecond, r.skipped.empty() ? "false" : "true",
+            r.failed.empty() ? "false" : "true",
+            i + 1 < results.size() ? "," : "");
+    }
+    out += "  ]\n}\n";
+    return out;
+}
+
+// =============================================================================
+// BASELINE COMPARISON
+// =============================================================================
+
+std::expected<std::map<std::string, double>, std::string>
+WeaR_BenchRunner::loadBaseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return std::unexpected(std::format("cannot open baseline '{}'", path));
+    }
+
+    std::map<std::string, double> baseline;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::string_view name = findField(line, "name");
+        std::string_view ns = findField(line, "ns_per_op");
+        if (name.empty() || ns.empty() || findField(line, "skipped") == "true" ||
+            findField(line, "failed") == "true") {
+            continue;
+        }
+
+        double value = 0.0;
+        auto [ptr, ec] = std::from_chars(ns.data(), ns.data() + ns.size(), value);
+        if (ec != std::errc{}) {
+            return std::unexpected(std::format("{}: bad ns_per_op for '{}'", path, name));
+        }
+        baseline[std::string(name)] = value;
+    }
+
+    if (baseline.empty()) {
+        return std::unexpected(std::format("{}: no benchmarks found", path));
+    }
+    return baseline;
+}
+
+std::vector<BenchComparison> WeaR_BenchRunner::compare(
+    const std::vector<BenchResult>& results,
+    const std::map<std::string, double>& baseline,
+    double thresholdPercent)
+{
+    std::vector<BenchComparison> rows;
+    for (const BenchResult& r : results) {
+        if (!r.skipped.empty() || !r.failed.empty()) continue;
+
+        BenchComparison row;
+        row.name = r.name;
+        row.currentNs = r.nsPerOp;
+
+        auto it = baseline.find(r.name);
+        if (it != baseline.end() && it->second > 0.0) {
+            row.baselineNs = it->second;
+            row.deltaPercent = (r.nsPerOp - it->second) / it->second * 100.0;
+            row.regressed = row.deltaPercent > thresholdPercent;
+        }
+        rows.push_back(std::move(row));
+    }
+    return rows;
+}
+
+} // namespace WeaR
@@ -0,0 +1,198 @@
+#pragma once
+
+/**
+ * @file WeaR_Bench.h
+ * @brief Self-contained benchmark harness for wear_bench
+ *
+ * A case does its setup, then calls BenchState::measure() with the body of
+ * one iteration. The runner calibrates the iteration count to a minimum
+ * run time, repeats the measurement and reports the median. Results are
+ * written as JSON (one benchmark per line) and can be compared against a
+ * previous run to flag regressions per commit.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace WeaR {
+
+// =============================================================================
+// OPTIMIZATION BARRIER
+// =============================================================================
+
+/**
+ * @brief Keep the compiler from discarding a value computed in a benchmark
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    static const void* volatile sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// =============================================================================
+// BENCHMARK STATE
+// =============================================================================
+
+/**
+ * @brief Per-run state handed to a benchmark case
+ */
+class BenchState {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit BenchState(uint64_t iterations) : m_iterations(iterations) {}
+
+    /**
+     * @brief Time @p body executed once per iteration
+     *
+     * Must be called exactly once per case invocation; anything before it
+     * is untimed setup.
+     */
+    template<typename Fn>
+    void measure(Fn&& body) {
+        const auto start = Clock::now();
+        for (uint64_t i = 0; i < m_iterations; ++i) {
+            body();
+        }
+        m_elapsed = Clock::now() - start;
+    }
+
+    /**
+     * @brief Bytes and operations handled by one iteration (for throughput)
+     */
+    void setBytesPerIteration(uint64_t bytes) { m_bytesPerIteration = bytes; }
+    void setItemsPerIteration(uint64_t items) { m_itemsPerIteration = items; }
+
+    /**
+     * @brief Mark the case as unusable on this host (reported, not timed)
+     */
+    void skip(std::string reason) { m_skipReason = std::move(reason); }
+
+    /**
+     * @brief Record a wrong result (reported, not timed; wear_bench exits non-zero)
+     */
+    void fail(std::string reason) { m_failReason = std::move(reason); }
+
+    [[nodiscard]] uint64_t iterations() const { return m_iterations; }
+    [[nodiscard]] Clock::duration elapsed() const { return m_elapsed; }
+    [[nodiscard]] uint64_t bytesPerIteration() const { return m_bytesPerIteration; }
+    [[nodiscard]] uint64_t itemsPerIteration() const { return m_itemsPerIteration; }
+    [[nodiscard]] const std::string& skipReason() const { return m_skipReason; }
+    [[nodiscard]] const std::string& failReason() const { return m_failReason; }
+
+private:
+    uint64_t m_iterations;
+    Clock::duration m_elapsed{};
+    uint64_t m_bytesPerIteration = 0;
+    uint64_t m_itemsPerIteration = 1;
+    std::string m_skipReason;
+    std::string m_failReason;
+};
+
+using BenchFunction = std::function<void(BenchState&)>;
+
+// =============================================================================
+// RESULTS
+// =============================================================================
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;        // Per repetition
+    uint32_t repetitions = 0;
+    double nsPerOp = 0.0;           // Median over repetitions
+    double minNsPerOp = 0.0;
+    double maxNsPerOp = 0.0;
+    double bytesPerSecond = 0.0;    // 0 if the case reports no bytes
+    double itemsPerSecond = 0.0;
+    std::string skipped;            // Non-empty if the case was skipped
+    std::string failed;             // Non-empty if a correctness check failed
+};
+
+struct BenchOptions {
+    std::string filter;             // Substring match on the case name
+    double minTimeSeconds = 0.1;    // Per repetition
+    uint32_t repetitions = 5;
+};
+
+/**
+ * @brief One row of a baseline comparison
+ */
+struct BenchComparison {
+    std::string name;
+    double baselineNs = 0.0;        // 0 if the case is new
+    double currentNs = 0.0;
+    double deltaPercent = 0.0;      // Positive = slower
+    bool regressed = false;
+};
+
+// =============================================================================
+// RUNNER
+// =============================================================================
+
+class WeaR_BenchRunner {
+public:
+    /**
+     * @brief Register a case; names use "group/case" ("memory/read_u64")
+     */
+    void add(std::string name, BenchFunction function);
+
+    [[nodiscard]] std::vector<std::string> getNames() const;
+
+    /**
+     * @brief Run every case matching the filter, reporting progress to stdout
+     */
+    [[nodiscard]] std::vector<BenchResult> run(const BenchOptions& options) const;
+
+    /**
+     * @brief JSON document with one benchmark object per line
+     * @param label Free-form run label (commit hash, build id)
+     */
+    [[nodiscard]] static std::string toJson(const std::vector<BenchResult>& results,
+                                            const std::string& label);
+
+    /**
+     * @brief Read median ns/op per benchmark from a previous toJson() file
+     */
+    [[nodiscard]] static std::expected<std::map<std::string, double>, std::string>
+    loadBaseline(const std::string& path);
+
+    /**
+     * @brief Compare results against a baseline
+     * @param thresholdPercent Slowdown above which a case counts as regressed
+     */
+    [[nodiscard]] static std::vector<BenchComparison> compare(
+        const std::vector<BenchResult>& results,
+        const std::map<std::string, double>& baseline,
+        double thresholdPercent);
+
+private:
+    struct Case {
+        std::string name;
+        BenchFunction function;
+    };
+
+    [[nodiscard]] BenchResult runCase(const Case& benchCase, const BenchOptions& options) const;
+
+    std::vector<Case> m_cases;
+};
+
+/**
+ * @brief Register the emulator hot-path benchmarks (WeaR_Benchmarks.cpp)
+ */
+void registerCoreBenchmarks(WeaR_BenchRunner& runner);
+
+} // namespace WeaR
@@ -0,0 +1,454 @@
+/**
+ * @file WeaR_Benchmarks.cpp
+ * @brief Hot-path benchmark cases for wear_bench
+ *
+ * Every case drives wear_core directly with synthetic input: no game
+ * files, no GPU and no audio device are needed, so the numbers are
+ * comparable across machines of the same class and across commits.
+ */
+
+#include "WeaR_Bench.h"
+#include "Core/WeaR_Memory.h"
+#include "Core/WeaR_Cpu.h"
+#include "Core/WeaR_InternalBios.h"
+#include "Core/WeaR_Simd.h"
+#include "Core/WeaR_EmulationContext.h"
+#include "HLE/WeaR_Syscalls.h"
+#include "HLE/Graphics/WeaR_GnmDriver.h"
+#include "HLE/Graphics/PM4_Packets.h"
+#include "HLE/FileSystem/WeaR_VFS.h"
+#include "Graphics/WeaR_RenderQueue.h"
+#include "Loader/WeaR_PkgLoader.h"
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace WeaR {
+
+namespace {
+
+constexpr uint64_t DATA_ADDR = PS4Memory::Region::HEAP_BASE;        // Memory benchmarks
+constexpr uint64_t PM4_ADDR = PS4Memory::Region::HEAP_BASE + 0x100000;
+constexpr uint64_t IDLE_SKIP_LIMIT = 1'000'003;    // Not a multiple of any loop length used
+
+/**
+ * @brief Guest memory shared by all cases (reserving 8 GB once is enough)
+ */
+WeaR_Memory& benchMemory() {
+    static WeaR_Memory memory;
+    return memory;
+}
+
+/**
+ * @brief Scratch directory for file-backed cases, removed at exit
+ */
+const std::filesystem::path& scratchDir() {
+    struct Scratch {
+        std::filesystem::path path;
+        Scratch() {
+            path = std::filesystem::temp_directory_path() / "wear_bench";
+            std::filesystem::create_directories(path);
+        }
+        ~Scratch() {
+            std::error_code ec;
+            std::filesystem::remove_all(path, ec);
+        }
+    };
+    static Scratch scratch;
+    return scratch.path;
+}
+
+void writeFile(const std::filesystem::path& path, const std::vector<uint8_t>& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+template<typename T>
+T toBigEndian(T value) {
+    if constexpr (std::endian::native == std::endian::little) {
+        return std::byteswap(value);
+    }
+    return value;
+}
+
+// =============================================================================
+// MEMORY
+// =============================================================================
+
+void registerMemoryBenchmarks(WeaR_BenchRunner& runner) {
+    runner.add("memory/read_u64", [](BenchState& state) {
+        auto& mem = benchMemory();
+        mem.write<uint64_t>(DATA_ADDR, 0x0123456789ABCDEFULL);
+        state.setBytesPerIteration(sizeof(uint64_t));
+        state.measure([&] {
+            doNotOptimize(mem.read<uint64_t>(DATA_ADDR));
+        });
+    });
+
+    runner.add("memory/write_u64", [](BenchState& state) {
+        auto& mem = benchMemory();
+        uint64_t value = 0;
+        state.setBytesPerIteration(sizeof(uint64_t));
+        state.measure([&] {
+            mem.write<uint64_t>(DATA_ADDR, value++);
+        });
+    });
+
+    runner.add("memory/read_u8_sequential", [](BenchState& state) {
+        auto& mem = benchMemory();
+        uint64_t offset = 0;
+        state.setBytesPerIteration(1);
+        state.measure([&] {
+            doNotOptimize(mem.read<uint8_t>(DATA_ADDR + (offset++ & 0xFFFF)));
+        });
+    });
+
+    for (size_t size : { size_t(64), size_t(4096), size_t(1) << 20 }) {
+        runner.add(std::format("memory/read_block_{}", size), [size](BenchState& state) {
+            auto& mem = benchMemory();
+            std::vector<uint8_t> buffer(size);
+            state.setBytesPerIteration(size);
+            state.measure([&] {
+                mem.readBlock(DATA_ADDR, buffer.data(), size);
+                doNotOptimize(buffer.data());
+            });
+        });
+    }
+}
+
+// =============================================================================
+// CPU
+// =============================================================================
+
+void registerCpuBenchmarks(WeaR_BenchRunner& runner) {
+    using InternalBios::InstructionMix;
+
+    for (InstructionMix mix : { InstructionMix::Nop, InstructionMix::MovImm, InstructionMix::Stack,
+                                InstructionMix::Branch, InstructionMix::Mixed }) {
+        runner.add(std::format("cpu/step_{}", InternalBios::getInstructionMixName(mix)),
+                   [mix](BenchState& state) {
+            auto& mem = benchMemory();
+            WeaR_Cpu cpu(mem);
+            InternalBios::loadInstructionMix(mem, cpu.getContext(), mix);
+            state.measure([&] {
+                doNotOptimize(cpu.step());
+            });
+            if (cpu.getState() == CpuState::Faulted) {
+                state.skip("CPU faulted while running the instruction mix");
+            }
+        });
+    }
+
+    // Idle loops counted without running them must end exactly where
+    // running them would: same instruction count, same RIP
+    for (InstructionMix mix : { InstructionMix::Nop, InstructionMix::MovImm }) {
+        runner.add(std::format("cpu/idle_skip_{}", InternalBios::getInstructionMixName(mix)),
+                   [mix](BenchState& state) {
+            struct Outcome { uint64_t instructions = 0; uint64_t rip = 0; uint64_t skipped = 0; };
+            auto runToLimit = [mix](bool idleDetection) {
+                auto& mem = benchMemory();
+                WeaR_Cpu cpu(mem);
+                InternalBios::loadInstructionMix(mem, cpu.getContext(), mix);
+                cpu.setIdleDetection(idleDetection);
+                cpu.setInstructionLimit(IDLE_SKIP_LIMIT);
+                cpu.runLoop();
+                return Outcome{ cpu.getInstructionCount(), cpu.getContext().RIP,
+                                cpu.getIdleStats().skippedInstructions };
+            };
+
+            const Outcome expected = runToLimit(false);
+            Outcome actual;
+            state.measure([&] {
+                actual = runToLimit(true);
+            });
+
+            if (actual.skipped == 0) {
+                state.fail("idle loop was not detected");
+            } else if (actual.instructions != expected.instructions || actual.rip != expected.rip) {
+                state.fail(std::format("stopped at {} instructions, RIP 0x{:X}; expected {}, RIP 0x{:X}",
+                                       actual.instructions, actual.rip,
+                                       expected.instructions, expected.rip));
+            }
+        });
+    }
+}
+
+// =============================================================================
+// SYSCALLS
+// =============================================================================
+
+void registerSyscallBenchmarks(WeaR_BenchRunner& runner) {
+    runner.add("syscalls/dispatch_getpid", [](BenchState& state) {
+        auto& mem = benchMemory();
+        WeaR_EmulationContext emulation;
+        auto& syscalls = emulation.getSyscalls();
+        WeaR_Context ctx{};
+        state.measure([&] {
+            ctx.RAX = Syscall::SYS_getpid;
+            syscalls.dispatch(ctx, mem);
+            doNotOptimize(ctx.RAX);
+        });
+    });
+
+    runner.add("syscalls/dispatch_unimplemented", [](BenchState& state) {
+        auto& mem = benchMemory();
+        WeaR_EmulationContext emulation;
+        auto& syscalls = emulation.getSyscalls();
+        WeaR_Context ctx{};
+        state.measure([&] {
+            ctx.RAX = 0xFFFF;
+            syscalls.dispatch(ctx, mem);
+            doNotOptimize(ctx.RAX);
+        });
+    });
+}
+
+// =============================================================================
+// PM4
+// =============================================================================
+
+/**
+ * @brief Write a typical draw-heavy command buffer; returns its size in dwords
+ *
+ * Per draw: a 4-register context write, an 8-register SH write, a NOP
+ * and a DRAW_INDEX_AUTO; every 16 draws a DISPATCH_DIRECT and EVENT_WRITE.
+ */
+uint32_t writeSyntheticCommandBuffer(WeaR_Memory& mem, uint64_t addr, uint32_t drawCount,
+                                     uint32_t& drawsOut) {
+    std::vector<uint32_t> dwords;
+    auto packet = [&](uint8_t opcode, std::initializer_list<uint32_t> payload) {
+        dwords.push_back(PM4::buildHeader(opcode, static_cast<uint16_t>(payload.size())));
+        dwords.insert(dwords.end(), payload);
+    };
+
+    drawsOut = 0;
+    for (uint32_t i = 0; i < drawCount; ++i) {
+        packet(PM4::Opcode::IT_SET_CONTEXT_REG, { 0x0318, i, 0x10, 0x20, 0x30 });
+        packet(PM4::Opcode::IT_SET_SH_REG, { 0x004C, i, i + 1, i + 2, i + 3, i + 4, i + 5, i + 6, i + 7 });
+        packet(PM4::Opcode::IT_NOP, { 0 });
+        packet(PM4::Opcode::IT_DRAW_INDEX_AUTO, { 3 * (i + 1), 2 });
+        ++drawsOut;
+        if (i % 16 == 15) {
+            packet(PM4::Opcode::IT_DISPATCH_DIRECT, { 8, 8, 1, 1 });
+            packet(PM4::Opcode::IT_EVENT_WRITE, { 0x16 });
+        }
+    }
+
+    mem.writeBlock(addr, dwords.data(), dwords.size() * sizeof(uint32_t));
+    return static_cast<uint32_t>(dwords.size());
+}
+
+void registerPm4Benchmarks(WeaR_BenchRunner& runner) {
+    runner.add("pm4/process_draw_stream", [](BenchState& state) {
+        auto& mem = benchMemory();
+        WeaR_RenderQueue queue;
+        WeaR_GnmDriver driver(queue);
+        uint32_t draws = 0;
+        const uint32_t dwords = writeSyntheticCommandBuffer(mem, PM4_ADDR, 256, draws);
+
+        state.setBytesPerIteration(dwords * sizeof(uint32_t));
+        state.setItemsPerIteration(draws);
+        state.measure([&] {
+            driver.processCommandBuffer(PM4_ADDR, dwords, mem);
+            queue.clear();      // Nothing consumes the queue here
+        });
+    });
+}
+
+// =============================================================================
+// RENDER QUEUE
+// =============================================================================
+
+void registerRenderQueueBenchmarks(WeaR_BenchRunner& runner) {
+    constexpr size_t BATCH = 64;
+
+    runner.add("render_queue/push_pop_64", [](BenchState& state) {
+        WeaR_RenderQueue queue;
+        WeaR_DrawCmd cmd;
+        cmd.type = RenderCmdType::DrawAuto;
+        cmd.vertexCount = 3;
+        state.setItemsPerIteration(BATCH);
+        state.measure([&] {
+            for (size_t i = 0; i < BATCH; ++i) {
+                queue.push(cmd);
+            }
+            doNotOptimize(queue.popAll());
+        });
+    });
+
+    runner.add("render_queue/push_batch_pop_64", [](BenchState& state) {
+        WeaR_RenderQueue queue;
+        std::vector<WeaR_DrawCmd> batch(BATCH);
+        for (auto& cmd : batch) {
+            cmd.type = RenderCmdType::DrawAuto;
+            cmd.vertexCount = 3;
+        }
+        state.setItemsPerIteration(BATCH);
+        state.measure([&] {
+            queue.push(batch);
+            doNotOptimize(queue.popAll());
+        });
+    });
+}
+
+// =============================================================================
+// VFS
+// =============================================================================
+
+void registerVfsBenchmarks(WeaR_BenchRunner& runner) {
+    constexpr size_t FILE_SIZE = 256 * 1024;
+    constexpr size_t CHUNK = 4096;
+
+    auto prepare = [](BenchState& state, WeaR_VFS& vfs) -> bool {
+        std::filesystem::path dir = scratchDir() / "app0";
+        std::filesystem::create_directories(dir);
+        if (!std::filesystem::exists(dir / "data.bin")) {
+            writeFile(dir / "data.bin", std::vector<uint8_t>(FILE_SIZE, 0xA5));
+        }
+        if (!vfs.isMounted("/app0") && !vfs.mount("/app0", dir.string())) {
+            state.skip("cannot mount scratch directory");
+            return false;
+        }
+        return true;
+    };
+
+    runner.add("vfs/open_close", [prepare](BenchState& state) {
+        WeaR_VFS vfs;
+        if (!prepare(state, vfs)) return;
+        state.measure([&] {
+            int32_t fd = vfs.openFile("/app0/data.bin", OpenFlags::O_RDONLY, 0);
+            (void)vfs.closeFile(fd);
+        });
+    });
+
+    runner.add("vfs/read_4k", [prepare](BenchState& state) {
+        WeaR_VFS vfs;
+        if (!prepare(state, vfs)) return;
+        int32_t fd = vfs.openFile("/app0/data.bin", OpenFlags::O_RDONLY, 0);
+        if (fd < 0) {
+            state.skip("cannot open scratch file");
+            return;
+        }
+        std::array<uint8_t, CHUNK> buffer{};
+        size_t offset = 0;
+        state.setBytesPerIteration(CHUNK);
+        state.measure([&] {
+            if (offset + CHUNK > FILE_SIZE) {
+                (void)vfs.seekFile(fd, 0, 0);
+                offset = 0;
+            }
+            doNotOptimize(vfs.readFile(fd, buffer.data(), CHUNK));
+            offset += CHUNK;
+        });
+        (void)vfs.closeFile(fd);
+    });
+}
+
+// =============================================================================
+// PKG
+// =============================================================================
+
+/**
+ * @brief Write a minimal PKG with an eboot entry of @p ebootSize bytes
+ */
+std::filesystem::path writeSyntheticPkg(size_t ebootSize) {
+    std::filesystem::path path = scratchDir() / std::format("synthetic_{}.pkg", ebootSize);
+    if (std::filesystem::exists(path)) return path;
+
+    constexpr uint32_t ENTRY_COUNT = 2;
+    const uint32_t tableOffset = sizeof(PkgHeader);
+    const uint32_t dataOffset = tableOffset + ENTRY_COUNT * sizeof(PkgEntry);
+
+    PkgHeader header{};
+    header.magic = toBigEndian(PKG_MAGIC);
+    header.entryCount = toBigEndian(ENTRY_COUNT);
+    header.tableOffset = toBigEndian(tableOffset);
+    std::memcpy(header.contentId, "UP0000-WEAR00000_00-BENCHMARK0000000", sizeof(header.contentId));
+
+    std::array<PkgEntry, ENTRY_COUNT> entries{};
+    entries[0].id = toBigEndian(PKG_ENTRY_ID_PARAM_SFO);
+    entries[0].dataOffset = toBigEndian(dataOffset);
+    entries[0].dataSize = toBigEndian(uint32_t(256));
+    entries[1].id = toBigEndian(PKG_ENTRY_ID_EBOOT);
+    entries[1].dataOffset = toBigEndian(dataOffset + 256);
+    entries[1].dataSize = toBigEndian(static_cast<uint32_t>(ebootSize));
+
+    std::vector<uint8_t> data(dataOffset + 256 + ebootSize, 0x5A);
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + tableOffset, entries.data(), sizeof(entries));
+    writeFile(path, data);
+    return path;
+}
+
+void registerPkgBenchmarks(WeaR_BenchRunner& runner) {
+    for (size_t size : { size_t(64) * 1024, size_t(4) << 20 }) {
+        runner.add(std::format("pkg/extract_entry_{}k", size / 1024), [size](BenchState& state) {
+            WeaR_PkgLoader loader;
+            if (!loader.loadPackage(writeSyntheticPkg(size))) {
+                state.skip("synthetic PKG failed to load");
+                return;
+            }
+            state.setBytesPerIteration(size);
+            state.measure([&] {
+                doNotOptimize(loader.extractEntry(PKG_ENTRY_ID_EBOOT));
+            });
+        });
+    }
+
+    runner.add("pkg/load_package", [](BenchState& state) {
+        std::filesystem::path path = writeSyntheticPkg(size_t(64) * 1024);
+        WeaR_PkgLoader loader;
+        state.measure([&] {
+            doNotOptimize(loader.loadPackage(path));
+        });
+    });
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// SIMD KERNELS
+// =============================================================================
+
+void registerSimdBenchmarks(WeaR_BenchRunner& runner) {
+    // One case per level the host can run, so the dispatch gain is visible
+    const auto maxLevel = static_cast<uint8_t>(getHostCpuInfo().simdLevel);
+    for (uint8_t i = 0; i <= maxLevel; ++i) {
+        const auto level = static_cast<SimdLevel>(i);
+        runner.add(std::format("simd/scale_pcm16_{}", getSimdLevelName(level)), [level](BenchState& state) {
+            const SimdKernels& kernels = getSimdKernels(level);
+            std::vector<int16_t> samples(2048);    // 1024 stereo frames
+            for (size_t j = 0; j < samples.size(); ++j) {
+                samples[j] = static_cast<int16_t>(j * 977);
+            }
+            state.setBytesPerIteration(samples.size() * sizeof(int16_t));
+            state.measure([&] {
+                kernels.scalePcm16(samples.data(), samples.size(), 0x7000);
+                doNotOptimize(samples.data());
+            });
+        });
+    }
+}
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+void registerCoreBenchmarks(WeaR_BenchRunner& runner) {
+    registerMemoryBenchmarks(runner);
+    registerCpuBenchmarks(runner);
+    registerSyscallBenchmarks(runner);
+    registerPm4Benchmarks(runner);
+    registerRenderQueueBenchmarks(runner);
+    registerVfsBenchmarks(runner);
+    registerPkgBenchmarks(runner);
+    registerSimdBenchmarks(runner);
+}
+
+} // namespace WeaR
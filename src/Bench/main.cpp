@@ -0,0 +1,172 @@
+/**
+ * @file main.cpp
+ * @brief wear_bench entry point - hot-path micro/macro benchmarks
+ *
+ * Typical CI use: run once per commit with --json, keep the file of the
+ * previous commit and pass it as --baseline to fail on regressions.
+ */
+
+#include "Bench/WeaR_Bench.h"
+#include "Core/WeaR_Log.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <format>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr int EXIT_USAGE = 2;
+constexpr int EXIT_REGRESSION = 3;
+constexpr int EXIT_CHECK_FAILED = 4;
+
+void printUsage(std::ostream& out) {
+    out << "Usage: wear_bench [options]\n"
+           "\n"
+           "Options:\n"
+           "  --filter TEXT        Run only benchmarks whose name contains TEXT\n"
+           "  --list               List benchmark names and exit\n"
+           "  --min-time S         Minimum seconds per repetition (default 0.1)\n"
+           "  --repetitions N      Measured repetitions, median is reported (default 5)\n"
+           "  --json FILE          Write results as JSON ('-' = stdout)\n"
+           "  --label TEXT         Label stored in the JSON (e.g. commit hash)\n"
+           "  --baseline FILE      Compare against a previous --json file\n"
+           "  --threshold PCT      Slowdown that counts as a regression (default 10)\n"
+           "  -h, --help           Show this help\n";
+}
+
+template<typename T>
+bool parseNumber(std::string_view text, T& out) {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    WeaR::BenchOptions options;
+    std::string jsonPath;
+    std::string label;
+    std::string baselinePath;
+    double threshold = 10.0;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << std::format("wear_bench: {} requires a value\n", arg);
+                std::exit(EXIT_USAGE);
+            }
+            return argv[++i];
+        };
+
+        bool ok = true;
+        if (arg == "-h" || arg == "--help") {
+            printUsage(std::cout);
+            return EXIT_SUCCESS;
+        } else if (arg == "--list") {
+            listOnly = true;
+        } else if (arg == "--filter") {
+            options.filter = value();
+        } else if (arg == "--min-time") {
+            ok = parseNumber(value(), options.minTimeSeconds) && options.minTimeSeconds > 0.0;
+        } else if (arg == "--repetitions") {
+            ok = parseNumber(value(), options.repetitions) && options.repetitions > 0;
+        } else if (arg == "--json") {
+            jsonPath = value();
+        } else if (arg == "--label") {
+            label = value();
+        } else if (arg == "--baseline") {
+            baselinePath = value();
+        } else if (arg == "--threshold") {
+            ok = parseNumber(value(), threshold) && threshold >= 0.0;
+        } else {
+            std::cerr << std::format("wear_bench: unknown option '{}'\n", arg);
+            printUsage(std::cerr);
+            return EXIT_USAGE;
+        }
+
+        if (!ok) {
+            std::cerr << std::format("wear_bench: invalid value for {}\n", arg);
+            return EXIT_USAGE;
+        }
+    }
+
+    WeaR::WeaR_BenchRunner runner;
+    WeaR::registerCoreBenchmarks(runner);
+
+    if (listOnly) {
+        for (const auto& name : runner.getNames()) {
+            std::cout << name << "\n";
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Load the baseline up front so a bad path fails before a long run
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty()) {
+        auto loaded = WeaR::WeaR_BenchRunner::loadBaseline(baselinePath);
+        if (!loaded) {
+            std::cerr << std::format("wear_bench: {}\n", loaded.error());
+            return EXIT_FAILURE;
+        }
+        baseline = std::move(*loaded);
+    }
+
+    // Measure the hot paths, not the log formatter
+    for (size_t i = 0; i < WeaR::LOG_CATEGORY_COUNT; ++i) {
+        WeaR::WeaR_LogFilter::setThreshold(static_cast<WeaR::LogCategory>(i), WeaR::LogThreshold::Error);
+    }
+
+    auto results = runner.run(options);
+    WeaR::getAsyncLogger().flush();
+
+    if (!jsonPath.empty()) {
+        std::string json = WeaR::WeaR_BenchRunner::toJson(results, label);
+        if (jsonPath == "-") {
+            std::cout << json;
+        } else {
+            std::ofstream file(jsonPath, std::ios::trunc);
+            if (!file || !(file << json)) {
+                std::cerr << std::format("wear_bench: cannot write '{}'\n", jsonPath);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    // A wrong result outranks any timing
+    const auto failed = std::ranges::count_if(results, [](const auto& r) { return !r.failed.empty(); });
+    if (failed > 0) {
+        std::cout << std::format("\n{} benchmark check(s) failed\n", failed);
+        return EXIT_CHECK_FAILED;
+    }
+
+    if (baseline.empty()) {
+        return EXIT_SUCCESS;
+    }
+
+    std::cout << std::format("\n{:<36} {:>12} {:>12} {:>9}\n", "Benchmark", "Baseline", "Current", "Delta");
+    bool regressed = false;
+    for (const auto& row : WeaR::WeaR_BenchRunner::compare(results, baseline, threshold)) {
+        if (row.baselineNs == 0.0) {
+            std::cout << std::format("{:<36} {:>12} {:>12.2f} {:>9}\n", row.name, "-", row.currentNs, "new");
+            continue;
+        }
+        std::cout << std::format("{:<36} {:>12.2f} {:>12.2f} {:>+8.1f}%{}\n",
+                                 row.name, row.baselineNs, row.currentNs, row.deltaPercent,
+                                 row.regressed ? "  REGRESSED" : "");
+        regressed |= row.regressed;
+    }
+
+    if (regressed) {
+        std::cout << std::format("\nRegressions above {:.1f}% detected\n", threshold);
+        return EXIT_REGRESSION;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,614 @@
+#include "WeaR_HeadlessRunner.h"
+#include "Core/WeaR_EmulationContext.h"
+#include "Core/WeaR_EmulatorCore.h"
+#include "Core/WeaR_Cpu.h"
+#include "Core/WeaR_HostCpu.h"
+#include "Core/WeaR_JobSystem.h"
+#include "Core/WeaR_Log.h"
+#include "Core/WeaR_ThreadRoles.h"
+#include "Core/WeaR_Trace.h"
+#include "Core/WeaR_TitleProfile.h"
+#include "Hardware/HardwareSpecs.h"
+#include "HLE/WeaR_Syscalls.h"
+#include "HLE/Graphics/WeaR_GnmDriver.h"
+#include "HLE/FileSystem/WeaR_VFS.h"
+#include "Graphics/WeaR_RenderQueue.h"
+#include "Audio/WeaR_AudioManager.h"
+#include "Input/WeaR_Input.h"
+#include "Input/WeaR_InputReplay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace WeaR {
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+namespace {
+
+constexpr auto POLL_INTERVAL = std::chrono::milliseconds(10);
+constexpr size_t HOT_FUNCTION_COUNT = 10;   // Guest profiler entries in the report
+
+/**
+ * @brief Stops a trace capture on every exit path of a run
+ */
+class TraceCaptureGuard {
+public:
+    explicit TraceCaptureGuard(bool active) : m_active(active) {}
+    ~TraceCaptureGuard() { stop(); }
+
+    TraceCaptureGuard(const TraceCaptureGuard&) = delete;
+    TraceCaptureGuard& operator=(const TraceCaptureGuard&) = delete;
+
+    void stop() {
+        if (m_active) {
+            getTracer().stop();
+            m_active = false;
+        }
+    }
+
+private:
+    bool m_active;
+};
+
+/**
+ * @brief Shuts the core down on every exit path of a run, failed boots included
+ */
+class CoreShutdownGuard {
+public:
+    explicit CoreShutdownGuard(WeaR_EmulatorCore& core) : m_core(core) {}
+    ~CoreShutdownGuard() { m_core.shutdown(); }
+
+    CoreShutdownGuard(const CoreShutdownGuard&) = delete;
+    CoreShutdownGuard& operator=(const CoreShutdownGuard&) = delete;
+
+private:
+    WeaR_EmulatorCore& m_core;
+};
+
+/**
+ * @brief Snapshot of the context counters the runner reports as deltas
+ */
+struct CounterSnapshot {
+    uint64_t instructions = 0;
+    CpuIdleStats idle;
+    uint64_t syscalls = 0;
+    uint64_t unimplementedSyscalls = 0;
+    uint64_t pm4Packets = 0;
+    uint64_t drawCalls = 0;
+    uint64_t audioFrames = 0;
+
+    static CounterSnapshot take(const WeaR_Cpu& cpu, const WeaR_EmulationContext& emulation) {
+        CounterSnapshot s;
+        s.instructions = cpu.getInstructionCount();
+        s.idle = cpu.getIdleStats();
+        s.syscalls = emulation.getSyscalls().getTotalCalls();
+        s.unimplementedSyscalls = emulation.getSyscalls().getUnimplementedCalls();
+        s.pm4Packets = emulation.getGnmDriver().getPacketsProcessed();
+        s.drawCalls = emulation.getGnmDriver().getDrawCallsQueued();
+        s.audioFrames = emulation.getAudio().getTotalFramesOutput();
+        return s;
+    }
+};
+
+std::string escapeJson(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+const char* getHeadlessExitName(HeadlessExit exit) {
+    switch (exit) {
+        case HeadlessExit::Halted:           return "halted";
+        case HeadlessExit::InstructionLimit: return "instruction-limit";
+        case HeadlessExit::TimeLimit:        return "time-limit";
+        case HeadlessExit::Faulted:          return "faulted";
+        case HeadlessExit::Flip:             return "flip";
+        case HeadlessExit::NothingToRun:     return "nothing-to-run";
+        default:                             return "unknown";
+    }
+}
+
+// =============================================================================
+// RUN
+// =============================================================================
+
+namespace {
+
+struct ExecuteLimits {
+    uint64_t maxInstructions = 0;   // Counted from the current instruction; 0 = unlimited
+    double maxSeconds = 0.0;        // 0 = unlimited
+    bool stopAtFlip = false;        // Stop at the next sceGnmSubmitDone
+};
+
+/**
+ * @brief Run the guest on a CPU thread until a limit, a fault or a halt
+ *
+ * Replay events at or before the current instruction are applied at once,
+ * so a journal recorded from boot also works from a fork point.
+ */
+HeadlessStats execute(WeaR_EmulationContext& emulation, WeaR_Cpu& cpu,
+                      const std::vector<InputReplayEvent>& replay, const ExecuteLimits& limits)
+{
+    using Clock = std::chrono::steady_clock;
+
+    HeadlessStats stats;
+    const CounterSnapshot before = CounterSnapshot::take(cpu, emulation);
+    const uint64_t flipsBefore = emulation.getSyscalls().getFlipCount();
+    const uint64_t instructionLimit = limits.maxInstructions != 0
+        ? before.instructions + limits.maxInstructions : 0;
+
+    std::atomic<bool> timedOut{false};
+    std::atomic<bool> flipped{false};
+    std::atomic<bool> finished{false};
+    HeadlessExit exit = HeadlessExit::Halted;
+
+    // runLoop() returns at each replay boundary so input lands on an exact
+    // instruction count; the loop resumes until a real stop condition
+    std::thread cpuThread([&] {
+        getTracer().setThreadName("CPU");
+        ScopedThreadRole threadRole(ThreadRole::GuestCpu, "CPU");
+        size_t next = 0;
+        while (true) {
+            const uint64_t count = cpu.getInstructionCount();
+            for (; next < replay.size() && replay[next].instruction <= count; ++next) {
+                emulation.getInput().setPadState(replay[next].state);
+                ++stats.replayEvents;
+            }
+
+            uint64_t limit = instructionLimit;
+            if (next < replay.size()) {
+                limit = limit != 0 ? std::min(limit, replay[next].instruction) : replay[next].instruction;
+            }
+            cpu.setInstructionLimit(limit);
+
+            if (timedOut.load()) { exit = HeadlessExit::TimeLimit; break; }
+            if (flipped.load())  { exit = HeadlessExit::Flip; break; }
+
+            cpu.runLoop();
+
+            const uint64_t reached = cpu.getInstructionCount();
+            if (cpu.getState() == CpuState::Faulted)                  { exit = HeadlessExit::Faulted; break; }
+            if (timedOut.load())                                       { exit = HeadlessExit::TimeLimit; break; }
+            if (flipped.load())                                        { exit = HeadlessExit::Flip; break; }
+            if (instructionLimit != 0 && reached >= instructionLimit) { exit = HeadlessExit::InstructionLimit; break; }
+            if (limit != 0 && reached >= limit) continue;             // Replay boundary
+            exit = HeadlessExit::Halted;
+            break;
+        }
+        cpu.setInstructionLimit(0);
+        finished.store(true);
+    });
+
+    // Watchdog + render queue drain. stop() is repeated because runLoop()
+    // clears the stop request when it is re-entered at a replay boundary.
+    const auto start = Clock::now();
+    while (!finished.load()) {
+        std::this_thread::sleep_for(POLL_INTERVAL);
+        stats.renderCommands += emulation.getRenderQueue().popAll().size();
+
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (limits.maxSeconds > 0.0 && elapsed >= limits.maxSeconds) {
+            timedOut.store(true);
+            cpu.stop();
+        }
+        if (limits.stopAtFlip && emulation.getSyscalls().getFlipCount() != flipsBefore) {
+            flipped.store(true);
+            cpu.stop();
+        }
+    }
+    cpuThread.join();
+    stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    stats.renderCommands += emulation.getRenderQueue().popAll().size();
+
+    const CounterSnapshot after = CounterSnapshot::take(cpu, emulation);
+    stats.exit = exit;
+    stats.instructions = after.instructions - before.instructions;
+    stats.skippedInstructions = after.idle.skippedInstructions - before.idle.skippedInstructions;
+    stats.idleSeconds = static_cast<double>(after.idle.waitNs - before.idle.waitNs) / 1e9;
+    stats.syscalls = after.syscalls - before.syscalls;
+    stats.unimplementedSyscalls = after.unimplementedSyscalls - before.unimplementedSyscalls;
+    stats.pm4Packets = after.pm4Packets - before.pm4Packets;
+    stats.drawCalls = after.drawCalls - before.drawCalls;
+    stats.audioFrames = after.audioFrames - before.audioFrames;
+    stats.finalRip = cpu.getContext().RIP;
+    return stats;
+}
+
+} // anonymous namespace
+
+std::expected<void, std::string> WeaR_HeadlessRunner::configureHost() {
+    // Before boot, so loader jobs already run on their cores
+    auto threadRoles = ThreadRoleConfig::parse(m_options.threadRoles, getHostCpuInfo());
+    if (!threadRoles) {
+        return std::unexpected(std::format("Invalid thread roles '{}': {}", m_options.threadRoles,
+                                           threadRoles.error()));
+    }
+    getThreadRoles().configure(*threadRoles);
+    if (!m_options.profileDir.empty()) {
+        getTitleProfiles().setDirectory(m_options.profileDir);
+    }
+
+    // Capture from boot so loader file reads show up on the timeline
+    if (!m_options.tracePath.empty() && !getTracer().start()) {
+        return std::unexpected("Tracing is not compiled into this build");
+    }
+    return {};
+}
+
+std::expected<void, std::string> WeaR_HeadlessRunner::boot(WeaR_EmulationContext& emulation) {
+    // No device, no pacing: audio must never hold the guest back
+    emulation.getAudio().setBackend({ AudioBackend::NullUnthrottled, "." });
+
+    auto& core = emulation.getCore();
+    if (!core.initialize(WeaR_Specs{})) {
+        return std::unexpected("Emulator core initialization failed");
+    }
+
+    if (core.loadGame(m_options.gamePath) == 0) {
+        return std::unexpected(std::format("Failed to load '{}'", m_options.gamePath));
+    }
+    return {};
+}
+
+std::expected<HeadlessStats, std::string> WeaR_HeadlessRunner::run() {
+    // Load the replay first so a bad script fails before the title boots
+    std::vector<InputReplayEvent> replay;
+    if (!m_options.replayPath.empty()) {
+        auto loaded = loadInputReplay(m_options.replayPath);
+        if (!loaded) return std::unexpected(loaded.error());
+        replay = std::move(*loaded);
+    }
+
+    if (auto configured = configureHost(); !configured) {
+        return std::unexpected(configured.error());
+    }
+    TraceCaptureGuard traceCapture(!m_options.tracePath.empty());
+
+    // Fresh console per run, so sequential runs start from a clean state
+    WeaR_EmulationContext emulation;
+    auto& core = emulation.getCore();
+    CoreShutdownGuard coreShutdown(core);
+    if (auto booted = boot(emulation); !booted) {
+        return std::unexpected(booted.error());
+    }
+
+    // Collectors reference the context, so they go before it does
+    auto& metrics = getMetricsExporter();
+    std::vector<WeaR_MetricsExporter::CollectorId> collectors;
+    auto stopMetrics = [&] {
+        metrics.stop();
+        for (auto id : collectors) metrics.removeCollector(id);
+        collectors.clear();
+    };
+    if (m_options.metrics.isEnabled()) {
+        collectors.push_back(metrics.addCollector(
+            [&emulation](WeaR_MetricsWriter& out) { collectCoreMetrics(out, emulation); }));
+        collectors.push_back(metrics.addCollector(collectHostMetrics));
+        if (auto started = metrics.start(m_options.metrics); !started) {
+            stopMetrics();
+            return std::unexpected(started.error());
+        }
+    }
+
+    WeaR_Cpu* cpu = core.getCpu();
+    if (core.isLegacyMode() || !cpu) {
+        HeadlessStats stats;
+        stats.exit = HeadlessExit::NothingToRun;
+        stopMetrics();
+        return stats;
+    }
+
+    // The sampler reads the CPU and memory, so it stops before the core shuts down
+    std::optional<WeaR_GuestProfiler> profiler;
+    if (!m_options.guestProfilePath.empty()) {
+        profiler.emplace(*cpu, *core.getMemory(), core.getGuestSymbols());
+        if (auto started = profiler->start(m_options.sampleRateHz); !started) {
+            stopMetrics();
+            return std::unexpected(started.error());
+        }
+    }
+
+    HeadlessStats stats = execute(emulation, *cpu, replay,
+                                  { m_options.maxInstructions, m_options.maxSeconds, false });
+    stopMetrics();
+
+    if (profiler) {
+        profiler->stop();
+        stats.profileSamples = profiler->getSampleCount();
+        stats.profileTruncatedSamples = profiler->getTruncatedSampleCount();
+        stats.hotFunctions = profiler->getTopFunctions(HOT_FUNCTION_COUNT);
+        if (auto written = profiler->writeCollapsed(m_options.guestProfilePath); !written) {
+            return std::unexpected(written.error());
+        }
+    }
+
+    if (!m_options.tracePath.empty()) {
+        traceCapture.stop();
+        if (!getTracer().writeChromeJson(m_options.tracePath)) {
+            return std::unexpected(std::format("cannot write trace '{}'", m_options.tracePath));
+        }
+    }
+
+    core.shutdown();    // Before the flush, so its log lines are written
+    getAsyncLogger().flush();
+    return stats;
+}
+
+// =============================================================================
+// FORK SERVER
+// =============================================================================
+
+#ifdef _WIN32
+
+std::expected<ForkServerStats, std::string> WeaR_HeadlessRunner::serveForks(std::istream&) {
+    return std::unexpected("The fork server needs fork() and is not available on Windows");
+}
+
+#else
+
+std::expected<ForkServerStats, std::string> WeaR_HeadlessRunner::serveForks(std::istream& cases) {
+    // Their threads and buffers would not survive into the children
+    if (!m_options.tracePath.empty() || m_options.metrics.isEnabled() || !m_options.guestProfilePath.empty()) {
+        return std::unexpected("--trace, --guest-profile and metrics export are not supported by the fork server");
+    }
+
+    std::vector<InputReplayEvent> warmUp;
+    if (!m_options.replayPath.empty()) {
+        auto loaded = loadInputReplay(m_options.replayPath);
+        if (!loaded) return std::unexpected(loaded.error());
+        warmUp = std::move(*loaded);
+    }
+
+    if (auto configured = configureHost(); !configured) {
+        return std::unexpected(configured.error());
+    }
+
+    WeaR_EmulationContext emulation;
+    if (auto booted = boot(emulation); !booted) {
+        return std::unexpected(booted.error());
+    }
+    auto& core = emulation.getCore();
+    WeaR_Cpu* cpu = core.getCpu();
+    if (core.isLegacyMode() || !cpu) {
+        core.shutdown();
+        return std::unexpected("The title has no executable image to fork from");
+    }
+
+    // Boot once, up to the fork point; every case starts from here
+    const auto bootStart = std::chrono::steady_clock::now();
+    if (m_options.forkAtInstructions != 0 || m_options.forkAtFlip) {
+        const HeadlessStats warm = execute(emulation, *cpu, warmUp,
+                                           { m_options.forkAtInstructions, 0.0, m_options.forkAtFlip });
+        if (warm.exit == HeadlessExit::Faulted || warm.exit == HeadlessExit::Halted) {
+            core.shutdown();
+            return std::unexpected(std::format("The title {} before the fork point (RIP=0x{:016X})",
+                                               getHeadlessExitName(warm.exit), warm.finalRip));
+        }
+    }
+
+    ForkServerStats server;
+    server.forkInstruction = cpu->getInstructionCount();
+    server.bootSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - bootStart).count();
+    WEAR_LOG_INFO(LogCategory::General, "Fork point at instruction {} after {:.3f} s",
+                  server.forkInstruction, server.bootSeconds);
+
+    // Children would all pin their CPU thread to the same core
+    if (m_options.forkJobs > 1) {
+        ThreadRoleConfig roles = getThreadRoles().getConfig();
+        roles[ThreadRole::GuestCpu].cores.clear();
+        (void)getThreadRoles().addOverlay(roles);
+    }
+
+    std::unordered_map<pid_t, uint64_t> running;   // Child -> case index
+    auto reap = [&](bool block) {
+        int status = 0;
+        const pid_t pid = waitpid(-1, &status, block ? 0 : WNOHANG);
+        if (pid <= 0) return false;
+        const uint64_t index = running[pid];
+        running.erase(pid);
+        if (WIFSIGNALED(status)) {
+            std::cout << std::format("case {}: killed by signal {}\n", index, WTERMSIG(status)) << std::flush;
+            ++server.failed;
+        } else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            ++server.failed;
+        }
+        return true;
+    };
+
+    std::string line;
+    while (std::getline(cases, line)) {
+        const auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        // "<replay|-> [stats.json]"
+        std::istringstream fields(line);
+        std::string replayPath;
+        std::string statsPath;
+        fields >> replayPath >> statsPath;
+        const uint64_t index = server.cases++;
+
+        std::vector<InputReplayEvent> replay;
+        if (replayPath != "-") {
+            auto loaded = loadInputReplay(replayPath);
+            if (!loaded) {
+                std::cout << std::format("case {}: {}\n", index, loaded.error()) << std::flush;
+                ++server.failed;
+                continue;
+            }
+            replay = std::move(*loaded);
+        }
+
+        while (running.size() >= std::max<uint32_t>(m_options.forkJobs, 1)) {
+            reap(true);
+        }
+        while (reap(false)) {}
+
+        // Nothing buffered may be written twice, and no lock may be inherited held
+        emulation.getVfs().flushFiles();
+        getAsyncLogger().flush();
+        std::cout.flush();
+        // Thread roles log while holding their lock, so theirs is taken first
+        getThreadRoles().beforeFork();
+        getAsyncLogger().beforeFork();
+        const pid_t pid = fork();
+        getAsyncLogger().afterFork();
+        getThreadRoles().afterFork(pid == 0);
+
+        if (pid < 0) {
+            std::cout << std::format("case {}: fork failed\n", index) << std::flush;
+            ++server.failed;
+            continue;
+        }
+        if (pid == 0) {
+            _exit(runForkedCase(emulation, *cpu, index, replayPath, replay, statsPath));
+        }
+        running[pid] = index;
+    }
+
+    while (!running.empty()) {
+        reap(true);
+    }
+
+    core.shutdown();
+    getAsyncLogger().flush();
+    return server;
+}
+
+int WeaR_HeadlessRunner::runForkedCase(WeaR_EmulationContext& emulation, WeaR_Cpu& cpu, uint64_t index,
+                                       const std::string& replayPath,
+                                       const std::vector<InputReplayEvent>& replay,
+                                       const std::string& statsPath)
+{
+    // Only the forking thread exists here. Leave through _exit() so no
+    // destructor joins a parent thread that was not copied.
+    getJobSystem().enterForkedChild();
+    emulation.getVfs().reopenFiles();
+
+    const HeadlessStats stats = execute(emulation, cpu, replay,
+                                        { m_options.maxInstructions, m_options.maxSeconds, false });
+
+    bool ok = stats.exit != HeadlessExit::Faulted;
+    if (!statsPath.empty()) {
+        HeadlessOptions caseOptions = m_options;
+        caseOptions.replayPath = replayPath;
+        std::ofstream file(statsPath, std::ios::trunc);
+        if (!file || !(file << toJson(caseOptions, stats))) {
+            std::cout << std::format("case {}: cannot write '{}'\n", index, statsPath);
+            ok = false;
+        }
+    }
+
+    std::cout << std::format("case {}: {} after {} instructions, {:.3f} s ({:.2f} MIPS), {} replay events [{}]\n",
+                             index, getHeadlessExitName(stats.exit), stats.instructions, stats.seconds,
+                             stats.mips(), stats.replayEvents, replayPath);
+    std::cout.flush();
+    getAsyncLogger().flush();
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif
+
+// =============================================================================
+// REPORTING
+// =============================================================================
+
+std::string WeaR_HeadlessRunner::formatReport(const HeadlessStats& stats) {
+    const double seconds = std::max(stats.seconds, 1e-9);
+    std::string out;
+    out += std::format("Exit:          {} after {:.3f} s (RIP=0x{:016X})\n",
+                       getHeadlessExitName(stats.exit), stats.seconds, stats.finalRip);
+    out += std::format("Instructions:  {} ({:.2f} MIPS)\n", stats.instructions, stats.mips());
+    if (stats.skippedInstructions > 0 || stats.idleSeconds > 0.0) {
+        out += std::format("Idle:          {:.3f} s asleep, {} loop instructions skipped\n",
+                           stats.idleSeconds, stats.skippedInstructions);
+    }
+    out += std::format("Syscalls:      {} ({:.0f}/s), unimplemented {}\n",
+                       stats.syscalls, stats.syscalls / seconds, stats.unimplementedSyscalls);
+    out += std::format("GPU:           {} PM4 packets, {} draws, {} render commands\n",
+                       stats.pm4Packets, stats.drawCalls, stats.renderCommands);
+    out += std::format("Audio frames:  {}\n", stats.audioFrames);
+    if (stats.replayEvents > 0) {
+        out += std::format("Replay events: {}\n", stats.replayEvents);
+    }
+    if (!stats.hotFunctions.empty()) {
+        const double samples = static_cast<double>(std::max<uint64_t>(stats.profileSamples, 1));
+        out += std::format("Hot functions: {} samples (self / total)\n", stats.profileSamples);
+        for (const ProfileFunction& function : stats.hotFunctions) {
+            out += std::format("  {:5.1f}% {:5.1f}%  {}\n", 100.0 * function.selfSamples / samples,
+                               100.0 * function.totalSamples / samples, function.name);
+        }
+        if (stats.profileTruncatedSamples > 0) {
+            out += std::format("  {} samples past the stack limit kept only their innermost frame\n",
+                               stats.profileTruncatedSamples);
+        }
+    }
+    return out;
+}
+
+std::string WeaR_HeadlessRunner::toJson(const HeadlessOptions& options, const HeadlessStats& stats) {
+    std::string out = "{\n";
+    out += std::format("  \"game\": \"{}\",\n", escapeJson(options.gamePath));
+    out += std::format("  \"exit\": \"{}\",\n", getHeadlessExitName(stats.exit));
+    out += std::format("  \"seconds\": {:.6f},\n", stats.seconds);
+    out += std::format("  \"instructions\": {},\n", stats.instructions);
+    out += std::format("  \"mips\": {:.3f},\n", stats.mips());
+    out += std::format("  \"skipped_instructions\": {},\n", stats.skippedInstructions);
+    out += std::format("  \"idle_seconds\": {:.6f},\n", stats.idleSeconds);
+    out += std::format("  \"syscalls\": {},\n", stats.syscalls);
+    out += std::format("  \"unimplemented_syscalls\": {},\n", stats.unimplementedSyscalls);
+    out += std::format("  \"pm4_packets\": {},\n", stats.pm4Packets);
+    out += std::format("  \"draw_calls\": {},\n", stats.drawCalls);
+    out += std::format("  \"render_commands\": {},\n", stats.renderCommands);
+    out += std::format("  \"audio_frames\": {},\n", stats.audioFrames);
+    out += std::format("  \"replay_events\": {},\n", stats.replayEvents);
+    out += std::format("  \"profile_samples\": {},\n", stats.profileSamples);
+    out += std::format("  \"profile_truncated_samples\": {},\n", stats.profileTruncatedSamples);
+    out += "  \"hot_functions\": [";
+    for (size_t i = 0; i < stats.hotFunctions.size(); ++i) {
+        const ProfileFunction& function = stats.hotFunctions[i];
+        out += std::format("{}\n    {{ \"name\": \"{}\", \"self\": {}, \"total\": {} }}", i ? "," : "",
+                           escapeJson(function.name), function.selfSamples, function.totalSamples);
+    }
+    out += stats.hotFunctions.empty() ? "],\n" : "\n  ],\n";
+    out += std::format("  \"final_rip\": {},\n", stats.finalRip);
+    out += std::format("  \"max_instructions\": {},\n", options.maxInstructions);
+    out += std::format("  \"max_seconds\": {:.3f}\n", options.maxSeconds);
+    out += "}\n";
+    return out;
+}
+
+} // namespace WeaR
@@ -0,0 +1,147 @@
+#pragma once
+
+/**
+ * @file WeaR_HeadlessRunner.h
+ * @brief Boot and run a title through WeaR_EmulatorCore without a window
+ *
+ * Each run() boots its own WeaR_EmulationContext, so a process can run
+ * titles one after another without state leaking between them. Runs must
+ * not overlap: thread roles, the tracer and the metrics exporter are
+ * process-wide and each run reconfigures them.
+ *
+ * The runner owns the CPU thread, stops it on an instruction or wall-clock
+ * limit, feeds an optional input replay, and discards render commands so
+ * the queue never grows without a presenting renderer. Audio uses the
+ * unthrottled null sink. Counters are reported as deltas over the run.
+ */
+
+#include "Core/WeaR_Metrics.h"
+#include "Core/WeaR_Profiler.h"
+
+#include <cstdint>
+#include <expected>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace WeaR {
+
+class WeaR_EmulationContext;
+class WeaR_Cpu;
+struct InputReplayEvent;
+
+// =============================================================================
+// OPTIONS & RESULTS
+// =============================================================================
+
+struct HeadlessOptions {
+    std::string gamePath;
+    uint64_t maxInstructions = 0;   // 0 = unlimited
+    double maxSeconds = 0.0;        // 0 = unlimited
+    std::string replayPath;         // Optional WeaR_InputReplay file
+    std::string statsJsonPath;      // Optional machine-readable summary
+    std::string tracePath;          // Optional Chrome trace-event timeline
+    std::string guestProfilePath;   // Optional collapsed guest stacks (flamegraph input)
+    uint32_t sampleRateHz = ProfilerConfig::DEFAULT_RATE_HZ;   // Guest profiler rate
+    MetricsConfig metrics;          // Prometheus endpoint / file for soak runs
+    std::string threadRoles = "auto";   // ThreadRoleConfig::parse() spec
+    std::string profileDir;         // Title profile directory; empty = "profiles"
+
+    // Fork server (serveForks)
+    uint64_t forkAtInstructions = 0;    // Fork point; 0 with forkAtFlip unset = right after load
+    bool forkAtFlip = false;            // Fork point at the first sceGnmSubmitDone
+    uint32_t forkJobs = 1;              // Children running at once
+};
+
+enum class HeadlessExit : uint8_t {
+    Halted,             // Guest stopped on its own (HLT or unhandled step)
+    InstructionLimit,
+    TimeLimit,
+    Faulted,
+    Flip,               // Reached the first flip (fork server warm-up)
+    NothingToRun        // Loaded without an executable image (legacy mode)
+};
+
+[[nodiscard]] const char* getHeadlessExitName(HeadlessExit exit);
+
+struct HeadlessStats {
+    HeadlessExit exit = HeadlessExit::Halted;
+    double seconds = 0.0;
+    uint64_t instructions = 0;
+    uint64_t skippedInstructions = 0;   // Idle-loop iterations counted, not run (part of instructions)
+    double idleSeconds = 0.0;           // CPU asleep in guest idle/spin loops
+    uint64_t syscalls = 0;
+    uint64_t unimplementedSyscalls = 0;
+    uint64_t pm4Packets = 0;
+    uint64_t drawCalls = 0;
+    uint64_t renderCommands = 0;
+    uint64_t audioFrames = 0;
+    uint64_t replayEvents = 0;
+    uint64_t finalRip = 0;
+    uint64_t profileSamples = 0;
+    uint64_t profileTruncatedSamples = 0;       // Kept with their innermost frame only
+    std::vector<ProfileFunction> hotFunctions;  // Guest profiler top entries, by self samples
+
+    [[nodiscard]] double mips() const {
+        // Interpreter throughput: skipped idle iterations would inflate it
+        const uint64_t executed = instructions - skippedInstructions;
+        return seconds > 0.0 ? static_cast<double>(executed) / seconds / 1e6 : 0.0;
+    }
+};
+
+struct ForkServerStats {
+    uint64_t cases = 0;
+    uint64_t failed = 0;            // Faulted, crashed, bad replay or fork failure
+    uint64_t forkInstruction = 0;   // Guest instruction count at the fork point
+    double bootSeconds = 0.0;       // Load to fork point, paid once
+};
+
+// =============================================================================
+// RUNNER
+// =============================================================================
+
+class WeaR_HeadlessRunner {
+public:
+    explicit WeaR_HeadlessRunner(HeadlessOptions options) : m_options(std::move(options)) {}
+
+    /**
+     * @brief Initialize the core, load the title and run it to a limit
+     * @return Run statistics, or an error if the title could not be started
+     */
+    [[nodiscard]] std::expected<HeadlessStats, std::string> run();
+
+    /**
+     * @brief Boot once to the fork point, then fork a child per test case
+     *
+     * Each line of @p cases is "<replay|-> [stats.json]". A child inherits
+     * the warmed-up guest memory, caches and HLE state copy-on-write, runs
+     * the replay to the usual limits (counted from the fork point), prints
+     * one result line and optionally writes its JSON. Lines are read as
+     * they arrive, so the input can be a pipe. POSIX only.
+     *
+     * @return Totals, or an error if the title could not reach the fork point
+     */
+    [[nodiscard]] std::expected<ForkServerStats, std::string> serveForks(std::istream& cases);
+
+    /**
+     * @brief Human-readable throughput report
+     */
+    [[nodiscard]] static std::string formatReport(const HeadlessStats& stats);
+
+    /**
+     * @brief JSON object with the options and statistics of a run
+     */
+    [[nodiscard]] static std::string toJson(const HeadlessOptions& options, const HeadlessStats& stats);
+
+private:
+    std::expected<void, std::string> configureHost();
+    std::expected<void, std::string> boot(WeaR_EmulationContext& emulation);
+    int runForkedCase(WeaR_EmulationContext& emulation, WeaR_Cpu& cpu, uint64_t index,
+                      const std::string& replayPath, const std::vector<InputReplayEvent>& replay,
+                      const std::string& statsPath);
+
+    HeadlessOptions m_options;
+};
+
+} // namespace WeaR
@@ -0,0 +1,215 @@
+/**
+ * @file main.cpp
+ * @brief wear-cli entry point - headless runner for regression and benchmark sweeps
+ *
+ * Boots an ELF or PKG through the emulator core with no window, no Vulkan
+ * device and no Qt application object, then prints throughput at exit.
+ */
+
+#include "CLI/WeaR_HeadlessRunner.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <format>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr int EXIT_USAGE = 2;
+
+void printUsage(std::ostream& out) {
+    out << "Usage: wear-cli [options] <game.elf|game.pkg>\n"
+           "\n"
+           "Options:\n"
+           "  --max-instructions N   Stop after N guest instructions\n"
+           "  --max-seconds S        Stop after S seconds of wall-clock time\n"
+           "  --replay FILE          Apply controller input from a replay file\n"
+           "  --stats-json FILE      Write run statistics as JSON ('-' = stdout)\n"
+           "  --trace FILE           Write a Chrome trace-event timeline of the run\n"
+           "  --guest-profile FILE   Sample guest code; write collapsed stacks for flamegraphs\n"
+           "  --sample-rate HZ       Guest profiler samples per second (default 997)\n"
+           "  --metrics-port N       Serve Prometheus metrics at http://127.0.0.1:N/metrics\n"
+           "  --metrics-bind ADDR    Listen address for --metrics-port (default 127.0.0.1)\n"
+           "  --metrics-file FILE    Rewrite Prometheus metrics to FILE periodically\n"
+           "  --metrics-interval S   Seconds between metrics file updates (default 5)\n"
+           "  --threads SPEC         Thread pinning/priority: off, auto (default) or\n"
+           "                         overrides such as 'auto;cpu=7@high;worker=0-5'\n"
+           "  --profile-dir DIR      Per-title profiles (default ./profiles)\n"
+           "\n"
+           "Fork server (POSIX):\n"
+           "  --fork-cases FILE      Boot once, then fork a child per line of FILE\n"
+           "                         ('<replay|-> [stats.json]'; '-' = stdin)\n"
+           "  --fork-at N|flip       Fork point: instruction N or the first flip; --replay\n"
+           "                         then drives the warm-up (default: right after load)\n"
+           "  --fork-jobs N          Children running at once (default 1)\n"
+           "  -h, --help             Show this help\n";
+}
+
+template<typename T>
+bool parseNumber(std::string_view text, T& out) {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    WeaR::HeadlessOptions options;
+    std::string forkCasesPath;
+    bool forkAtGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << std::format("wear-cli: {} requires a value\n", arg);
+                std::exit(EXIT_USAGE);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "-h" || arg == "--help") {
+            printUsage(std::cout);
+            return EXIT_SUCCESS;
+        } else if (arg == "--max-instructions") {
+            if (!parseNumber(value(), options.maxInstructions)) {
+                std::cerr << "wear-cli: --max-instructions expects a non-negative integer\n";
+                return EXIT_USAGE;
+            }
+        } else if (arg == "--max-seconds") {
+            if (!parseNumber(value(), options.maxSeconds) || options.maxSeconds < 0.0) {
+                std::cerr << "wear-cli: --max-seconds expects a non-negative number\n";
+                return EXIT_USAGE;
+            }
+        } else if (arg == "--replay") {
+            options.replayPath = value();
+        } else if (arg == "--stats-json") {
+            options.statsJsonPath = value();
+        } else if (arg == "--trace") {
+            options.tracePath = value();
+        } else if (arg == "--guest-profile") {
+            options.guestProfilePath = value();
+        } else if (arg == "--sample-rate") {
+            if (!parseNumber(value(), options.sampleRateHz) || options.sampleRateHz == 0 ||
+                options.sampleRateHz > WeaR::ProfilerConfig::MAX_RATE_HZ) {
+                std::cerr << std::format("wear-cli: --sample-rate expects 1-{} Hz\n",
+                                         WeaR::ProfilerConfig::MAX_RATE_HZ);
+                return EXIT_USAGE;
+            }
+        } else if (arg == "--metrics-port") {
+            if (!parseNumber(value(), options.metrics.httpPort) || options.metrics.httpPort == 0) {
+                std::cerr << "wear-cli: --metrics-port expects a port between 1 and 65535\n";
+                return EXIT_USAGE;
+            }
+        } else if (arg == "--metrics-bind") {
+            options.metrics.bindAddress = value();
+        } else if (arg == "--metrics-file") {
+            options.metrics.filePath = value();
+        } else if (arg == "--metrics-interval") {
+            double seconds = 0.0;
+            if (!parseNumber(value(), seconds) || seconds <= 0.0) {
+                std::cerr << "wear-cli: --metrics-interval expects a positive number\n";
+                return EXIT_USAGE;
+            }
+            options.metrics.fileInterval = std::chrono::milliseconds(static_cast<int64_t>(seconds * 1000.0));
+        } else if (arg == "--threads") {
+            options.threadRoles = value();
+        } else if (arg == "--profile-dir") {
+            options.profileDir = value();
+        } else if (arg == "--fork-cases") {
+            forkCasesPath = value();
+        } else if (arg == "--fork-at") {
+            std::string_view point = value();
+            forkAtGiven = true;
+            if (point == "flip") {
+                options.forkAtFlip = true;
+            } else if (!parseNumber(point, options.forkAtInstructions) || options.forkAtInstructions == 0) {
+                std::cerr << "wear-cli: --fork-at expects a positive instruction count or 'flip'\n";
+                return EXIT_USAGE;
+            }
+        } else if (arg == "--fork-jobs") {
+            if (!parseNumber(value(), options.forkJobs) || options.forkJobs == 0) {
+                std::cerr << "wear-cli: --fork-jobs expects a positive integer\n";
+                return EXIT_USAGE;
+            }
+        } else if (arg.starts_with("-")) {
+            std::cerr << std::format("wear-cli: unknown option '{}'\n", arg);
+            printUsage(std::cerr);
+            return EXIT_USAGE;
+        } else if (options.gamePath.empty()) {
+            options.gamePath = arg;
+        } else {
+            std::cerr << "wear-cli: only one game path may be given\n";
+            return EXIT_USAGE;
+        }
+    }
+
+    if (options.gamePath.empty()) {
+        printUsage(std::cerr);
+        return EXIT_USAGE;
+    }
+
+    if (!forkCasesPath.empty()) {
+        if (!options.statsJsonPath.empty()) {
+            std::cerr << "wear-cli: --stats-json does not apply to --fork-cases; name a file per case\n";
+            return EXIT_USAGE;
+        }
+        if (!options.replayPath.empty() && !forkAtGiven) {
+            std::cerr << "wear-cli: a warm-up --replay needs --fork-at\n";
+            return EXIT_USAGE;
+        }
+
+        std::ifstream file;
+        if (forkCasesPath != "-") {
+            file.open(forkCasesPath);
+            if (!file) {
+                std::cerr << std::format("wear-cli: cannot open '{}'\n", forkCasesPath);
+                return EXIT_FAILURE;
+            }
+        }
+
+        WeaR::WeaR_HeadlessRunner runner(options);
+        auto served = runner.serveForks(forkCasesPath == "-" ? std::cin : file);
+        if (!served) {
+            std::cerr << std::format("wear-cli: {}\n", served.error());
+            return EXIT_FAILURE;
+        }
+        std::cout << std::format("\nFork server: {} cases, {} failed; fork point at instruction {} "
+                                 "reached in {:.3f} s\n", served->cases, served->failed,
+                                 served->forkInstruction, served->bootSeconds);
+        return served->failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (forkAtGiven || options.forkJobs != 1) {
+        std::cerr << "wear-cli: --fork-at and --fork-jobs need --fork-cases\n";
+        return EXIT_USAGE;
+    }
+
+    WeaR::WeaR_HeadlessRunner runner(options);
+    auto result = runner.run();
+    if (!result) {
+        std::cerr << std::format("wear-cli: {}\n", result.error());
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "\n" << WeaR::WeaR_HeadlessRunner::formatReport(*result);
+
+    if (!options.statsJsonPath.empty()) {
+        std::string json = WeaR::WeaR_HeadlessRunner::toJson(options, *result);
+        if (options.statsJsonPath == "-") {
+            std::cout << json;
+        } else {
+            std::ofstream file(options.statsJsonPath, std::ios::trunc);
+            if (!file || !(file << json)) {
+                std::cerr << std::format("wear-cli: cannot write '{}'\n", options.statsJsonPath);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    return result->exit == WeaR::HeadlessExit::Faulted ? EXIT_FAILURE : EXIT_SUCCESS;
+}
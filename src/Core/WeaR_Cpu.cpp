@@ -1,10 +1,13 @@
 #include "WeaR_Cpu.h"
 #include "WeaR_Memory.h"
+#include "WeaR_Log.h"
+#include "WeaR_Trace.h"
 
-#include <iostream>
+#include <algorithm>
 #include <format>
 #include <thread>
 #include <chrono>
+#include <utility>
 
 namespace WeaR {
 
@@ -45,18 +48,24 @@ void WeaR_Cpu::reset() {
     m_shouldStop.store(false);
     m_instructionCount.store(0);
     m_lastOpcode = 0;
+    m_loopProbe = {};
+    m_idleHint = IdleHint::None;
+    m_pauseCount = 0;
+    m_spinBackoff = IdleConfig::SPIN_BACKOFF_MIN;
     
-    std::cout << "[CPU] Reset complete\n";
+    WEAR_LOG_INFO(LogCategory::CPU, "Reset complete");
 }
 
 void WeaR_Cpu::stop() {
     m_shouldStop.store(true);
     m_state.store(CpuState::Stopped);
+    wake();
 }
 
 void WeaR_Cpu::pause() {
     if (m_state.load() == CpuState::Running) {
         m_state.store(CpuState::Paused);
+        wake();
     }
 }
 
@@ -71,34 +80,65 @@ void WeaR_Cpu::resume() {
 // =============================================================================
 
 void WeaR_Cpu::runLoop() {
-    std::cout << std::format("[CPU] Starting execution at RIP=0x{:016X}\n", m_context.RIP);
+    WEAR_LOG_INFO(LogCategory::CPU, "Starting execution at RIP=0x{:016X}", m_context.RIP);
     
     m_state.store(CpuState::Running);
     m_shouldStop.store(false);
+    WeaR_TraceSlice slice(TraceCategory::CPU, "cpu_slice", "instructions",
+                          TraceConfig::CPU_SLICE_INSTRUCTIONS);
+    m_traceSlice = &slice;
+
+    bool halted = false;
+    while (!halted && !m_shouldStop.load()) {
+        // Re-read per slice: a limit set while running applies from the next one
+        const uint64_t limit = m_instructionLimit.load();
+        uint64_t budget = m_sliceInstructions.load(std::memory_order_relaxed);
+        if (limit != 0) {
+            const uint64_t executed = m_instructionCount.load(std::memory_order_relaxed);
+            if (executed >= limit) {
+                break;
+            }
+            // Never overshoot: replay and benchmarks rely on the exact count
+            budget = std::min(budget, limit - executed);
+        }
 
-    while (!m_shouldStop.load()) {
         // Check for pause
         if (m_state.load() == CpuState::Paused) {
+            slice.flush();
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
             continue;
         }
 
-        // Execute one instruction
-        uint32_t cycles = step();
-        
-        if (cycles == 0) {
-            // Halt or error occurred
-            break;
-        }
+        // Execute one slice; stop/pause/limit are only checked between slices,
+        // except a stop() issued by the guest itself (exit syscall)
+        uint64_t executed = 0;
+        while (executed < budget) {
+            uint32_t cycles = step();
+
+            if (cycles == 0) {
+                // Halt or error occurred
+                halted = true;
+                break;
+            }
+
+            ++executed;
+            slice.tick();
 
-        m_instructionCount.fetch_add(1);
+            if (m_shouldStop.load(std::memory_order_relaxed) || m_idleHint != IdleHint::None) {
+                break;
+            }
+        }
+        m_instructionCount.fetch_add(executed, std::memory_order_relaxed);
 
-        // Basic cycle throttling (very simple for now)
-        // In a real emulator, this would be more sophisticated
+        if (m_idleHint != IdleHint::None && !halted) {
+            slice.flush();
+            handleIdle(limit);
+        }
     }
 
-    std::cout << std::format("[CPU] Execution stopped. Instructions: {}\n", 
-                              m_instructionCount.load());
+    m_traceSlice = nullptr;
+    WEAR_LOG_INFO(LogCategory::CPU, "Execution stopped. Instructions: {}",
+                  m_instructionCount.load());
     
     if (m_state.load() != CpuState::Faulted) {
         m_state.store(CpuState::Stopped);
@@ -144,6 +184,7 @@ uint32_t WeaR_Cpu::step() {
         // =====================================================================
         uint8_t opcode = fetchByte();
         m_lastOpcode = opcode;
+        ++m_steps;
 
         // =====================================================================
         // DECODE & EXECUTE
@@ -181,6 +222,25 @@ uint32_t WeaR_Cpu::step() {
                 execJMP_rel32();
                 return 1;
 
+            // =================================================================
+            // JMP rel8 (0xEB)
+            // =================================================================
+            case 0xEB:
+                execJMP_rel8();
+                return 1;
+
+            // =================================================================
+            // PAUSE (0xF3 0x90); other REP forms are not decoded yet
+            // =================================================================
+            case 0xF3:
+                if (m_memory.read<uint8_t>(m_context.RIP) == 0x90) {
+                    m_context.RIP++;
+                    execPAUSE();
+                } else {
+                    execUnknown(opcode);
+                }
+                return 1;
+
             // =================================================================
             // CALL rel32 (0xE8)
             // =================================================================
@@ -250,13 +310,13 @@ uint32_t WeaR_Cpu::step() {
         }
     }
     catch (const MemoryAccessException& e) {
-        std::cerr << std::format("[CPU] Memory fault at RIP=0x{:016X}: {}\n",
-                                  m_context.RIP, e.what());
+        WEAR_LOG_ERROR(LogCategory::CPU, "Memory fault at RIP=0x{:016X}: {}",
+                       m_context.RIP, e.what());
         m_state.store(CpuState::Faulted);
         return 0;
     }
     catch (const std::exception& e) {
-        std::cerr << std::format("[CPU] Exception: {}\n", e.what());
+        WEAR_LOG_ERROR(LogCategory::CPU, "Exception: {}", e.what());
         m_state.store(CpuState::Faulted);
         return 0;
     }
@@ -285,6 +345,40 @@ void WeaR_Cpu::execJMP_rel32() {
     m_context.RIP = static_cast<uint64_t>(
         static_cast<int64_t>(m_context.RIP) + offset
     );
+    if (offset < 0) {
+        noteBackwardBranch(m_context.RIP);
+    }
+}
+
+void WeaR_Cpu::execJMP_rel8() {
+    // JMP rel8 - Short jump relative (EB FE is the classic self-jump)
+    int8_t offset = static_cast<int8_t>(fetchByte());
+    m_context.RIP = static_cast<uint64_t>(
+        static_cast<int64_t>(m_context.RIP) + offset
+    );
+    if (offset < 0) {
+        noteBackwardBranch(m_context.RIP);
+    }
+}
+
+void WeaR_Cpu::execPAUSE() {
+    // PAUSE - Spin-wait hint. A run of them at one address means the guest is
+    // waiting on something outside this thread, so back off instead of spinning
+    if (!m_idleDetection.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const uint64_t rip = m_context.RIP;
+    if (rip != m_pauseRip || m_steps - m_pauseStep > IdleConfig::SPIN_PAUSE_MAX_GAP) {
+        m_pauseRip = rip;
+        m_pauseCount = 0;
+        m_spinBackoff = IdleConfig::SPIN_BACKOFF_MIN;
+    }
+    m_pauseStep = m_steps;
+    if (++m_pauseCount >= IdleConfig::SPIN_PAUSE_THRESHOLD) {
+        m_pauseCount = 0;
+        m_idleEpoch = m_wakeEpoch.load(std::memory_order_relaxed);
+        m_idleHint = IdleHint::Spin;
+    }
 }
 
 void WeaR_Cpu::execCALL_rel32() {
@@ -294,6 +388,7 @@ void WeaR_Cpu::execCALL_rel32() {
     // Push return address
     m_context.RSP -= 8;
     m_memory.write<uint64_t>(m_context.RSP, m_context.RIP);
+    ++m_sideEffects;
     
     // Jump to target
     m_context.RIP = static_cast<uint64_t>(
@@ -313,6 +408,7 @@ void WeaR_Cpu::execPUSH_reg(uint8_t reg) {
     // PUSH reg - Push register to stack
     m_context.RSP -= 8;
     m_memory.write<uint64_t>(m_context.RSP, m_context.GPR[reg]);
+    ++m_sideEffects;
 }
 
 void WeaR_Cpu::execPOP_reg(uint8_t reg) {
@@ -322,25 +418,115 @@ void WeaR_Cpu::execPOP_reg(uint8_t reg) {
 }
 
 void WeaR_Cpu::execSYSCALL() {
-    // SYSCALL - System call
+    // SYSCALL - System call; the HLE side may change anything
+    ++m_sideEffects;
     if (m_syscallHandler) {
+        // The handler may sleep or wait on the host; keep that out of cpu_slice
+        if (m_traceSlice) m_traceSlice->flush();
         m_syscallHandler(m_context);
+        if (m_traceSlice) m_traceSlice->flush();
     } else {
-        std::cout << std::format("[CPU] SYSCALL RAX=0x{:X} (no handler)\n", 
-                                  m_context.RAX);
+        WEAR_LOG_WARN_LIMITED(LogCategory::CPU, "SYSCALL RAX=0x{:X} (no handler)", m_context.RAX);
     }
 }
 
 void WeaR_Cpu::execHLT() {
     // HLT - Halt processor
-    std::cout << "[CPU] HLT instruction - stopping\n";
+    WEAR_LOG_INFO(LogCategory::CPU, "HLT instruction - stopping");
     m_state.store(CpuState::Halted);
 }
 
 void WeaR_Cpu::execUnknown(uint8_t opcode) {
-    // Unknown opcode - log and continue
-    std::cerr << std::format("[CPU] Unknown opcode 0x{:02X} at RIP=0x{:016X}\n",
-                              opcode, m_context.RIP - 1);
+    // Unknown opcode - log (rate limited, a broken title hits this in a loop) and continue
+    WEAR_LOG_WARN_LIMITED(LogCategory::CPU, "Unknown opcode 0x{:02X} at RIP=0x{:016X}",
+                          opcode, m_context.RIP - 1);
+}
+
+// =============================================================================
+// IDLE DETECTION
+// =============================================================================
+
+void WeaR_Cpu::noteBackwardBranch(uint64_t target) {
+    if (!m_idleDetection.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Back at the same loop head with the same registers and flags, and
+    // nothing written or called since: the next iteration repeats this one
+    // exactly, forever. (XMM state is not compared; no decoded instruction
+    // touches it yet.)
+    const uint64_t epoch = m_wakeEpoch.load(std::memory_order_relaxed);
+    LoopProbe& probe = m_loopProbe;
+    if (probe.valid && probe.target == target && probe.sideEffects == m_sideEffects &&
+        probe.epoch == epoch && probe.rflags == m_context.RFLAGS && probe.gpr == m_context.GPR) {
+        m_loopLength = m_steps - probe.step;
+        m_idleEpoch = epoch;
+        m_idleHint = IdleHint::Loop;
+        probe.step = m_steps;
+        return;
+    }
+
+    probe.valid = true;
+    probe.target = target;
+    probe.step = m_steps;
+    probe.sideEffects = m_sideEffects;
+    probe.epoch = epoch;
+    probe.rflags = m_context.RFLAGS;
+    probe.gpr = m_context.GPR;
+}
+
+void WeaR_Cpu::handleIdle(uint64_t limit) {
+    const IdleHint hint = std::exchange(m_idleHint, IdleHint::None);
+
+    if (hint == IdleHint::Loop && limit != 0) {
+        // Count whole iterations up to the limit without running them; the
+        // remainder runs normally so the final count and RIP stay exact
+        const uint64_t count = m_instructionCount.load(std::memory_order_relaxed);
+        if (count < limit && m_loopLength != 0) {
+            const uint64_t skip = (limit - count) / m_loopLength * m_loopLength;
+            m_instructionCount.fetch_add(skip, std::memory_order_relaxed);
+            m_skippedInstructions.fetch_add(skip, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    if (hint == IdleHint::Loop) {
+        waitIdle(IdleConfig::LOOP_WAIT);
+    } else {
+        waitIdle(m_spinBackoff);
+        m_spinBackoff = std::min(m_spinBackoff * 2, IdleConfig::SPIN_BACKOFF_MAX);
+    }
+}
+
+void WeaR_Cpu::waitIdle(std::chrono::microseconds timeout) {
+    WEAR_TRACE_SCOPE(TraceCategory::CPU, "cpu_idle");
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> lock(m_idleMutex);
+        m_idleCv.wait_for(lock, timeout, [this] {
+            return m_wakeEpoch.load() != m_idleEpoch || m_shouldStop.load();
+        });
+    }
+    const auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    m_idleWaits.fetch_add(1, std::memory_order_relaxed);
+    m_idleWaitNs.fetch_add(static_cast<uint64_t>(waited.count()), std::memory_order_relaxed);
+}
+
+void WeaR_Cpu::wake() {
+    {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        m_wakeEpoch.fetch_add(1);
+    }
+    m_idleCv.notify_all();
+}
+
+CpuIdleStats WeaR_Cpu::getIdleStats() const {
+    CpuIdleStats stats;
+    stats.waits = m_idleWaits.load(std::memory_order_relaxed);
+    stats.waitNs = m_idleWaitNs.load(std::memory_order_relaxed);
+    stats.skippedInstructions = m_skippedInstructions.load(std::memory_order_relaxed);
+    return stats;
 }
 
 // Placeholder implementations
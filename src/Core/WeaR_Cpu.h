@@ -10,16 +10,21 @@
  * - Thread-safe run loop
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <string>
 
 namespace WeaR {
 
 // Forward declaration
 class WeaR_Memory;
+class WeaR_TraceSlice;
 
 // =============================================================================
 // x86-64 FLAGS REGISTER
@@ -137,6 +142,24 @@ enum class CpuState : uint8_t {
     Faulted
 };
 
+// =============================================================================
+// IDLE DETECTION
+// =============================================================================
+
+namespace IdleConfig {
+    constexpr uint32_t SPIN_PAUSE_THRESHOLD = 256;      // PAUSEs at one address before backing off
+    constexpr uint64_t SPIN_PAUSE_MAX_GAP = 64;         // Instructions between PAUSEs of one spin
+    constexpr auto SPIN_BACKOFF_MIN = std::chrono::microseconds(500);
+    constexpr auto SPIN_BACKOFF_MAX = std::chrono::microseconds(4000);
+    constexpr auto LOOP_WAIT = std::chrono::microseconds(16000);   // Timer tick for a stuck loop
+}
+
+struct CpuIdleStats {
+    uint64_t waits = 0;
+    uint64_t waitNs = 0;
+    uint64_t skippedInstructions = 0;   // Iterations of pure loops counted without running them
+};
+
 // =============================================================================
 // CPU CORE CLASS
 // =============================================================================
@@ -175,6 +198,41 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Make runLoop() return once the instruction count reaches limit
+     *
+     * A running loop picks the new limit up at its next slice; an idle
+     * wait is cut short so that happens promptly.
+     * @param limit Absolute instruction count (0 = unlimited)
+     */
+    void setInstructionLimit(uint64_t limit) { m_instructionLimit.store(limit); wake(); }
+
+    /**
+     * @brief Instructions executed between stop/pause checks (title profile)
+     */
+    void setSliceInstructions(uint32_t count) { m_sliceInstructions.store(std::max<uint32_t>(count, 1)); }
+
+    /**
+     * @brief Stop spinning on guest idle loops (default on, title profile)
+     *
+     * A loop whose iteration leaves registers unchanged without writing
+     * memory or making a syscall can never leave on its own: under an
+     * instruction limit its iterations are counted without running them,
+     * otherwise the CPU re-checks it every LOOP_WAIT (16 ms, one frame),
+     * sooner if stopped, paused or given a new limit. A run of PAUSEs at
+     * one address backs off for a short, growing delay.
+     */
+    void setIdleDetection(bool enabled) { m_idleDetection.store(enabled); }
+
+    /**
+     * @brief End an idle wait early
+     *
+     * Called by stop(), pause() and setInstructionLimit(). Nothing models
+     * interrupts or writes from other agents yet, so a guest waiting on
+     * those resumes at the next LOOP_WAIT tick.
+     */
+    void wake();
+
     /**
      * @brief Pause execution
      */
@@ -199,6 +257,7 @@ public:
     [[nodiscard]] WeaR_Context& getContext() { return m_context; }
     [[nodiscard]] uint64_t getInstructionCount() const { return m_instructionCount.load(); }
     [[nodiscard]] uint8_t getLastOpcode() const { return m_lastOpcode; }
+    [[nodiscard]] CpuIdleStats getIdleStats() const;
 
     /**
      * @brief Set syscall handler for INT/SYSCALL instructions
@@ -225,6 +284,8 @@ private:
     void execNOP();
     void execRET();
     void execJMP_rel32();
+    void execJMP_rel8();
+    void execPAUSE();
     void execMOV_reg_imm64(uint8_t reg);
     void execPUSH_reg(uint8_t reg);
     void execPOP_reg(uint8_t reg);
@@ -233,15 +294,54 @@ private:
     void execHLT();
     void execUnknown(uint8_t opcode);
 
+    // Idle detection
+    enum class IdleHint : uint8_t { None, Loop, Spin };
+    void noteBackwardBranch(uint64_t target);
+    void handleIdle(uint64_t limit);
+    void waitIdle(std::chrono::microseconds timeout);
+
     WeaR_Memory& m_memory;
     WeaR_Context m_context{};
     
     std::atomic<CpuState> m_state{CpuState::Stopped};
     std::atomic<bool> m_shouldStop{false};
     std::atomic<uint64_t> m_instructionCount{0};
+    std::atomic<uint64_t> m_instructionLimit{0};
+    std::atomic<uint32_t> m_sliceInstructions{4096};
     
     uint8_t m_lastOpcode = 0;
     SyscallHandler m_syscallHandler;
+    WeaR_TraceSlice* m_traceSlice = nullptr;    // runLoop's cpu_slice; syscalls may block, so they close it
+
+    // Idle detection state (CPU thread only). Instructions that write guest
+    // memory or call out must bump m_sideEffects, or their loops look pure.
+    struct LoopProbe {
+        bool valid = false;
+        uint64_t target = 0;
+        uint64_t step = 0;
+        uint64_t sideEffects = 0;
+        uint64_t epoch = 0;
+        uint64_t rflags = 0;
+        std::array<uint64_t, 16> gpr{};
+    };
+    LoopProbe m_loopProbe;
+    uint64_t m_steps = 0;
+    uint64_t m_sideEffects = 0;
+    uint64_t m_loopLength = 0;
+    uint64_t m_idleEpoch = 0;
+    IdleHint m_idleHint = IdleHint::None;
+    uint64_t m_pauseRip = 0;
+    uint64_t m_pauseStep = 0;
+    uint32_t m_pauseCount = 0;
+    std::chrono::microseconds m_spinBackoff = IdleConfig::SPIN_BACKOFF_MIN;
+    std::atomic<bool> m_idleDetection{true};
+
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCv;
+    std::atomic<uint64_t> m_wakeEpoch{0};
+    std::atomic<uint64_t> m_idleWaits{0};
+    std::atomic<uint64_t> m_idleWaitNs{0};
+    std::atomic<uint64_t> m_skippedInstructions{0};
 };
 
 } // namespace WeaR
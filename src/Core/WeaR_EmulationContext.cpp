@@ -0,0 +1,27 @@
+#include "WeaR_EmulationContext.h"
+#include "WeaR_EmulatorCore.h"
+#include "HLE/WeaR_Syscalls.h"
+#include "HLE/Graphics/WeaR_GnmDriver.h"
+#include "HLE/FileSystem/WeaR_VFS.h"
+#include "Graphics/WeaR_RenderQueue.h"
+#include "Audio/WeaR_AudioManager.h"
+#include "Input/WeaR_Input.h"
+#include "Input/WeaR_InputLatency.h"
+
+namespace WeaR {
+
+WeaR_EmulationContext::WeaR_EmulationContext()
+    : m_inputLatency(std::make_unique<WeaR_InputLatency>())
+    , m_input(std::make_unique<WeaR_InputManager>())
+    , m_audio(std::make_unique<WeaR_AudioManager>())
+    , m_vfs(std::make_unique<WeaR_VFS>())
+    , m_renderQueue(std::make_unique<WeaR_RenderQueue>())
+    , m_gnmDriver(std::make_unique<WeaR_GnmDriver>(*m_renderQueue))
+    , m_syscalls(std::make_unique<WeaR_Syscalls>(*this))
+    , m_core(std::make_unique<WeaR_EmulatorCore>(*this))
+{
+}
+
+WeaR_EmulationContext::~WeaR_EmulationContext() = default;
+
+} // namespace WeaR
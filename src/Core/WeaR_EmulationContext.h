@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file WeaR_EmulationContext.h
+ * @brief Owner of all per-emulation state
+ *
+ * One context is one emulated console: core (memory, CPU), syscall
+ * dispatcher, GNM driver, render queue, VFS, audio, input and latency
+ * tracking. Subsystems reach their siblings through the context that owns
+ * them, never through globals, so a process can run several independent
+ * instances (batch compatibility and benchmark sweeps).
+ *
+ * Host services stay process-wide: logger, tracer, job system, thread
+ * roles, metrics exporter, title profiles and the host CPU probe.
+ */
+
+#include <memory>
+
+namespace WeaR {
+
+class WeaR_EmulatorCore;
+class WeaR_Syscalls;
+class WeaR_GnmDriver;
+class WeaR_RenderQueue;
+class WeaR_VFS;
+class WeaR_AudioManager;
+class WeaR_InputManager;
+class WeaR_InputLatency;
+
+class WeaR_EmulationContext {
+public:
+    WeaR_EmulationContext();
+    ~WeaR_EmulationContext();
+
+    WeaR_EmulationContext(const WeaR_EmulationContext&) = delete;
+    WeaR_EmulationContext& operator=(const WeaR_EmulationContext&) = delete;
+
+    [[nodiscard]] WeaR_EmulatorCore& getCore() { return *m_core; }
+    [[nodiscard]] const WeaR_EmulatorCore& getCore() const { return *m_core; }
+    [[nodiscard]] WeaR_Syscalls& getSyscalls() { return *m_syscalls; }
+    [[nodiscard]] const WeaR_Syscalls& getSyscalls() const { return *m_syscalls; }
+    [[nodiscard]] WeaR_GnmDriver& getGnmDriver() { return *m_gnmDriver; }
+    [[nodiscard]] const WeaR_GnmDriver& getGnmDriver() const { return *m_gnmDriver; }
+    [[nodiscard]] WeaR_RenderQueue& getRenderQueue() { return *m_renderQueue; }
+    [[nodiscard]] const WeaR_RenderQueue& getRenderQueue() const { return *m_renderQueue; }
+    [[nodiscard]] WeaR_VFS& getVfs() { return *m_vfs; }
+    [[nodiscard]] const WeaR_VFS& getVfs() const { return *m_vfs; }
+    [[nodiscard]] WeaR_AudioManager& getAudio() { return *m_audio; }
+    [[nodiscard]] const WeaR_AudioManager& getAudio() const { return *m_audio; }
+    [[nodiscard]] WeaR_InputManager& getInput() { return *m_input; }
+    [[nodiscard]] const WeaR_InputManager& getInput() const { return *m_input; }
+    [[nodiscard]] WeaR_InputLatency& getInputLatency() { return *m_inputLatency; }
+    [[nodiscard]] const WeaR_InputLatency& getInputLatency() const { return *m_inputLatency; }
+
+private:
+    // Construction order; the core goes last so it is destroyed first and
+    // can still shut audio and VFS down
+    std::unique_ptr<WeaR_InputLatency> m_inputLatency;
+    std::unique_ptr<WeaR_InputManager> m_input;
+    std::unique_ptr<WeaR_AudioManager> m_audio;
+    std::unique_ptr<WeaR_VFS> m_vfs;
+    std::unique_ptr<WeaR_RenderQueue> m_renderQueue;
+    std::unique_ptr<WeaR_GnmDriver> m_gnmDriver;
+    std::unique_ptr<WeaR_Syscalls> m_syscalls;
+    std::unique_ptr<WeaR_EmulatorCore> m_core;
+};
+
+} // namespace WeaR
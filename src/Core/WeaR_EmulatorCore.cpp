@@ -1,16 +1,21 @@
 #include "WeaR_EmulatorCore.h"
+#include "WeaR_EmulationContext.h"
 #include "WeaR_Memory.h"
 #include "WeaR_Cpu.h"
 #include "WeaR_InternalBios.h"
+#include "WeaR_Trace.h"
+#include "WeaR_Simd.h"
+#include "WeaR_ThreadRoles.h"
+#include "WeaR_TitleProfile.h"
+#include "WeaR_Log.h"
 #include "Loader/WeaR_ElfLoader.h"
 #include "Loader/WeaR_PkgLoader.h"
 #include "HLE/WeaR_Syscalls.h"
 #include "HLE/FileSystem/WeaR_VFS.h"
 #include "Audio/WeaR_AudioManager.h"
 #include "Input/WeaR_Input.h"
-#include "Graphics/WeaR_RenderEngine.h"
+#include "Input/WeaR_InputLatency.h"
 
-#include <iostream>
 #include <format>
 #include <filesystem>
 #include <fstream>
@@ -33,21 +38,14 @@ const char* getEmuStateName(EmuState state) {
     }
 }
 
-// =============================================================================
-// GLOBAL INSTANCE
-// =============================================================================
-
-WeaR_EmulatorCore& getEmulatorCore() {
-    static WeaR_EmulatorCore instance;
-    return instance;
-}
-
 // =============================================================================
 // CONSTRUCTOR / DESTRUCTOR
 // =============================================================================
 
-WeaR_EmulatorCore::WeaR_EmulatorCore() {
-    std::cout << "[Core] EmulatorCore created\n";
+WeaR_EmulatorCore::WeaR_EmulatorCore(WeaR_EmulationContext& context)
+    : m_context(context)
+{
+    WEAR_LOG_DEBUG(LogCategory::General, "EmulatorCore created");
 }
 
 WeaR_EmulatorCore::~WeaR_EmulatorCore() {
@@ -65,6 +63,11 @@ bool WeaR_EmulatorCore::initialize(const WeaR_Specs& specs) {
     
     setState(EmuState::Booting);
     
+    // Probe the host CPU and pick the SIMD kernels once, before any user
+    (void)getSimdKernels();
+    const auto& hostCpu = getHostCpuInfo();
+    log(std::format("Host CPU: {} [{}]", hostCpu.summary(), hostCpu.featureString()));
+    
     // 1. Initialize Memory (constructor allocates)
     m_memory = std::make_unique<WeaR_Memory>();
     if (!m_memory->isInitialized()) {
@@ -78,17 +81,17 @@ bool WeaR_EmulatorCore::initialize(const WeaR_Specs& specs) {
     
     // 3. Setup syscall handler
     m_cpu->setSyscallHandler([this](WeaR_Context& ctx) {
-        getSyscallDispatcher().dispatch(ctx, *m_memory);
+        m_context.getSyscalls().dispatch(ctx, *m_memory);
     });
     
     // 4. Initialize HLE modules
     initializeHLE();
     
     // 5. Initialize Audio
-    WeaR_AudioManager::get().init();
+    m_context.getAudio().init();
     
     // 6. Reset Input
-    WeaR_InputManager::get().reset();
+    m_context.getInput().reset();
     
     (void)specs;  // Specs used by renderer
     
@@ -108,10 +111,10 @@ void WeaR_EmulatorCore::shutdown() {
     stop();
     
     // Shutdown Audio
-    WeaR_AudioManager::get().shutdown();
+    m_context.getAudio().shutdown();
     
     // Clear VFS
-    WeaR_VFS::get().clearMounts();
+    m_context.getVfs().clearMounts();
     
     // Clear CPU and Memory
     m_cpu.reset();
@@ -121,6 +124,8 @@ void WeaR_EmulatorCore::shutdown() {
     m_gameLoaded = false;
     m_entryPoint = 0;
     m_gamePath.clear();
+    m_guestSymbols = {};
+    restoreThreadRoles();
     
     setState(EmuState::Idle);
     log("EmulatorCore shutdown complete");
@@ -131,6 +136,34 @@ void WeaR_EmulatorCore::initializeHLE() {
     log("HLE modules loaded");
 }
 
+void WeaR_EmulatorCore::applyTitleProfile(const std::string& contentId) {
+    // A previous title's thread overrides must not leak into this one
+    restoreThreadRoles();
+
+    m_titleProfile = getTitleProfiles().load(contentId);
+    log(std::format("Title profile: {}", m_titleProfile.summary()));
+
+    m_cpu->setSliceInstructions(m_titleProfile.sliceInstructions);
+    m_cpu->setIdleDetection(m_titleProfile.idleDetection);
+
+    if (!m_titleProfile.threadRoles.empty()) {
+        auto config = ThreadRoleConfig::parse(m_titleProfile.threadRoles, getHostCpuInfo());
+        if (config) {
+            m_threadRoleOverlay = getThreadRoles().addOverlay(*config);
+        } else {
+            log(std::format("Title profile thread_roles ignored: {}", config.error()));
+        }
+    }
+}
+
+void WeaR_EmulatorCore::restoreThreadRoles() {
+    // The user's settings (possibly changed while the title ran) take over again
+    if (m_threadRoleOverlay != 0) {
+        getThreadRoles().removeOverlay(m_threadRoleOverlay);
+        m_threadRoleOverlay = 0;
+    }
+}
+
 // =============================================================================
 // GAME LOADING
 // =============================================================================
@@ -155,8 +188,8 @@ uint64_t WeaR_EmulatorCore::loadGame(const std::string& path) {
     // Mount /app0 to game directory
     std::filesystem::path gamePath = path;
     std::string gameDir = gamePath.parent_path().string();
-    WeaR_VFS::get().mount("/app0", gameDir);
-    WeaR_VFS::get().mount("/hostapp", gameDir);
+    m_context.getVfs().mount("/app0", gameDir);
+    m_context.getVfs().mount("/hostapp", gameDir);
     
     // Detect file type by magic header
     std::ifstream file(path, std::ios::binary);
@@ -187,6 +220,7 @@ uint64_t WeaR_EmulatorCore::loadGame(const std::string& path) {
             setState(EmuState::Idle);
             return 0;
         }
+        applyTitleProfile(pkgResult->contentId);
         
         auto ebootData = pkgLoader.extractEboot();
         if (!ebootData) {
@@ -279,6 +313,8 @@ uint64_t WeaR_EmulatorCore::loadGame(const std::string& path) {
             return 0;
         }
         m_entryPoint = result->entryPoint;
+        m_guestSymbols = WeaR_GuestSymbols(*result);
+        applyTitleProfile({});
         
     } else {
         log(std::format("Unknown file format (magic: 0x{:08X})", magic));
@@ -461,13 +497,23 @@ bool WeaR_EmulatorCore::stop() {
         m_cpuThread.join();
     }
     
+    // Report input latency for this session
+    auto& latency = m_context.getInputLatency();
+    if (latency.getInputToGuest().getCount() > 0) {
+        log(std::format("Input latency\n{}", latency.report()));
+    }
+    
     // Reset state
     m_cpu->reset();
-    WeaR_InputManager::get().reset();
+    m_context.getInput().reset();
+    latency.reset();
+    m_context.getSyscalls().reset();
     
     m_gameLoaded = false;
     m_entryPoint = 0;
     m_gamePath.clear();
+    m_guestSymbols = {};
+    restoreThreadRoles();
     
     setState(EmuState::Idle);
     log("Emulation stopped");
@@ -489,6 +535,8 @@ bool WeaR_EmulatorCore::togglePause() {
 // =============================================================================
 
 void WeaR_EmulatorCore::cpuThreadMain() {
+    getTracer().setThreadName("CPU");
+    ScopedThreadRole threadRole(ThreadRole::GuestCpu, "CPU");
     log("[CPU] =========================================");
     log("[CPU] ISOLATION MODE - NO EXECUTION");
     log("[CPU] CPU Thread is SLEEPING ONLY");
@@ -547,7 +595,7 @@ void WeaR_EmulatorCore::setState(EmuState newState) {
 }
 
 void WeaR_EmulatorCore::log(const std::string& message) {
-    std::cout << std::format("[Core] {}\n", message);
+    WEAR_LOG_INFO(LogCategory::General, "{}", message);
     
     std::lock_guard<std::mutex> lock(m_callbackMutex);
     if (m_logCallback) {
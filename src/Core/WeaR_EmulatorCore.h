@@ -7,6 +7,10 @@
  * Manages the Run/Pause/Stop state machine and coordinates initialization order.
  */
 
+#include "WeaR_ThreadRoles.h"
+#include "WeaR_TitleProfile.h"
+#include "WeaR_Profiler.h"
+
 #include <string>
 #include <thread>
 #include <atomic>
@@ -21,6 +25,7 @@ namespace WeaR {
 class WeaR_Memory;
 class WeaR_Cpu;
 class WeaR_RenderEngine;
+class WeaR_EmulationContext;
 struct WeaR_Specs;
 struct WeaR_Context;
 
@@ -54,7 +59,10 @@ public:
     using StateCallback = std::function<void(EmuState newState)>;
     using LogCallback = std::function<void(const std::string& message)>;
 
-    WeaR_EmulatorCore();
+    /**
+     * @param context Owner; provides the syscall dispatcher, VFS, audio and input
+     */
+    explicit WeaR_EmulatorCore(WeaR_EmulationContext& context);
     ~WeaR_EmulatorCore();
 
     // Non-copyable
@@ -104,11 +112,27 @@ public:
      */
     [[nodiscard]] bool isGameLoaded() const { return m_gameLoaded; }
 
+    /**
+     * @brief True if the title was loaded without an executable image
+     *        (PS2 Classic / isolation mode) and the CPU has nothing to run
+     */
+    [[nodiscard]] bool isLegacyMode() const { return m_isLegacyMode; }
+
     /**
      * @brief Get loaded game path
      */
     [[nodiscard]] const std::string& getGamePath() const { return m_gamePath; }
 
+    /**
+     * @brief Profile applied by the last loadGame() (built-in defaults before that)
+     */
+    [[nodiscard]] const TitleProfile& getTitleProfile() const { return m_titleProfile; }
+
+    /**
+     * @brief Function symbols and code ranges of the loaded ELF (empty otherwise)
+     */
+    [[nodiscard]] const WeaR_GuestSymbols& getGuestSymbols() const { return m_guestSymbols; }
+
     // =========================================================================
     // STATE CONTROL
     // =========================================================================
@@ -197,6 +221,10 @@ private:
     void setState(EmuState newState);
     void cpuThreadMain();
     void initializeHLE();
+    void applyTitleProfile(const std::string& contentId);
+    void restoreThreadRoles();
+
+    WeaR_EmulationContext& m_context;
 
     // State
     std::atomic<EmuState> m_state{EmuState::Idle};
@@ -205,6 +233,9 @@ private:
     bool m_isLegacyMode = false;  // PS2 Classic / Non-executable games
     std::string m_gamePath;
     uint64_t m_entryPoint = 0;
+    TitleProfile m_titleProfile;
+    WeaR_GuestSymbols m_guestSymbols;
+    uint64_t m_threadRoleOverlay = 0;      // Title profile's thread roles over the user's; 0 = none
 
     // Subsystems
     std::unique_ptr<WeaR_Memory> m_memory;
@@ -221,9 +252,4 @@ private:
     mutable std::mutex m_callbackMutex;
 };
 
-/**
- * @brief Get global emulator core instance
- */
-WeaR_EmulatorCore& getEmulatorCore();
-
 } // namespace WeaR
@@ -0,0 +1,311 @@
+#include "WeaR_HostCpu.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define WEAR_HOST_X86 1
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #include <immintrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#else
+    #define WEAR_HOST_X86 0
+#endif
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace WeaR {
+
+const char* getSimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::SSE42:  return "sse4.2";
+        case SimdLevel::AVX2:   return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+        default:                return "unknown";
+    }
+}
+
+namespace {
+
+// =============================================================================
+// CPUID
+// =============================================================================
+
+#if WEAR_HOST_X86
+struct CpuidRegs {
+    uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+};
+
+CpuidRegs cpuid(uint32_t leaf, uint32_t subleaf = 0) {
+    CpuidRegs r;
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    r.eax = static_cast<uint32_t>(regs[0]);
+    r.ebx = static_cast<uint32_t>(regs[1]);
+    r.ecx = static_cast<uint32_t>(regs[2]);
+    r.edx = static_cast<uint32_t>(regs[3]);
+#else
+    __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+    return r;
+}
+
+uint64_t readXcr0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+constexpr bool bit(uint32_t value, int index) { return ((value >> index) & 1u) != 0; }
+
+// XCR0 state components the OS must save for the vector registers
+constexpr uint64_t XCR0_AVX = 0x6;          // XMM | YMM
+constexpr uint64_t XCR0_AVX512 = 0xE6;      // XMM | YMM | opmask | ZMM_Hi256 | Hi16_ZMM
+
+void probeCpuid(HostCpuInfo& info) {
+    CpuidRegs leaf0 = cpuid(0);
+    const uint32_t maxLeaf = leaf0.eax;
+
+    char vendor[13] = {};
+    std::memcpy(vendor + 0, &leaf0.ebx, 4);
+    std::memcpy(vendor + 4, &leaf0.edx, 4);
+    std::memcpy(vendor + 8, &leaf0.ecx, 4);
+    info.vendor = vendor;
+
+    if (cpuid(0x80000000).eax >= 0x80000004) {
+        char brand[49] = {};
+        for (uint32_t i = 0; i < 3; ++i) {
+            CpuidRegs r = cpuid(0x80000002 + i);
+            std::memcpy(brand + i * 16 + 0, &r.eax, 4);
+            std::memcpy(brand + i * 16 + 4, &r.ebx, 4);
+            std::memcpy(brand + i * 16 + 8, &r.ecx, 4);
+            std::memcpy(brand + i * 16 + 12, &r.edx, 4);
+        }
+        std::string_view text(brand);
+        size_t first = text.find_first_not_of(' ');
+        info.brand = first == std::string_view::npos ? "" : std::string(text.substr(first));
+    }
+
+    if (maxLeaf < 1) return;
+    CpuidRegs leaf1 = cpuid(1);
+    auto& f = info.features;
+    f.pclmul = bit(leaf1.ecx, 1);
+    f.ssse3  = bit(leaf1.ecx, 9);
+    f.sse42  = bit(leaf1.ecx, 20);
+    f.popcnt = bit(leaf1.ecx, 23);
+    f.aesni  = bit(leaf1.ecx, 25);
+
+    const bool osxsave = bit(leaf1.ecx, 27);
+    const uint64_t xcr0 = osxsave ? readXcr0() : 0;
+    const bool avxState = (xcr0 & XCR0_AVX) == XCR0_AVX;
+    const bool avx512State = (xcr0 & XCR0_AVX512) == XCR0_AVX512;
+
+    f.avx = avxState && bit(leaf1.ecx, 28);
+    f.fma = f.avx && bit(leaf1.ecx, 12);
+
+    if (maxLeaf < 7) return;
+    CpuidRegs leaf7 = cpuid(7, 0);
+    f.bmi1     = bit(leaf7.ebx, 3);
+    f.avx2     = f.avx && bit(leaf7.ebx, 5);
+    f.bmi2     = bit(leaf7.ebx, 8);
+    f.avx512f  = avx512State && bit(leaf7.ebx, 16);
+    f.sha      = bit(leaf7.ebx, 29);
+    f.avx512bw = f.avx512f && bit(leaf7.ebx, 30);
+    f.avx512vl = f.avx512f && bit(leaf7.ebx, 31);
+    f.vaes     = f.avx && bit(leaf7.ecx, 9);
+    info.hybrid = bit(leaf7.edx, 15);
+}
+#endif
+
+// =============================================================================
+// TOPOLOGY
+// =============================================================================
+
+#ifdef _WIN32
+void probeTopology(HostCpuInfo& info) {
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    if (length == 0) return;
+
+    std::vector<uint8_t> buffer(length);
+    auto* first = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+    if (!GetLogicalProcessorInformationEx(RelationAll, first, &length)) return;
+
+    uint32_t cores = 0;
+    std::vector<uint32_t> coreOf(info.logicalProcessors, 0);
+    bool mapped = true;
+    for (DWORD offset = 0; offset < length;) {
+        auto* entry = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        if (entry->Relationship == RelationProcessorCore) {
+            // Only processor group 0 is mapped; larger hosts skip the map
+            const GROUP_AFFINITY& group = entry->Processor.GroupMask[0];
+            if (group.Group != 0) mapped = false;
+            for (uint32_t cpu = 0; cpu < 64 && cpu < info.logicalProcessors; ++cpu) {
+                if (group.Mask & (KAFFINITY{1} << cpu)) coreOf[cpu] = cores;
+            }
+            ++cores;
+        } else if (entry->Relationship == RelationCache) {
+            const CACHE_RELATIONSHIP& cache = entry->Cache;
+            const bool data = cache.Type == CacheData || cache.Type == CacheUnified;
+            if (data && cache.Level == 1) {
+                info.cache.l1dBytes = std::max<uint32_t>(info.cache.l1dBytes, cache.CacheSize);
+                info.cache.lineSize = std::max<uint32_t>(info.cache.lineSize, cache.LineSize);
+            } else if (data && cache.Level == 2) {
+                info.cache.l2Bytes = std::max<uint32_t>(info.cache.l2Bytes, cache.CacheSize);
+            } else if (data && cache.Level == 3) {
+                info.cache.l3Bytes = std::max<uint32_t>(info.cache.l3Bytes, cache.CacheSize);
+            }
+        }
+        offset += entry->Size;
+    }
+    info.physicalCores = cores;
+    if (mapped && cores > 0) info.coreOfLogical = std::move(coreOf);
+}
+#else
+bool readSysfsValue(const std::string& path, uint32_t& value) {
+    std::ifstream file(path);
+    return static_cast<bool>(file >> value);
+}
+
+void probeTopology(HostCpuInfo& info) {
+    // One (package, core) pair per physical core
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(info.logicalProcessors);
+    std::set<std::pair<uint32_t, uint32_t>> cores;
+    bool mapped = true;
+    for (uint32_t cpu = 0; cpu < info.logicalProcessors; ++cpu) {
+        const std::string base = std::format("/sys/devices/system/cpu/cpu{}/topology/", cpu);
+        uint32_t package = 0, core = 0;
+        if (readSysfsValue(base + "physical_package_id", package) &&
+            readSysfsValue(base + "core_id", core)) {
+            cores.emplace(package, core);
+            pairs[cpu] = {package, core};
+        } else {
+            mapped = false;
+        }
+    }
+    info.physicalCores = static_cast<uint32_t>(cores.size());
+
+    if (mapped && !cores.empty()) {
+        info.coreOfLogical.resize(info.logicalProcessors);
+        for (uint32_t cpu = 0; cpu < info.logicalProcessors; ++cpu) {
+            auto it = cores.find(pairs[cpu]);
+            info.coreOfLogical[cpu] = static_cast<uint32_t>(std::distance(cores.begin(), it));
+        }
+    }
+
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    auto query = [](int name) {
+        long value = sysconf(name);
+        return value > 0 ? static_cast<uint32_t>(value) : 0u;
+    };
+    info.cache.lineSize = query(_SC_LEVEL1_DCACHE_LINESIZE);
+    info.cache.l1dBytes = query(_SC_LEVEL1_DCACHE_SIZE);
+    info.cache.l2Bytes = query(_SC_LEVEL2_CACHE_SIZE);
+    info.cache.l3Bytes = query(_SC_LEVEL3_CACHE_SIZE);
+#endif
+}
+#endif
+
+// =============================================================================
+// SIMD LEVEL
+// =============================================================================
+
+SimdLevel parseSimdLevel(std::string_view text, SimdLevel fallback) {
+    for (uint8_t i = 0; i < static_cast<uint8_t>(SimdLevel::Count); ++i) {
+        auto level = static_cast<SimdLevel>(i);
+        if (text == getSimdLevelName(level)) return level;
+    }
+    return fallback;
+}
+
+HostCpuInfo probeHostCpu() {
+    HostCpuInfo info;
+    info.logicalProcessors = std::max(1u, std::thread::hardware_concurrency());
+
+#if WEAR_HOST_X86
+    probeCpuid(info);
+#endif
+    probeTopology(info);
+
+    if (info.physicalCores == 0) {
+        info.physicalCores = info.logicalProcessors;
+    }
+
+    info.simdLevel = info.maxSimdLevel();
+#ifdef _MSC_VER
+#pragma warning(suppress : 4996)
+#endif
+    if (const char* cap = std::getenv("WEAR_SIMD")) {
+        info.simdLevel = std::min(info.simdLevel, parseSimdLevel(cap, info.simdLevel));
+    }
+    return info;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// HostCpuInfo
+// =============================================================================
+
+SimdLevel HostCpuInfo::maxSimdLevel() const {
+    const auto& f = features;
+    if (f.avx512f && f.avx512bw && f.avx512vl && f.avx2) return SimdLevel::AVX512;
+    if (f.avx2 && f.fma && f.bmi1 && f.bmi2) return SimdLevel::AVX2;
+    if (f.sse42 && f.ssse3 && f.popcnt) return SimdLevel::SSE42;
+    return SimdLevel::Scalar;
+}
+
+std::string HostCpuInfo::featureString() const {
+    const std::pair<bool, const char*> flags[] = {
+        {features.ssse3, "ssse3"},   {features.sse42, "sse4.2"},     {features.popcnt, "popcnt"},
+        {features.avx, "avx"},       {features.avx2, "avx2"},        {features.fma, "fma"},
+        {features.bmi1, "bmi1"},     {features.bmi2, "bmi2"},        {features.avx512f, "avx512f"},
+        {features.avx512bw, "avx512bw"}, {features.avx512vl, "avx512vl"},
+        {features.aesni, "aes"},     {features.pclmul, "pclmul"},    {features.vaes, "vaes"},
+        {features.sha, "sha"},
+    };
+
+    std::string out;
+    for (const auto& [present, name] : flags) {
+        if (!present) continue;
+        if (!out.empty()) out += ' ';
+        out += name;
+    }
+    return out.empty() ? "none" : out;
+}
+
+std::string HostCpuInfo::summary() const {
+    return std::format("{} ({} cores / {} threads, L2 {} KB, L3 {} MB, simd={})",
+                       !brand.empty() ? brand : !vendor.empty() ? vendor : "Unknown CPU", physicalCores, logicalProcessors,
+                       cache.l2Bytes / 1024, cache.l3Bytes / (1024 * 1024),
+                       getSimdLevelName(simdLevel));
+}
+
+const HostCpuInfo& getHostCpuInfo() {
+    static const HostCpuInfo info = probeHostCpu();
+    return info;
+}
+
+} // namespace WeaR
@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file WeaR_HostCpu.h
+ * @brief Host CPU feature, core and cache topology probe
+ *
+ * Probed once on first use (CPUID plus the OS topology API). Vector
+ * features are only reported when the OS saves the matching register
+ * state, so a feature bit here is safe to execute.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WeaR {
+
+/**
+ * @brief Vector ISA tiers used to pick SIMD kernels
+ */
+enum class SimdLevel : uint8_t {
+    Scalar,
+    SSE42,      // SSE4.2 + SSSE3 + POPCNT
+    AVX2,       // AVX2 + FMA + BMI1/2
+    AVX512,     // AVX-512 F/BW/VL
+    Count
+};
+
+[[nodiscard]] const char* getSimdLevelName(SimdLevel level);
+
+struct HostCpuFeatures {
+    bool sse42 = false;
+    bool ssse3 = false;
+    bool popcnt = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool bmi1 = false;
+    bool bmi2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool avx512vl = false;
+    bool aesni = false;
+    bool pclmul = false;
+    bool vaes = false;
+    bool sha = false;
+};
+
+struct HostCacheInfo {
+    uint32_t lineSize = 0;      // Bytes
+    uint32_t l1dBytes = 0;      // Per core
+    uint32_t l2Bytes = 0;       // Per core (or per cluster)
+    uint32_t l3Bytes = 0;       // Largest shared cache
+};
+
+struct HostCpuInfo {
+    std::string vendor;         // "GenuineIntel", "AuthenticAMD", ...
+    std::string brand;
+    HostCpuFeatures features;
+    HostCacheInfo cache;
+    uint32_t physicalCores = 0;
+    uint32_t logicalProcessors = 0;
+    std::vector<uint32_t> coreOfLogical;  // Physical core index per logical processor (may be empty)
+    bool hybrid = false;        // Mixed core types (P/E): core indices say nothing about speed
+    SimdLevel simdLevel = SimdLevel::Scalar;  // After the WEAR_SIMD cap
+
+    /**
+     * @brief Highest tier the hardware supports (ignores WEAR_SIMD)
+     */
+    [[nodiscard]] SimdLevel maxSimdLevel() const;
+
+    /**
+     * @brief Space-separated feature list ("sse4.2 avx2 bmi2 aes ...")
+     */
+    [[nodiscard]] std::string featureString() const;
+
+    /**
+     * @brief One-line summary for logs and reports
+     */
+    [[nodiscard]] std::string summary() const;
+};
+
+/**
+ * @brief Host CPU capabilities (probed on first call)
+ *
+ * The WEAR_SIMD environment variable (scalar, sse4.2, avx2, avx512) caps
+ * simdLevel, e.g. to reproduce an older host's code path.
+ */
+[[nodiscard]] const HostCpuInfo& getHostCpuInfo();
+
+} // namespace WeaR
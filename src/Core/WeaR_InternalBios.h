@@ -4,7 +4,8 @@
  * @file WeaR_InternalBios.h
  * @brief Internal BIOS for testing without external game files
  * 
- * Writes a small test payload to memory that exercises basic syscalls.
+ * Writes a small test payload to memory that exercises basic syscalls,
+ * and generated instruction mixes used by wear_bench.
  */
 
 #include "WeaR_Memory.h"
@@ -12,6 +13,7 @@
 
 #include <cstring>
 #include <cstdint>
+#include <vector>
 
 namespace WeaR {
 namespace InternalBios {
@@ -151,5 +153,120 @@ inline uint64_t load(WeaR_Memory& mem, WeaR_Context& ctx) {
     return ENTRY_POINT;
 }
 
+// =============================================================================
+// GENERATED INSTRUCTION MIXES (benchmarks)
+// =============================================================================
+
+/**
+ * @brief Instruction pattern repeated by loadInstructionMix()
+ */
+enum class InstructionMix : uint8_t {
+    Nop,        // NOP
+    MovImm,     // MOV r32, imm32 / MOV r64, imm64
+    Stack,      // PUSH/POP pairs
+    Branch,     // CALL/RET + JMP rel32
+    Mixed       // One block of each of the above
+};
+
+inline const char* getInstructionMixName(InstructionMix mix) {
+    switch (mix) {
+        case InstructionMix::Nop:    return "nop";
+        case InstructionMix::MovImm: return "mov_imm";
+        case InstructionMix::Stack:  return "stack";
+        case InstructionMix::Branch: return "branch";
+        case InstructionMix::Mixed:  return "mixed";
+        default:                     return "unknown";
+    }
+}
+
+/**
+ * @brief Write an endless loop of one instruction pattern
+ *
+ * The loop body is @p blockCount copies of the pattern followed by a
+ * JMP back to the entry point, so step() can run it indefinitely. Uses
+ * only opcodes the interpreter implements and never issues a SYSCALL.
+ *
+ * @return Entry point address
+ */
+inline uint64_t loadInstructionMix(WeaR_Memory& mem, WeaR_Context& ctx,
+                                   InstructionMix mix, uint32_t blockCount = 64) {
+    constexpr uint64_t ENTRY_POINT = 0x400000;
+
+    uint64_t addr = ENTRY_POINT;
+    std::vector<uint64_t> callSites;    // CALL rel32 fields patched to the RET stub
+
+    auto emitPattern = [&](InstructionMix pattern) {
+        switch (pattern) {
+            case InstructionMix::Nop:
+                mem.write<uint8_t>(addr++, 0x90);
+                break;
+
+            case InstructionMix::MovImm:
+                // MOV EAX, imm32
+                mem.write<uint8_t>(addr++, 0xB8);
+                mem.write<uint32_t>(addr, 0x12345678);
+                addr += 4;
+                // MOV R9, imm64
+                mem.write<uint8_t>(addr++, 0x49);  // REX.W + REX.B
+                mem.write<uint8_t>(addr++, 0xB9);
+                mem.write<uint64_t>(addr, 0x0123456789ABCDEFULL);
+                addr += 8;
+                break;
+
+            case InstructionMix::Stack:
+                mem.write<uint8_t>(addr++, 0x50);  // PUSH RAX
+                mem.write<uint8_t>(addr++, 0x53);  // PUSH RBX
+                mem.write<uint8_t>(addr++, 0x5B);  // POP RBX
+                mem.write<uint8_t>(addr++, 0x58);  // POP RAX
+                break;
+
+            case InstructionMix::Branch:
+                // CALL stub (target patched below)
+                mem.write<uint8_t>(addr++, 0xE8);
+                callSites.push_back(addr);
+                addr += 4;
+                // JMP to the next instruction
+                mem.write<uint8_t>(addr++, 0xE9);
+                mem.write<int32_t>(addr, 0);
+                addr += 4;
+                break;
+
+            default:
+                break;
+        }
+    };
+
+    for (uint32_t i = 0; i < blockCount; ++i) {
+        if (mix == InstructionMix::Mixed) {
+            emitPattern(InstructionMix::Nop);
+            emitPattern(InstructionMix::MovImm);
+            emitPattern(InstructionMix::Stack);
+            emitPattern(InstructionMix::Branch);
+        } else {
+            emitPattern(mix);
+        }
+    }
+
+    // JMP ENTRY_POINT
+    int32_t loopOffset = static_cast<int32_t>(ENTRY_POINT - (addr + 5));
+    mem.write<uint8_t>(addr++, 0xE9);
+    mem.write<int32_t>(addr, loopOffset);
+    addr += 4;
+
+    // RET stub shared by every CALL
+    const uint64_t stub = addr;
+    mem.write<uint8_t>(addr++, 0xC3);
+    for (uint64_t site : callSites) {
+        mem.write<int32_t>(site, static_cast<int32_t>(stub - (site + 4)));
+    }
+
+    ctx.reset();
+    ctx.RIP = ENTRY_POINT;
+    ctx.RSP = PS4Memory::Region::STACK_TOP - 0x1000;
+    ctx.RBP = ctx.RSP;
+
+    return ENTRY_POINT;
+}
+
 } // namespace InternalBios
 } // namespace WeaR
@@ -0,0 +1,362 @@
+#include "WeaR_JobSystem.h"
+#include "WeaR_HostCpu.h"
+#include "WeaR_Log.h"
+#include "WeaR_ThreadRoles.h"
+#include "WeaR_Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <format>
+#include <mutex>
+
+namespace WeaR {
+
+const char* getJobPriorityName(JobPriority priority) {
+    switch (priority) {
+        case JobPriority::Realtime:   return "realtime";
+        case JobPriority::Normal:     return "normal";
+        case JobPriority::Background: return "background";
+        case JobPriority::IO:         return "io";
+        default:                      return "unknown";
+    }
+}
+
+namespace {
+
+// Worker identity of the calling thread (index is only valid for t_owner)
+thread_local int32_t t_workerIndex = -1;
+thread_local const WeaR_JobSystem* t_owner = nullptr;
+
+} // anonymous namespace
+
+// =============================================================================
+// JOB GROUP
+// =============================================================================
+
+void WeaR_JobGroup::complete() {
+    // Notify under the lock so a waiter cannot destroy the group in between
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_done.notify_all();
+    }
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+WeaR_JobSystem::WeaR_JobSystem(uint32_t workerCount) {
+    if (workerCount == 0) {
+        // Leave one logical processor for the thread that submits the work
+        workerCount = std::max(1u, getHostCpuInfo().logicalProcessors - 1);
+    }
+    workerCount = std::min(workerCount, JobConfig::MAX_WORKERS);
+
+    // Create every worker before starting any, so thieves see the full set
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        m_workers[i]->thread = std::thread([this, i] { workerMain(i); });
+    }
+    for (uint32_t i = 0; i < JobConfig::IO_WORKERS; ++i) {
+        m_ioThreads.emplace_back([this, i] { ioWorkerMain(i); });
+    }
+
+    WEAR_LOG_INFO(LogCategory::General, "Job system: {} workers, {} I/O workers",
+                  workerCount, JobConfig::IO_WORKERS);
+}
+
+WeaR_JobSystem::~WeaR_JobSystem() {
+    {
+        std::lock_guard<std::mutex> sleepLock(m_sleepMutex);
+        std::lock_guard<std::mutex> ioLock(m_ioMutex);
+        m_stopping.store(true);
+    }
+    m_wake.notify_all();
+    m_ioWake.notify_all();
+
+    // Workers drain their queues before exiting, so pending groups complete
+    for (auto& worker : m_workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+    for (auto& thread : m_ioThreads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+void WeaR_JobSystem::enterForkedChild() {
+    m_inline.store(true, std::memory_order_relaxed);
+}
+
+int32_t WeaR_JobSystem::getCurrentWorker() {
+    return t_workerIndex;
+}
+
+int32_t WeaR_JobSystem::selfIndex() const {
+    return t_owner == this ? t_workerIndex : -1;
+}
+
+// =============================================================================
+// SUBMISSION
+// =============================================================================
+
+void WeaR_JobSystem::submit(Job job, const JobOptions& options) {
+    if (!job) return;
+
+    if (options.group) options.group->add();
+    m_submitted.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_inline.load(std::memory_order_relaxed)) {
+        Task task{std::move(job), options.group};
+        run(task);
+        return;
+    }
+
+    const auto priority = static_cast<size_t>(options.priority);
+    m_queued[priority].fetch_add(1, std::memory_order_relaxed);
+    Task task{std::move(job), options.group};
+
+    if (options.priority == JobPriority::IO) {
+        {
+            std::lock_guard<std::mutex> lock(m_ioMutex);
+            m_ioQueue.push_back(std::move(task));
+        }
+        m_ioWake.notify_one();
+        return;
+    }
+
+    // Count before publishing: a thief that takes the task right away must
+    // not decrement the counter below zero
+    m_computeQueued.fetch_add(1, std::memory_order_release);
+
+    int32_t target = selfIndex();
+    if (options.preferredWorker >= 0) {
+        target = options.preferredWorker % static_cast<int32_t>(m_workers.size());
+    }
+
+    if (target >= 0) {
+        Worker& worker = *m_workers[static_cast<size_t>(target)];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queues[priority].push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        m_injected[priority].push_back(std::move(task));
+    }
+
+    wakeWorker();
+}
+
+void WeaR_JobSystem::wakeWorker() {
+    // Taking the lock orders this with a worker that is about to sleep
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_wake.notify_one();
+}
+
+// =============================================================================
+// SCHEDULING
+// =============================================================================
+
+bool WeaR_JobSystem::tryGetTask(int32_t self, Task& out) {
+    const auto workerCount = static_cast<uint32_t>(m_workers.size());
+
+    auto take = [&](size_t priority, bool stolen) {
+        m_queued[priority].fetch_sub(1, std::memory_order_relaxed);
+        m_computeQueued.fetch_sub(1, std::memory_order_relaxed);
+        if (stolen) m_stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    // Strict priority across the pool: a realtime job anywhere beats a
+    // normal job in the worker's own deque
+    for (size_t priority = 0; priority < COMPUTE_PRIORITY_COUNT; ++priority) {
+        if (self >= 0) {
+            Worker& own = *m_workers[static_cast<size_t>(self)];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            auto& queue = own.queues[priority];
+            if (!queue.empty()) {
+                out = std::move(queue.back());
+                queue.pop_back();
+                return take(priority, false);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_injectMutex);
+            auto& queue = m_injected[priority];
+            if (!queue.empty()) {
+                out = std::move(queue.front());
+                queue.pop_front();
+                return take(priority, false);
+            }
+        }
+
+        const uint32_t start = m_nextVictim.fetch_add(1, std::memory_order_relaxed);
+        for (uint32_t k = 0; k < workerCount; ++k) {
+            const uint32_t victim = (start + k) % workerCount;
+            if (static_cast<int32_t>(victim) == self) continue;
+
+            Worker& other = *m_workers[victim];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            auto& queue = other.queues[priority];
+            if (!queue.empty()) {
+                out = std::move(queue.front());
+                queue.pop_front();
+                return take(priority, true);
+            }
+        }
+    }
+    return false;
+}
+
+void WeaR_JobSystem::run(Task& task) {
+    try {
+        task.job();
+    } catch (const std::exception& e) {
+        WEAR_LOG_ERROR(LogCategory::General, "Job threw an exception: {}", e.what());
+    } catch (...) {
+        WEAR_LOG_ERROR(LogCategory::General, "Job threw an unknown exception");
+    }
+
+    m_executed.fetch_add(1, std::memory_order_relaxed);
+    if (task.group) task.group->complete();
+}
+
+void WeaR_JobSystem::workerMain(uint32_t index) {
+    t_workerIndex = static_cast<int32_t>(index);
+    t_owner = this;
+    getTracer().setThreadName(std::format("Job {}", index));
+    ScopedThreadRole threadRole(ThreadRole::Worker, std::format("Job {}", index));
+
+    const auto self = static_cast<int32_t>(index);
+    while (true) {
+        Task task;
+        if (tryGetTask(self, task)) {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this] {
+            return m_stopping.load() || m_computeQueued.load(std::memory_order_acquire) > 0;
+        });
+        if (m_stopping.load() && m_computeQueued.load() == 0) {
+            break;
+        }
+    }
+}
+
+void WeaR_JobSystem::ioWorkerMain(uint32_t index) {
+    getTracer().setThreadName(std::format("I/O {}", index));
+    ScopedThreadRole threadRole(ThreadRole::IO, std::format("I/O {}", index));
+
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_ioMutex);
+            m_ioWake.wait(lock, [this] { return m_stopping.load() || !m_ioQueue.empty(); });
+            if (m_ioQueue.empty()) {
+                break;
+            }
+            task = std::move(m_ioQueue.front());
+            m_ioQueue.pop_front();
+        }
+        m_queued[static_cast<size_t>(JobPriority::IO)].fetch_sub(1, std::memory_order_relaxed);
+        run(task);
+    }
+}
+
+// =============================================================================
+// WAITING
+// =============================================================================
+
+void WeaR_JobSystem::wait(WeaR_JobGroup& group) {
+    const int32_t self = selfIndex();
+
+    while (!group.isDone()) {
+        Task task;
+        if (tryGetTask(self, task)) {
+            run(task);
+            continue;
+        }
+
+        // Nothing to help with; sleep briefly so new work is still picked up
+        std::unique_lock<std::mutex> lock(group.m_mutex);
+        group.m_done.wait_for(lock, std::chrono::milliseconds(1), [&] { return group.isDone(); });
+    }
+
+    // The last complete() may still hold the lock; let it leave first
+    std::lock_guard<std::mutex> lock(group.m_mutex);
+}
+
+void WeaR_JobSystem::parallelFor(size_t begin, size_t end, size_t grain, const RangeBody& body,
+                                 JobPriority priority)
+{
+    if (end <= begin) return;
+
+    const size_t total = end - begin;
+    grain = std::max<size_t>(grain, 1);
+
+    // A few chunks per thread balance uneven chunks without flooding the queues
+    const size_t maxChunks = (static_cast<size_t>(getWorkerCount()) + 1) * 4;
+    const size_t chunks = std::min((total + grain - 1) / grain, maxChunks);
+    if (chunks <= 1) {
+        body(begin, end);
+        return;
+    }
+
+    const size_t chunkSize = (total + chunks - 1) / chunks;
+
+    // The first exception from any chunk, rethrown once every chunk is done
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+    auto runChunk = [&body, &firstError, &errorMutex](size_t chunkBegin, size_t chunkEnd) {
+        try {
+            body(chunkBegin, chunkEnd);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!firstError) firstError = std::current_exception();
+        }
+    };
+
+    WeaR_JobGroup group;
+    for (size_t chunkBegin = begin + chunkSize; chunkBegin < end; chunkBegin += chunkSize) {
+        const size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+        submit([&runChunk, chunkBegin, chunkEnd] { runChunk(chunkBegin, chunkEnd); },
+               JobOptions{priority, -1, &group});
+    }
+
+    // The chunks reference body and runChunk, so always wait before leaving
+    runChunk(begin, std::min(end, begin + chunkSize));
+    wait(group);
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+// =============================================================================
+// STATISTICS
+// =============================================================================
+
+JobSystemStats WeaR_JobSystem::getStats() const {
+    JobSystemStats stats;
+    stats.workers = static_cast<uint32_t>(m_workers.size());
+    stats.ioWorkers = static_cast<uint32_t>(m_ioThreads.size());
+    stats.submitted = m_submitted.load(std::memory_order_relaxed);
+    stats.executed = m_executed.load(std::memory_order_relaxed);
+    stats.stolen = m_stolen.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < JOB_PRIORITY_COUNT; ++i) {
+        stats.queued[i] = m_queued[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+WeaR_JobSystem& getJobSystem() {
+    static WeaR_JobSystem instance;
+    return instance;
+}
+
+} // namespace WeaR
@@ -0,0 +1,195 @@
+#pragma once
+
+/**
+ * @file WeaR_JobSystem.h
+ * @brief Work-stealing job system shared by all subsystems
+ *
+ * Compute workers each own a deque per priority: the owner pushes and
+ * pops at the back (LIFO, cache-warm), idle workers steal from the front
+ * of other workers' deques (FIFO, oldest and usually largest work first).
+ * Jobs submitted from outside the pool go to a shared injection queue.
+ * Blocking I/O runs on a separate small pool so it never occupies a
+ * compute worker. Long-lived loops (CPU, render, logger) keep their
+ * dedicated threads; everything finite should be submitted here.
+ */
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace WeaR {
+
+// =============================================================================
+// PRIORITIES & OPTIONS
+// =============================================================================
+
+/**
+ * @brief Queue order; a running job is never preempted
+ */
+enum class JobPriority : uint8_t {
+    Realtime,       // Audio mixing, frame recording: taken before anything else
+    Normal,         // Loading, relocation, detiling
+    Background,     // Shader compilation, cache warming
+    IO,             // Blocking file/network work (separate I/O workers)
+    Count
+};
+
+constexpr size_t JOB_PRIORITY_COUNT = static_cast<size_t>(JobPriority::Count);
+constexpr size_t COMPUTE_PRIORITY_COUNT = static_cast<size_t>(JobPriority::IO);
+
+[[nodiscard]] const char* getJobPriorityName(JobPriority priority);
+
+namespace JobConfig {
+    constexpr uint32_t IO_WORKERS = 2;
+    constexpr uint32_t MAX_WORKERS = 64;
+}
+
+/**
+ * @brief Completion counter for a set of jobs
+ */
+class WeaR_JobGroup {
+public:
+    WeaR_JobGroup() = default;
+    WeaR_JobGroup(const WeaR_JobGroup&) = delete;
+    WeaR_JobGroup& operator=(const WeaR_JobGroup&) = delete;
+
+    [[nodiscard]] bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+    [[nodiscard]] uint32_t getPending() const { return m_pending.load(std::memory_order_relaxed); }
+
+private:
+    friend class WeaR_JobSystem;
+
+    void add() { m_pending.fetch_add(1, std::memory_order_relaxed); }
+    void complete();
+
+    std::atomic<uint32_t> m_pending{0};
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+};
+
+struct JobOptions {
+    JobPriority priority = JobPriority::Normal;
+    int32_t preferredWorker = -1;       // Affinity hint: queue on this worker (still stealable)
+    WeaR_JobGroup* group = nullptr;     // Counted until the job has run
+};
+
+struct JobSystemStats {
+    uint32_t workers = 0;
+    uint32_t ioWorkers = 0;
+    uint64_t submitted = 0;
+    uint64_t executed = 0;
+    uint64_t stolen = 0;
+    std::array<uint64_t, JOB_PRIORITY_COUNT> queued{};     // Current depth per priority
+};
+
+// =============================================================================
+// JOB SYSTEM
+// =============================================================================
+
+class WeaR_JobSystem {
+public:
+    using Job = std::function<void()>;
+    using RangeBody = std::function<void(size_t begin, size_t end)>;
+
+    /**
+     * @param workerCount Compute workers; 0 = logical processors - 1 (at least 1)
+     */
+    explicit WeaR_JobSystem(uint32_t workerCount = 0);
+    ~WeaR_JobSystem();
+
+    WeaR_JobSystem(const WeaR_JobSystem&) = delete;
+    WeaR_JobSystem& operator=(const WeaR_JobSystem&) = delete;
+
+    void submit(Job job, const JobOptions& options = {});
+
+    /**
+     * @brief Block until the group is done, running queued jobs meanwhile
+     */
+    void wait(WeaR_JobGroup& group);
+
+    /**
+     * @brief Run body over [begin, end) in chunks of at least grain items
+     *
+     * The caller runs the first chunk and helps with the rest, so this is
+     * safe to call from inside a job. If any chunk throws, the remaining
+     * chunks still run and the first exception is rethrown here.
+     */
+    void parallelFor(size_t begin, size_t end, size_t grain, const RangeBody& body,
+                     JobPriority priority = JobPriority::Normal);
+
+    [[nodiscard]] uint32_t getWorkerCount() const {
+        return m_inline.load(std::memory_order_relaxed) ? 0 : static_cast<uint32_t>(m_workers.size());
+    }
+
+    /**
+     * @brief Call in a fork() child: run every job inline from now on
+     *
+     * Only the forking thread exists in the child, so queued work would
+     * never be picked up. Queues and their locks (possibly held by a parent
+     * worker at the fork) are not touched again.
+     */
+    void enterForkedChild();
+
+    /**
+     * @brief Index of the calling compute worker, or -1 outside the pool
+     */
+    [[nodiscard]] static int32_t getCurrentWorker();
+
+    [[nodiscard]] JobSystemStats getStats() const;
+
+private:
+    struct Task {
+        Job job;
+        WeaR_JobGroup* group = nullptr;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::array<std::deque<Task>, COMPUTE_PRIORITY_COUNT> queues;
+        std::thread thread;
+    };
+
+    void workerMain(uint32_t index);
+    void ioWorkerMain(uint32_t index);
+    bool tryGetTask(int32_t self, Task& out);
+    void run(Task& task);
+    void wakeWorker();
+    [[nodiscard]] int32_t selfIndex() const;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_ioThreads;
+
+    // Submissions from threads outside the pool
+    std::mutex m_injectMutex;
+    std::array<std::deque<Task>, COMPUTE_PRIORITY_COUNT> m_injected;
+
+    std::mutex m_ioMutex;
+    std::condition_variable m_ioWake;
+    std::deque<Task> m_ioQueue;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<uint64_t> m_computeQueued{0};
+    std::array<std::atomic<uint64_t>, JOB_PRIORITY_COUNT> m_queued{};
+    std::atomic<uint64_t> m_submitted{0};
+    std::atomic<uint64_t> m_executed{0};
+    std::atomic<uint64_t> m_stolen{0};
+    std::atomic<uint32_t> m_nextVictim{0};
+    std::atomic<bool> m_stopping{false};
+    std::atomic<bool> m_inline{false};         // No workers (fork() child)
+};
+
+/**
+ * @brief Get the shared job system (started on first use)
+ */
+WeaR_JobSystem& getJobSystem();
+
+} // namespace WeaR
@@ -0,0 +1,489 @@
+#include "WeaR_Log.h"
+#include "WeaR_ThreadRoles.h"
+
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+
+namespace WeaR {
+
+// =============================================================================
+// LEVEL TAGS
+// =============================================================================
+
+const char* getLogLevelTag(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "[DBG]";
+        case LogLevel::Info:    return "[INF]";
+        case LogLevel::Warning: return "[WRN]";
+        case LogLevel::Error:   return "[ERR]";
+        case LogLevel::Syscall: return "[SYS]";
+        default:                return "[???]";
+    }
+}
+
+// =============================================================================
+// CATEGORIES AND THRESHOLDS
+// =============================================================================
+
+const char* getLogCategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::General: return "";
+        case LogCategory::CPU:     return "CPU";
+        case LogCategory::Syscall: return "SYSCALL";
+        case LogCategory::GNM:     return "GNM";
+        case LogCategory::VFS:     return "VFS";
+        case LogCategory::PKG:     return "PKG";
+        case LogCategory::ELF:     return "ELF";
+        case LogCategory::Audio:   return "AUDIO";
+        default:                   return "???";
+    }
+}
+
+const char* getLogThresholdName(LogThreshold threshold) {
+    switch (threshold) {
+        case LogThreshold::Debug:   return "debug";
+        case LogThreshold::Info:    return "info";
+        case LogThreshold::Warning: return "warning";
+        case LogThreshold::Error:   return "error";
+        case LogThreshold::Off:     return "off";
+        default:                    return "unknown";
+    }
+}
+
+std::optional<LogThreshold> parseLogThreshold(std::string_view name) {
+    if (name == "debug")   return LogThreshold::Debug;
+    if (name == "info")    return LogThreshold::Info;
+    if (name == "warning") return LogThreshold::Warning;
+    if (name == "error")   return LogThreshold::Error;
+    if (name == "off")     return LogThreshold::Off;
+    return std::nullopt;
+}
+
+// =============================================================================
+// PER-THREAD RING
+// =============================================================================
+
+static_assert((LogConfig::RING_CAPACITY & (LogConfig::RING_CAPACITY - 1)) == 0,
+              "RING_CAPACITY must be a power of two");
+
+WeaR_LogRing::WeaR_LogRing(uint32_t threadId)
+    : m_slots(std::make_unique<LogRecord[]>(LogConfig::RING_CAPACITY))
+    , m_threadId(threadId)
+{
+}
+
+LogRecord* WeaR_LogRing::tryAcquire() {
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    const uint64_t tail = m_tail.load(std::memory_order_acquire);
+    if (head - tail >= LogConfig::RING_CAPACITY) {
+        return nullptr;
+    }
+    return &m_slots[head & (LogConfig::RING_CAPACITY - 1)];
+}
+
+void WeaR_LogRing::commit() {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+const LogRecord* WeaR_LogRing::peek() const {
+    const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &m_slots[tail & (LogConfig::RING_CAPACITY - 1)];
+}
+
+void WeaR_LogRing::release() {
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool WeaR_LogRing::isEmpty() const {
+    return getPendingCount() == 0;
+}
+
+size_t WeaR_LogRing::getPendingCount() const {
+    return static_cast<size_t>(m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed));
+}
+
+// =============================================================================
+// RATE LIMITER
+// =============================================================================
+
+namespace {
+
+// FNV-1a over the format string identity and the encoded arguments
+uint64_t hashRecord(const LogRecord& record) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+    };
+    mix(&record.format, sizeof(record.format));
+    mix(&record.payloadSize, sizeof(record.payloadSize));
+    mix(record.payload, record.payloadSize);
+    return hash;
+}
+
+} // anonymous namespace
+
+WeaR_LogLimiter::WeaR_LogLimiter()
+    : m_slots(std::make_unique<Slot[]>(LogConfig::LIMIT_SLOTS))
+{
+    getAsyncLogger().registerLimiter(this);
+}
+
+WeaR_LogLimiter::~WeaR_LogLimiter() {
+    getAsyncLogger().unregisterLimiter(this);
+}
+
+bool WeaR_LogLimiter::admit(const LogRecord& record) {
+    const uint64_t hash = hashRecord(record);
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (now - m_windowStart >= LogConfig::LIMIT_WINDOW) {
+        m_windowStart = now;
+        m_siteAdmitted = 0;
+    }
+
+    Slot& slot = findSlot(hash, now);
+    if (now - slot.windowStart >= LogConfig::LIMIT_WINDOW) {
+        retireSlot(slot);
+        slot.windowStart = now;
+    }
+
+    if (slot.admitted < LogConfig::LIMIT_BURST) {
+        if (m_siteAdmitted < LogConfig::LIMIT_SITE_BURST) {
+            slot.admitted++;
+            m_siteAdmitted++;
+            std::memcpy(&slot.sample, &record, LogRecord::HEADER_SIZE + record.payloadSize);
+            return true;
+        }
+        // Many different messages from one site: count them together
+        if (m_siteSuppressed == 0) {
+            std::memcpy(&m_siteSample, &record, LogRecord::HEADER_SIZE + record.payloadSize);
+        }
+        m_siteSuppressed++;
+        return false;
+    }
+
+    slot.suppressed++;
+    return false;
+}
+
+WeaR_LogLimiter::Slot& WeaR_LogLimiter::findSlot(uint64_t hash, Clock::time_point now) {
+    Slot* oldest = &m_slots[0];
+    for (size_t i = 0; i < LogConfig::LIMIT_SLOTS; ++i) {
+        Slot& slot = m_slots[i];
+        if (slot.used && slot.hash == hash) {
+            return slot;
+        }
+        if (!slot.used) {
+            oldest = &slot;
+            break;
+        }
+        if (slot.windowStart < oldest->windowStart) {
+            oldest = &slot;
+        }
+    }
+
+    // Evict the least recently started key, keeping its count for the report
+    retireSlot(*oldest);
+    oldest->used = true;
+    oldest->hash = hash;
+    oldest->windowStart = now;
+    return *oldest;
+}
+
+void WeaR_LogLimiter::retireSlot(Slot& slot) {
+    if (slot.suppressed > 0) {
+        LogSummary summary;
+        std::memcpy(&summary.sample, &slot.sample, LogRecord::HEADER_SIZE + slot.sample.payloadSize);
+        summary.count = slot.suppressed;
+        summary.identical = true;
+        m_pending.push_back(summary);
+    }
+    slot.admitted = 0;
+    slot.suppressed = 0;
+}
+
+void WeaR_LogLimiter::collectSummaries(std::vector<LogSummary>& out, bool force) {
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (size_t i = 0; i < LogConfig::LIMIT_SLOTS; ++i) {
+        Slot& slot = m_slots[i];
+        if (slot.used && slot.suppressed > 0 &&
+            (force || now - slot.windowStart >= LogConfig::LIMIT_WINDOW)) {
+            retireSlot(slot);
+        }
+    }
+
+    if (m_siteSuppressed > 0 && (force || now - m_windowStart >= LogConfig::LIMIT_WINDOW)) {
+        LogSummary summary;
+        std::memcpy(&summary.sample, &m_siteSample, LogRecord::HEADER_SIZE + m_siteSample.payloadSize);
+        summary.count = m_siteSuppressed;
+        summary.identical = false;
+        m_pending.push_back(summary);
+        m_siteSuppressed = 0;
+    }
+
+    out.insert(out.end(), m_pending.begin(), m_pending.end());
+    m_pending.clear();
+}
+
+// =============================================================================
+// SINKS
+// =============================================================================
+
+void WeaR_ConsoleLogSink::write(const LogLine& line) {
+    std::cout << line.text << '\n';
+}
+
+void WeaR_ConsoleLogSink::flush() {
+    std::cout.flush();
+}
+
+WeaR_FileLogSink::WeaR_FileLogSink(const std::string& path)
+    : m_file(path, std::ios::out | std::ios::app)
+{
+    if (!m_file) {
+        std::cerr << std::format("[Log] Cannot open log file: {}\n", path);
+    }
+}
+
+void WeaR_FileLogSink::write(const LogLine& line) {
+    if (m_file) {
+        m_file << line.text << '\n';
+    }
+}
+
+void WeaR_FileLogSink::flush() {
+    m_file.flush();
+}
+
+// =============================================================================
+// ASYNC LOGGER
+// =============================================================================
+
+WeaR_AsyncLogger& getAsyncLogger() {
+    static WeaR_AsyncLogger instance;
+    return instance;
+}
+
+WeaR_AsyncLogger::WeaR_AsyncLogger() {
+    m_sinks.push_back(std::make_shared<WeaR_ConsoleLogSink>());
+    m_thread = std::thread([this]() { threadMain(); });
+}
+
+WeaR_AsyncLogger::~WeaR_AsyncLogger() {
+    m_running = false;
+    m_wakeup.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    flush();
+}
+
+WeaR_LogRing& WeaR_AsyncLogger::localRing() {
+    thread_local std::shared_ptr<WeaR_LogRing> ring;
+    if (!ring) {
+        ring = std::make_shared<WeaR_LogRing>(m_nextThreadId.fetch_add(1, std::memory_order_relaxed));
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        m_rings.push_back(ring);
+    }
+    return *ring;
+}
+
+void WeaR_AsyncLogger::addSink(std::shared_ptr<WeaR_LogSink> sink) {
+    if (!sink) return;
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    m_sinks.push_back(std::move(sink));
+}
+
+void WeaR_AsyncLogger::removeSink(const WeaR_LogSink* sink) {
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    std::erase_if(m_sinks, [sink](const auto& entry) { return entry.get() == sink; });
+}
+
+void WeaR_AsyncLogger::registerLimiter(WeaR_LogLimiter* limiter) {
+    std::lock_guard<std::mutex> lock(m_limitersMutex);
+    m_limiters.push_back(limiter);
+}
+
+void WeaR_AsyncLogger::unregisterLimiter(WeaR_LogLimiter* limiter) {
+    std::lock_guard<std::mutex> lock(m_limitersMutex);
+    std::erase(m_limiters, limiter);
+}
+
+void WeaR_AsyncLogger::flush() {
+    drain(true);
+
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    for (auto& sink : m_sinks) {
+        sink->flush();
+    }
+}
+
+void WeaR_AsyncLogger::beforeFork() {
+    // Same order as drain(): the drain mutex first, then the ones it nests
+    m_drainMutex.lock();
+    m_limitersMutex.lock();
+    m_ringsMutex.lock();
+    m_sinkMutex.lock();
+    m_wakeupMutex.lock();
+}
+
+void WeaR_AsyncLogger::afterFork() {
+    m_wakeupMutex.unlock();
+    m_sinkMutex.unlock();
+    m_ringsMutex.unlock();
+    m_limitersMutex.unlock();
+    m_drainMutex.unlock();
+}
+
+void WeaR_AsyncLogger::threadMain() {
+    ScopedThreadRole threadRole(ThreadRole::Service, "Logger");
+    while (m_running.load(std::memory_order_relaxed)) {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeupMutex);
+            m_wakeup.wait_for(lock, LogConfig::DRAIN_INTERVAL);
+        }
+        drain();
+    }
+}
+
+bool WeaR_AsyncLogger::drain(bool forceSummaries) {
+    std::lock_guard<std::mutex> drainLock(m_drainMutex);
+
+    // Collect rate limiter reports a few times per window
+    m_summaries.clear();
+    auto steadyNow = std::chrono::steady_clock::now();
+    if (forceSummaries || steadyNow - m_lastSummaryCheck >= LogConfig::LIMIT_WINDOW / 4) {
+        m_lastSummaryCheck = steadyNow;
+        std::lock_guard<std::mutex> lock(m_limitersMutex);
+        for (WeaR_LogLimiter* limiter : m_limiters) {
+            limiter->collectSummaries(m_summaries, forceSummaries);
+        }
+    }
+
+    std::vector<std::shared_ptr<WeaR_LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        rings = m_rings;
+    }
+
+    // Snapshot how many records each ring holds now; records committed
+    // during this pass wait for the next one, so a busy producer cannot
+    // keep the drain loop spinning
+    std::vector<size_t> budget(rings.size());
+    size_t total = 0;
+    uint64_t dropped = 0;
+    for (size_t i = 0; i < rings.size(); ++i) {
+        dropped += rings[i]->takeDropped();
+        budget[i] = rings[i]->getPendingCount();
+        total += budget[i];
+    }
+
+    if (total == 0 && dropped == 0 && m_summaries.empty()) {
+        // Reap rings whose thread has exited (only the registry still owns them)
+        rings.clear();
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        std::erase_if(m_rings, [](const auto& ring) { return ring.use_count() == 1 && ring->isEmpty(); });
+        return false;
+    }
+
+    std::lock_guard<std::mutex> sinkLock(m_sinkMutex);
+
+    // Merge by timestamp so lines from different threads interleave correctly
+    for (size_t n = 0; n < total; ++n) {
+        size_t oldestIndex = rings.size();
+        const LogRecord* oldest = nullptr;
+        for (size_t i = 0; i < rings.size(); ++i) {
+            if (budget[i] == 0) continue;
+            const LogRecord* record = rings[i]->peek();
+            if (record && (!oldest || record->timestampNs < oldest->timestampNs)) {
+                oldest = record;
+                oldestIndex = i;
+            }
+        }
+        if (!oldest) break;
+
+        m_message.clear();
+        try {
+            oldest->formatFn(*oldest, m_message);
+        } catch (const std::exception& e) {
+            m_message = std::format("<log format error: {}>", e.what());
+        }
+        emitLine(oldest->timestampNs, oldest->level, oldest->category, oldest->threadId, m_message);
+
+        rings[oldestIndex]->release();
+        --budget[oldestIndex];
+        m_recordsWritten.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    for (const LogSummary& summary : m_summaries) {
+        m_message.clear();
+        try {
+            summary.sample.formatFn(summary.sample, m_message);
+        } catch (const std::exception& e) {
+            m_message = std::format("<log format error: {}>", e.what());
+        }
+        m_message = summary.identical
+            ? std::format("{} ({} occurrences suppressed)", m_message, summary.count)
+            : std::format("{} similar messages suppressed (first: {})", summary.count, m_message);
+        emitLine(now, summary.sample.level, summary.sample.category, 0, m_message);
+    }
+
+    if (dropped > 0) {
+        m_recordsDropped.fetch_add(dropped, std::memory_order_relaxed);
+        emitLine(now, LogLevel::Warning, LogCategory::General, 0,
+                 std::format("[Log] {} records dropped (producer ring full)", dropped));
+    }
+
+    return true;
+}
+
+void WeaR_AsyncLogger::emitLine(uint64_t timestampNs, LogLevel level, LogCategory category,
+                                uint32_t threadId, std::string_view message)
+{
+    // Local wall-clock time "hh:mm:ss.zzz"
+    std::time_t seconds = static_cast<std::time_t>(timestampNs / 1'000'000'000ull);
+    uint32_t millis = static_cast<uint32_t>((timestampNs / 1'000'000ull) % 1000);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+
+    m_text = std::format("{:02}:{:02}:{:02}.{:03} {} ",
+                         local.tm_hour, local.tm_min, local.tm_sec, millis,
+                         getLogLevelTag(level));
+    if (category != LogCategory::General) {
+        m_text += std::format("[{}] ", getLogCategoryName(category));
+    }
+    m_text += message;
+
+    LogLine line;
+    line.timestampNs = timestampNs;
+    line.level = level;
+    line.category = category;
+    line.threadId = threadId;
+    line.message = message;
+    line.text = m_text;
+
+    for (auto& sink : m_sinks) {
+        sink->write(line);
+    }
+}
+
+} // namespace WeaR
@@ -0,0 +1,679 @@
+#pragma once
+
+/**
+ * @file WeaR_Log.h
+ * @brief Asynchronous binary logger with deferred formatting
+ *
+ * Producers never format text. A log call copies a pointer to the static
+ * format string, a type-specific decoder and the raw argument bytes into a
+ * fixed-size record in a per-thread lock-free ring. A background thread
+ * drains all rings, formats the records and hands the lines to sinks
+ * (console, file, GUI).
+ *
+ * Memory is bounded: each producer thread owns RING_CAPACITY records of
+ * RECORD_SIZE bytes. When a ring is full the record is dropped and counted;
+ * the hot path never blocks on logging.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace WeaR {
+
+// =============================================================================
+// LOG LEVEL
+// =============================================================================
+
+/**
+ * @brief Log message severity
+ */
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Syscall
+};
+
+/**
+ * @brief Short tag for a level ("[DBG]", "[INF]", ...)
+ */
+[[nodiscard]] const char* getLogLevelTag(LogLevel level);
+
+/**
+ * @brief Severity used for filtering (Syscall traces filter like Debug)
+ */
+[[nodiscard]] constexpr uint8_t getLogSeverity(LogLevel level) {
+    return level == LogLevel::Syscall ? 0 : static_cast<uint8_t>(level);
+}
+
+// =============================================================================
+// CATEGORIES AND FILTERING
+// =============================================================================
+
+/**
+ * @brief Subsystem a message belongs to (each has its own runtime level)
+ */
+enum class LogCategory : uint8_t {
+    General,
+    CPU,
+    Syscall,
+    GNM,
+    VFS,
+    PKG,
+    ELF,
+    Audio,
+    Count
+};
+
+constexpr size_t LOG_CATEGORY_COUNT = static_cast<size_t>(LogCategory::Count);
+
+/**
+ * @brief Stable name used by settings ("CPU", "SYSCALL", ...; "" for General)
+ */
+[[nodiscard]] const char* getLogCategoryName(LogCategory category);
+
+/**
+ * @brief Lowest severity a category lets through
+ */
+enum class LogThreshold : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+[[nodiscard]] const char* getLogThresholdName(LogThreshold threshold);
+[[nodiscard]] std::optional<LogThreshold> parseLogThreshold(std::string_view name);
+
+/**
+ * @brief Per-category runtime levels
+ *
+ * Checked by the WEAR_LOG_* macros before any argument is evaluated.
+ * Every category starts at Debug so unconfigured builds log everything.
+ */
+class WeaR_LogFilter {
+public:
+    [[nodiscard]] static bool isEnabled(LogCategory category, LogLevel level) {
+        return getLogSeverity(level) >=
+               s_thresholds[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    static void setThreshold(LogCategory category, LogThreshold threshold) {
+        s_thresholds[static_cast<size_t>(category)].store(static_cast<uint8_t>(threshold),
+                                                          std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static LogThreshold getThreshold(LogCategory category) {
+        return static_cast<LogThreshold>(
+            s_thresholds[static_cast<size_t>(category)].load(std::memory_order_relaxed));
+    }
+
+private:
+    static inline std::atomic<uint8_t> s_thresholds[LOG_CATEGORY_COUNT] = {};
+};
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+namespace LogConfig {
+    constexpr size_t RECORD_SIZE = 512;         // Bytes per record (header + payload)
+    constexpr size_t RING_CAPACITY = 512;       // Records per producer thread (power of two)
+    constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(10);
+
+    // Rate limiting (WEAR_LOG_*_LIMITED)
+    constexpr auto LIMIT_WINDOW = std::chrono::seconds(1);
+    constexpr uint32_t LIMIT_BURST = 5;         // Identical lines per window before suppressing
+    constexpr uint32_t LIMIT_SITE_BURST = 50;   // Lines per call site per window
+    constexpr size_t LIMIT_SLOTS = 16;          // Distinct messages tracked per call site
+}
+
+// =============================================================================
+// BINARY RECORD
+// =============================================================================
+
+struct LogRecord;
+
+/**
+ * @brief Decodes a record's payload and appends the formatted message
+ */
+using LogFormatFn = void (*)(const LogRecord& record, std::string& out);
+
+struct LogRecord {
+    static constexpr size_t HEADER_SIZE = 40;
+    static constexpr size_t PAYLOAD_CAPACITY = LogConfig::RECORD_SIZE - HEADER_SIZE;
+
+    uint64_t timestampNs;           // system_clock, nanoseconds since epoch
+    LogFormatFn formatFn;
+    const char* format;             // Static format string (not owned)
+    uint32_t formatSize;
+    uint32_t threadId;
+    LogLevel level;
+    LogCategory category;
+    uint16_t payloadSize;
+    uint8_t truncated;              // Arguments did not fit; the message ends in "…"
+    uint8_t padding[3];
+    uint8_t payload[PAYLOAD_CAPACITY];
+};
+
+static_assert(sizeof(LogRecord) == LogConfig::RECORD_SIZE, "LogRecord size mismatch");
+
+namespace LogDetail {
+
+template<typename T>
+using Stored = std::remove_cvref_t<T>;
+
+/**
+ * @brief Strings are copied by value; everything else as raw bytes
+ */
+template<typename T>
+constexpr bool IS_STRING =
+    std::is_same_v<Stored<T>, std::string> ||
+    std::is_same_v<Stored<T>, std::string_view> ||
+    std::is_same_v<std::decay_t<T>, const char*> ||
+    std::is_same_v<std::decay_t<T>, char*>;
+
+template<typename T>
+using Decoded = std::conditional_t<IS_STRING<T>, std::string_view, Stored<T>>;
+
+/**
+ * @brief Sequential payload encoder
+ *
+ * Strings are stored as [u16 length][bytes] and truncated to the space left;
+ * values that no longer fit are skipped. PayloadReader applies the same rules,
+ * so both sides stay in sync even when a record overflows. Either case sets
+ * truncated(), and the formatted message is then marked with a trailing "…".
+ */
+class PayloadWriter {
+public:
+    PayloadWriter(uint8_t* data, size_t capacity) : m_data(data), m_capacity(capacity) {}
+
+    template<typename T>
+    void put(const T& value) {
+        if constexpr (IS_STRING<T>) {
+            putString(toView(value));
+        } else {
+            static_assert(std::is_trivially_copyable_v<Stored<T>>,
+                          "Log arguments must be strings or trivially copyable; pre-format other types");
+            if (m_pos + sizeof(Stored<T>) > m_capacity) {
+                m_truncated = true;
+                return;
+            }
+            std::memcpy(m_data + m_pos, &value, sizeof(Stored<T>));
+            m_pos += sizeof(Stored<T>);
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return m_pos; }
+    [[nodiscard]] bool truncated() const { return m_truncated; }
+
+private:
+    template<typename T>
+    static std::string_view toView(const T& value) {
+        if constexpr (std::is_pointer_v<std::decay_t<T>>) {
+            return value ? std::string_view(value) : std::string_view("(null)");
+        } else {
+            return std::string_view(value);
+        }
+    }
+
+    void putString(std::string_view text) {
+        if (m_pos + sizeof(uint16_t) > m_capacity) {
+            m_truncated = true;
+            return;
+        }
+        size_t length = std::min(text.size(), m_capacity - m_pos - sizeof(uint16_t));
+        m_truncated |= length < text.size();
+        uint16_t length16 = static_cast<uint16_t>(length);
+        std::memcpy(m_data + m_pos, &length16, sizeof(length16));
+        std::memcpy(m_data + m_pos + sizeof(length16), text.data(), length);
+        m_pos += sizeof(length16) + length;
+    }
+
+    uint8_t* m_data;
+    size_t m_capacity;
+    size_t m_pos = 0;
+    bool m_truncated = false;
+};
+
+class PayloadReader {
+public:
+    PayloadReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    template<typename T>
+    Decoded<T> get() {
+        if constexpr (IS_STRING<T>) {
+            if (m_pos + sizeof(uint16_t) > m_size) return {};
+            uint16_t length = 0;
+            std::memcpy(&length, m_data + m_pos, sizeof(length));
+            m_pos += sizeof(length);
+            std::string_view text(reinterpret_cast<const char*>(m_data + m_pos), length);
+            m_pos += length;
+            return text;
+        } else {
+            Stored<T> value{};
+            if (m_pos + sizeof(Stored<T>) > m_size) return value;
+            std::memcpy(&value, m_data + m_pos, sizeof(Stored<T>));
+            m_pos += sizeof(Stored<T>);
+            return value;
+        }
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+};
+
+/**
+ * @brief Decoder instantiated per argument-type list at each call site
+ */
+template<typename... Args>
+void formatRecord(const LogRecord& record, std::string& out) {
+    PayloadReader reader(record.payload, record.payloadSize);
+
+    // Braced init guarantees left-to-right decoding order
+    std::tuple<Decoded<Args>...> values{ reader.template get<Args>()... };
+
+    std::apply([&](auto&... decoded) {
+        std::vformat_to(std::back_inserter(out),
+                        std::string_view(record.format, record.formatSize),
+                        std::make_format_args(decoded...));
+    }, values);
+    if (record.truncated) {
+        out += "\u2026";
+    }
+}
+
+} // namespace LogDetail
+
+// =============================================================================
+// PER-THREAD RING
+// =============================================================================
+
+/**
+ * @brief Single-producer / single-consumer record ring
+ */
+class WeaR_LogRing {
+public:
+    explicit WeaR_LogRing(uint32_t threadId);
+
+    // Producer side
+    [[nodiscard]] LogRecord* tryAcquire();
+    void commit();
+    void noteDropped() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+
+    // Consumer side
+    [[nodiscard]] const LogRecord* peek() const;
+    void release();
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] size_t getPendingCount() const;
+    [[nodiscard]] uint64_t takeDropped() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+
+    [[nodiscard]] uint32_t getThreadId() const { return m_threadId; }
+
+private:
+    std::unique_ptr<LogRecord[]> m_slots;
+    uint32_t m_threadId;
+    alignas(64) std::atomic<uint64_t> m_head{0};    // Next slot to write (producer)
+    alignas(64) std::atomic<uint64_t> m_tail{0};    // Next slot to read (consumer)
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+// =============================================================================
+// RATE LIMITER
+// =============================================================================
+
+/**
+ * @brief Suppressed-message report handed to the logger thread
+ */
+struct LogSummary {
+    LogRecord sample;               // Last admitted occurrence (formatted for the report)
+    uint64_t count = 0;             // Occurrences suppressed
+    bool identical = true;          // false: call-site budget exceeded by differing messages
+};
+
+/**
+ * @brief Per-call-site deduplication and rate limiting
+ *
+ * Messages are keyed by call site (one limiter per site) and by a hash of
+ * the format string and the encoded arguments. Each key may log
+ * LIMIT_BURST times per LIMIT_WINDOW, and the site as a whole
+ * LIMIT_SITE_BURST times. Everything beyond that is only counted; the
+ * logger thread reports the counts once the window has passed.
+ */
+class WeaR_LogLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    WeaR_LogLimiter();
+    ~WeaR_LogLimiter();
+
+    WeaR_LogLimiter(const WeaR_LogLimiter&) = delete;
+    WeaR_LogLimiter& operator=(const WeaR_LogLimiter&) = delete;
+
+    /**
+     * @brief Decide whether an encoded record should be logged
+     */
+    [[nodiscard]] bool admit(const LogRecord& record);
+
+    /**
+     * @brief Move due reports into out (logger thread)
+     * @param force Report everything regardless of window (shutdown / flush)
+     */
+    void collectSummaries(std::vector<LogSummary>& out, bool force);
+
+private:
+    struct Slot {
+        bool used = false;
+        uint64_t hash = 0;
+        uint32_t admitted = 0;
+        uint64_t suppressed = 0;
+        Clock::time_point windowStart{};
+        LogRecord sample;
+    };
+
+    [[nodiscard]] Slot& findSlot(uint64_t hash, Clock::time_point now);
+    void retireSlot(Slot& slot);
+
+    std::mutex m_mutex;
+    std::unique_ptr<Slot[]> m_slots;
+    std::vector<LogSummary> m_pending;      // Reports from evicted slots
+
+    Clock::time_point m_windowStart{};
+    uint32_t m_siteAdmitted = 0;
+    uint64_t m_siteSuppressed = 0;
+    LogRecord m_siteSample;
+};
+
+// =============================================================================
+// SINKS
+// =============================================================================
+
+/**
+ * @brief A formatted log line as delivered to sinks
+ */
+struct LogLine {
+    uint64_t timestampNs = 0;
+    LogLevel level = LogLevel::Info;
+    LogCategory category = LogCategory::General;
+    uint32_t threadId = 0;
+    std::string_view message;       // Formatted message only
+    std::string_view text;          // "hh:mm:ss.zzz [TAG] [CATEGORY] message"
+};
+
+/**
+ * @brief Log output destination (called from the logger thread only)
+ */
+class WeaR_LogSink {
+public:
+    virtual ~WeaR_LogSink() = default;
+    virtual void write(const LogLine& line) = 0;
+    virtual void flush() {}
+};
+
+/**
+ * @brief Writes lines to stdout
+ */
+class WeaR_ConsoleLogSink final : public WeaR_LogSink {
+public:
+    void write(const LogLine& line) override;
+    void flush() override;
+};
+
+/**
+ * @brief Appends lines to a text file
+ */
+class WeaR_FileLogSink final : public WeaR_LogSink {
+public:
+    explicit WeaR_FileLogSink(const std::string& path);
+
+    [[nodiscard]] bool isOpen() const { return m_file.is_open(); }
+    void write(const LogLine& line) override;
+    void flush() override;
+
+private:
+    std::ofstream m_file;
+};
+
+// =============================================================================
+// ASYNC LOGGER
+// =============================================================================
+
+class WeaR_AsyncLogger {
+public:
+    WeaR_AsyncLogger();
+    ~WeaR_AsyncLogger();
+
+    WeaR_AsyncLogger(const WeaR_AsyncLogger&) = delete;
+    WeaR_AsyncLogger& operator=(const WeaR_AsyncLogger&) = delete;
+
+    /**
+     * @brief Record a message; formatting happens on the logger thread
+     *
+     * Never blocks. Arguments must be strings or trivially copyable.
+     */
+    template<typename... Args>
+    void log(LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
+        log(LogCategory::General, level, fmt, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Record a message for a category
+     *
+     * Does not consult WeaR_LogFilter; use the WEAR_LOG_* macros so that
+     * filtered messages skip argument evaluation as well.
+     */
+    template<typename... Args>
+    void log(LogCategory category, LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
+        WeaR_LogRing& ring = localRing();
+        LogRecord* record = ring.tryAcquire();
+        if (!record) {
+            ring.noteDropped();
+            return;
+        }
+
+        encode<Args...>(*record, category, level, fmt, args...);
+        commit(ring, *record);
+    }
+
+    /**
+     * @brief Record a message through a call-site rate limiter
+     *
+     * The record is encoded on the stack first so the limiter can key it
+     * by its arguments; suppressed occurrences never reach the ring.
+     */
+    template<typename... Args>
+    void logLimited(WeaR_LogLimiter& limiter, LogCategory category, LogLevel level,
+                    std::format_string<Args...> fmt, Args&&... args)
+    {
+        LogRecord record;
+        encode<Args...>(record, category, level, fmt, args...);
+        if (!limiter.admit(record)) {
+            return;
+        }
+
+        WeaR_LogRing& ring = localRing();
+        LogRecord* slot = ring.tryAcquire();
+        if (!slot) {
+            ring.noteDropped();
+            return;
+        }
+
+        std::memcpy(slot, &record, LogRecord::HEADER_SIZE + record.payloadSize);
+        commit(ring, *slot);
+    }
+
+    /**
+     * @brief Rate limiter registry (called by WeaR_LogLimiter)
+     */
+    void registerLimiter(WeaR_LogLimiter* limiter);
+    void unregisterLimiter(WeaR_LogLimiter* limiter);
+
+    /**
+     * @brief Register an output; the logger keeps a shared reference
+     */
+    void addSink(std::shared_ptr<WeaR_LogSink> sink);
+
+    /**
+     * @brief Unregister an output (waits for an in-progress write)
+     */
+    void removeSink(const WeaR_LogSink* sink);
+
+    /**
+     * @brief Format and deliver everything recorded so far (blocking)
+     */
+    void flush();
+
+    /**
+     * @brief fork() support: hold every logger lock across the fork so the
+     *        child never inherits one taken by the drain thread
+     *
+     * Call afterFork() in both processes. The child has no drain thread; it
+     * must flush() itself and leave with _exit() instead of destructors.
+     */
+    void beforeFork();
+    void afterFork();
+
+    /**
+     * @brief Statistics
+     */
+    [[nodiscard]] uint64_t getRecordsWritten() const { return m_recordsWritten.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t getRecordsDropped() const { return m_recordsDropped.load(std::memory_order_relaxed); }
+
+private:
+    template<typename... Args>
+    static void encode(LogRecord& record, LogCategory category, LogLevel level,
+                       std::format_string<Args...> fmt, const Args&... args)
+    {
+        const std::string_view format = fmt.get();
+        record.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        record.formatFn = &LogDetail::formatRecord<Args...>;
+        record.format = format.data();
+        record.formatSize = static_cast<uint32_t>(format.size());
+        record.level = level;
+        record.category = category;
+
+        LogDetail::PayloadWriter writer(record.payload, LogRecord::PAYLOAD_CAPACITY);
+        (writer.put(args), ...);
+        record.payloadSize = static_cast<uint16_t>(writer.size());
+        record.truncated = writer.truncated() ? 1 : 0;
+    }
+
+    void commit(WeaR_LogRing& ring, LogRecord& record) {
+        record.threadId = ring.getThreadId();
+        ring.commit();
+
+        // Wake the drain thread early for errors or when the ring fills up
+        if (record.level == LogLevel::Error || ring.getPendingCount() >= LogConfig::RING_CAPACITY / 2) {
+            m_wakeup.notify_one();
+        }
+    }
+
+    [[nodiscard]] WeaR_LogRing& localRing();
+    void threadMain();
+    bool drain(bool forceSummaries = false);   // Returns true if anything was delivered
+    void emitLine(uint64_t timestampNs, LogLevel level, LogCategory category, uint32_t threadId,
+                  std::string_view message);
+
+    std::vector<std::shared_ptr<WeaR_LogRing>> m_rings;
+    std::mutex m_ringsMutex;
+    std::atomic<uint32_t> m_nextThreadId{1};
+
+    std::vector<std::shared_ptr<WeaR_LogSink>> m_sinks;
+    std::mutex m_sinkMutex;
+
+    std::vector<WeaR_LogLimiter*> m_limiters;
+    std::mutex m_limitersMutex;
+    std::chrono::steady_clock::time_point m_lastSummaryCheck{};
+    std::vector<LogSummary> m_summaries;    // Scratch (drain thread)
+
+    std::mutex m_drainMutex;            // Serialises consumers (thread + flush)
+    std::mutex m_wakeupMutex;
+    std::condition_variable m_wakeup;
+    std::atomic<bool> m_running{true};
+    std::thread m_thread;
+
+    std::string m_message;              // Formatting scratch (drain thread)
+    std::string m_text;
+
+    std::atomic<uint64_t> m_recordsWritten{0};
+    std::atomic<uint64_t> m_recordsDropped{0};
+};
+
+/**
+ * @brief Get global asynchronous logger
+ */
+WeaR_AsyncLogger& getAsyncLogger();
+
+} // namespace WeaR
+
+// =============================================================================
+// LOGGING MACROS
+// =============================================================================
+
+/**
+ * Build-time floor (0 = Debug, 1 = Info, 2 = Warning, 3 = Error). Calls
+ * below it are discarded by the compiler, arguments included. Set through
+ * the WEAR_LOG_MIN_LEVEL CMake option.
+ */
+#ifndef WEAR_LOG_MIN_SEVERITY
+#define WEAR_LOG_MIN_SEVERITY 0
+#endif
+
+/**
+ * Above the floor, the category's runtime threshold is checked before the
+ * arguments are evaluated, so a disabled message costs one relaxed load.
+ */
+#define WEAR_LOG(category, level, ...)                                              \
+    do {                                                                            \
+        if constexpr (::WeaR::getLogSeverity(level) >= WEAR_LOG_MIN_SEVERITY) {     \
+            if (::WeaR::WeaR_LogFilter::isEnabled(category, level)) {               \
+                ::WeaR::getAsyncLogger().log(category, level, __VA_ARGS__);         \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
+/**
+ * Rate-limited variant for hot paths (unknown opcodes, unimplemented
+ * syscalls). Each expansion owns a WeaR_LogLimiter.
+ */
+#define WEAR_LOG_LIMITED(category, level, ...)                                      \
+    do {                                                                            \
+        if constexpr (::WeaR::getLogSeverity(level) >= WEAR_LOG_MIN_SEVERITY) {     \
+            if (::WeaR::WeaR_LogFilter::isEnabled(category, level)) {               \
+                static ::WeaR::WeaR_LogLimiter wearLogLimiter;                      \
+                ::WeaR::getAsyncLogger().logLimited(wearLogLimiter, category, level, \
+                                                    __VA_ARGS__);                   \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
+#define WEAR_LOG_TRACE(category, ...) WEAR_LOG(category, ::WeaR::LogLevel::Syscall, __VA_ARGS__)
+#define WEAR_LOG_DEBUG(category, ...) WEAR_LOG(category, ::WeaR::LogLevel::Debug, __VA_ARGS__)
+#define WEAR_LOG_INFO(category, ...)  WEAR_LOG(category, ::WeaR::LogLevel::Info, __VA_ARGS__)
+#define WEAR_LOG_WARN(category, ...)  WEAR_LOG(category, ::WeaR::LogLevel::Warning, __VA_ARGS__)
+#define WEAR_LOG_ERROR(category, ...) WEAR_LOG(category, ::WeaR::LogLevel::Error, __VA_ARGS__)
+
+#define WEAR_LOG_DEBUG_LIMITED(category, ...) WEAR_LOG_LIMITED(category, ::WeaR::LogLevel::Debug, __VA_ARGS__)
+#define WEAR_LOG_WARN_LIMITED(category, ...)  WEAR_LOG_LIMITED(category, ::WeaR::LogLevel::Warning, __VA_ARGS__)
+#define WEAR_LOG_ERROR_LIMITED(category, ...) WEAR_LOG_LIMITED(category, ::WeaR::LogLevel::Error, __VA_ARGS__)
@@ -1,13 +1,15 @@
 #include "WeaR_Memory.h"
+#include "WeaR_Log.h"
 
 #include <cstring>
-#include <iostream>
 #include <format>
 
 #ifdef _WIN32
 #include <Windows.h>
 #else
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
@@ -53,7 +55,7 @@ void WeaR_Memory::allocateMemory() {
 
     const size_t size = PS4Memory::MEMORY_SIZE;
     
-    std::cout << std::format("[Memory] Allocating {} GB unified memory...\n", size / (1024 * 1024 * 1024));
+    WEAR_LOG_INFO(LogCategory::General, "Allocating {} GB unified memory", size / (1024 * 1024 * 1024));
 
 #ifdef _WIN32
     // Windows: Use VirtualAlloc for large aligned allocation
@@ -66,17 +68,17 @@ void WeaR_Memory::allocateMemory() {
 
     if (!m_memory) {
         DWORD error = GetLastError();
-        std::cerr << std::format("[Memory] VirtualAlloc failed with error: {}\n", error);
+        WEAR_LOG_ERROR(LogCategory::General, "VirtualAlloc failed with error: {}", error);
         
         // Fallback: try smaller allocation for development
         const size_t fallbackSize = 512 * 1024 * 1024;  // 512 MB
-        std::cout << "[Memory] Trying fallback allocation of 512 MB...\n";
+        WEAR_LOG_WARN(LogCategory::General, "Trying fallback allocation of 512 MB");
         
         m_memory = static_cast<uint8_t*>(VirtualAlloc(
             nullptr, fallbackSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
         
         if (m_memory) {
-            std::cout << "[Memory] Fallback allocation successful (limited mode)\n";
+            WEAR_LOG_WARN(LogCategory::General, "Fallback allocation successful (limited mode)");
         }
     }
 #else
@@ -91,14 +93,14 @@ void WeaR_Memory::allocateMemory() {
 
     if (m_memory == MAP_FAILED) {
         m_memory = nullptr;
-        std::cerr << "[Memory] mmap failed\n";
+        WEAR_LOG_ERROR(LogCategory::General, "Unified memory mmap failed");
     }
 #endif
 
     if (m_memory) {
         m_ownsMemory = true;
-        std::cout << std::format("[Memory] Allocated at address: 0x{:016X}\n", 
-                                  reinterpret_cast<uintptr_t>(m_memory));
+        WEAR_LOG_INFO(LogCategory::General, "Unified memory allocated at 0x{:016X}",
+                      reinterpret_cast<uintptr_t>(m_memory));
     } else {
         throw std::runtime_error("Failed to allocate PS4 unified memory");
     }
@@ -107,7 +109,7 @@ void WeaR_Memory::allocateMemory() {
 void WeaR_Memory::freeMemory() {
     if (!m_memory || !m_ownsMemory) return;
 
-    std::cout << "[Memory] Freeing unified memory...\n";
+    WEAR_LOG_DEBUG(LogCategory::General, "Freeing unified memory");
 
 #ifdef _WIN32
     VirtualFree(m_memory, 0, MEM_RELEASE);
@@ -119,6 +121,102 @@ void WeaR_Memory::freeMemory() {
     m_ownsMemory = false;
 }
 
+// =============================================================================
+// SHARED FILE MAPPINGS
+// =============================================================================
+
+size_t WeaR_Memory::hostPageSize() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return pageSize;
+#endif
+}
+
+#ifndef _WIN32
+namespace {
+
+FileStamp stampOf(const struct stat& info) {
+#ifdef __APPLE__
+    const struct timespec& modified = info.st_mtimespec;
+#else
+    const struct timespec& modified = info.st_mtim;
+#endif
+    return { static_cast<uint64_t>(info.st_size),
+             static_cast<int64_t>(modified.tv_sec) * 1'000'000'000 + modified.tv_nsec };
+}
+
+} // anonymous namespace
+#endif
+
+std::optional<FileStamp> WeaR_Memory::getFileStamp(const std::filesystem::path& path) {
+#ifdef _WIN32
+    (void)path;
+    return std::nullopt;
+#else
+    struct stat info{};
+    if (stat(path.c_str(), &info) != 0) return std::nullopt;
+    return stampOf(info);
+#endif
+}
+
+bool WeaR_Memory::mapFileShared(uint64_t virtualAddress, const std::filesystem::path& path,
+                                uint64_t fileOffset, size_t size, const FileStamp& expected)
+{
+#ifdef _WIN32
+    // The arena is one committed VirtualAlloc; a view can only replace part
+    // of it with placeholder reservations (VirtualAlloc2), which it does not use
+    (void)virtualAddress; (void)path; (void)fileOffset; (void)size; (void)expected;
+    return false;
+#else
+    const size_t pageSize = hostPageSize();
+    if (!m_memory || size == 0 || !isValidAddress(virtualAddress, size)) return false;
+
+    const uint64_t physicalAddr = translateAddress(virtualAddress);
+    if (physicalAddr % pageSize != 0 || fileOffset % pageSize != 0 || size % pageSize != 0) {
+        return false;
+    }
+
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    // A range past the end of the file would fault on first touch
+    struct stat before{};
+    if (fstat(fd, &before) != 0 || stampOf(before) != expected || fileOffset + size > expected.size) {
+        close(fd);
+        return false;
+    }
+
+    // Writable so guest and loader writes still work; MAP_PRIVATE turns
+    // each written page into a private copy and leaves the file alone
+    uint8_t* target = m_memory + physicalAddr;
+    void* mapped = mmap(target, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE, fd, static_cast<off_t>(fileOffset));
+
+    // Written between the caller's read and the mmap: the pages may not
+    // match what the caller parsed
+    struct stat after{};
+    const bool unchanged = fstat(fd, &after) == 0 && stampOf(after) == expected;
+    close(fd);
+
+    if (mapped != MAP_FAILED && unchanged) {
+        return true;
+    }
+
+    // MAP_FIXED may have dropped the old pages already; put zeroed ones back
+    if (mmap(target, size, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE, -1, 0) == MAP_FAILED) {
+        WEAR_LOG_ERROR(LogCategory::General, "Cannot restore guest pages at 0x{:X} after a failed file mapping",
+                       virtualAddress);
+        throw std::runtime_error("Guest memory lost after a failed file mapping");
+    }
+    return false;
+#endif
+}
+
 // =============================================================================
 // ADDRESS TRANSLATION
 // =============================================================================
@@ -9,6 +9,8 @@
  */
 
 #include <cstdint>
+#include <filesystem>
+#include <optional>
 #include <string>
 #include <stdexcept>
 #include <type_traits>
@@ -104,6 +106,16 @@ private:
 // WEAR_MEMORY CLASS
 // =============================================================================
 
+/**
+ * @brief Identity of a file's contents for shared mappings
+ */
+struct FileStamp {
+    uint64_t size = 0;
+    int64_t modifiedNs = 0;
+
+    bool operator==(const FileStamp&) const = default;
+};
+
 /**
  * @brief PS4 unified memory simulation
  * 
@@ -236,6 +248,43 @@ public:
      */
     [[nodiscard]] bool isValidAddress(uint64_t virtualAddress, size_t size = 1) const;
 
+    // =========================================================================
+    // SHARED FILE MAPPINGS
+    // =========================================================================
+
+    /**
+     * @brief Map a file range over guest memory, private copy-on-write
+     *
+     * The pages come from the host page cache, so every instance and every
+     * process mapping the same file shares one copy until a page is written
+     * (relocations, patches); only that page is then copied. The file must
+     * not be modified or truncated while it is mapped.
+     *
+     * @param virtualAddress Guest address, host-page aligned
+     * @param path File to map
+     * @param fileOffset Offset in the file, host-page aligned
+     * @param size Bytes, a multiple of the host page size
+     * @param expected Stamp taken when the caller read the file; the mapping
+     *        is dropped if the file no longer matches it once mapped
+     * @return false if the platform or the arguments do not allow it, or the
+     *         file changed; the caller then copies the data instead
+     * @throws std::runtime_error if the range could not be restored after a
+     *         failed mapping
+     */
+    bool mapFileShared(uint64_t virtualAddress, const std::filesystem::path& path,
+                       uint64_t fileOffset, size_t size, const FileStamp& expected);
+
+    /**
+     * @brief Size and modification time of a file, for mapFileShared()
+     * @return std::nullopt if it cannot be read or the platform cannot map files
+     */
+    [[nodiscard]] static std::optional<FileStamp> getFileStamp(const std::filesystem::path& path);
+
+    /**
+     * @brief Host page size (granularity of mapFileShared)
+     */
+    [[nodiscard]] static size_t hostPageSize();
+
 private:
     void validateAccess(uint64_t physicalAddr, size_t size) const;
     void allocateMemory();
@@ -0,0 +1,429 @@
+#include "WeaR_Metrics.h"
+#include "WeaR_Log.h"
+#include "WeaR_Cpu.h"
+#include "WeaR_EmulatorCore.h"
+#include "WeaR_EmulationContext.h"
+#include "WeaR_JobSystem.h"
+#include "WeaR_ThreadRoles.h"
+#include "HLE/WeaR_Syscalls.h"
+#include "HLE/Graphics/WeaR_GnmDriver.h"
+#include "HLE/FileSystem/WeaR_VFS.h"
+#include "Audio/WeaR_AudioManager.h"
+#include "Graphics/WeaR_RenderQueue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/select.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace WeaR {
+
+namespace {
+
+// Upper bound on select() so stop() is noticed promptly
+constexpr auto POLL_INTERVAL = std::chrono::milliseconds(200);
+constexpr size_t MAX_REQUEST_SIZE = 4096;
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+constexpr SocketHandle BAD_SOCKET = INVALID_SOCKET;
+void closeSocket(SocketHandle s) { closesocket(s); }
+void releaseSockets() { WSACleanup(); }     // Pairs with WSAStartup in start()
+#else
+using SocketHandle = int;
+constexpr SocketHandle BAD_SOCKET = -1;
+void closeSocket(SocketHandle s) { ::close(s); }
+void releaseSockets() {}
+#endif
+
+SocketHandle toHandle(intptr_t s) { return static_cast<SocketHandle>(s); }
+
+bool sendAll(SocketHandle s, std::string_view data) {
+    while (!data.empty()) {
+        const int chunk = static_cast<int>(std::min<size_t>(data.size(), 1 << 20));
+        const auto sent = ::send(s, data.data(), chunk, 0);
+        if (sent <= 0) return false;
+        data.remove_prefix(static_cast<size_t>(sent));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// HISTOGRAM
+// =============================================================================
+
+WeaR_Histogram::WeaR_Histogram(std::vector<double> bounds)
+    : m_bounds(std::move(bounds))
+{
+    if (m_bounds.size() > MAX_BUCKETS) {
+        m_bounds.resize(MAX_BUCKETS);
+    }
+}
+
+void WeaR_Histogram::observe(double value) {
+    size_t bucket = static_cast<size_t>(
+        std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin());
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_sumMicros.fetch_add(static_cast<uint64_t>(std::max(value, 0.0) * 1e6), std::memory_order_relaxed);
+}
+
+WeaR_Histogram::Snapshot WeaR_Histogram::snapshot() const {
+    Snapshot snap;
+    snap.bounds = m_bounds;
+    snap.cumulative.resize(m_bounds.size() + 1);
+
+    uint64_t running = 0;
+    for (size_t i = 0; i <= m_bounds.size(); ++i) {
+        running += m_buckets[i].load(std::memory_order_relaxed);
+        snap.cumulative[i] = running;
+    }
+
+    // Count is the +Inf bucket so the document stays self-consistent
+    snap.count = running;
+    snap.sum = static_cast<double>(m_sumMicros.load(std::memory_order_relaxed)) / 1e6;
+    return snap;
+}
+
+// =============================================================================
+// TEXT WRITER
+// =============================================================================
+
+void WeaR_MetricsWriter::header(std::string_view name, std::string_view help, std::string_view type) {
+    m_text += std::format("# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+}
+
+void WeaR_MetricsWriter::counter(std::string_view name, std::string_view help, uint64_t value) {
+    header(name, help, "counter");
+    m_text += std::format("{} {}\n", name, value);
+}
+
+void WeaR_MetricsWriter::counter(std::string_view name, std::string_view help, double value) {
+    header(name, help, "counter");
+    m_text += std::format("{} {}\n", name, value);
+}
+
+void WeaR_MetricsWriter::gauge(std::string_view name, std::string_view help, double value) {
+    header(name, help, "gauge");
+    m_text += std::format("{} {}\n", name, value);
+}
+
+void WeaR_MetricsWriter::gauge(std::string_view name, std::string_view help, std::string_view label,
+                               const std::vector<std::pair<std::string_view, double>>& samples)
+{
+    header(name, help, "gauge");
+    for (const auto& [labelValue, value] : samples) {
+        m_text += std::format("{}{{{}=\"{}\"}} {}\n", name, label, labelValue, value);
+    }
+}
+
+void WeaR_MetricsWriter::histogram(std::string_view name, std::string_view help,
+                                   const WeaR_Histogram::Snapshot& snapshot)
+{
+    header(name, help, "histogram");
+    for (size_t i = 0; i < snapshot.bounds.size(); ++i) {
+        m_text += std::format("{}_bucket{{le=\"{}\"}} {}\n", name, snapshot.bounds[i], snapshot.cumulative[i]);
+    }
+    m_text += std::format("{}_bucket{{le=\"+Inf\"}} {}\n", name, snapshot.count);
+    m_text += std::format("{}_sum {}\n{}_count {}\n", name, snapshot.sum, name, snapshot.count);
+}
+
+// =============================================================================
+// COLLECTORS
+// =============================================================================
+
+void collectCoreMetrics(WeaR_MetricsWriter& writer, const WeaR_EmulationContext& context) {
+    const auto& core = context.getCore();
+    const WeaR_Cpu* cpu = core.getCpu();
+
+    writer.gauge("wear_emulator_running", "1 while the emulator is running a title",
+                 core.getState() == EmuState::Running ? 1.0 : 0.0);
+    writer.counter("wear_cpu_instructions_total", "Guest instructions executed",
+                   cpu ? cpu->getInstructionCount() : 0);
+    const CpuIdleStats idle = cpu ? cpu->getIdleStats() : CpuIdleStats{};
+    writer.counter("wear_cpu_idle_waits_total", "Times the CPU slept in a guest idle or spin loop", idle.waits);
+    writer.counter("wear_cpu_idle_seconds_total", "Time the CPU slept in guest idle or spin loops",
+                   static_cast<double>(idle.waitNs) / 1e9);
+    writer.counter("wear_cpu_skipped_instructions_total",
+                   "Idle-loop instructions counted toward a limit without running them",
+                   idle.skippedInstructions);
+
+    const auto& syscalls = context.getSyscalls();
+    writer.counter("wear_syscalls_total", "Guest syscalls dispatched", syscalls.getTotalCalls());
+    writer.counter("wear_syscalls_unimplemented_total", "Guest syscalls without an HLE handler",
+                   syscalls.getUnimplementedCalls());
+
+    const auto& gnm = context.getGnmDriver();
+    writer.counter("wear_pm4_packets_total", "PM4 packets processed", gnm.getPacketsProcessed());
+    writer.counter("wear_draw_calls_total", "Draw calls queued by the GNM driver", gnm.getDrawCallsQueued());
+
+    const auto& vfs = context.getVfs();
+    writer.counter("wear_vfs_read_bytes_total", "Bytes read through the VFS", vfs.getTotalBytesRead());
+    writer.counter("wear_vfs_written_bytes_total", "Bytes written through the VFS", vfs.getTotalBytesWritten());
+    writer.gauge("wear_vfs_open_files", "Open VFS file handles", static_cast<double>(vfs.getOpenFileCount()));
+
+    const auto& audio = context.getAudio();
+    writer.counter("wear_audio_frames_total", "Audio frames output", audio.getTotalFramesOutput());
+    writer.gauge("wear_audio_open_ports", "Open audio ports", static_cast<double>(audio.getOpenPortCount()));
+
+    const auto& queue = context.getRenderQueue();
+    writer.counter("wear_render_queue_pushed_total", "Render commands pushed", queue.getTotalPushed());
+    writer.counter("wear_render_queue_popped_total", "Render commands consumed", queue.getTotalPopped());
+    writer.gauge("wear_render_queue_depth", "Render commands pending", static_cast<double>(queue.size()));
+}
+
+void collectHostMetrics(WeaR_MetricsWriter& writer) {
+    const auto& logger = getAsyncLogger();
+    writer.counter("wear_log_records_dropped_total", "Log records dropped on full rings",
+                   logger.getRecordsDropped());
+
+    const JobSystemStats jobs = getJobSystem().getStats();
+    writer.counter("wear_jobs_submitted_total", "Jobs submitted to the job system", jobs.submitted);
+    writer.counter("wear_jobs_executed_total", "Jobs run to completion", jobs.executed);
+    writer.counter("wear_jobs_stolen_total", "Jobs taken from another worker's deque", jobs.stolen);
+    std::vector<std::pair<std::string_view, double>> queued;
+    for (size_t i = 0; i < JOB_PRIORITY_COUNT; ++i) {
+        queued.emplace_back(getJobPriorityName(static_cast<JobPriority>(i)),
+                            static_cast<double>(jobs.queued[i]));
+    }
+    writer.gauge("wear_jobs_queued", "Jobs waiting to run, per priority", "priority", queued);
+}
+
+// =============================================================================
+// EXPORTER
+// =============================================================================
+
+WeaR_MetricsExporter& getMetricsExporter() {
+    static WeaR_MetricsExporter instance;
+    return instance;
+}
+
+WeaR_MetricsExporter::~WeaR_MetricsExporter() {
+    stop();
+}
+
+WeaR_MetricsExporter::CollectorId WeaR_MetricsExporter::addCollector(MetricsCollector collector) {
+    std::lock_guard<std::mutex> lock(m_collectorMutex);
+    const CollectorId id = m_nextId++;
+    m_collectors.push_back({ id, std::move(collector) });
+    return id;
+}
+
+void WeaR_MetricsExporter::removeCollector(CollectorId id) {
+    std::lock_guard<std::mutex> lock(m_collectorMutex);
+    std::erase_if(m_collectors, [id](const Entry& entry) { return entry.id == id; });
+}
+
+std::string WeaR_MetricsExporter::render() const {
+    WeaR_MetricsWriter writer;
+    std::lock_guard<std::mutex> lock(m_collectorMutex);
+    for (const Entry& entry : m_collectors) {
+        entry.collector(writer);
+    }
+    return writer.text();
+}
+
+std::expected<void, std::string> WeaR_MetricsExporter::start(const MetricsConfig& config) {
+    stop();
+    if (!config.isEnabled()) {
+        return {};
+    }
+
+    m_config = config;
+
+    if (config.httpPort != 0) {
+#ifdef _WIN32
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            return std::unexpected("WSAStartup failed");
+        }
+#endif
+        SocketHandle s = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (s == BAD_SOCKET) {
+            releaseSockets();
+            return std::unexpected("Cannot create metrics socket");
+        }
+
+        int reuse = 1;
+        ::setsockopt(s, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(config.httpPort);
+        if (::inet_pton(AF_INET, config.bindAddress.c_str(), &addr.sin_addr) != 1) {
+            closeSocket(s);
+            releaseSockets();
+            return std::unexpected(std::format("Invalid metrics bind address '{}'", config.bindAddress));
+        }
+
+        if (::bind(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(s, 8) != 0) {
+            closeSocket(s);
+            releaseSockets();
+            return std::unexpected(std::format("Cannot listen on {}:{}", config.bindAddress, config.httpPort));
+        }
+        m_listenSocket = static_cast<intptr_t>(s);
+        WEAR_LOG_INFO(LogCategory::General, "Metrics served at http://{}:{}/metrics",
+                      config.bindAddress, config.httpPort);
+    }
+
+    if (!config.filePath.empty()) {
+        WEAR_LOG_INFO(LogCategory::General, "Metrics written to {} every {} ms",
+                      config.filePath, config.fileInterval.count());
+    }
+
+    m_running.store(true);
+    m_thread = std::thread([this]() { threadMain(); });
+    return {};
+}
+
+void WeaR_MetricsExporter::stop() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    m_wakeup.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    if (m_listenSocket != -1) {
+        closeSocket(toHandle(m_listenSocket));
+        m_listenSocket = -1;
+        releaseSockets();
+    }
+
+    // Final values for soak runs that end between intervals
+    if (!m_config.filePath.empty()) {
+        (void)writeFile();
+    }
+}
+
+void WeaR_MetricsExporter::threadMain() {
+    ScopedThreadRole threadRole(ThreadRole::Service, "Metrics");
+    using Clock = std::chrono::steady_clock;
+    const bool fileOutput = !m_config.filePath.empty();
+    const auto interval = std::max(m_config.fileInterval, std::chrono::milliseconds(100));
+    auto nextWrite = Clock::now();
+
+    while (m_running.load()) {
+        if (fileOutput && Clock::now() >= nextWrite) {
+            (void)writeFile();
+            nextWrite += interval;
+            if (nextWrite < Clock::now()) {
+                nextWrite = Clock::now() + interval;    // Fell behind; do not burst
+            }
+        }
+
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(POLL_INTERVAL);
+        if (fileOutput) {
+            wait = std::min(wait, std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::max(nextWrite - Clock::now(), Clock::duration::zero())));
+        }
+
+        if (m_listenSocket == -1) {
+            std::unique_lock<std::mutex> lock(m_wakeupMutex);
+            m_wakeup.wait_for(lock, wait, [this]() { return !m_running.load(); });
+            continue;
+        }
+
+        const SocketHandle listener = toHandle(m_listenSocket);
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(listener, &readSet);
+        timeval timeout{};
+        timeout.tv_sec = static_cast<long>(wait.count() / 1000);
+        timeout.tv_usec = static_cast<long>((wait.count() % 1000) * 1000);
+
+        if (::select(static_cast<int>(listener) + 1, &readSet, nullptr, nullptr, &timeout) > 0) {
+            SocketHandle client = ::accept(listener, nullptr, nullptr);
+            if (client != BAD_SOCKET) {
+                serveClient(static_cast<intptr_t>(client));
+            }
+        }
+    }
+}
+
+void WeaR_MetricsExporter::serveClient(intptr_t clientHandle) {
+    const SocketHandle client = toHandle(clientHandle);
+
+    // A stalled client must not hold up the file output
+#ifdef _WIN32
+    DWORD timeoutMs = 1000;
+    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeoutMs), sizeof(timeoutMs));
+    ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeoutMs), sizeof(timeoutMs));
+#else
+    timeval timeout{1, 0};
+    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#endif
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE) {
+        const auto received = ::recv(client, buffer, static_cast<int>(sizeof(buffer)), 0);
+        if (received <= 0) break;
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    std::string_view line(request);
+    line = line.substr(0, line.find("\r\n"));
+
+    std::string status = "200 OK";
+    std::string body;
+    if (!line.starts_with("GET ")) {
+        status = "405 Method Not Allowed";
+    } else if (line.starts_with("GET /metrics ") || line.starts_with("GET / ")) {
+        body = render();
+    } else {
+        status = "404 Not Found";
+    }
+
+    std::string response = std::format(
+        "HTTP/1.1 {}\r\n"
+        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        "Content-Length: {}\r\n"
+        "Connection: close\r\n\r\n",
+        status, body.size());
+    response += body;
+    (void)sendAll(client, response);
+    closeSocket(client);
+}
+
+bool WeaR_MetricsExporter::writeFile() const {
+    // Write then rename so readers never see a partial document
+    const std::filesystem::path path(m_config.filePath);
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+
+    {
+        std::ofstream file(temp, std::ios::trunc | std::ios::binary);
+        if (!file || !(file << render())) {
+            WEAR_LOG_WARN_LIMITED(LogCategory::General, "Cannot write metrics file {}", temp.string());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        WEAR_LOG_WARN_LIMITED(LogCategory::General, "Cannot replace metrics file {}: {}",
+                              path.string(), ec.message());
+        return false;
+    }
+    return true;
+}
+
+} // namespace WeaR
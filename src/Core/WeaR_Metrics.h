@@ -0,0 +1,182 @@
+#pragma once
+
+/**
+ * @file WeaR_Metrics.h
+ * @brief Emulator counters in Prometheus text exposition format
+ *
+ * Subsystems keep their own counters; collectors read them when an export
+ * is produced, so nothing is added to the hot paths. Exports are served to
+ * scrapers from a loopback HTTP listener (GET /metrics) and/or written to a
+ * file at a fixed interval (atomically replaced, suitable for the
+ * node_exporter textfile collector).
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace WeaR {
+
+class WeaR_EmulationContext;
+
+// =============================================================================
+// HISTOGRAM
+// =============================================================================
+
+/**
+ * @brief Lock-free fixed-bucket histogram (one writer or many)
+ */
+class WeaR_Histogram {
+public:
+    static constexpr size_t MAX_BUCKETS = 16;
+
+    struct Snapshot {
+        std::vector<double> bounds;             // Upper bounds, ascending (+Inf implied)
+        std::vector<uint64_t> cumulative;       // bounds.size() + 1 entries
+        double sum = 0.0;
+        uint64_t count = 0;
+    };
+
+    /**
+     * @param bounds Bucket upper bounds in ascending order (at most MAX_BUCKETS)
+     */
+    explicit WeaR_Histogram(std::vector<double> bounds);
+
+    void observe(double value);
+    [[nodiscard]] Snapshot snapshot() const;
+
+private:
+    std::vector<double> m_bounds;
+    std::array<std::atomic<uint64_t>, MAX_BUCKETS + 1> m_buckets{};
+    std::atomic<uint64_t> m_sumMicros{0};       // Sum scaled by 1e6 to stay integral
+};
+
+// =============================================================================
+// TEXT WRITER
+// =============================================================================
+
+/**
+ * @brief Builds one exposition document (HELP/TYPE headers plus samples)
+ */
+class WeaR_MetricsWriter {
+public:
+    void counter(std::string_view name, std::string_view help, uint64_t value);
+    void counter(std::string_view name, std::string_view help, double value);  // e.g. "_seconds_total"
+    void gauge(std::string_view name, std::string_view help, double value);
+
+    /**
+     * @brief One gauge with a sample per value of label, e.g. name{priority="io"}
+     */
+    void gauge(std::string_view name, std::string_view help, std::string_view label,
+               const std::vector<std::pair<std::string_view, double>>& samples);
+    void histogram(std::string_view name, std::string_view help, const WeaR_Histogram::Snapshot& snapshot);
+
+    [[nodiscard]] const std::string& text() const { return m_text; }
+
+private:
+    void header(std::string_view name, std::string_view help, std::string_view type);
+
+    std::string m_text;
+};
+
+using MetricsCollector = std::function<void(WeaR_MetricsWriter&)>;
+
+/**
+ * @brief Counters of one emulation context (CPU, syscalls, PM4, VFS, audio,
+ *        render queue); register at most one context per exporter
+ */
+void collectCoreMetrics(WeaR_MetricsWriter& writer, const WeaR_EmulationContext& context);
+
+/**
+ * @brief Process-wide counters (logger, job system)
+ */
+void collectHostMetrics(WeaR_MetricsWriter& writer);
+
+// =============================================================================
+// EXPORTER
+// =============================================================================
+
+struct MetricsConfig {
+    uint16_t httpPort = 0;                          // 0 = no listener
+    std::string bindAddress = "127.0.0.1";
+    std::string filePath;                           // Empty = no file output
+    std::chrono::milliseconds fileInterval{5000};
+
+    [[nodiscard]] bool isEnabled() const { return httpPort != 0 || !filePath.empty(); }
+};
+
+class WeaR_MetricsExporter {
+public:
+    using CollectorId = uint32_t;
+
+    WeaR_MetricsExporter() = default;
+    ~WeaR_MetricsExporter();
+
+    WeaR_MetricsExporter(const WeaR_MetricsExporter&) = delete;
+    WeaR_MetricsExporter& operator=(const WeaR_MetricsExporter&) = delete;
+
+    /**
+     * @brief Register a collector; it runs on the exporter thread
+     */
+    CollectorId addCollector(MetricsCollector collector);
+
+    /**
+     * @brief Unregister a collector (waits for an in-progress collection)
+     */
+    void removeCollector(CollectorId id);
+
+    /**
+     * @brief Start serving/writing; restarts if already running
+     */
+    std::expected<void, std::string> start(const MetricsConfig& config);
+
+    /**
+     * @brief Stop the exporter thread (the file receives a final update)
+     */
+    void stop();
+
+    [[nodiscard]] bool isRunning() const { return m_running.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Run every collector and return the exposition text
+     */
+    [[nodiscard]] std::string render() const;
+
+private:
+    struct Entry {
+        CollectorId id;
+        MetricsCollector collector;
+    };
+
+    void threadMain();
+    void serveClient(intptr_t client);
+    bool writeFile() const;
+
+    mutable std::mutex m_collectorMutex;
+    std::vector<Entry> m_collectors;
+    CollectorId m_nextId = 1;
+
+    MetricsConfig m_config;
+    intptr_t m_listenSocket = -1;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::mutex m_wakeupMutex;
+    std::condition_variable m_wakeup;
+};
+
+/**
+ * @brief Get global metrics exporter
+ */
+WeaR_MetricsExporter& getMetricsExporter();
+
+} // namespace WeaR
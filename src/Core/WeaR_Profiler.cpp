@@ -0,0 +1,272 @@
+#include "WeaR_Profiler.h"
+#include "WeaR_Cpu.h"
+#include "WeaR_Memory.h"
+#include "WeaR_Log.h"
+#include "WeaR_ThreadRoles.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <unordered_map>
+
+namespace WeaR {
+
+// =============================================================================
+// GUEST SYMBOLS
+// =============================================================================
+
+WeaR_GuestSymbols::WeaR_GuestSymbols(const ElfLoadResult& image)
+    : m_symbols(image.symbols)
+    , m_sections(image.codeSections)
+{
+    for (const LoadedSegment& segment : image.segments) {
+        if (segment.flags & Elf64::PF_X) {
+            m_code.emplace_back(segment.virtualAddress, segment.virtualAddress + segment.memorySize);
+        }
+    }
+}
+
+const ElfSymbol* WeaR_GuestSymbols::findSymbol(uint64_t address) const {
+    auto next = std::ranges::upper_bound(m_symbols, address, {}, &ElfSymbol::address);
+    if (next == m_symbols.begin()) return nullptr;
+    const ElfSymbol& symbol = *std::prev(next);
+    if (symbol.size != 0) {
+        return address < symbol.address + symbol.size ? &symbol : nullptr;
+    }
+    // No size recorded: assume it runs to the next symbol
+    return (next == m_symbols.end() || address < next->address) ? &symbol : nullptr;
+}
+
+const ElfSection* WeaR_GuestSymbols::findSection(uint64_t address) const {
+    auto next = std::ranges::upper_bound(m_sections, address, {}, &ElfSection::address);
+    if (next == m_sections.begin()) return nullptr;
+    const ElfSection& section = *std::prev(next);
+    return address < section.address + section.size ? &section : nullptr;
+}
+
+uint64_t WeaR_GuestSymbols::functionStart(uint64_t address) const {
+    if (const ElfSymbol* symbol = findSymbol(address)) {
+        return symbol->address;
+    }
+    // Stripped: one frame per code section, else per executable segment,
+    // so distinct keys stay bounded by the image layout
+    if (const ElfSection* section = findSection(address)) {
+        return section->address;
+    }
+    auto segment = std::ranges::find_if(m_code, [address](const auto& range) {
+        return address >= range.first && address < range.second;
+    });
+    return segment != m_code.end() ? segment->first : address;
+}
+
+std::string WeaR_GuestSymbols::describe(uint64_t address) const {
+    if (const ElfSymbol* symbol = findSymbol(address)) {
+        return address == symbol->address
+            ? symbol->name : std::format("{}+0x{:X}", symbol->name, address - symbol->address);
+    }
+    if (const ElfSection* section = findSection(address); section && !section->name.empty()) {
+        return address == section->address
+            ? section->name : std::format("{}+0x{:X}", section->name, address - section->address);
+    }
+    return std::format("0x{:X}", address);
+}
+
+bool WeaR_GuestSymbols::isCode(uint64_t address) const {
+    return std::ranges::any_of(m_code, [address](const auto& range) {
+        return address >= range.first && address < range.second;
+    });
+}
+
+// =============================================================================
+// PROFILER
+// =============================================================================
+
+namespace {
+
+/**
+ * @brief A stack slot that points just past a call instruction
+ *
+ * Stack scanning without unwind info: stale slots can add a frame, but a
+ * value that is not preceded by a call is never taken.
+ */
+bool isReturnAddress(const WeaR_Memory& memory, const WeaR_GuestSymbols& symbols, uint64_t value) {
+    if (value < 6 || !symbols.isCode(value)) {
+        return false;
+    }
+    try {
+        if (memory.read<uint8_t>(value - 5) == 0xE8) {
+            return true;                                        // CALL rel32
+        }
+        if (memory.read<uint8_t>(value - 6) == 0xFF && memory.read<uint8_t>(value - 5) == 0x15) {
+            return true;                                        // CALL [RIP+disp32]
+        }
+        return memory.read<uint8_t>(value - 2) == 0xFF &&
+               (memory.read<uint8_t>(value - 1) & 0xF8) == 0xD0; // CALL reg
+    } catch (const MemoryAccessException&) {
+        return false;
+    }
+}
+
+} // anonymous namespace
+
+WeaR_GuestProfiler::WeaR_GuestProfiler(const WeaR_Cpu& cpu, const WeaR_Memory& memory,
+                                       WeaR_GuestSymbols symbols)
+    : m_cpu(cpu)
+    , m_memory(memory)
+    , m_symbols(std::move(symbols))
+{
+}
+
+WeaR_GuestProfiler::~WeaR_GuestProfiler() {
+    stop();
+}
+
+std::expected<void, std::string> WeaR_GuestProfiler::start(uint32_t rateHz) {
+    if (rateHz == 0 || rateHz > ProfilerConfig::MAX_RATE_HZ) {
+        return std::unexpected(std::format("Sampling rate must be 1-{} Hz", ProfilerConfig::MAX_RATE_HZ));
+    }
+    if (m_running.exchange(true)) {
+        return std::unexpected("Profiler is already running");
+    }
+
+    WEAR_LOG_INFO(LogCategory::CPU, "Guest profiler sampling at {} Hz ({} function symbols)",
+                  rateHz, m_symbols.getSymbolCount());
+    m_thread = std::thread([this, rateHz]() { threadMain(rateHz); });
+    return {};
+}
+
+void WeaR_GuestProfiler::stop() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    m_wakeup.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void WeaR_GuestProfiler::threadMain(uint32_t rateHz) {
+    ScopedThreadRole threadRole(ThreadRole::Service, "Profiler");
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / rateHz;
+    auto next = Clock::now() + period;
+
+    while (m_running.load()) {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeupMutex);
+            if (m_wakeup.wait_until(lock, next, [this]() { return !m_running.load(); })) {
+                break;
+            }
+        }
+
+        takeSample();
+        next += period;
+        if (next < Clock::now()) {
+            next = Clock::now() + period;   // Fell behind; do not burst
+        }
+    }
+}
+
+void WeaR_GuestProfiler::takeSample() {
+    // Paused, halted and stopped guests are not running any code
+    if (m_cpu.getState() != CpuState::Running) {
+        return;
+    }
+
+    const WeaR_Context& context = m_cpu.getContext();
+    const uint64_t rip = context.RIP;
+    const uint64_t rsp = context.RSP;
+
+    std::vector<uint64_t> stack;
+    stack.reserve(ProfilerConfig::MAX_STACK_DEPTH + 1);
+    stack.push_back(m_symbols.functionStart(rip));
+    for (size_t slot = 0; slot < ProfilerConfig::STACK_SCAN_SLOTS &&
+                          stack.size() <= ProfilerConfig::MAX_STACK_DEPTH; ++slot) {
+        uint64_t value = 0;
+        try {
+            value = m_memory.read<uint64_t>(rsp + slot * sizeof(uint64_t));
+        } catch (const MemoryAccessException&) {
+            break;  // Ran off the stack
+        }
+        if (isReturnAddress(m_memory, m_symbols, value)) {
+            // The call itself is one byte back; after a call to a noreturn
+            // function the return address is already the next symbol
+            stack.push_back(m_symbols.functionStart(value - 1));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_stacksMutex);
+        auto it = m_stacks.find(stack);
+        if (it == m_stacks.end() && m_stacks.size() >= ProfilerConfig::MAX_DISTINCT_STACKS) {
+            // Full: keep only the innermost frame, bounded by the function count
+            stack.resize(1);
+            it = m_stacks.try_emplace(std::move(stack), 0).first;
+            m_truncatedSamples.fetch_add(1, std::memory_order_relaxed);
+        } else if (it == m_stacks.end()) {
+            it = m_stacks.try_emplace(std::move(stack), 0).first;
+        }
+        ++it->second;
+    }
+    m_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<ProfileFunction> WeaR_GuestProfiler::getTopFunctions(size_t count) const {
+    struct Counts { uint64_t self = 0; uint64_t total = 0; };
+    std::unordered_map<uint64_t, Counts> functions;
+    {
+        std::lock_guard<std::mutex> lock(m_stacksMutex);
+        for (const auto& [stack, samples] : m_stacks) {
+            functions[stack.front()].self += samples;
+            for (size_t i = 0; i < stack.size(); ++i) {
+                // Recursion counts once per sample
+                if (std::find(stack.begin(), stack.begin() + i, stack[i]) == stack.begin() + i) {
+                    functions[stack[i]].total += samples;
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<uint64_t, Counts>> sorted(functions.begin(), functions.end());
+    std::ranges::sort(sorted, [](const auto& a, const auto& b) {
+        return a.second.self != b.second.self ? a.second.self > b.second.self
+                                              : a.second.total > b.second.total;
+    });
+    sorted.resize(std::min(sorted.size(), count));
+
+    std::vector<ProfileFunction> result;
+    result.reserve(sorted.size());
+    for (const auto& [address, counts] : sorted) {
+        result.push_back({ m_symbols.describe(address), counts.self, counts.total });
+    }
+    return result;
+}
+
+std::string WeaR_GuestProfiler::toCollapsed() const {
+    std::lock_guard<std::mutex> lock(m_stacksMutex);
+    std::string out;
+    for (const auto& [stack, samples] : m_stacks) {
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            if (it != stack.rbegin()) out += ';';
+            out += m_symbols.describe(*it);
+        }
+        out += std::format(" {}\n", samples);
+    }
+    return out;
+}
+
+std::expected<void, std::string> WeaR_GuestProfiler::writeCollapsed(const std::filesystem::path& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        return std::unexpected(std::format("Cannot write profile '{}'", path.string()));
+    }
+    file << toCollapsed();
+    if (!file) {
+        return std::unexpected(std::format("Cannot write profile '{}'", path.string()));
+    }
+    return {};
+}
+
+} // namespace WeaR
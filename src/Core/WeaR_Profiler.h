@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+ * @file WeaR_Profiler.h
+ * @brief Sampling profiler for guest code
+ *
+ * A host thread samples the guest RIP and a few return addresses from the
+ * guest stack at a fixed rate. The CPU thread does no extra work: the
+ * sampler peeks at the register file and stack the same way the debugger
+ * view does, so a sample taken mid-instruction can be slightly off. Samples
+ * are grouped per function with the ELF symbols (or per code section for
+ * stripped titles) and exported as collapsed stacks for flamegraph.pl,
+ * inferno or speedscope.
+ */
+
+#include "Loader/WeaR_ElfLoader.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace WeaR {
+
+class WeaR_Cpu;
+class WeaR_Memory;
+
+namespace ProfilerConfig {
+    constexpr uint32_t DEFAULT_RATE_HZ = 997;       // Prime, so it does not beat against frame timers
+    constexpr uint32_t MAX_RATE_HZ = 20000;
+    constexpr size_t MAX_STACK_DEPTH = 8;           // Return addresses kept per sample
+    constexpr size_t STACK_SCAN_SLOTS = 256;        // Stack qwords searched for them
+    constexpr size_t MAX_DISTINCT_STACKS = 65536;   // Beyond this, new stacks keep only the leaf
+}
+
+// =============================================================================
+// GUEST SYMBOLS
+// =============================================================================
+
+/**
+ * @brief Address-to-function lookup for one loaded image
+ */
+class WeaR_GuestSymbols {
+public:
+    WeaR_GuestSymbols() = default;
+    explicit WeaR_GuestSymbols(const ElfLoadResult& image);
+
+    /**
+     * @brief Start of the function containing address
+     *
+     * Symbols without a size extend to the next symbol. Addresses no symbol
+     * covers map to the start of their code section, else of their
+     * executable segment; anything outside the image is returned unchanged.
+     */
+    [[nodiscard]] uint64_t functionStart(uint64_t address) const;
+
+    /**
+     * @brief Symbol name, else "section+0xOFFSET", else "0xADDRESS"
+     */
+    [[nodiscard]] std::string describe(uint64_t address) const;
+
+    /**
+     * @brief Inside an executable segment of the image
+     */
+    [[nodiscard]] bool isCode(uint64_t address) const;
+
+    [[nodiscard]] size_t getSymbolCount() const { return m_symbols.size(); }
+
+private:
+    [[nodiscard]] const ElfSymbol* findSymbol(uint64_t address) const;
+    [[nodiscard]] const ElfSection* findSection(uint64_t address) const;
+
+    std::vector<ElfSymbol> m_symbols;                       // Sorted by address
+    std::vector<ElfSection> m_sections;                     // Sorted by address
+    std::vector<std::pair<uint64_t, uint64_t>> m_code;      // Executable segments [begin, end)
+};
+
+// =============================================================================
+// PROFILER
+// =============================================================================
+
+struct ProfileFunction {
+    std::string name;
+    uint64_t selfSamples = 0;       // Samples with RIP in the function
+    uint64_t totalSamples = 0;      // Samples with the function anywhere on the stack
+};
+
+class WeaR_GuestProfiler {
+public:
+    WeaR_GuestProfiler(const WeaR_Cpu& cpu, const WeaR_Memory& memory, WeaR_GuestSymbols symbols);
+    ~WeaR_GuestProfiler();
+
+    WeaR_GuestProfiler(const WeaR_GuestProfiler&) = delete;
+    WeaR_GuestProfiler& operator=(const WeaR_GuestProfiler&) = delete;
+
+    /**
+     * @brief Start the sampler thread
+     * @param rateHz Samples per second, 1..MAX_RATE_HZ
+     */
+    std::expected<void, std::string> start(uint32_t rateHz = ProfilerConfig::DEFAULT_RATE_HZ);
+    void stop();
+
+    [[nodiscard]] uint64_t getSampleCount() const { return m_samples.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Samples cut to their innermost frame because MAX_DISTINCT_STACKS was reached
+     */
+    [[nodiscard]] uint64_t getTruncatedSampleCount() const {
+        return m_truncatedSamples.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Functions with the most self samples, highest first
+     */
+    [[nodiscard]] std::vector<ProfileFunction> getTopFunctions(size_t count) const;
+
+    /**
+     * @brief One "outer;...;inner count" line per distinct stack
+     */
+    [[nodiscard]] std::string toCollapsed() const;
+
+    std::expected<void, std::string> writeCollapsed(const std::filesystem::path& path) const;
+
+private:
+    void threadMain(uint32_t rateHz);
+    void takeSample();
+
+    const WeaR_Cpu& m_cpu;
+    const WeaR_Memory& m_memory;
+    const WeaR_GuestSymbols m_symbols;
+
+    // Function starts, innermost first; written by the sampler thread only
+    mutable std::mutex m_stacksMutex;
+    std::map<std::vector<uint64_t>, uint64_t> m_stacks;
+    std::atomic<uint64_t> m_samples{0};
+    std::atomic<uint64_t> m_truncatedSamples{0};
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::mutex m_wakeupMutex;
+    std::condition_variable m_wakeup;
+};
+
+} // namespace WeaR
@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @file WeaR_SeqLock.h
+ * @brief Single-writer sequence lock for small trivially-copyable snapshots
+ *
+ * Readers never block the writer and never take a lock: they copy the
+ * payload and retry only if a store raced with the copy. Intended for
+ * state that is written rarely (host input events) and read often from
+ * several threads (guest polling every frame).
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace WeaR {
+
+template<typename T>
+class WeaR_SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock payload must be trivially copyable");
+
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    WeaR_SeqLock() { store(T{}); }
+
+    /**
+     * @brief Publish a new value
+     * @note Only one thread may store at a time (callers serialise writers)
+     */
+    void store(const T& value) {
+        uint64_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint64_t seq = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(seq + 1, std::memory_order_relaxed);   // Odd = write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        m_sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Read a consistent snapshot (lock-free, retries on a racing store)
+     */
+    [[nodiscard]] T load() const {
+        uint64_t words[WORD_COUNT];
+        uint64_t before, after;
+
+        do {
+            before = m_sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = m_sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Number of completed stores (even sequence / 2)
+     */
+    [[nodiscard]] uint64_t getVersion() const {
+        return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    alignas(64) std::atomic<uint64_t> m_sequence{0};
+    std::atomic<uint64_t> m_words[WORD_COUNT] = {};
+};
+
+} // namespace WeaR
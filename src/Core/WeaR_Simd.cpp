@@ -0,0 +1,150 @@
+#include "WeaR_Simd.h"
+
+#include <array>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define WEAR_SIMD_X86 1
+    #include <immintrin.h>
+#else
+    #define WEAR_SIMD_X86 0
+#endif
+
+// MSVC exposes every intrinsic regardless of /arch; GCC and Clang need the
+// ISA enabled on the function that uses it
+#if defined(__GNUC__) || defined(__clang__)
+    #define WEAR_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define WEAR_TARGET(isa)
+#endif
+
+namespace WeaR {
+
+namespace {
+
+// =============================================================================
+// SCALAR REFERENCE
+// =============================================================================
+
+// Same rounding as pmulhrsw: (x * g + 0x4000) >> 15
+inline int16_t scaleSample(int16_t sample, int16_t gain) {
+    return static_cast<int16_t>((static_cast<int32_t>(sample) * gain + 0x4000) >> 15);
+}
+
+void scalePcm16Scalar(int16_t* samples, size_t count, int16_t gainQ15) {
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = scaleSample(samples[i], gainQ15);
+    }
+}
+
+#if WEAR_SIMD_X86
+
+// =============================================================================
+// SSE4.2 (SSSE3 pmulhrsw)
+// =============================================================================
+
+WEAR_TARGET("sse4.2,ssse3")
+void scalePcm16Sse42(int16_t* samples, size_t count, int16_t gainQ15) {
+    const __m128i gain = _mm_set1_epi16(gainQ15);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto* p = reinterpret_cast<__m128i*>(samples + i);
+        _mm_storeu_si128(p, _mm_mulhrs_epi16(_mm_loadu_si128(p), gain));
+    }
+    for (; i < count; ++i) {
+        samples[i] = scaleSample(samples[i], gainQ15);
+    }
+}
+
+// =============================================================================
+// AVX2
+// =============================================================================
+
+WEAR_TARGET("avx2")
+void scalePcm16Avx2(int16_t* samples, size_t count, int16_t gainQ15) {
+    const __m256i gain = _mm256_set1_epi16(gainQ15);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        auto* p = reinterpret_cast<__m256i*>(samples + i);
+        _mm256_storeu_si256(p, _mm256_mulhrs_epi16(_mm256_loadu_si256(p), gain));
+    }
+    for (; i < count; ++i) {
+        samples[i] = scaleSample(samples[i], gainQ15);
+    }
+}
+
+// =============================================================================
+// AVX-512
+// =============================================================================
+
+WEAR_TARGET("avx512f,avx512bw,avx512vl")
+void scalePcm16Avx512(int16_t* samples, size_t count, int16_t gainQ15) {
+    const __m512i gain = _mm512_set1_epi16(gainQ15);
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        void* p = samples + i;
+        _mm512_storeu_si512(p, _mm512_mulhrs_epi16(_mm512_loadu_si512(p), gain));
+    }
+    if (i < count) {
+        // Masked tail instead of a scalar loop
+        const __mmask32 mask = (__mmask32{1} << (count - i)) - 1;
+        __m512i tail = _mm512_maskz_loadu_epi16(mask, samples + i);
+        _mm512_mask_storeu_epi16(samples + i, mask, _mm512_mulhrs_epi16(tail, gain));
+    }
+}
+
+#endif
+
+// =============================================================================
+// TABLES
+// =============================================================================
+
+using KernelTables = std::array<SimdKernels, static_cast<size_t>(SimdLevel::Count)>;
+
+KernelTables buildTables() {
+    KernelTables tables{};
+
+    SimdKernels scalar;
+    scalar.level = SimdLevel::Scalar;
+    scalar.scalePcm16 = scalePcm16Scalar;
+
+    // Every level starts from the next lower one, so a kernel without a
+    // variant for some level falls back to the best one below it
+    for (auto& table : tables) table = scalar;
+
+#if WEAR_SIMD_X86
+    SimdKernels& sse42 = tables[static_cast<size_t>(SimdLevel::SSE42)];
+    sse42.level = SimdLevel::SSE42;
+    sse42.scalePcm16 = scalePcm16Sse42;
+
+    SimdKernels& avx2 = tables[static_cast<size_t>(SimdLevel::AVX2)];
+    avx2 = sse42;
+    avx2.level = SimdLevel::AVX2;
+    avx2.scalePcm16 = scalePcm16Avx2;
+
+    SimdKernels& avx512 = tables[static_cast<size_t>(SimdLevel::AVX512)];
+    avx512 = avx2;
+    avx512.level = SimdLevel::AVX512;
+    avx512.scalePcm16 = scalePcm16Avx512;
+#endif
+
+    return tables;
+}
+
+const KernelTables& getTables() {
+    static const KernelTables tables = buildTables();
+    return tables;
+}
+
+} // anonymous namespace
+
+const SimdKernels& getSimdKernels(SimdLevel level) {
+    level = std::min(level, getHostCpuInfo().simdLevel);
+    return getTables()[static_cast<size_t>(level)];
+}
+
+const SimdKernels& getSimdKernels() {
+    static const SimdKernels& selected = getSimdKernels(getHostCpuInfo().simdLevel);
+    return selected;
+}
+
+} // namespace WeaR
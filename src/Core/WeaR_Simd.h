@@ -0,0 +1,51 @@
+#pragma once
+
+/**
+ * @file WeaR_Simd.h
+ * @brief Runtime-dispatched SIMD kernels
+ *
+ * The build targets the baseline ISA. Each kernel is compiled once per
+ * SimdLevel with per-function target attributes, and a table of function
+ * pointers is chosen once from getHostCpuInfo(), so one binary runs the
+ * best variant on every host. Variants are bit-exact with the scalar
+ * reference.
+ */
+
+#include "WeaR_HostCpu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace WeaR {
+
+struct SimdKernels {
+    SimdLevel level = SimdLevel::Scalar;
+
+    /**
+     * @brief samples[i] = round(samples[i] * gain / 32768), gain in [0, 32767]
+     */
+    void (*scalePcm16)(int16_t* samples, size_t count, int16_t gainQ15) = nullptr;
+};
+
+/**
+ * @brief Kernels for the host's SIMD level (selected on first call)
+ */
+[[nodiscard]] const SimdKernels& getSimdKernels();
+
+/**
+ * @brief Kernels for a specific level, clamped to the host level (and WEAR_SIMD)
+ *
+ * For benchmarks and cross-checking variants against the scalar path.
+ */
+[[nodiscard]] const SimdKernels& getSimdKernels(SimdLevel level);
+
+/**
+ * @brief Convert a [0, 1] volume to the Q15 gain used by scalePcm16
+ */
+[[nodiscard]] inline int16_t toGainQ15(float gain) {
+    return static_cast<int16_t>(std::lround(std::clamp(gain, 0.0f, 1.0f) * 32767.0f));
+}
+
+} // namespace WeaR
@@ -0,0 +1,244 @@
+#include "WeaR_StartupGraph.h"
+
+#include <algorithm>
+#include <exception>
+#include <format>
+
+namespace WeaR {
+
+const char* getStageStatusName(StageStatus status) {
+    switch (status) {
+        case StageStatus::Pending: return "pending";
+        case StageStatus::Running: return "running";
+        case StageStatus::Done:    return "done";
+        case StageStatus::Failed:  return "failed";
+        case StageStatus::Skipped: return "skipped";
+    }
+    return "unknown";
+}
+
+// =============================================================================
+// CONSTRUCTION
+// =============================================================================
+
+WeaR_StartupGraph::WeaR_StartupGraph()
+    : m_origin(std::chrono::steady_clock::now())
+{
+}
+
+WeaR_StartupGraph::~WeaR_StartupGraph() {
+    waitAll();
+}
+
+double WeaR_StartupGraph::sinceOrigin(std::chrono::steady_clock::time_point t) const {
+    return std::chrono::duration<double, std::milli>(t - m_origin).count();
+}
+
+size_t WeaR_StartupGraph::findLocked(std::string_view name) const {
+    for (size_t i = 0; i < m_stages.size(); ++i) {
+        if (m_stages[i]->timing.name == name) return i;
+    }
+    return m_stages.size();
+}
+
+bool WeaR_StartupGraph::isFinished(StageStatus status) {
+    return status == StageStatus::Done || status == StageStatus::Failed ||
+           status == StageStatus::Skipped;
+}
+
+// =============================================================================
+// STAGES
+// =============================================================================
+
+std::expected<void, std::string> WeaR_StartupGraph::addStage(
+    std::string name, std::vector<std::string> dependencies, Task task, JobPriority priority)
+{
+    auto stage = std::make_unique<Stage>();
+    stage->timing.name = std::move(name);
+    stage->task = std::move(task);
+    stage->priority = priority;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (findLocked(stage->timing.name) != m_stages.size()) {
+        return std::unexpected(std::format("Duplicate startup stage '{}'", stage->timing.name));
+    }
+    for (const auto& dependency : dependencies) {
+        size_t found = findLocked(dependency);
+        if (found == m_stages.size()) {
+            return std::unexpected(std::format("Startup stage '{}' depends on unknown stage '{}'",
+                                               stage->timing.name, dependency));
+        }
+        stage->dependencies.push_back(found);
+    }
+    m_stages.push_back(std::move(stage));
+
+    scheduleReadyLocked();
+    return {};
+}
+
+void WeaR_StartupGraph::scheduleReadyLocked() {
+    // Skipping a stage can release its dependents, so repeat until stable
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t index = 0; index < m_stages.size(); ++index) {
+            Stage& stage = *m_stages[index];
+            if (stage.scheduled || stage.timing.inlineStage) continue;
+
+            const bool ready = std::ranges::all_of(stage.dependencies, [&](size_t dep) {
+                return isFinished(m_stages[dep]->timing.status);
+            });
+            if (!ready) continue;
+
+            stage.scheduled = true;
+            for (size_t dep : stage.dependencies) {
+                StageStatus status = m_stages[dep]->timing.status;
+                if (status == StageStatus::Failed || status == StageStatus::Skipped) {
+                    stage.timing.status = StageStatus::Skipped;
+                    stage.timing.error = std::format("dependency '{}' {}", m_stages[dep]->timing.name,
+                                                     getStageStatusName(status));
+                    break;
+                }
+            }
+
+            if (stage.timing.status == StageStatus::Skipped) {
+                changed = true;
+                m_changed.notify_all();
+            } else {
+                getJobSystem().submit([this, index] { runStage(index); },
+                                      JobOptions{stage.priority, -1, nullptr});
+            }
+        }
+    }
+}
+
+void WeaR_StartupGraph::runStage(size_t index) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Stage& stage = *m_stages[index];
+
+    auto start = std::chrono::steady_clock::now();
+    stage.timing.status = StageStatus::Running;
+    stage.timing.startMs = sinceOrigin(start);
+    lock.unlock();
+
+    std::string error;
+    bool ok = true;
+    try {
+        stage.task();
+    } catch (const std::exception& e) {
+        ok = false;
+        error = e.what();
+    } catch (...) {
+        ok = false;
+        error = "unknown exception";
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    lock.lock();
+    stage.timing.durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+    stage.timing.status = ok ? StageStatus::Done : StageStatus::Failed;
+    stage.timing.error = std::move(error);
+    scheduleReadyLocked();
+    m_changed.notify_all();
+}
+
+bool WeaR_StartupGraph::runInline(std::string name, const Task& task) {
+    auto stage = std::make_unique<Stage>();
+    stage->timing.name = std::move(name);
+    stage->timing.inlineStage = true;
+    stage->timing.status = StageStatus::Running;
+
+    auto start = std::chrono::steady_clock::now();
+    stage->timing.startMs = sinceOrigin(start);
+
+    Stage* raw = stage.get();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stages.push_back(std::move(stage));
+    }
+
+    std::string error;
+    bool ok = true;
+    try {
+        task();
+    } catch (const std::exception& e) {
+        ok = false;
+        error = e.what();
+    } catch (...) {
+        ok = false;
+        error = "unknown exception";
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    raw->timing.durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+    raw->timing.status = ok ? StageStatus::Done : StageStatus::Failed;
+    raw->timing.error = std::move(error);
+    m_changed.notify_all();
+    return ok;
+}
+
+StageStatus WeaR_StartupGraph::wait(std::string_view name) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    size_t index = findLocked(name);
+    if (index == m_stages.size()) return StageStatus::Pending;
+
+    Stage& stage = *m_stages[index];
+    m_changed.wait(lock, [&] { return isFinished(stage.timing.status); });
+    return stage.timing.status;
+}
+
+void WeaR_StartupGraph::waitAll() {
+    // Jobs capture this graph, so the destructor must not return before them
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [&] {
+        return std::ranges::all_of(m_stages, [](const auto& stage) {
+            return isFinished(stage->timing.status);
+        });
+    });
+}
+
+// =============================================================================
+// REPORTING
+// =============================================================================
+
+std::vector<StageTiming> WeaR_StartupGraph::getTimings() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<StageTiming> timings;
+    timings.reserve(m_stages.size());
+    for (const auto& stage : m_stages) {
+        timings.push_back(stage->timing);
+    }
+    return timings;
+}
+
+double WeaR_StartupGraph::getElapsedMs() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    double end = 0.0;
+    for (const auto& stage : m_stages) {
+        end = std::max(end, stage->timing.startMs + stage->timing.durationMs);
+    }
+    return end;
+}
+
+std::string WeaR_StartupGraph::formatReport() const {
+    std::vector<StageTiming> timings = getTimings();
+    std::ranges::sort(timings, {}, &StageTiming::startMs);
+
+    double busyMs = 0.0;
+    for (const auto& timing : timings) busyMs += timing.durationMs;
+
+    std::string out = std::format("Startup: {:.1f} ms wall, {:.1f} ms of stage work\n",
+                                  getElapsedMs(), busyMs);
+    out += std::format("  {:<22} {:>10} {:>12}  {}\n", "stage", "start ms", "duration ms", "status");
+    for (const auto& timing : timings) {
+        out += std::format("  {:<22} {:>10.1f} {:>12.1f}  {}{}", timing.name, timing.startMs,
+                           timing.durationMs, getStageStatusName(timing.status),
+                           timing.inlineStage ? " (main thread)" : "");
+        if (!timing.error.empty()) out += std::format(" - {}", timing.error);
+        out += '\n';
+    }
+    return out;
+}
+
+} // namespace WeaR
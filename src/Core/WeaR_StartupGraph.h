@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * @file WeaR_StartupGraph.h
+ * @brief Concurrent startup stages with dependencies and per-stage timing
+ *
+ * Stages are added with the names of the stages they depend on and are
+ * submitted to the job system as soon as those have finished, so
+ * independent work (GPU probe, core bring-up, cache loads) overlaps the Qt
+ * bootstrap on the main thread. Work that must stay on the caller's thread is measured with
+ * runInline() and appears in the same report.
+ */
+
+#include "WeaR_JobSystem.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace WeaR {
+
+enum class StageStatus : uint8_t {
+    Pending,
+    Running,
+    Done,
+    Failed,     // Task threw; the message is kept in StageTiming::error
+    Skipped     // A dependency failed or was skipped
+};
+
+[[nodiscard]] const char* getStageStatusName(StageStatus status);
+
+struct StageTiming {
+    std::string name;
+    StageStatus status = StageStatus::Pending;
+    bool inlineStage = false;   // Ran on the caller's thread
+    double startMs = 0.0;       // Relative to graph construction
+    double durationMs = 0.0;
+    std::string error;
+};
+
+class WeaR_StartupGraph {
+public:
+    using Task = std::function<void()>;
+
+    WeaR_StartupGraph();
+    ~WeaR_StartupGraph();
+
+    WeaR_StartupGraph(const WeaR_StartupGraph&) = delete;
+    WeaR_StartupGraph& operator=(const WeaR_StartupGraph&) = delete;
+
+    /**
+     * @brief Add a stage; it starts once every dependency has finished
+     * @param dependencies Names of stages added earlier (keeps the graph acyclic)
+     * @param priority Job priority; use IO for stages that mostly block on files
+     */
+    std::expected<void, std::string> addStage(std::string name,
+                                              std::vector<std::string> dependencies,
+                                              Task task,
+                                              JobPriority priority = JobPriority::Normal);
+
+    /**
+     * @brief Run a stage on the calling thread and record its timing
+     * @return False if the task threw
+     */
+    bool runInline(std::string name, const Task& task);
+
+    /**
+     * @brief Block until a stage has finished (done, failed or skipped)
+     * @return The final status, or Pending for an unknown name
+     */
+    StageStatus wait(std::string_view name);
+
+    /**
+     * @brief Block until every stage has finished
+     */
+    void waitAll();
+
+    [[nodiscard]] std::vector<StageTiming> getTimings() const;
+
+    /**
+     * @brief Table of stages with start offset, duration and status
+     */
+    [[nodiscard]] std::string formatReport() const;
+
+    /**
+     * @brief Wall-clock time from construction to the last finished stage
+     */
+    [[nodiscard]] double getElapsedMs() const;
+
+private:
+    struct Stage {
+        StageTiming timing;
+        std::vector<size_t> dependencies;
+        Task task;
+        JobPriority priority = JobPriority::Normal;
+        bool scheduled = false;     // Submitted, or resolved as skipped
+    };
+
+    void scheduleReadyLocked();
+    void runStage(size_t index);
+    [[nodiscard]] double sinceOrigin(std::chrono::steady_clock::time_point t) const;
+    [[nodiscard]] size_t findLocked(std::string_view name) const;
+    [[nodiscard]] static bool isFinished(StageStatus status);
+
+    std::chrono::steady_clock::time_point m_origin;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::vector<std::unique_ptr<Stage>> m_stages;
+};
+
+} // namespace WeaR
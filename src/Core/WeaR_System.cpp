@@ -1,8 +1,10 @@
 #include "WeaR_System.h"
+#include "WeaR_EmulationContext.h"
+#include "WeaR_ThreadRoles.h"
 #include "Graphics/WeaR_RenderEngine.h"
 #include "HLE/WeaR_Syscalls.h"
+#include "WeaR_Log.h"
 
-#include <iostream>
 #include <format>
 
 namespace WeaR {
@@ -11,7 +13,10 @@ namespace WeaR {
 // CONSTRUCTOR / DESTRUCTOR
 // =============================================================================
 
-WeaR_System::WeaR_System() = default;
+WeaR_System::WeaR_System(WeaR_EmulationContext& context)
+    : m_context(context)
+{
+}
 
 WeaR_System::~WeaR_System() {
     shutdown();
@@ -23,23 +28,23 @@ WeaR_System::~WeaR_System() {
 
 bool WeaR_System::initialize(const WeaR_Specs& specs) {
     if (m_state.load() != SystemState::Uninitialized) {
-        std::cout << "[System] Already initialized\n";
+        WEAR_LOG_WARN(LogCategory::General, "System already initialized");
         return false;
     }
 
     m_specs = specs;
 
     try {
-        std::cout << "[System] Initializing subsystems...\n";
+        WEAR_LOG_INFO(LogCategory::General, "Initializing system subsystems");
 
         // Initialize memory
         m_memory = std::make_unique<WeaR_Memory>();
         if (!m_memory->isInitialized()) {
-            std::cerr << "[System] Failed to initialize memory\n";
+            WEAR_LOG_ERROR(LogCategory::General, "Failed to initialize memory");
             setState(SystemState::Error);
             return false;
         }
-        std::cout << "[System] Memory initialized\n";
+        WEAR_LOG_INFO(LogCategory::General, "Memory initialized");
 
         // Initialize CPU
         m_cpu = std::make_unique<WeaR_Cpu>(*m_memory);
@@ -48,18 +53,18 @@ bool WeaR_System::initialize(const WeaR_Specs& specs) {
         m_cpu->setSyscallHandler([this](WeaR_Context& ctx) {
             handleSyscall(ctx);
         });
-        std::cout << "[System] CPU initialized\n";
+        WEAR_LOG_INFO(LogCategory::General, "CPU initialized");
 
         // Initialize ELF loader
         m_elfLoader = std::make_unique<WeaR_ElfLoader>();
-        std::cout << "[System] ELF loader initialized\n";
+        WEAR_LOG_INFO(LogCategory::General, "ELF loader initialized");
 
         setState(SystemState::Ready);
-        std::cout << "[System] All subsystems ready\n";
+        WEAR_LOG_INFO(LogCategory::General, "All subsystems ready");
         return true;
 
     } catch (const std::exception& e) {
-        std::cerr << std::format("[System] Init failed: {}\n", e.what());
+        WEAR_LOG_ERROR(LogCategory::General, "System init failed: {}", e.what());
         setState(SystemState::Error);
         return false;
     }
@@ -71,22 +76,22 @@ bool WeaR_System::initialize(const WeaR_Specs& specs) {
 
 uint64_t WeaR_System::loadGame(const std::string& filepath) {
     if (!m_memory || !m_elfLoader) {
-        std::cerr << "[System] Not initialized\n";
+        WEAR_LOG_ERROR(LogCategory::General, "System not initialized");
         return 0;
     }
 
-    std::cout << std::format("[System] Loading game: {}\n", filepath);
+    WEAR_LOG_INFO(LogCategory::General, "Loading game: {}", filepath);
 
     auto result = m_elfLoader->loadElf(filepath, *m_memory);
     if (!result) {
-        std::cerr << std::format("[System] Load failed: {}\n", result.error());
+        WEAR_LOG_ERROR(LogCategory::General, "Load failed: {}", result.error());
         return 0;
     }
 
     m_entryPoint = result->entryPoint;
     m_loadedGame = filepath;
 
-    std::cout << std::format("[System] Game loaded. Entry: 0x{:016X}\n", m_entryPoint);
+    WEAR_LOG_INFO(LogCategory::General, "Game loaded. Entry: 0x{:016X}", m_entryPoint);
 
     // Set up initial CPU state
     m_cpu->getContext().RIP = m_entryPoint;
@@ -102,16 +107,16 @@ uint64_t WeaR_System::loadGame(const std::string& filepath) {
 
 void WeaR_System::boot() {
     if (m_state.load() != SystemState::Ready) {
-        std::cerr << "[System] Not ready to boot\n";
+        WEAR_LOG_ERROR(LogCategory::General, "System not ready to boot");
         return;
     }
 
     if (m_entryPoint == 0) {
-        std::cerr << "[System] No game loaded\n";
+        WEAR_LOG_ERROR(LogCategory::General, "No game loaded");
         return;
     }
 
-    std::cout << std::format("[System] Booting at RIP=0x{:016X}\n", m_entryPoint);
+    WEAR_LOG_INFO(LogCategory::General, "Booting at RIP=0x{:016X}", m_entryPoint);
 
     // Stop any existing thread
     if (m_cpuThread && m_cpuThread->joinable()) {
@@ -180,12 +185,13 @@ void WeaR_System::shutdown() {
 // =============================================================================
 
 void WeaR_System::cpuThreadFunc() {
-    std::cout << "[System] CPU thread started\n";
+    ScopedThreadRole threadRole(ThreadRole::GuestCpu, "CPU");
+    WEAR_LOG_INFO(LogCategory::General, "CPU thread started");
 
     try {
         m_cpu->runLoop();
     } catch (const std::exception& e) {
-        std::cerr << std::format("[System] CPU thread exception: {}\n", e.what());
+        WEAR_LOG_ERROR(LogCategory::General, "CPU thread exception: {}", e.what());
         setState(SystemState::Error);
     }
 
@@ -204,7 +210,7 @@ void WeaR_System::cpuThreadFunc() {
             }
     }
 
-    std::cout << "[System] CPU thread ended\n";
+    WEAR_LOG_INFO(LogCategory::General, "CPU thread ended");
 }
 
 // =============================================================================
@@ -238,11 +244,12 @@ void WeaR_System::setState(SystemState state) {
 // =============================================================================
 
 void WeaR_System::handleSyscall(WeaR_Context& ctx) {
-    // Route to global HLE syscall dispatcher
-    getSyscallDispatcher().dispatch(ctx, *m_memory);
+    // Route to the context's HLE syscall dispatcher
+    auto& syscalls = m_context.getSyscalls();
+    syscalls.dispatch(ctx, *m_memory);
     
     // Check if sys_exit was called
-    if (ctx.RAX == 0 && getSyscallDispatcher().getTotalCalls() > 0) {
+    if (ctx.RAX == 0 && syscalls.getTotalCalls() > 0) {
         // Could check for exit syscall here
     }
 }
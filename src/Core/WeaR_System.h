@@ -27,6 +27,7 @@ namespace WeaR {
 
 // Forward declaration
 class WeaR_RenderEngine;
+class WeaR_EmulationContext;
 
 // =============================================================================
 // SYSTEM STATE
@@ -61,7 +62,10 @@ struct SystemCallbacks {
  */
 class WeaR_System {
 public:
-    WeaR_System();
+    /**
+     * @param context Provides the syscall dispatcher; must outlive the system
+     */
+    explicit WeaR_System(WeaR_EmulationContext& context);
     ~WeaR_System();
 
     // Non-copyable
@@ -155,6 +159,7 @@ private:
     void handleSyscall(WeaR_Context& ctx);
 
     // Components
+    WeaR_EmulationContext& m_context;
     std::unique_ptr<WeaR_Memory> m_memory;
     std::unique_ptr<WeaR_Cpu> m_cpu;
     std::unique_ptr<WeaR_ElfLoader> m_elfLoader;
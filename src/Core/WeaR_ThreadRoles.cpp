@@ -0,0 +1,597 @@
+#include "WeaR_ThreadRoles.h"
+#include "WeaR_Log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <format>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <pthread.h>
+    #ifdef __linux__
+        #include <fstream>
+        #include <sched.h>
+        #include <sstream>
+        #include <sys/resource.h>
+        #include <sys/syscall.h>
+        #include <unistd.h>
+    #endif
+#endif
+
+namespace WeaR {
+
+const char* getThreadRoleName(ThreadRole role) {
+    switch (role) {
+        case ThreadRole::GuestCpu: return "cpu";
+        case ThreadRole::Render:   return "render";
+        case ThreadRole::Gui:      return "gui";
+        case ThreadRole::Audio:    return "audio";
+        case ThreadRole::Worker:   return "worker";
+        case ThreadRole::IO:       return "io";
+        case ThreadRole::Service:  return "service";
+        default:                   return "unknown";
+    }
+}
+
+const char* getThreadPriorityName(ThreadPriority priority) {
+    switch (priority) {
+        case ThreadPriority::Low:      return "low";
+        case ThreadPriority::Normal:   return "normal";
+        case ThreadPriority::High:     return "high";
+        case ThreadPriority::Realtime: return "realtime";
+    }
+    return "unknown";
+}
+
+namespace {
+
+// =============================================================================
+// PLATFORM
+// =============================================================================
+
+#ifdef _WIN32
+using NativeThread = HANDLE;
+
+// Only processor group 0 is addressable through a thread affinity mask
+constexpr uint32_t MAX_MASK_CORES = 64;
+
+uint64_t currentOsThreadId() {
+    return GetCurrentThreadId();
+}
+
+NativeThread openCurrentThread() {
+    return OpenThread(THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION, FALSE, GetCurrentThreadId());
+}
+
+void closeThread(NativeThread thread) {
+    if (thread) CloseHandle(thread);
+}
+
+std::vector<uint32_t> getProcessCores() {
+    DWORD_PTR processMask = 0, systemMask = 0;
+    std::vector<uint32_t> cores;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+        for (uint32_t cpu = 0; cpu < MAX_MASK_CORES; ++cpu) {
+            if (processMask & (DWORD_PTR{1} << cpu)) cores.push_back(cpu);
+        }
+    }
+    return cores;
+}
+
+std::string setAffinity(NativeThread thread, const std::vector<uint32_t>& cores) {
+    DWORD_PTR mask = 0;
+    for (uint32_t cpu : cores) {
+        if (cpu < MAX_MASK_CORES) mask |= DWORD_PTR{1} << cpu;
+    }
+    if (mask == 0) return "no selected core is in processor group 0";
+    if (SetThreadAffinityMask(thread, mask) == 0) {
+        return std::format("SetThreadAffinityMask failed (error {})", GetLastError());
+    }
+    return {};
+}
+
+std::string setPriority(NativeThread thread, uint64_t, ThreadPriority priority) {
+    int value = THREAD_PRIORITY_NORMAL;
+    switch (priority) {
+        case ThreadPriority::Low:      value = THREAD_PRIORITY_BELOW_NORMAL; break;
+        case ThreadPriority::Normal:   value = THREAD_PRIORITY_NORMAL; break;
+        case ThreadPriority::High:     value = THREAD_PRIORITY_HIGHEST; break;
+        case ThreadPriority::Realtime: value = THREAD_PRIORITY_TIME_CRITICAL; break;
+    }
+    if (!SetThreadPriority(thread, value)) {
+        return std::format("SetThreadPriority({}) failed (error {})", getThreadPriorityName(priority),
+                           GetLastError());
+    }
+    return {};
+}
+#else
+using NativeThread = pthread_t;
+
+NativeThread openCurrentThread() {
+    return pthread_self();
+}
+
+void closeThread(NativeThread) {}
+
+#ifdef __linux__
+uint64_t currentOsThreadId() {
+    return static_cast<uint64_t>(::syscall(SYS_gettid));
+}
+
+std::vector<uint32_t> getProcessCores() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    std::vector<uint32_t> cores;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cores.push_back(cpu);
+        }
+    }
+    return cores;
+}
+
+std::string setAffinity(NativeThread thread, const std::vector<uint32_t>& cores) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t cpu : cores) {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    if (int rc = pthread_setaffinity_np(thread, sizeof(set), &set); rc != 0) {
+        return std::format("pinning to cores {} failed: {}", formatCoreList(cores), std::strerror(rc));
+    }
+    return {};
+}
+
+bool hasCapSysNice() {
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);) {
+        if (line.starts_with("CapEff:")) {
+            uint64_t caps = 0;
+            std::istringstream(line.substr(7)) >> std::hex >> caps;
+            return (caps >> 23) & 1;                            // CAP_SYS_NICE
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Lowest nice value this process may set, checked once
+ *
+ * Raising a nice value is always allowed; lowering it needs CAP_SYS_NICE or
+ * an RLIMIT_NICE that reaches that far (down to 20 - rlim_cur).
+ */
+int minimumNice() {
+    static const int value = [] {
+        if (hasCapSysNice()) return -20;
+        rlimit limit{};
+        if (getrlimit(RLIMIT_NICE, &limit) != 0) return 20;
+        if (limit.rlim_cur == RLIM_INFINITY || limit.rlim_cur >= 40) return -20;
+        return 20 - static_cast<int>(limit.rlim_cur);
+    }();
+    return value;
+}
+
+std::string setNice(uint64_t tid, int nice) {
+    // Linux applies a per-thread nice value when given a thread id
+    const auto id = static_cast<id_t>(tid);
+    errno = 0;
+    const int current = getpriority(PRIO_PROCESS, id);
+    if (current == -1 && errno != 0) {
+        return std::format("reading nice value failed: {}", std::strerror(errno));
+    }
+    if (nice == current) {
+        return {};
+    }
+
+    // Never raise priority without permission, and never lower it when
+    // going back to the current value would need permission we lack
+    if (nice < current && nice < minimumNice()) {
+        return std::format("nice {} needs CAP_SYS_NICE or RLIMIT_NICE, left at {}", nice, current);
+    }
+    if (nice > current && current < minimumNice()) {
+        return std::format("nice {} not applied: it could not be undone without CAP_SYS_NICE "
+                           "or RLIMIT_NICE", nice);
+    }
+
+    if (setpriority(PRIO_PROCESS, id, nice) != 0) {
+        return std::format("setting nice {} failed: {}", nice, std::strerror(errno));
+    }
+    return {};
+}
+
+std::string setPriority(NativeThread thread, uint64_t tid, ThreadPriority priority) {
+    sched_param param{};
+    if (priority == ThreadPriority::Realtime) {
+        param.sched_priority = ThreadConfig::REALTIME_PRIORITY;
+        if (pthread_setschedparam(thread, SCHED_FIFO, &param) == 0) {
+            return {};
+        }
+        std::string error = setNice(tid, ThreadConfig::NICE_HIGH);
+        return error.empty()
+            ? "real-time scheduling not permitted (needs CAP_SYS_NICE or RLIMIT_RTPRIO), using high"
+            : error;
+    }
+
+    // Drop SCHED_FIFO left by an earlier configuration
+    param.sched_priority = 0;
+    (void)pthread_setschedparam(thread, SCHED_OTHER, &param);
+
+    int nice = 0;
+    if (priority == ThreadPriority::Low) nice = ThreadConfig::NICE_LOW;
+    if (priority == ThreadPriority::High) nice = ThreadConfig::NICE_HIGH;
+    return setNice(tid, nice);
+}
+#else
+uint64_t currentOsThreadId() {
+    return 0;
+}
+
+std::vector<uint32_t> getProcessCores() {
+    return {};
+}
+
+std::string setAffinity(NativeThread, const std::vector<uint32_t>&) {
+    return "core pinning is not supported on this platform";
+}
+
+std::string setPriority(NativeThread, uint64_t, ThreadPriority priority) {
+    if (priority == ThreadPriority::Normal) return {};
+    return "thread priorities are not supported on this platform";
+}
+#endif
+#endif
+
+// =============================================================================
+// PARSING
+// =============================================================================
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && text.front() == ' ') text.remove_prefix(1);
+    while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
+    return text;
+}
+
+bool parseIndex(std::string_view text, uint32_t& value) {
+    text = trim(text);
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && end == text.data() + text.size();
+}
+
+std::expected<std::vector<uint32_t>, std::string> parseCoreList(std::string_view text,
+                                                                uint32_t logicalProcessors)
+{
+    std::vector<uint32_t> cores;
+    while (!text.empty()) {
+        size_t comma = text.find(',');
+        std::string_view item = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+
+        uint32_t first = 0, last = 0;
+        size_t dash = item.find('-');
+        bool ok = dash == std::string_view::npos
+            ? parseIndex(item, first) && parseIndex(item, last)
+            : parseIndex(item.substr(0, dash), first) && parseIndex(item.substr(dash + 1), last);
+        if (!ok || first > last) {
+            return std::unexpected(std::format("invalid core list entry '{}'", item));
+        }
+        if (last >= logicalProcessors) {
+            return std::unexpected(std::format("core {} does not exist (host has {})", last,
+                                               logicalProcessors));
+        }
+        for (uint32_t cpu = first; cpu <= last; ++cpu) cores.push_back(cpu);
+    }
+
+    std::ranges::sort(cores);
+    auto [dupFirst, dupLast] = std::ranges::unique(cores);
+    cores.erase(dupFirst, dupLast);
+    return cores;
+}
+
+} // anonymous namespace
+
+std::string formatCoreList(const std::vector<uint32_t>& cores) {
+    std::string out;
+    for (size_t i = 0; i < cores.size();) {
+        size_t j = i;
+        while (j + 1 < cores.size() && cores[j + 1] == cores[j] + 1) ++j;
+        if (!out.empty()) out += ',';
+        out += j == i ? std::format("{}", cores[i]) : std::format("{}-{}", cores[i], cores[j]);
+        i = j + 1;
+    }
+    return out;
+}
+
+// =============================================================================
+// ThreadRoleConfig
+// =============================================================================
+
+ThreadRoleConfig ThreadRoleConfig::makeAuto(const HostCpuInfo& cpu) {
+    ThreadRoleConfig config;
+    config[ThreadRole::GuestCpu].priority = ThreadPriority::High;
+    config[ThreadRole::Render].priority = ThreadPriority::High;
+    config[ThreadRole::Audio].priority = ThreadPriority::Realtime;
+    config[ThreadRole::IO].priority = ThreadPriority::Low;
+    config[ThreadRole::Service].priority = ThreadPriority::Low;
+
+    // On hybrid parts the highest-numbered cores are usually the slow ones
+    if (cpu.hybrid) return config;
+
+    // Logical processors grouped by physical core, so SMT siblings stay together
+    std::vector<std::vector<uint32_t>> cores;
+    if (cpu.coreOfLogical.size() == cpu.logicalProcessors) {
+        for (uint32_t logical = 0; logical < cpu.logicalProcessors; ++logical) {
+            uint32_t core = cpu.coreOfLogical[logical];
+            if (core >= cores.size()) cores.resize(core + 1);
+            cores[core].push_back(logical);
+        }
+    } else {
+        for (uint32_t logical = 0; logical < cpu.logicalProcessors; ++logical) {
+            cores.push_back({logical});
+        }
+    }
+    std::erase_if(cores, [](const auto& siblings) { return siblings.empty(); });
+    if (cores.size() < ThreadConfig::AUTO_PIN_MIN_CORES) return config;
+
+    // Core 0 takes most interrupts, so the dedicated cores come from the top
+    config[ThreadRole::GuestCpu].cores = cores[cores.size() - 1];
+    config[ThreadRole::Render].cores = cores[cores.size() - 2];
+
+    std::vector<uint32_t> shared;
+    for (size_t i = 0; i + 2 < cores.size(); ++i) {
+        shared.insert(shared.end(), cores[i].begin(), cores[i].end());
+    }
+    std::ranges::sort(shared);
+    for (ThreadRole role : {ThreadRole::Gui, ThreadRole::Audio, ThreadRole::Worker,
+                            ThreadRole::IO, ThreadRole::Service}) {
+        config[role].cores = shared;
+    }
+    return config;
+}
+
+std::expected<ThreadRoleConfig, std::string> ThreadRoleConfig::parse(std::string_view spec,
+                                                                     const HostCpuInfo& cpu)
+{
+    ThreadRoleConfig config;
+    bool first = true;
+
+    while (!spec.empty()) {
+        size_t semicolon = spec.find(';');
+        std::string_view item = trim(spec.substr(0, semicolon));
+        spec = semicolon == std::string_view::npos ? std::string_view{} : spec.substr(semicolon + 1);
+        if (item.empty()) continue;
+
+        const bool isBase = item == "off" || item == "auto";
+        if (isBase) {
+            if (!first) return std::unexpected(std::format("'{}' must come first", item));
+            if (item == "auto") config = makeAuto(cpu);
+            first = false;
+            continue;
+        }
+        first = false;
+
+        size_t equals = item.find('=');
+        if (equals == std::string_view::npos) {
+            return std::unexpected(std::format("expected role=cores[@priority], got '{}'", item));
+        }
+
+        std::string_view roleName = trim(item.substr(0, equals));
+        auto role = ThreadRole::Count;
+        for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+            if (roleName == getThreadRoleName(static_cast<ThreadRole>(i))) {
+                role = static_cast<ThreadRole>(i);
+            }
+        }
+        if (role == ThreadRole::Count) {
+            return std::unexpected(std::format("unknown thread role '{}'", roleName));
+        }
+
+        std::string_view value = item.substr(equals + 1);
+        ThreadRolePolicy& policy = config[role];
+
+        size_t at = value.find('@');
+        if (at != std::string_view::npos) {
+            std::string_view priorityName = trim(value.substr(at + 1));
+            bool found = false;
+            for (auto priority : {ThreadPriority::Low, ThreadPriority::Normal, ThreadPriority::High,
+                                  ThreadPriority::Realtime}) {
+                if (priorityName == getThreadPriorityName(priority)) {
+                    policy.priority = priority;
+                    found = true;
+                }
+            }
+            if (!found) return std::unexpected(std::format("unknown priority '{}'", priorityName));
+            value = value.substr(0, at);
+        }
+
+        // "render=@high" keeps the cores from the base
+        value = trim(value);
+        if (!value.empty()) {
+            auto cores = parseCoreList(value, cpu.logicalProcessors);
+            if (!cores) return std::unexpected(cores.error());
+            policy.cores = std::move(*cores);
+        }
+    }
+    return config;
+}
+
+std::string ThreadRoleConfig::describe() const {
+    std::string out;
+    for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        const ThreadRolePolicy& policy = roles[i];
+        if (policy.cores.empty() && policy.priority == ThreadPriority::Normal) continue;
+
+        if (!out.empty()) out += ';';
+        out += std::format("{}={}", getThreadRoleName(static_cast<ThreadRole>(i)),
+                           formatCoreList(policy.cores));
+        if (policy.priority != ThreadPriority::Normal) {
+            out += std::format("@{}", getThreadPriorityName(policy.priority));
+        }
+    }
+    return out.empty() ? "off" : out;
+}
+
+// =============================================================================
+// REGISTRY
+// =============================================================================
+
+struct WeaR_ThreadRoles::Entry {
+    uint64_t handle = 0;
+    ThreadRole role = ThreadRole::Service;
+    std::string name;
+    uint64_t osThreadId = 0;
+    NativeThread thread{};
+    bool modified = false;      // Differs from the process defaults
+    std::string error;
+};
+
+WeaR_ThreadRoles::WeaR_ThreadRoles()
+    : m_processCores(getProcessCores())
+{
+}
+
+WeaR_ThreadRoles::~WeaR_ThreadRoles() {
+    for (auto& entry : m_threads) {
+        closeThread(entry->thread);
+    }
+}
+
+void WeaR_ThreadRoles::configure(const ThreadRoleConfig& config) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_base = config;
+    reapplyLocked();
+}
+
+uint64_t WeaR_ThreadRoles::addOverlay(const ThreadRoleConfig& config) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint64_t handle = m_nextHandle++;
+    m_overlays.emplace_back(handle, config);
+    reapplyLocked();
+    return handle;
+}
+
+void WeaR_ThreadRoles::removeOverlay(uint64_t handle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::ranges::find(m_overlays, handle, &std::pair<uint64_t, ThreadRoleConfig>::first);
+    if (it == m_overlays.end()) return;
+    m_overlays.erase(it);
+    reapplyLocked();
+}
+
+ThreadRoleConfig WeaR_ThreadRoles::getConfig() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return effectiveLocked();
+}
+
+const ThreadRoleConfig& WeaR_ThreadRoles::effectiveLocked() const {
+    return m_overlays.empty() ? m_base : m_overlays.back().second;
+}
+
+void WeaR_ThreadRoles::reapplyLocked() {
+    m_warned = {};
+    for (auto& entry : m_threads) {
+        applyLocked(*entry);
+    }
+    WEAR_LOG_INFO(LogCategory::General, "Thread roles: {}{}", effectiveLocked().describe(),
+                  m_overlays.empty() ? "" : " (overlay)");
+}
+
+uint64_t WeaR_ThreadRoles::registerCurrentThread(ThreadRole role, std::string name) {
+    auto entry = std::make_unique<Entry>();
+    entry->role = role;
+    entry->name = std::move(name);
+    entry->osThreadId = currentOsThreadId();
+    entry->thread = openCurrentThread();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entry->handle = m_nextHandle++;
+    applyLocked(*entry);
+    m_threads.push_back(std::move(entry));
+    return m_threads.back()->handle;
+}
+
+void WeaR_ThreadRoles::unregisterThread(uint64_t handle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::ranges::find(m_threads, handle, [](const auto& entry) { return entry->handle; });
+    if (it == m_threads.end()) return;
+    closeThread((*it)->thread);
+    m_threads.erase(it);
+}
+
+void WeaR_ThreadRoles::beforeFork() {
+    m_mutex.lock();
+}
+
+void WeaR_ThreadRoles::afterFork(bool inChild) {
+    if (inChild) {
+        // Handles still held by copied scopes are ignored by unregisterThread()
+        for (auto& entry : m_threads) {
+            closeThread(entry->thread);
+        }
+        m_threads.clear();
+    }
+    m_mutex.unlock();
+}
+
+std::vector<ThreadRoleStatus> WeaR_ThreadRoles::getThreads() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<ThreadRoleStatus> threads;
+    threads.reserve(m_threads.size());
+    for (const auto& entry : m_threads) {
+        threads.push_back({entry->role, entry->name, entry->osThreadId, entry->error});
+    }
+    return threads;
+}
+
+void WeaR_ThreadRoles::applyLocked(Entry& entry) {
+    const ThreadRolePolicy& policy = effectiveLocked()[entry.role];
+    const bool isDefault = policy.cores.empty() && policy.priority == ThreadPriority::Normal;
+
+    // Leave untouched threads alone so "off" costs nothing
+    entry.error.clear();
+    if (isDefault && !entry.modified) return;
+
+    std::vector<std::string> errors;
+
+    // Pinning never widens the set the process was started with (taskset, job objects)
+    std::vector<uint32_t> cores = policy.cores.empty() ? m_processCores : policy.cores;
+    if (!policy.cores.empty() && !m_processCores.empty()) {
+        std::erase_if(cores, [&](uint32_t cpu) { return !std::ranges::binary_search(m_processCores, cpu); });
+        if (cores.empty()) {
+            errors.push_back(std::format("cores {} are outside the process affinity",
+                                         formatCoreList(policy.cores)));
+        }
+    }
+    if (!cores.empty()) {
+        if (std::string error = setAffinity(entry.thread, cores); !error.empty()) {
+            errors.push_back(std::move(error));
+        }
+    }
+
+    if (std::string error = setPriority(entry.thread, entry.osThreadId, policy.priority); !error.empty()) {
+        errors.push_back(std::move(error));
+    }
+
+    entry.modified = !isDefault;
+    for (const auto& error : errors) {
+        if (!entry.error.empty()) entry.error += "; ";
+        entry.error += error;
+    }
+
+    auto& warned = m_warned[static_cast<size_t>(entry.role)];
+    if (!entry.error.empty() && !warned) {
+        warned = true;
+        WEAR_LOG_WARN(LogCategory::General, "Thread '{}' ({}): {}", entry.name,
+                      getThreadRoleName(entry.role), entry.error);
+    }
+}
+
+WeaR_ThreadRoles& getThreadRoles() {
+    // Leaked on purpose: threads owned by other singletons unregister on exit
+    static auto* roles = new WeaR_ThreadRoles();
+    return *roles;
+}
+
+} // namespace WeaR
@@ -0,0 +1,212 @@
+#pragma once
+
+/**
+ * @file WeaR_ThreadRoles.h
+ * @brief Thread-role registry: core pinning and scheduling priority
+ *
+ * Long-lived threads register under a role when they start. Each role has
+ * a policy (allowed cores, priority) that is applied on registration and
+ * re-applied to every live thread when the configuration changes, so the
+ * settings can be switched while a title runs. Failures (no permission
+ * for real-time priority, unsupported platform) are logged once per role
+ * and never fatal.
+ */
+
+#include "WeaR_HostCpu.h"
+
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace WeaR {
+
+// =============================================================================
+// ROLES & POLICIES
+// =============================================================================
+
+enum class ThreadRole : uint8_t {
+    GuestCpu,       // Runs guest code
+    Render,         // Records and presents frames
+    Gui,            // Qt main thread
+    Audio,          // Host audio mixing
+    Worker,         // Job system compute workers
+    IO,             // Job system I/O workers
+    Service,        // Logger, metrics exporter
+    Count
+};
+
+constexpr size_t THREAD_ROLE_COUNT = static_cast<size_t>(ThreadRole::Count);
+
+enum class ThreadPriority : uint8_t {
+    Low,
+    Normal,
+    High,
+    Realtime        // Falls back to High when the OS refuses
+};
+
+[[nodiscard]] const char* getThreadRoleName(ThreadRole role);
+[[nodiscard]] const char* getThreadPriorityName(ThreadPriority priority);
+
+namespace ThreadConfig {
+    constexpr uint32_t AUTO_PIN_MIN_CORES = 4;  // Fewer physical cores: priorities only
+    constexpr int REALTIME_PRIORITY = 10;       // SCHED_FIFO level on Linux
+    constexpr int NICE_LOW = 5;
+    constexpr int NICE_HIGH = -5;
+}
+
+struct ThreadRolePolicy {
+    std::vector<uint32_t> cores;    // Logical processors; empty = the process default
+    ThreadPriority priority = ThreadPriority::Normal;
+};
+
+struct ThreadRoleConfig {
+    std::array<ThreadRolePolicy, THREAD_ROLE_COUNT> roles{};
+
+    [[nodiscard]] ThreadRolePolicy& operator[](ThreadRole role) { return roles[static_cast<size_t>(role)]; }
+    [[nodiscard]] const ThreadRolePolicy& operator[](ThreadRole role) const {
+        return roles[static_cast<size_t>(role)];
+    }
+
+    /**
+     * @brief Guest CPU and render on the last two physical cores, everything
+     *        else on the remaining ones; elevated render/audio priority
+     *
+     * Pinning is skipped on hybrid (P/E) CPUs and hosts with fewer than
+     * AUTO_PIN_MIN_CORES cores, where only the priorities are set.
+     */
+    [[nodiscard]] static ThreadRoleConfig makeAuto(const HostCpuInfo& cpu);
+
+    /**
+     * @brief Parse "off", "auto", or a base followed by role overrides
+     *
+     * Overrides are "role=cores[@priority]" separated by ';', e.g.
+     * "auto;cpu=7@high;worker=0-5" or "render=@realtime". Cores are a list
+     * of indices and ranges ("0-3,6").
+     */
+    [[nodiscard]] static std::expected<ThreadRoleConfig, std::string> parse(std::string_view spec,
+                                                                            const HostCpuInfo& cpu);
+
+    /**
+     * @brief Overrides for every non-default role, in parse() syntax ("off" if none)
+     */
+    [[nodiscard]] std::string describe() const;
+};
+
+/**
+ * @brief "0-3,6" style list
+ */
+[[nodiscard]] std::string formatCoreList(const std::vector<uint32_t>& cores);
+
+struct ThreadRoleStatus {
+    ThreadRole role = ThreadRole::Service;
+    std::string name;
+    uint64_t osThreadId = 0;
+    std::string error;              // Last apply failure, empty when the policy is in effect
+};
+
+// =============================================================================
+// REGISTRY
+// =============================================================================
+
+class WeaR_ThreadRoles {
+public:
+    WeaR_ThreadRoles();
+    ~WeaR_ThreadRoles();
+
+    WeaR_ThreadRoles(const WeaR_ThreadRoles&) = delete;
+    WeaR_ThreadRoles& operator=(const WeaR_ThreadRoles&) = delete;
+
+    /**
+     * @brief Replace the base (user) policies and re-apply them to all registered threads
+     *
+     * While an overlay is active it stays in effect; the new base takes
+     * over once the last overlay is removed.
+     */
+    void configure(const ThreadRoleConfig& config);
+
+    /**
+     * @brief Put a complete policy set (a title profile's) on top of the base
+     *
+     * The most recently added overlay still active wins.
+     * @return Handle for removeOverlay()
+     */
+    uint64_t addOverlay(const ThreadRoleConfig& config);
+
+    /**
+     * @brief Drop an overlay and re-apply what remains (base or another overlay)
+     */
+    void removeOverlay(uint64_t handle);
+
+    /**
+     * @brief Policies in effect: the top overlay, else the base
+     */
+    [[nodiscard]] ThreadRoleConfig getConfig() const;
+
+    /**
+     * @brief Register the calling thread and apply its role's policy
+     * @return Handle for unregisterThread()
+     */
+    uint64_t registerCurrentThread(ThreadRole role, std::string name);
+
+    /**
+     * @brief Forget a thread; must be called before it exits
+     */
+    void unregisterThread(uint64_t handle);
+
+    [[nodiscard]] std::vector<ThreadRoleStatus> getThreads() const;
+
+    /**
+     * @brief fork() support: hold the registry lock across the fork
+     *
+     * Call afterFork() in both processes. The child forgets every
+     * registered thread, the forking one included: their OS ids belong to
+     * the parent, and re-applying a policy would move the parent's threads.
+     */
+    void beforeFork();
+    void afterFork(bool inChild);
+
+private:
+    struct Entry;
+
+    [[nodiscard]] const ThreadRoleConfig& effectiveLocked() const;
+    void reapplyLocked();
+    void applyLocked(Entry& entry);
+
+    mutable std::mutex m_mutex;
+    ThreadRoleConfig m_base;
+    std::vector<std::pair<uint64_t, ThreadRoleConfig>> m_overlays;  // Oldest first
+    std::vector<uint32_t> m_processCores;   // Affinity at startup; restored by "off"
+    std::vector<std::unique_ptr<Entry>> m_threads;
+    std::array<bool, THREAD_ROLE_COUNT> m_warned{};
+    uint64_t m_nextHandle = 1;
+};
+
+/**
+ * @brief Get the thread-role registry (never destroyed, so threads may
+ *        unregister during static destruction)
+ */
+WeaR_ThreadRoles& getThreadRoles();
+
+/**
+ * @brief Registers the calling thread for the lifetime of the scope
+ */
+class ScopedThreadRole {
+public:
+    ScopedThreadRole(ThreadRole role, std::string name)
+        : m_handle(getThreadRoles().registerCurrentThread(role, std::move(name))) {}
+    ~ScopedThreadRole() { getThreadRoles().unregisterThread(m_handle); }
+
+    ScopedThreadRole(const ScopedThreadRole&) = delete;
+    ScopedThreadRole& operator=(const ScopedThreadRole&) = delete;
+
+private:
+    uint64_t m_handle;
+};
+
+} // namespace WeaR
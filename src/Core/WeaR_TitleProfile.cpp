@@ -0,0 +1,232 @@
+#include "WeaR_TitleProfile.h"
+#include "WeaR_Log.h"
+
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+namespace WeaR {
+
+const char* getCpuBackendName(CpuBackend backend) {
+    switch (backend) {
+        case CpuBackend::Interpreter: return "interpreter";
+        default:                      return "unknown";
+    }
+}
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+template<typename T>
+std::expected<T, std::string> parseRange(std::string_view key, std::string_view text, T min, T max) {
+    // from_chars ignores the C locale, so "0.5" parses under a decimal-comma
+    // locale too (the GUI runs with the user's locale)
+    T value{};
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || end != text.data() + text.size()) {
+        return std::unexpected(std::format("{} expects a number, got '{}'", key, text));
+    }
+    // Written so that NaN fails too
+    if (!(value >= min && value <= max)) {
+        return std::unexpected(std::format("{} must be between {} and {}", key, min, max));
+    }
+    return value;
+}
+
+/**
+ * @brief Apply one profile file on top of profile
+ * @return False if the file does not exist
+ */
+bool readProfileFile(const std::filesystem::path& path, TitleProfile& profile) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string line;
+    for (uint32_t lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        std::string_view text = trim(line);
+        if (text.empty() || text.front() == '#' || text.front() == ';') continue;
+
+        size_t equals = text.find('=');
+        if (equals == std::string_view::npos) {
+            WEAR_LOG_WARN(LogCategory::General, "{}:{}: expected key = value", path.string(), lineNumber);
+            continue;
+        }
+        auto result = profile.set(trim(text.substr(0, equals)), trim(text.substr(equals + 1)));
+        if (!result) {
+            WEAR_LOG_WARN(LogCategory::General, "{}:{}: {}", path.string(), lineNumber, result.error());
+        }
+    }
+
+    if (!profile.source.empty()) profile.source += " + ";
+    profile.source += path.filename().string();
+    return true;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// TitleProfile
+// =============================================================================
+
+std::expected<void, std::string> TitleProfile::set(std::string_view key, std::string_view value) {
+    if (key == "name") {
+        name = value;
+    } else if (key == "cpu_backend") {
+        for (uint8_t i = 0; i < static_cast<uint8_t>(CpuBackend::Count); ++i) {
+            if (value == getCpuBackendName(static_cast<CpuBackend>(i))) {
+                cpuBackend = static_cast<CpuBackend>(i);
+                return {};
+            }
+        }
+        return std::unexpected(std::format("unknown cpu_backend '{}'", value));
+    } else if (key == "slice_instructions") {
+        auto parsed = parseRange<uint32_t>(key, value, 1, ProfileConfig::MAX_SLICE_INSTRUCTIONS);
+        if (!parsed) return std::unexpected(parsed.error());
+        sliceInstructions = *parsed;
+    } else if (key == "idle_detection") {
+        auto parsed = parseRange<uint32_t>(key, value, 0, 1);
+        if (!parsed) return std::unexpected(parsed.error());
+        idleDetection = *parsed != 0;
+    } else if (key == "frames_in_flight") {
+        auto parsed = parseRange<uint32_t>(key, value, 1, ProfileConfig::MAX_FRAMES_IN_FLIGHT);
+        if (!parsed) return std::unexpected(parsed.error());
+        framesInFlight = *parsed;
+    } else if (key == "resolution_scale") {
+        auto parsed = parseRange<float>(key, value, ProfileConfig::MIN_RESOLUTION_SCALE,
+                                        ProfileConfig::MAX_RESOLUTION_SCALE);
+        if (!parsed) return std::unexpected(parsed.error());
+        resolutionScale = *parsed;
+    } else if (key == "pipeline_cache_budget_mb") {
+        auto parsed = parseRange<uint32_t>(key, value, 0, ProfileConfig::MAX_PIPELINE_CACHE_BUDGET_MB);
+        if (!parsed) return std::unexpected(parsed.error());
+        pipelineCacheBudgetMB = *parsed;
+    } else if (key == "thread_roles") {
+        threadRoles = value;
+    } else {
+        return std::unexpected(std::format("unknown key '{}'", key));
+    }
+    return {};
+}
+
+std::string TitleProfile::serialize() const {
+    std::ostringstream out;
+    out << "# WeaR-emu title profile" << (contentId.empty() ? "" : ": " + contentId) << "\n";
+    out << "name = " << name << "\n";
+    out << "cpu_backend = " << getCpuBackendName(cpuBackend) << "\n";
+    out << "slice_instructions = " << sliceInstructions << "\n";
+    out << "idle_detection = " << (idleDetection ? 1 : 0) << "\n";
+    out << "frames_in_flight = " << framesInFlight << "\n";
+    out << "resolution_scale = " << resolutionScale << "\n";
+    out << "pipeline_cache_budget_mb = " << pipelineCacheBudgetMB << "\n";
+    out << "thread_roles = " << threadRoles << "\n";
+    return out.str();
+}
+
+std::string TitleProfile::summary() const {
+    return std::format("{} [{}]: cpu={} slice={} idle={} frames_in_flight={} scale={:.2f} "
+                       "pipeline_cache={} MB threads={}",
+                       contentId.empty() ? "no content ID" : contentId,
+                       source.empty() ? "built-in" : source, getCpuBackendName(cpuBackend),
+                       sliceInstructions, idleDetection ? "detect" : "spin", framesInFlight,
+                       resolutionScale, pipelineCacheBudgetMB,
+                       threadRoles.empty() ? "global" : threadRoles);
+}
+
+// =============================================================================
+// WeaR_TitleProfiles
+// =============================================================================
+
+void WeaR_TitleProfiles::setDirectory(std::filesystem::path directory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directory = std::move(directory);
+}
+
+std::filesystem::path WeaR_TitleProfiles::getDirectory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_directory;
+}
+
+void WeaR_TitleProfiles::setDefaults(const TitleProfile& defaults) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_defaults = defaults;
+    m_defaults.contentId.clear();
+    m_defaults.source.clear();
+}
+
+bool WeaR_TitleProfiles::isValidContentId(std::string_view contentId) {
+    if (contentId.empty()) return false;
+    for (char c : contentId) {
+        const bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                        c == '-' || c == '_';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+TitleProfile WeaR_TitleProfiles::load(std::string_view contentId) const {
+    std::filesystem::path directory;
+    TitleProfile profile;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        directory = m_directory;
+        profile = m_defaults;
+    }
+    (void)readProfileFile(directory / ProfileConfig::DEFAULT_PROFILE_FILE, profile);
+
+    if (isValidContentId(contentId)) {
+        (void)readProfileFile(directory / (std::string(contentId) + ".ini"), profile);
+    } else if (!contentId.empty()) {
+        WEAR_LOG_WARN(LogCategory::General, "Content ID '{}' is not usable as a profile name", contentId);
+    }
+
+    // Keys in the files never override which title this is
+    profile.contentId = contentId;
+    return profile;
+}
+
+std::expected<void, std::string> WeaR_TitleProfiles::save(const TitleProfile& profile) const {
+    if (!profile.contentId.empty() && !isValidContentId(profile.contentId)) {
+        return std::unexpected(std::format("Invalid content ID '{}'", profile.contentId));
+    }
+
+    const std::filesystem::path directory = getDirectory();
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        return std::unexpected(std::format("Cannot create '{}': {}", directory.string(), ec.message()));
+    }
+
+    const std::filesystem::path target = profile.contentId.empty()
+        ? directory / ProfileConfig::DEFAULT_PROFILE_FILE
+        : directory / (profile.contentId + ".ini");
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+
+    {
+        std::ofstream file(temp, std::ios::trunc);
+        if (!file || !(file << profile.serialize())) {
+            return std::unexpected(std::format("Cannot write '{}'", temp.string()));
+        }
+    }
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return std::unexpected(std::format("Cannot replace '{}'", target.string()));
+    }
+    return {};
+}
+
+WeaR_TitleProfiles& getTitleProfiles() {
+    static WeaR_TitleProfiles instance;
+    return instance;
+}
+
+} // namespace WeaR
@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file WeaR_TitleProfile.h
+ * @brief Per-title performance profiles keyed by PKG content ID
+ *
+ * Profiles are plain key=value files in the profile directory:
+ * "default.ini" holds the baseline for every title and
+ * "<CONTENT_ID>.ini" overrides single keys for one title. The core loads
+ * the profile in loadGame() and applies it to the live subsystems; the
+ * frontend reads the render keys when it creates the render engine.
+ */
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace WeaR {
+
+enum class CpuBackend : uint8_t {
+    Interpreter,    // The only backend today; the key keeps profiles forward compatible
+    Count
+};
+
+[[nodiscard]] const char* getCpuBackendName(CpuBackend backend);
+
+namespace ProfileConfig {
+    constexpr uint32_t DEFAULT_SLICE_INSTRUCTIONS = 4096;
+    constexpr uint32_t MAX_SLICE_INSTRUCTIONS = 1u << 20;
+    constexpr uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
+    constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;            // Matches WeaR_RenderEngine
+    constexpr uint32_t DEFAULT_PIPELINE_CACHE_BUDGET_MB = 256;
+    constexpr uint32_t MAX_PIPELINE_CACHE_BUDGET_MB = 4096;
+    constexpr float MIN_RESOLUTION_SCALE = 0.5f;
+    constexpr float MAX_RESOLUTION_SCALE = 4.0f;
+    constexpr const char* DEFAULT_PROFILE_FILE = "default.ini";
+}
+
+struct TitleProfile {
+    std::string contentId;                  // Empty for titles without one (bare ELF)
+    std::string name;                       // Free text, for humans
+    std::string source;                     // Files the values came from, for logs
+    CpuBackend cpuBackend = CpuBackend::Interpreter;
+    uint32_t sliceInstructions = ProfileConfig::DEFAULT_SLICE_INSTRUCTIONS;   // Between stop/pause checks
+    bool idleDetection = true;              // Sleep in guest idle/spin loops instead of spinning
+    uint32_t framesInFlight = ProfileConfig::DEFAULT_FRAMES_IN_FLIGHT;
+    float resolutionScale = 1.0f;
+    uint32_t pipelineCacheBudgetMB = ProfileConfig::DEFAULT_PIPELINE_CACHE_BUDGET_MB;  // 0 = never save
+    std::string threadRoles;                // ThreadRoleConfig spec; empty = keep the global setting
+
+    /**
+     * @brief Set one key from a profile file
+     * @return Error text for unknown keys and out-of-range values
+     */
+    std::expected<void, std::string> set(std::string_view key, std::string_view value);
+
+    /**
+     * @brief Profile file contents with every key
+     */
+    [[nodiscard]] std::string serialize() const;
+
+    /**
+     * @brief One-line summary for logs
+     */
+    [[nodiscard]] std::string summary() const;
+};
+
+class WeaR_TitleProfiles {
+public:
+    void setDirectory(std::filesystem::path directory);
+    [[nodiscard]] std::filesystem::path getDirectory() const;
+
+    /**
+     * @brief Values load() starts from before reading any file (frontend settings)
+     */
+    void setDefaults(const TitleProfile& defaults);
+
+    /**
+     * @brief The defaults, then default.ini, then the title's file on top
+     *
+     * Missing files are fine (built-in defaults); bad lines are logged and
+     * skipped so one typo does not drop the whole profile.
+     */
+    [[nodiscard]] TitleProfile load(std::string_view contentId) const;
+
+    /**
+     * @brief Write the profile to <CONTENT_ID>.ini (or default.ini if it has no ID)
+     */
+    std::expected<void, std::string> save(const TitleProfile& profile) const;
+
+    /**
+     * @brief Content IDs are [A-Za-z0-9_-]; anything else is never used as a file name
+     */
+    [[nodiscard]] static bool isValidContentId(std::string_view contentId);
+
+private:
+    mutable std::mutex m_mutex;
+    std::filesystem::path m_directory = "profiles";
+    TitleProfile m_defaults;
+};
+
+/**
+ * @brief Get the global profile store
+ */
+WeaR_TitleProfiles& getTitleProfiles();
+
+} // namespace WeaR
@@ -0,0 +1,251 @@
+#include "WeaR_Trace.h"
+#include "WeaR_Log.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+
+namespace WeaR {
+
+// =============================================================================
+// CATEGORIES
+// =============================================================================
+
+const char* getTraceCategoryName(TraceCategory category) {
+    switch (category) {
+        case TraceCategory::CPU:     return "cpu";
+        case TraceCategory::Syscall: return "syscall";
+        case TraceCategory::GPU:     return "gpu";
+        case TraceCategory::Render:  return "render";
+        case TraceCategory::Audio:   return "audio";
+        case TraceCategory::VFS:     return "vfs";
+        default:                     return "other";
+    }
+}
+
+// =============================================================================
+// PER-THREAD RING
+// =============================================================================
+
+static_assert((TraceConfig::RING_CAPACITY & (TraceConfig::RING_CAPACITY - 1)) == 0,
+              "RING_CAPACITY must be a power of two");
+
+WeaR_TraceRing::WeaR_TraceRing(uint32_t threadId)
+    : m_slots(std::make_unique<Slot[]>(TraceConfig::RING_CAPACITY))
+    , m_threadId(threadId)
+{
+}
+
+void WeaR_TraceRing::push(const TraceEvent& event) {
+    uint64_t words[WORD_COUNT] = {};
+    std::memcpy(words, &event, sizeof(TraceEvent));
+
+    const uint64_t position = m_head.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[position & (TraceConfig::RING_CAPACITY - 1)];
+
+    // Sequence 2p+1 marks slot p as being written, 2p+2 as complete
+    slot.sequence.store(position * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(position * 2 + 2, std::memory_order_release);
+
+    m_head.store(position + 1, std::memory_order_release);
+}
+
+uint64_t WeaR_TraceRing::getCaptureOverwritten() const {
+    const uint64_t written = m_head.load(std::memory_order_relaxed) -
+                             m_captureHead.load(std::memory_order_relaxed);
+    return written > TraceConfig::RING_CAPACITY ? written - TraceConfig::RING_CAPACITY : 0;
+}
+
+void WeaR_TraceRing::snapshot(uint64_t sinceNs, std::vector<TraceEvent>& out) const {
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const uint64_t first = head > TraceConfig::RING_CAPACITY ? head - TraceConfig::RING_CAPACITY : 0;
+
+    for (uint64_t position = first; position < head; ++position) {
+        const Slot& slot = m_slots[position & (TraceConfig::RING_CAPACITY - 1)];
+
+        const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != position * 2 + 2) {
+            continue;   // Being written or already overwritten
+        }
+
+        uint64_t words[WORD_COUNT];
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+
+        TraceEvent event;
+        std::memcpy(&event, words, sizeof(TraceEvent));
+        if (event.startNs >= sinceNs) {
+            out.push_back(event);
+        }
+    }
+}
+
+// =============================================================================
+// TRACER
+// =============================================================================
+
+WeaR_Tracer& getTracer() {
+    static WeaR_Tracer instance;
+    return instance;
+}
+
+bool WeaR_Tracer::start() {
+#if WEAR_TRACE_ENABLED
+    {
+        // Rings of exited threads only hold events from earlier captures
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::erase_if(m_rings, [](const auto& ring) { return ring.use_count() == 1; });
+        for (const auto& ring : m_rings) {
+            ring->beginCapture();
+        }
+    }
+
+    m_captureEndNs.store(0, std::memory_order_relaxed);
+    m_captureStartNs.store(now(), std::memory_order_relaxed);
+    s_enabled.store(true, std::memory_order_release);
+    WEAR_LOG_INFO(LogCategory::General, "Trace capture started");
+    return true;
+#else
+    WEAR_LOG_WARN(LogCategory::General, "Trace capture unavailable: built with WEAR_ENABLE_TRACING=OFF");
+    return false;
+#endif
+}
+
+void WeaR_Tracer::stop() {
+#if WEAR_TRACE_ENABLED
+    if (s_enabled.exchange(false, std::memory_order_acq_rel)) {
+        m_captureEndNs.store(now(), std::memory_order_relaxed);
+        WEAR_LOG_INFO(LogCategory::General, "Trace capture stopped");
+    }
+#endif
+}
+
+void WeaR_Tracer::record(TraceCategory category, const char* name, uint64_t startNs, uint64_t endNs,
+                         const char* argName, uint64_t arg)
+{
+    TraceEvent event;
+    event.startNs = startNs;
+    event.durationNs = endNs > startNs ? endNs - startNs : 0;
+    event.name = name;
+    event.argName = argName;
+    event.arg = arg;
+    event.category = category;
+    localRing().push(event);
+}
+
+uint32_t WeaR_Tracer::localThreadId() {
+    thread_local uint32_t threadId = m_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+}
+
+WeaR_TraceRing& WeaR_Tracer::localRing() {
+    // Allocated on the first recorded event, so untraced threads cost nothing
+    thread_local std::shared_ptr<WeaR_TraceRing> ring;
+    if (!ring) {
+        ring = std::make_shared<WeaR_TraceRing>(localThreadId());
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rings.push_back(ring);
+    }
+    return *ring;
+}
+
+void WeaR_Tracer::setThreadName(std::string name) {
+    const uint32_t threadId = localThreadId();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threadNames[threadId] = std::move(name);
+}
+
+// =============================================================================
+// EXPORT
+// =============================================================================
+
+namespace {
+
+void appendEscaped(std::string& out, std::string_view text) {
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) out += c;
+    }
+}
+
+} // anonymous namespace
+
+std::string WeaR_Tracer::exportChromeJson() const {
+    std::vector<std::shared_ptr<WeaR_TraceRing>> rings;
+    std::unordered_map<uint32_t, std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        rings = m_rings;
+        threadNames = m_threadNames;
+    }
+
+    const uint64_t startNs = m_captureStartNs.load(std::memory_order_relaxed);
+    const uint64_t endNs = m_captureEndNs.load(std::memory_order_relaxed);
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() -> std::string_view {
+        std::string_view s = first ? "" : ",\n";
+        first = false;
+        return s;
+    };
+
+    out += separator();
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"WeaR-emu\"}}";
+
+    std::vector<TraceEvent> events;
+    uint64_t overwritten = 0;
+    for (const auto& ring : rings) {
+        const uint32_t tid = ring->getThreadId();
+
+        out += separator();
+        out += std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", tid);
+        auto it = threadNames.find(tid);
+        appendEscaped(out, it != threadNames.end() ? it->second : std::format("Thread {}", tid));
+        out += "\"}}";
+
+        events.clear();
+        ring->snapshot(startNs, events);
+        overwritten += ring->getCaptureOverwritten();
+
+        for (const TraceEvent& event : events) {
+            if (endNs != 0 && event.startNs > endNs) continue;
+
+            // Timestamps are microseconds relative to the capture start
+            out += separator();
+            out += std::format("{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},"
+                               "\"ts\":{:.3f},\"dur\":{:.3f}",
+                               event.name, getTraceCategoryName(event.category), tid,
+                               static_cast<double>(event.startNs - startNs) / 1000.0,
+                               static_cast<double>(event.durationNs) / 1000.0);
+            if (event.argName) {
+                out += std::format(",\"args\":{{\"{}\":{}}}", event.argName, event.arg);
+            }
+            out += "}";
+        }
+    }
+
+    out += std::format("\n],\"otherData\":{{\"events_overwritten\":{}}}}}\n", overwritten);
+    return out;
+}
+
+bool WeaR_Tracer::writeChromeJson(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file || !(file << exportChromeJson())) {
+        WEAR_LOG_ERROR(LogCategory::General, "Failed to write trace to {}", path);
+        return false;
+    }
+    WEAR_LOG_INFO(LogCategory::General, "Trace written to {}", path);
+    return true;
+}
+
+} // namespace WeaR
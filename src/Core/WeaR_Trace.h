@@ -0,0 +1,320 @@
+#pragma once
+
+/**
+ * @file WeaR_Trace.h
+ * @brief Timeline tracing across emulator threads (Chrome trace-event export)
+ *
+ * Every thread records complete events into its own fixed-size ring and
+ * overwrites the oldest entries, so a capture always holds the most recent
+ * activity of each thread. Recording is off until start(); a disabled trace
+ * point costs one relaxed load. Exports open in chrome://tracing and
+ * ui.perfetto.dev.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Set to 0 through the WEAR_ENABLE_TRACING CMake option to compile every
+ * trace point out.
+ */
+#ifndef WEAR_TRACE_ENABLED
+#define WEAR_TRACE_ENABLED 1
+#endif
+
+namespace WeaR {
+
+// =============================================================================
+// CATEGORIES
+// =============================================================================
+
+enum class TraceCategory : uint8_t {
+    CPU,
+    Syscall,
+    GPU,            // PM4 command processing
+    Render,         // Host Vulkan frame
+    Audio,
+    VFS,
+    Count
+};
+
+/**
+ * @brief Category name as shown in the trace viewer ("cpu", "syscall", ...)
+ */
+[[nodiscard]] const char* getTraceCategoryName(TraceCategory category);
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+namespace TraceConfig {
+    constexpr size_t RING_CAPACITY = 16384;             // Events per thread (power of two)
+    constexpr uint64_t CPU_SLICE_INSTRUCTIONS = 65536;  // Guest instructions per "cpu_slice" event
+}
+
+// =============================================================================
+// EVENT
+// =============================================================================
+
+struct TraceEvent {
+    uint64_t startNs = 0;           // steady_clock
+    uint64_t durationNs = 0;
+    const char* name = nullptr;     // Static string (not owned)
+    const char* argName = nullptr;  // Static string; nullptr = no argument
+    uint64_t arg = 0;
+    TraceCategory category = TraceCategory::CPU;
+};
+
+static_assert(std::is_trivially_copyable_v<TraceEvent>, "TraceEvent must be trivially copyable");
+
+// =============================================================================
+// PER-THREAD RING
+// =============================================================================
+
+/**
+ * @brief Single-producer overwrite ring readable from any thread
+ *
+ * Each slot carries its own sequence number (odd while being written), so
+ * an export running concurrently with the producer skips torn entries
+ * instead of blocking it.
+ */
+class WeaR_TraceRing {
+    static constexpr size_t WORD_COUNT = (sizeof(TraceEvent) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    explicit WeaR_TraceRing(uint32_t threadId);
+
+    // Producer side
+    void push(const TraceEvent& event);
+
+    // Any thread
+    void snapshot(uint64_t sinceNs, std::vector<TraceEvent>& out) const;
+    [[nodiscard]] uint64_t getEventsWritten() const { return m_head.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Remember the current head; getCaptureOverwritten() counts from here
+     */
+    void beginCapture() {
+        m_captureHead.store(m_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Events of the current capture lost to wrap-around
+     */
+    [[nodiscard]] uint64_t getCaptureOverwritten() const;
+    [[nodiscard]] uint32_t getThreadId() const { return m_threadId; }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> words[WORD_COUNT] = {};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    uint32_t m_threadId;
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    std::atomic<uint64_t> m_captureHead{0};     // m_head when the capture started
+};
+
+// =============================================================================
+// TRACER
+// =============================================================================
+
+class WeaR_Tracer {
+public:
+    WeaR_Tracer() = default;
+
+    WeaR_Tracer(const WeaR_Tracer&) = delete;
+    WeaR_Tracer& operator=(const WeaR_Tracer&) = delete;
+
+    [[nodiscard]] static bool isEnabled() {
+#if WEAR_TRACE_ENABLED
+        return s_enabled.load(std::memory_order_relaxed);
+#else
+        return false;
+#endif
+    }
+
+    [[nodiscard]] static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Begin a capture; only events recorded from now on are exported
+     * @return false if trace points were compiled out
+     */
+    bool start();
+
+    /**
+     * @brief Stop recording (the captured events stay available for export)
+     */
+    void stop();
+
+    /**
+     * @brief Record a complete event on the calling thread
+     */
+    void record(TraceCategory category, const char* name, uint64_t startNs, uint64_t endNs,
+                const char* argName = nullptr, uint64_t arg = 0);
+
+    /**
+     * @brief Name shown for the calling thread's track ("CPU", "Render", ...)
+     */
+    void setThreadName(std::string name);
+
+    /**
+     * @brief Chrome trace-event JSON of the current (or last) capture
+     */
+    [[nodiscard]] std::string exportChromeJson() const;
+
+    /**
+     * @brief Write exportChromeJson() to a file
+     */
+    bool writeChromeJson(const std::string& path) const;
+
+    [[nodiscard]] uint64_t getCaptureStartNs() const { return m_captureStartNs.load(std::memory_order_relaxed); }
+
+private:
+    [[nodiscard]] WeaR_TraceRing& localRing();
+    [[nodiscard]] uint32_t localThreadId();
+
+#if WEAR_TRACE_ENABLED
+    static inline std::atomic<bool> s_enabled{false};
+#endif
+
+    std::vector<std::shared_ptr<WeaR_TraceRing>> m_rings;
+    std::unordered_map<uint32_t, std::string> m_threadNames;
+    mutable std::mutex m_mutex;
+    std::atomic<uint32_t> m_nextThreadId{1};
+    std::atomic<uint64_t> m_captureStartNs{0};
+    std::atomic<uint64_t> m_captureEndNs{0};    // 0 while recording
+};
+
+/**
+ * @brief Get global tracer
+ */
+WeaR_Tracer& getTracer();
+
+// =============================================================================
+// SCOPED EVENTS
+// =============================================================================
+
+/**
+ * @brief Records one event spanning its lifetime (or until end())
+ */
+class WeaR_TraceScope {
+public:
+    WeaR_TraceScope(TraceCategory category, const char* name,
+                    const char* argName = nullptr, uint64_t arg = 0)
+        : m_name(WeaR_Tracer::isEnabled() ? name : nullptr)
+        , m_argName(argName)
+        , m_arg(arg)
+        , m_category(category)
+    {
+        if (m_name) {
+            m_startNs = WeaR_Tracer::now();
+        }
+    }
+
+    ~WeaR_TraceScope() { end(); }
+
+    WeaR_TraceScope(const WeaR_TraceScope&) = delete;
+    WeaR_TraceScope& operator=(const WeaR_TraceScope&) = delete;
+
+    /**
+     * @brief Set the argument once it is known (e.g. bytes actually read)
+     */
+    void setArg(const char* argName, uint64_t arg) {
+        m_argName = argName;
+        m_arg = arg;
+    }
+
+    void end() {
+        if (m_name) {
+            getTracer().record(m_category, m_name, m_startNs, WeaR_Tracer::now(), m_argName, m_arg);
+            m_name = nullptr;
+        }
+    }
+
+private:
+    const char* m_name;
+    const char* m_argName;
+    uint64_t m_arg;
+    uint64_t m_startNs = 0;
+    TraceCategory m_category;
+};
+
+/**
+ * @brief Splits a long-running loop into events of a fixed number of steps
+ *
+ * Used where one event per iteration would flood the ring (the interpreter
+ * loop). tick() is an increment and a compare while tracing is off.
+ */
+class WeaR_TraceSlice {
+public:
+    WeaR_TraceSlice(TraceCategory category, const char* name, const char* argName, uint64_t length)
+        : m_name(name), m_argName(argName), m_length(length), m_category(category)
+    {
+        m_startNs = WeaR_Tracer::isEnabled() ? WeaR_Tracer::now() : 0;
+    }
+
+    ~WeaR_TraceSlice() { flush(); }
+
+    WeaR_TraceSlice(const WeaR_TraceSlice&) = delete;
+    WeaR_TraceSlice& operator=(const WeaR_TraceSlice&) = delete;
+
+    void tick() {
+        if (++m_count >= m_length) {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Close the current slice early (before blocking or sleeping)
+     */
+    void flush() {
+        const bool enabled = WeaR_Tracer::isEnabled();
+        const uint64_t now = enabled ? WeaR_Tracer::now() : 0;
+        if (enabled && m_startNs != 0 && m_count != 0) {
+            getTracer().record(m_category, m_name, m_startNs, now, m_argName, m_count);
+        }
+        m_startNs = now;
+        m_count = 0;
+    }
+
+private:
+    const char* m_name;
+    const char* m_argName;
+    uint64_t m_length;
+    uint64_t m_count = 0;
+    uint64_t m_startNs;
+    TraceCategory m_category;
+};
+
+} // namespace WeaR
+
+// =============================================================================
+// TRACE MACROS
+// =============================================================================
+
+#define WEAR_TRACE_CONCAT_INNER(a, b) a##b
+#define WEAR_TRACE_CONCAT(a, b) WEAR_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * Event covering the rest of the enclosing block. Names must be string
+ * literals; the optional argument is a (literal name, integer) pair.
+ */
+#define WEAR_TRACE_SCOPE(category, name) \
+    ::WeaR::WeaR_TraceScope WEAR_TRACE_CONCAT(wearTraceScope, __LINE__)(category, name)
+
+#define WEAR_TRACE_SCOPE_ARG(category, name, argName, arg)                          \
+    ::WeaR::WeaR_TraceScope WEAR_TRACE_CONCAT(wearTraceScope, __LINE__)(            \
+        category, name, argName, static_cast<uint64_t>(arg))
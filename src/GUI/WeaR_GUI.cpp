@@ -2,11 +2,21 @@
 #include "WeaR_Style.h"
 #include "WeaR_SettingsDialog.h"
 #include "WeaR_Logger.h"
+#include "WeaR_LogModel.h"
 
 #include "Graphics/WeaR_RenderEngine.h"
+#include "Graphics/WeaR_RenderThread.h"
 #include "Core/WeaR_System.h"
 #include "Core/WeaR_EmulatorCore.h"
+#include "Core/WeaR_EmulationContext.h"
+#include "Core/WeaR_Trace.h"
+#include "Core/WeaR_Metrics.h"
+#include "Core/WeaR_ThreadRoles.h"
 #include "Input/WeaR_Input.h"
+#include "Audio/WeaR_AudioManager.h"
+#include "Audio/WeaR_QtAudioSink.h"
+#include "HLE/WeaR_Syscalls.h"
+#include "HLE/Graphics/WeaR_GnmDriver.h"
 
 #include <QApplication>
 #include <QVBoxLayout>
@@ -17,7 +27,8 @@
 #include <QTableWidget>
 #include <QHeaderView>
 #include <QDockWidget>
-#include <QTextEdit>
+#include <QListView>
+#include <QScrollBar>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QStatusBar>
@@ -25,9 +36,12 @@
 #include <QKeyEvent>
 #include <QShowEvent>
 #include <QCloseEvent>
+#include <QResizeEvent>
 #include <QFileInfo>
 #include <QDir>
+#include <QDateTime>
 
+#include <algorithm>
 #include <iostream>
 
 namespace WeaR {
@@ -36,9 +50,10 @@ namespace WeaR {
 // CONSTRUCTOR / DESTRUCTOR
 // =============================================================================
 
-WeaR_GUI::WeaR_GUI(const WeaR_Specs& specs, QWidget* parent)
+WeaR_GUI::WeaR_GUI(const WeaR_Specs& specs, WeaR_EmulationContext& emulation, QWidget* parent)
     : QMainWindow(parent)
     , m_specs(specs)
+    , m_emulation(emulation)
 {
     setWindowTitle("WeaR-emu - PlayStation 4 Emulator");
     setMinimumSize(1000, 650);
@@ -46,22 +61,18 @@ WeaR_GUI::WeaR_GUI(const WeaR_Specs& specs, QWidget* parent)
 
     applyStylesheet();
     setupUI();
-    initializeInputSystem();
 
-    // Connect global logger to GUI log console
-    connect(&getLogger(), &WeaR_Logger::logAdded, this, [this](const QString& message, int level) {
-        if (m_logConsole) {
-            QString color;
-            switch (level) {
-                case 0: color = "#5A5A5A"; break;  // Debug
-                case 1: color = "#CCCCCC"; break;  // Info
-                case 2: color = "#E67E22"; break;  // Warning
-                case 3: color = "#E74C3C"; break;  // Error
-                default: color = "#CCCCCC";
-            }
-            m_logConsole->append(QString("<span style='color:%1'>%2</span>").arg(color, message));
-        }
-    });
+    // Register the GUI log sink and drain it into the log view in batches
+    (void)getLogger();
+    m_logTimer = new QTimer(this);
+    connect(m_logTimer, &QTimer::timeout, this, &WeaR_GUI::onFlushLog);
+    m_logTimer->start(100);
+
+    applyLogSettings();
+    initializeInputSystem();
+    applyAudioSettings();
+    applyThreadSettings();
+    applyProfileDefaults();
 
     // Set application icon (for Windows taskbar only)
     QApplication::setWindowIcon(QIcon(":/resources/wear_logo.png"));
@@ -75,6 +86,24 @@ WeaR_GUI::WeaR_GUI(const WeaR_Specs& specs, QWidget* parent)
 
 WeaR_GUI::~WeaR_GUI() {
     stopRenderLoop();
+    getMetricsExporter().stop();
+    for (uint32_t id : { m_renderMetricsId, m_coreMetricsId, m_hostMetricsId }) {
+        if (id != 0) {
+            getMetricsExporter().removeCollector(id);
+        }
+    }
+}
+
+void WeaR_GUI::updateSpecs(const WeaR_Specs& specs) {
+    m_specs = specs;
+    log(QString("[GPU] Hardware changed since last run, re-detected: %1")
+            .arg(QString::fromStdString(m_specs.gpuName)), 2);
+    log(QString("[WEAR-GEN] %1").arg(m_specs.canRunFrameGen ? "Available" : "Not Supported"), 1);
+}
+
+void WeaR_GUI::setPipelineCache(std::string path, std::vector<uint8_t> data) {
+    m_pipelineCachePath = std::move(path);
+    m_pipelineCacheData = std::move(data);
 }
 
 // =============================================================================
@@ -134,6 +163,10 @@ void WeaR_GUI::setupToolbar() {
     m_refreshAction->setShortcut(QKeySequence("F5"));
     connect(m_refreshAction, &QAction::triggered, this, &WeaR_GUI::onRefreshGames);
 
+    m_saveProfileAction = m_toolbar->addAction("Save Profile");
+    m_saveProfileAction->setToolTip("Write the loaded title's current profile to <CONTENT_ID>.ini");
+    connect(m_saveProfileAction, &QAction::triggered, this, &WeaR_GUI::onSaveTitleProfile);
+
     addToolBar(Qt::TopToolBarArea, m_toolbar);
 }
 
@@ -185,13 +218,18 @@ void WeaR_GUI::setupLogDock() {
     m_logDock->setAllowedAreas(Qt::BottomDockWidgetArea | Qt::TopDockWidgetArea);
     m_logDock->setFeatures(QDockWidget::DockWidgetClosable | QDockWidget::DockWidgetMovable);
 
-    m_logConsole = new QTextEdit();
-    m_logConsole->setObjectName("logConsole");
-    m_logConsole->setReadOnly(true);
-    m_logConsole->setPlaceholderText("System logs...");
-    m_logConsole->setMinimumHeight(120);
+    m_logModel = new WeaR_LogModel(this);
 
-    m_logDock->setWidget(m_logConsole);
+    m_logView = new QListView();
+    m_logView->setObjectName("logConsole");
+    m_logView->setModel(m_logModel);
+    m_logView->setUniformItemSizes(true);
+    m_logView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_logView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    m_logView->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    m_logView->setMinimumHeight(120);
+
+    m_logDock->setWidget(m_logView);
     addDockWidget(Qt::BottomDockWidgetArea, m_logDock);
 }
 
@@ -235,7 +273,7 @@ void WeaR_GUI::onBootBios() {
         log("[BIOS] === BOOT BIOS CLICKED ===", 1);
         
         log("[BIOS] Step 1: Getting emulator core...", 1);
-        auto& core = getEmulatorCore();
+        auto& core = m_emulation.getCore();
         
         log("[BIOS] Step 2: Checking initialization...", 1);
         if (!core.isInitialized()) {
@@ -284,7 +322,35 @@ void WeaR_GUI::onBootBios() {
 
 void WeaR_GUI::onOpenSettings() {
     SettingsDialog dialog(this);
-    dialog.exec();
+    if (dialog.exec() == QDialog::Accepted) {
+        applyLogSettings();
+        applyAudioSettings();
+        applyMetricsSettings();
+        applyThreadSettings();
+        applyProfileDefaults();
+        if (m_renderThread) {
+            m_renderThread->setVsyncEnabled(SettingsDialog::getSetting("Graphics/VSync", true).toBool());
+        }
+        if (m_engine) {
+            m_engine->getPerfOverlay().setEnabled(SettingsDialog::getSetting("Graphics/PerfOverlay", false).toBool());
+        }
+    }
+}
+
+void WeaR_GUI::onSaveTitleProfile() {
+    const auto& core = m_emulation.getCore();
+    const TitleProfile& profile = core.getTitleProfile();
+    if (!core.isGameLoaded() || profile.contentId.empty()) {
+        log("[PROFILE] Load a PKG title first; only titles with a content ID have their own profile", 2);
+        return;
+    }
+
+    auto result = getTitleProfiles().save(profile);
+    if (!result) {
+        log(QString("[PROFILE] %1").arg(QString::fromStdString(result.error())), 3);
+        return;
+    }
+    log(QString("[PROFILE] Saved %1.ini").arg(QString::fromStdString(profile.contentId)), 1);
 }
 
 void WeaR_GUI::onRefreshGames() {
@@ -316,7 +382,7 @@ void WeaR_GUI::loadGameFile(const QString& filepath) {
     log(QString("[LOAD] Loading: %1").arg(filepath), 1);
     updateGameState(GameState::Loading, "Loading...");
 
-    auto& core = getEmulatorCore();
+    auto& core = m_emulation.getCore();
     if (!core.isInitialized()) {
         if (!core.initialize(m_specs)) {
             log("[ERROR] Failed to initialize emulator core", 3);
@@ -345,6 +411,7 @@ void WeaR_GUI::bootGame() {
 
     log("[BOOT] Starting emulation...", 1);
     initializeRenderEngine();
+    applyRenderProfile();
     startRenderLoop();
 
     updateGameState(GameState::Running, QFileInfo(m_loadedGamePath).fileName());
@@ -380,22 +447,23 @@ void WeaR_GUI::scanGameDirectory() {
 // =============================================================================
 
 void WeaR_GUI::log(const QString& message, int level) {
-    if (!m_logConsole) return;
+    getLogger().log(message, static_cast<LogLevel>(level));
+    emit logMessage(message, level);
+}
 
-    QString color;
-    switch (level) {
-        case 0: color = "#5A5A5A"; break;  // Debug
-        case 1: color = "#CCCCCC"; break;  // Info
-        case 2: color = "#E67E22"; break;  // Warning
-        case 3: color = "#E74C3C"; break;  // Error
-        default: color = "#CCCCCC";
-    }
+void WeaR_GUI::onFlushLog() {
+    QList<LogEntry> entries = getLogger().flushMessages();
+    if (entries.isEmpty() || !m_logModel) return;
 
-    QString timestamp = QTime::currentTime().toString("HH:mm:ss");
-    m_logConsole->append(QString("<span style='color:#5A5A5A'>[%1]</span> <span style='color:%2'>%3</span>")
-        .arg(timestamp, color, message));
+    // Follow the tail only if the user has not scrolled up
+    QScrollBar* scrollBar = m_logView->verticalScrollBar();
+    bool atBottom = scrollBar->value() == scrollBar->maximum();
 
-    emit logMessage(message, level);
+    m_logModel->appendEntries(entries);
+
+    if (atBottom) {
+        m_logView->scrollToBottom();
+    }
 }
 
 // =============================================================================
@@ -444,6 +512,119 @@ void WeaR_GUI::updateControllerStatus() {
     }
 }
 
+// =============================================================================
+// TRACE CAPTURE
+// =============================================================================
+
+void WeaR_GUI::toggleTraceCapture() {
+    auto& tracer = getTracer();
+    if (!WeaR_Tracer::isEnabled()) {
+        if (tracer.start()) {
+            log("[TRACE] Capture started (F4 to stop)", 1);
+        } else {
+            log("[TRACE] Tracing is not compiled into this build", 2);
+        }
+        return;
+    }
+
+    tracer.stop();
+    QDir dir(QDir(QApplication::applicationDirPath()).filePath("traces"));
+    dir.mkpath(".");
+    QString path = dir.filePath(QString("wear_trace_%1.json")
+        .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")));
+
+    if (tracer.writeChromeJson(path.toStdString())) {
+        log(QString("[TRACE] Saved %1 (open in ui.perfetto.dev or chrome://tracing)").arg(path), 1);
+    } else {
+        log(QString("[TRACE] Failed to write %1").arg(path), 3);
+    }
+}
+
+// =============================================================================
+// METRICS EXPORT
+// =============================================================================
+
+void WeaR_GUI::startMetrics() {
+    if (m_coreMetricsId != 0) {
+        return;
+    }
+    m_coreMetricsId = getMetricsExporter().addCollector([this](WeaR_MetricsWriter& writer) {
+        collectCoreMetrics(writer, m_emulation);
+    });
+    m_hostMetricsId = getMetricsExporter().addCollector(collectHostMetrics);
+    applyMetricsSettings();
+}
+
+void WeaR_GUI::applyMetricsSettings() {
+    MetricsConfig config;
+    config.httpPort = static_cast<uint16_t>(SettingsDialog::getSetting("Metrics/HttpPort", 0).toInt());
+    if (SettingsDialog::getSetting("Metrics/Remote", false).toBool()) {
+        config.bindAddress = "0.0.0.0";
+    }
+    config.filePath = SettingsDialog::getSetting("Metrics/File", "").toString().toStdString();
+
+    auto result = getMetricsExporter().start(config);
+    if (!result) {
+        log(QString("[METRICS] %1").arg(QString::fromStdString(result.error())), 3);
+    }
+}
+
+// =============================================================================
+// THREAD SCHEDULING
+// =============================================================================
+
+void WeaR_GUI::applyThreadSettings() {
+    const std::string spec = SettingsDialog::getSetting("System/ThreadRoles", "auto").toString().toStdString();
+    auto config = ThreadRoleConfig::parse(spec, getHostCpuInfo());
+    if (!config) {
+        log(QString("[THREADS] Ignoring '%1': %2").arg(QString::fromStdString(spec),
+                                                        QString::fromStdString(config.error())), 3);
+        return;
+    }
+    getThreadRoles().configure(*config);
+}
+
+// =============================================================================
+// TITLE PROFILES
+// =============================================================================
+
+void WeaR_GUI::applyProfileDefaults() {
+    // Settings-dialog values a title's profile may override; used from the next load
+    TitleProfile defaults;
+    defaults.resolutionScale = std::clamp(SettingsDialog::getSetting("Graphics/ResolutionScale", 1.0).toFloat(),
+                                          ProfileConfig::MIN_RESOLUTION_SCALE,
+                                          ProfileConfig::MAX_RESOLUTION_SCALE);
+    getTitleProfiles().setDefaults(defaults);
+}
+
+// =============================================================================
+// AUDIO SETTINGS
+// =============================================================================
+
+void WeaR_GUI::applyAudioSettings() {
+    AudioBackendConfig config;
+    QString name = SettingsDialog::getSetting("Audio/Backend", "device").toString();
+    config.backend = parseAudioBackend(name.toStdString()).value_or(AudioBackend::Device);
+    config.wavDirectory = QDir(QApplication::applicationDirPath()).filePath("audio_capture").toStdString();
+    
+    auto& audio = m_emulation.getAudio();
+    audio.setDeviceSinkFactory(createQtAudioSinkFactory());
+    audio.setBackend(config);
+    audio.setMasterVolume(SettingsDialog::getSetting("Audio/MasterVolume", 100).toInt() / 100.0f);
+}
+
+// =============================================================================
+// LOG SETTINGS
+// =============================================================================
+
+void WeaR_GUI::applyLogSettings() {
+    for (LogCategory category : SettingsDialog::LOG_CATEGORIES) {
+        QString key = QString("Logging/%1").arg(getLogCategoryName(category));
+        QString name = SettingsDialog::getSetting(key, "info").toString();
+        WeaR_LogFilter::setThreshold(category, parseLogThreshold(name.toStdString()).value_or(LogThreshold::Info));
+    }
+}
+
 // =============================================================================
 // RENDER ENGINE
 // =============================================================================
@@ -455,15 +636,29 @@ void WeaR_GUI::initializeRenderEngine() {
     if (!m_renderWidget) {
         m_renderWidget = new QWidget(this);
         m_renderWidget->setMinimumSize(640, 480);
+        m_renderWidget->installEventFilter(this);
     }
 
     m_engine = std::make_unique<WeaR_RenderEngine>();
 
     RenderEngineConfig config;
+    config.context = &m_emulation;
     config.appName = "WeaR-emu";
     config.windowWidth = static_cast<uint32_t>(m_renderWidget->width());
     config.windowHeight = static_cast<uint32_t>(m_renderWidget->height());
     config.enableValidation = false;
+    config.vsyncEnabled = SettingsDialog::getSetting("Graphics/VSync", true).toBool();
+    // Render keys of the title profile loadGame() just applied
+    const TitleProfile& profile = m_emulation.getCore().getTitleProfile();
+    config.framesInFlight = profile.framesInFlight;
+    config.pipelineCacheBudgetBytes = uint64_t{profile.pipelineCacheBudgetMB} * 1024 * 1024;
+    config.pipelineCachePath = m_pipelineCachePath;
+    config.savePipelineCache = profile.pipelineCacheBudgetMB != 0;
+    // The startup load is used once; later inits pick up what shutdown saved
+    config.pipelineCacheData = m_pipelineCacheData.empty()
+        ? WeaR_RenderEngine::readPipelineCacheFile(m_pipelineCachePath)
+        : std::move(m_pipelineCacheData);
+    m_pipelineCacheData.clear();
 
     auto hwnd = reinterpret_cast<HWND>(m_renderWidget->winId());
     auto result = m_engine->initVulkan(m_specs, hwnd, config);
@@ -473,49 +668,88 @@ void WeaR_GUI::initializeRenderEngine() {
         return;
     }
 
+    // Counters are polled by the render thread twice per second
+    auto& overlay = m_engine->getPerfOverlay();
+    overlay.setCounterSource([&emulation = m_emulation] {
+        PerfCounters counters;
+        counters.instructions = emulation.getCore().getInstructionCount();
+        counters.syscalls = emulation.getSyscalls().getTotalCalls();
+        counters.unimplementedSyscalls = emulation.getSyscalls().getUnimplementedCalls();
+        counters.pm4Packets = emulation.getGnmDriver().getPacketsProcessed();
+        counters.drawCalls = emulation.getGnmDriver().getDrawCallsQueued();
+        counters.audioFill = emulation.getAudio().getBufferFill();
+        return counters;
+    });
+    overlay.setEnabled(SettingsDialog::getSetting("Graphics/PerfOverlay", false).toBool());
+
     m_engineInitialized = true;
     log("[VULKAN] Render engine initialized", 1);
 }
 
+void WeaR_GUI::applyRenderProfile() {
+    if (!m_engineInitialized || !m_engine) return;
+
+    // The renderer outlives titles; later boots bring their own render keys
+    const TitleProfile& profile = m_emulation.getCore().getTitleProfile();
+    m_engine->setPipelineCachePolicy(profile.pipelineCacheBudgetMB != 0,
+                                     uint64_t{profile.pipelineCacheBudgetMB} * 1024 * 1024);
+    if (m_renderThread && m_renderThread->isRunning()) {
+        m_renderThread->setFramesInFlight(profile.framesInFlight);
+    } else {
+        m_engine->setFramesInFlight(profile.framesInFlight);
+    }
+}
+
 void WeaR_GUI::startRenderLoop() {
-    if (m_renderTimer) return;
+    if (!m_engineInitialized || !m_engine) return;
+
+    if (!m_renderThread) {
+        m_renderThread = std::make_unique<WeaR_RenderThread>();
+
+        WeaR_RenderThread* thread = m_renderThread.get();
+        m_renderMetricsId = getMetricsExporter().addCollector([thread](WeaR_MetricsWriter& writer) {
+            writer.counter("wear_frames_total", "Frames presented", thread->getFrameCount());
+            writer.gauge("wear_frame_time_last_seconds", "Duration of the last presented frame",
+                         thread->getLastFrameTimeUs() / 1e6);
+            writer.histogram("wear_frame_time_seconds", "Presented frame durations",
+                             thread->getFrameTimeHistogram().snapshot());
+        });
+    }
+    if (m_renderThread->isRunning()) return;
 
-    m_renderTimer = new QTimer(this);
-    connect(m_renderTimer, &QTimer::timeout, this, &WeaR_GUI::onRenderFrame);
-    m_renderTimer->start(16);
+    // Frames are produced on the render thread; the GUI only samples stats
+    m_renderThread->start(m_engine.get());
+
+    if (!m_statsTimer) {
+        m_statsTimer = new QTimer(this);
+        connect(m_statsTimer, &QTimer::timeout, this, &WeaR_GUI::onUpdateFrameStats);
+    }
+    m_statsTimer->start(1000);
 
     m_fpsTimer.start();
-    m_frameCount = 0;
+    m_lastFrameCount = 0;
 }
 
 void WeaR_GUI::stopRenderLoop() {
-    if (m_renderTimer) {
-        m_renderTimer->stop();
-        delete m_renderTimer;
-        m_renderTimer = nullptr;
+    if (m_statsTimer) {
+        m_statsTimer->stop();
     }
-}
-
-void WeaR_GUI::onRenderFrame() {
-    if (!m_engineInitialized || !m_engine) return;
-
-    auto result = m_engine->renderFrame();
-    if (!result) {
-        log(QString("[RENDER] Error: %1").arg(QString::fromStdString(result.error())), 3);
+    // Must join before m_engine is destroyed
+    if (m_renderThread) {
+        m_renderThread->stop();
     }
-
-    m_frameCount++;
-    updateFPSCounter();
 }
 
-void WeaR_GUI::updateFPSCounter() {
-    qint64 elapsed = m_fpsTimer.elapsed();
-    if (elapsed >= 1000) {
-        m_currentFPS = static_cast<float>(m_frameCount) * 1000.0f / elapsed;
+void WeaR_GUI::onUpdateFrameStats() {
+    if (!m_renderThread) return;
+
+    qint64 elapsed = m_fpsTimer.restart();
+    uint64_t frames = m_renderThread->getFrameCount();
+    if (elapsed > 0) {
+        m_currentFPS = static_cast<float>(frames - m_lastFrameCount) * 1000.0f / elapsed;
         m_fpsLabel->setText(QString("FPS: %1").arg(m_currentFPS, 0, 'f', 1));
-        m_frameCount = 0;
-        m_fpsTimer.restart();
     }
+    m_lastFrameCount = frames;
 }
 
 // =============================================================================
@@ -532,13 +766,31 @@ void WeaR_GUI::closeEvent(QCloseEvent* event) {
     QMainWindow::closeEvent(event);
 }
 
+bool WeaR_GUI::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == m_renderWidget && event->type() == QEvent::Resize && m_renderThread) {
+        auto* resize = static_cast<QResizeEvent*>(event);
+        m_renderThread->requestResize(static_cast<uint32_t>(resize->size().width()),
+                                      static_cast<uint32_t>(resize->size().height()));
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
+
 void WeaR_GUI::keyPressEvent(QKeyEvent* event) {
-    WeaR_InputManager::get().handleKeyPress(event->key(), true);
+    if (event->key() == Qt::Key_F3 && !event->isAutoRepeat() && m_engine) {
+        auto& overlay = m_engine->getPerfOverlay();
+        overlay.setEnabled(!overlay.isEnabled());
+        return;
+    }
+    if (event->key() == Qt::Key_F4 && !event->isAutoRepeat()) {
+        toggleTraceCapture();
+        return;
+    }
+    m_emulation.getInput().handleKeyPress(event->key(), true);
     QMainWindow::keyPressEvent(event);
 }
 
 void WeaR_GUI::keyReleaseEvent(QKeyEvent* event) {
-    WeaR_InputManager::get().handleKeyPress(event->key(), false);
+    m_emulation.getInput().handleKeyPress(event->key(), false);
     QMainWindow::keyReleaseEvent(event);
 }
 
@@ -11,6 +11,8 @@
 #include <QTimer>
 #include <QElapsedTimer>
 #include <memory>
+#include <string>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 class QLabel;
@@ -18,15 +20,18 @@ class QPushButton;
 class QToolBar;
 class QTableWidget;
 class QDockWidget;
-class QTextEdit;
+class QListView;
 class QAction;
 QT_END_NAMESPACE
 
 namespace WeaR {
 
+class WeaR_EmulationContext;
 class WeaR_RenderEngine;
+class WeaR_RenderThread;
 class WeaR_System;
 class WeaR_Input;
+class WeaR_LogModel;
 
 enum class GameState : uint8_t { NoGame, Loading, Loaded, Running, Paused, Error };
 
@@ -37,9 +42,30 @@ class WeaR_GUI : public QMainWindow {
     Q_OBJECT
 
 public:
-    explicit WeaR_GUI(const WeaR_Specs& specs, QWidget* parent = nullptr);
+    /**
+     * @param emulation The console this window drives; must outlive the window
+     */
+    WeaR_GUI(const WeaR_Specs& specs, WeaR_EmulationContext& emulation, QWidget* parent = nullptr);
     ~WeaR_GUI() override;
 
+    /**
+     * @brief Replace the cached specs the window was built with (GPU or driver changed)
+     */
+    void updateSpecs(const WeaR_Specs& specs);
+
+    /**
+     * @brief Pipeline cache loaded at startup; handed to the engine at init
+     */
+    void setPipelineCache(std::string path, std::vector<uint8_t> data);
+
+    /**
+     * @brief Register the metrics collectors and start the exporter
+     *
+     * Call once the emulator core has initialized: the exporter thread reads
+     * the core through the collectors as soon as they are registered.
+     */
+    void startMetrics();
+
 signals:
     void launchGameRequested();
     void gameLoaded(uint64_t entryPoint);
@@ -50,15 +76,18 @@ protected:
     void closeEvent(QCloseEvent* event) override;
     void keyPressEvent(QKeyEvent* event) override;
     void keyReleaseEvent(QKeyEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
 
 private slots:
     void onLoadGame();
     void onBootBios();
     void onOpenSettings();
     void onRefreshGames();
+    void onSaveTitleProfile();
     void onGameDoubleClicked(int row, int column);
-    void onRenderFrame();
+    void onUpdateFrameStats();
     void onInputPoll();
+    void onFlushLog();
 
 private:
     // Setup
@@ -81,15 +110,23 @@ private:
 
     // Systems
     void initializeInputSystem();
+    void applyAudioSettings();
+    void applyLogSettings();
+    void toggleTraceCapture();
+    void applyMetricsSettings();
+    void applyThreadSettings();
+    void applyProfileDefaults();
     void initializeRenderEngine();
+    void applyRenderProfile();
     void startRenderLoop();
     void stopRenderLoop();
     void updateControllerStatus();
-    void updateFPSCounter();
 
     // Data
     WeaR_Specs m_specs;
+    WeaR_EmulationContext& m_emulation;
     std::unique_ptr<WeaR_RenderEngine> m_engine;
+    std::unique_ptr<WeaR_RenderThread> m_renderThread;
     std::unique_ptr<WeaR_System> m_system;
     std::unique_ptr<WeaR_Input> m_input;
 
@@ -98,19 +135,26 @@ private:
     QString m_loadedGamePath;
 
     // Timers
-    QTimer* m_renderTimer = nullptr;
+    QTimer* m_statsTimer = nullptr;
     QTimer* m_inputTimer = nullptr;
+    QTimer* m_logTimer = nullptr;
     QElapsedTimer m_fpsTimer;
-    uint32_t m_frameCount = 0;
+    uint64_t m_lastFrameCount = 0;
     float m_currentFPS = 0.0f;
     bool m_engineInitialized = false;
     bool m_controllerConnected = false;
+    uint32_t m_coreMetricsId = 0;       // Collectors for m_emulation and host counters
+    uint32_t m_hostMetricsId = 0;
+    uint32_t m_renderMetricsId = 0;     // Frame-time collector (removed before m_renderThread)
+    std::string m_pipelineCachePath;
+    std::vector<uint8_t> m_pipelineCacheData;
 
     // UI Elements
     QToolBar* m_toolbar = nullptr;
     QTableWidget* m_gameTable = nullptr;
     QDockWidget* m_logDock = nullptr;
-    QTextEdit* m_logConsole = nullptr;
+    QListView* m_logView = nullptr;
+    WeaR_LogModel* m_logModel = nullptr;
     QWidget* m_renderWidget = nullptr;
 
     // Toolbar Actions
@@ -118,6 +162,7 @@ private:
     QAction* m_biosAction = nullptr;
     QAction* m_settingsAction = nullptr;
     QAction* m_refreshAction = nullptr;
+    QAction* m_saveProfileAction = nullptr;
 
     // Status Bar
     QLabel* m_controllerLabel = nullptr;
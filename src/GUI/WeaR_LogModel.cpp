@@ -0,0 +1,65 @@
+#include "WeaR_LogModel.h"
+
+#include <QColor>
+
+#include <algorithm>
+
+namespace WeaR {
+
+WeaR_LogModel::WeaR_LogModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int WeaR_LogModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_entries.size());
+}
+
+QVariant WeaR_LogModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_entries.size()) {
+        return QVariant();
+    }
+
+    const LogEntry& entry = m_entries[index.row()];
+    switch (role) {
+        case Qt::DisplayRole:
+            return entry.text;
+        case Qt::ForegroundRole:
+            switch (entry.level) {
+                case LogLevel::Debug:   return QColor("#5A5A5A");
+                case LogLevel::Warning: return QColor("#E67E22");
+                case LogLevel::Error:   return QColor("#E74C3C");
+                default:                return QColor("#CCCCCC");
+            }
+        default:
+            return QVariant();
+    }
+}
+
+void WeaR_LogModel::appendEntries(const QList<LogEntry>& entries) {
+    if (entries.isEmpty()) return;
+
+    // Only the newest MAX_LINES of the batch can survive
+    qsizetype first = std::max<qsizetype>(0, entries.size() - MAX_LINES);
+    qsizetype incoming = entries.size() - first;
+
+    qsizetype overflow = m_entries.size() + incoming - MAX_LINES;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(overflow - 1));
+        m_entries.remove(0, overflow);
+        endRemoveRows();
+    }
+
+    int start = static_cast<int>(m_entries.size());
+    beginInsertRows(QModelIndex(), start, start + static_cast<int>(incoming - 1));
+    m_entries.append(entries.mid(first));
+    endInsertRows();
+}
+
+void WeaR_LogModel::clear() {
+    beginResetModel();
+    m_entries.clear();
+    endResetModel();
+}
+
+} // namespace WeaR
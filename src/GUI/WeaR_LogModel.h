@@ -0,0 +1,41 @@
+#pragma once
+
+/**
+ * @file WeaR_LogModel.h
+ * @brief Capped list model behind the GUI log view
+ *
+ * Lines arrive in batches from a GUI timer, so each batch costs one
+ * insert (and at most one trim) notification regardless of its size.
+ * The view only paints visible rows.
+ */
+
+#include "WeaR_Logger.h"
+
+#include <QAbstractListModel>
+#include <QList>
+
+namespace WeaR {
+
+class WeaR_LogModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    static constexpr int MAX_LINES = 5000;
+
+    explicit WeaR_LogModel(QObject* parent = nullptr);
+
+    [[nodiscard]] int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    [[nodiscard]] QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Append a batch, discarding the oldest lines beyond MAX_LINES
+     */
+    void appendEntries(const QList<LogEntry>& entries);
+
+    void clear();
+
+private:
+    QList<LogEntry> m_entries;
+};
+
+} // namespace WeaR
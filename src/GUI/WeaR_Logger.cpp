@@ -1,7 +1,6 @@
 #include "WeaR_Logger.h"
 
-#include <QDateTime>
-#include <iostream>
+#include <utility>
 
 namespace WeaR {
 
@@ -15,12 +14,19 @@ WeaR_Logger& getLogger() {
 }
 
 // =============================================================================
-// CONSTRUCTOR
+// CONSTRUCTOR / DESTRUCTOR
 // =============================================================================
 
 WeaR_Logger::WeaR_Logger(QObject* parent)
     : QObject(parent)
 {
+    // Non-owning registration: the async logger outlives this singleton
+    // because it is constructed first
+    getAsyncLogger().addSink(std::shared_ptr<WeaR_LogSink>(this, [](WeaR_LogSink*) {}));
+}
+
+WeaR_Logger::~WeaR_Logger() {
+    getAsyncLogger().removeSink(this);
 }
 
 // =============================================================================
@@ -28,37 +34,24 @@ WeaR_Logger::WeaR_Logger(QObject* parent)
 // =============================================================================
 
 void WeaR_Logger::log(const std::string& message, LogLevel level) {
-    log(QString::fromStdString(message), level);
+    getAsyncLogger().log(level, "{}", message);
 }
 
 void WeaR_Logger::log(const QString& message, LogLevel level) {
-    QString formatted = formatMessage(message, level);
-    
-    {
-        QMutexLocker locker(&m_mutex);
-        m_pendingMessages.enqueue(formatted);
-        m_messageCount++;
-    }
-
-    // Emit signal (will be queued if cross-thread)
-    emit logAdded(formatted, static_cast<int>(level));
-
-    // Also output to console
-    std::cout << formatted.toStdString() << "\n";
+    getAsyncLogger().log(level, "{}", message.toStdString());
 }
 
-QString WeaR_Logger::formatMessage(const QString& message, LogLevel level) const {
-    QString prefix;
-    switch (level) {
-        case LogLevel::Debug:   prefix = "[DBG]"; break;
-        case LogLevel::Info:    prefix = "[INF]"; break;
-        case LogLevel::Warning: prefix = "[WRN]"; break;
-        case LogLevel::Error:   prefix = "[ERR]"; break;
-        case LogLevel::Syscall: prefix = "[SYS]"; break;
-    }
+void WeaR_Logger::write(const LogLine& line) {
+    LogEntry entry;
+    entry.text = QString::fromUtf8(line.text.data(), static_cast<qsizetype>(line.text.size()));
+    entry.level = line.level;
 
-    QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss.zzz");
-    return QString("%1 %2 %3").arg(timestamp, prefix, message);
+    QMutexLocker locker(&m_mutex);
+    m_pendingMessages.append(std::move(entry));
+    if (m_pendingMessages.size() > MAX_PENDING_MESSAGES) {
+        m_pendingMessages.removeFirst();
+    }
+    m_messageCount++;
 }
 
 void WeaR_Logger::clear() {
@@ -66,13 +59,9 @@ void WeaR_Logger::clear() {
     m_pendingMessages.clear();
 }
 
-QStringList WeaR_Logger::flushMessages() {
+QList<LogEntry> WeaR_Logger::flushMessages() {
     QMutexLocker locker(&m_mutex);
-    QStringList messages;
-    while (!m_pendingMessages.isEmpty()) {
-        messages.append(m_pendingMessages.dequeue());
-    }
-    return messages;
+    return std::exchange(m_pendingMessages, {});
 }
 
 bool WeaR_Logger::hasPending() const {
@@ -2,49 +2,51 @@
 
 /**
  * @file WeaR_Logger.h
- * @brief Thread-safe logging system for kernel output
+ * @brief GUI sink for the asynchronous logger
  * 
- * Allows CPU thread to safely push log messages to GUI.
- * Uses Qt signals/slots for thread-safe updates.
+ * Receives formatted lines from the WeaR_AsyncLogger thread and queues
+ * them for the GUI, which drains the queue in batches on a timer.
  */
 
+#include "Core/WeaR_Log.h"
+
 #include <QObject>
 #include <QString>
 #include <QMutex>
-#include <QQueue>
+#include <QList>
 
 namespace WeaR {
 
 /**
- * @brief Log message severity
+ * @brief One formatted line awaiting display
  */
-enum class LogLevel : uint8_t {
-    Debug,
-    Info,
-    Warning,
-    Error,
-    Syscall
+struct LogEntry {
+    QString text;
+    LogLevel level = LogLevel::Info;
 };
 
 /**
- * @brief Thread-safe kernel logger
+ * @brief Thread-safe kernel logger (GUI side)
  */
-class WeaR_Logger : public QObject {
+class WeaR_Logger : public QObject, public WeaR_LogSink {
     Q_OBJECT
 
 public:
+    // Oldest lines are discarded beyond this many undelivered messages
+    static constexpr int MAX_PENDING_MESSAGES = 10000;
+
     explicit WeaR_Logger(QObject* parent = nullptr);
-    ~WeaR_Logger() override = default;
+    ~WeaR_Logger() override;
 
     /**
-     * @brief Log a message (thread-safe)
+     * @brief Log a preformatted message (thread-safe, asynchronous)
      * @param message Message to log
      * @param level Severity level
      */
     void log(const std::string& message, LogLevel level = LogLevel::Info);
 
     /**
-     * @brief Log with QString (thread-safe)
+     * @brief Log with QString (thread-safe, asynchronous)
      */
     void log(const QString& message, LogLevel level = LogLevel::Info);
 
@@ -54,9 +56,9 @@ public:
     void clear();
 
     /**
-     * @brief Get pending messages (call from GUI thread)
+     * @brief Take all pending lines (call from GUI thread)
      */
-    QStringList flushMessages();
+    QList<LogEntry> flushMessages();
 
     /**
      * @brief Check if there are pending messages
@@ -68,17 +70,14 @@ public:
      */
     [[nodiscard]] uint64_t getMessageCount() const { return m_messageCount; }
 
-signals:
     /**
-     * @brief Emitted when new log is available (use queued connection)
+     * @brief WeaR_LogSink - called on the logger thread
      */
-    void logAdded(const QString& message, int level);
+    void write(const LogLine& line) override;
 
 private:
-    QString formatMessage(const QString& message, LogLevel level) const;
-
     mutable QMutex m_mutex;
-    QQueue<QString> m_pendingMessages;
+    QList<LogEntry> m_pendingMessages;
     uint64_t m_messageCount = 0;
 };
 
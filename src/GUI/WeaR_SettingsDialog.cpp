@@ -1,6 +1,7 @@
 #include "WeaR_SettingsDialog.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
+#include <QGridLayout>
 #include <QTabWidget>
 #include <QLabel>
 #include <QLineEdit>
@@ -8,6 +9,7 @@
 #include <QCheckBox>
 #include <QComboBox>
 #include <QSlider>
+#include <QSpinBox>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QGroupBox>
@@ -143,6 +145,25 @@ void SettingsDialog::setupUI()
     m_enableDebugConsole = new QCheckBox("Enable Debug Console / Log Window");
     debugLayout->addWidget(m_enableDebugConsole);
 
+    QGridLayout* logLevelGrid = new QGridLayout;
+    for (size_t i = 0; i < LOG_CATEGORIES.size(); ++i) {
+        int row = static_cast<int>(i / 2);
+        int column = static_cast<int>(i % 2) * 2;
+
+        QComboBox* combo = new QComboBox;
+        combo->addItem("Debug", "debug");
+        combo->addItem("Info", "info");
+        combo->addItem("Warning", "warning");
+        combo->addItem("Error", "error");
+        combo->addItem("Off", "off");
+        m_logLevelCombos[i] = combo;
+
+        logLevelGrid->addWidget(new QLabel(QString("%1 log level:").arg(getLogCategoryName(LOG_CATEGORIES[i]))),
+                                row, column);
+        logLevelGrid->addWidget(combo, row, column + 1);
+    }
+    debugLayout->addLayout(logLevelGrid);
+
     generalLayout->addWidget(firmwareGroup);
     generalLayout->addWidget(debugGroup);
     generalLayout->addStretch();
@@ -163,6 +184,7 @@ void SettingsDialog::setupUI()
     m_resolutionScaleCombo->addItem("1080p (1.5x)", 1.5);
     m_resolutionScaleCombo->addItem("1440p (2x)", 2);
     m_resolutionScaleCombo->addItem("4K (3x)", 3);
+    m_resolutionScaleCombo->setToolTip("Default for titles whose profile does not set resolution_scale");
     displayGrid->addWidget(m_resolutionScaleCombo, 0, 1);
     
     displayGrid->addWidget(new QLabel("Aspect Ratio:"), 1, 0);
@@ -179,6 +201,10 @@ void SettingsDialog::setupUI()
     m_enableWeaRGen = new QCheckBox("Enable WeaR-Gen (AI Frame Generation)");
     m_enableWeaRGen->setToolTip("Use compute shaders to generate intermediate frames");
     displayGrid->addWidget(m_enableWeaRGen, 3, 0, 1, 2);
+
+    m_showPerfOverlay = new QCheckBox("Show Performance Overlay (F3)");
+    m_showPerfOverlay->setToolTip("MIPS, syscall rates, PM4/draw counts, queue depth, audio fill and frame times");
+    displayGrid->addWidget(m_showPerfOverlay, 4, 0, 1, 2);
     
     graphicsLayout->addWidget(displayGroup);
     graphicsLayout->addStretch();
@@ -206,7 +232,25 @@ void SettingsDialog::setupUI()
     volumeLayout->addWidget(m_masterVolumeSlider);
     volumeLayout->addWidget(m_volumeLabel);
     
+    QGroupBox* outputGroup = new QGroupBox("Output Backend", audioTab);
+    QVBoxLayout* outputLayout = new QVBoxLayout(outputGroup);
+    
+    QHBoxLayout* audioBackendLayout = new QHBoxLayout;
+    audioBackendLayout->addWidget(new QLabel("Backend:"));
+    m_audioBackendCombo = new QComboBox;
+    m_audioBackendCombo->addItem("Audio Device", "device");
+    m_audioBackendCombo->addItem("Null (Real-time)", "null");
+    m_audioBackendCombo->addItem("Null (Unthrottled)", "null-unthrottled");
+    m_audioBackendCombo->addItem("WAV File Capture", "wav");
+    audioBackendLayout->addWidget(m_audioBackendCombo);
+    outputLayout->addLayout(audioBackendLayout);
+    
+    QLabel* audioNote = new QLabel("Null and WAV backends need no audio device. Applies to newly opened ports.");
+    audioNote->setStyleSheet("color: #888888; font-style: italic;");
+    outputLayout->addWidget(audioNote);
+    
     audioLayout->addWidget(volumeGroup);
+    audioLayout->addWidget(outputGroup);
     audioLayout->addStretch();
     m_tabs->addTab(audioTab, "Audio");
 
@@ -230,6 +274,42 @@ void SettingsDialog::setupUI()
     regionGrid->addWidget(m_regionCombo, 1, 1);
     
     systemLayout->addWidget(regionGroup);
+
+    QGroupBox* metricsGroup = new QGroupBox("Metrics Export (Prometheus)", systemTab);
+    QGridLayout* metricsGrid = new QGridLayout(metricsGroup);
+
+    metricsGrid->addWidget(new QLabel("HTTP Port:"), 0, 0);
+    m_metricsPortSpin = new QSpinBox;
+    m_metricsPortSpin->setRange(0, 65535);
+    m_metricsPortSpin->setSpecialValueText("Off");
+    m_metricsPortSpin->setToolTip("Serve counters at http://<host>:<port>/metrics");
+    metricsGrid->addWidget(m_metricsPortSpin, 0, 1);
+
+    m_metricsRemote = new QCheckBox("Accept remote scrapes (listen on all interfaces)");
+    metricsGrid->addWidget(m_metricsRemote, 1, 0, 1, 2);
+
+    metricsGrid->addWidget(new QLabel("Metrics File:"), 2, 0);
+    m_metricsFileEdit = new QLineEdit;
+    m_metricsFileEdit->setPlaceholderText("Optional, rewritten every 5 s (e.g. wear.prom)");
+    metricsGrid->addWidget(m_metricsFileEdit, 2, 1);
+
+    systemLayout->addWidget(metricsGroup);
+
+    QGroupBox* threadsGroup = new QGroupBox("Thread Scheduling", systemTab);
+    QGridLayout* threadsGrid = new QGridLayout(threadsGroup);
+
+    threadsGrid->addWidget(new QLabel("Pinning:"), 0, 0);
+    m_threadRolesCombo = new QComboBox;
+    m_threadRolesCombo->setEditable(true);
+    m_threadRolesCombo->addItems({"auto", "off"});
+    m_threadRolesCombo->setToolTip(
+        "auto: guest CPU and render threads get their own cores and higher priority\n"
+        "off: leave scheduling to the OS\n"
+        "Custom: role=cores[@priority] separated by ';', e.g. auto;cpu=7@high;worker=0-5\n"
+        "Roles: cpu, render, gui, audio, worker, io, service");
+    threadsGrid->addWidget(m_threadRolesCombo, 0, 1);
+
+    systemLayout->addWidget(threadsGroup);
     systemLayout->addStretch();
     m_tabs->addTab(systemTab, "System");
 
@@ -269,13 +349,9 @@ void SettingsDialog::setupUI()
     dangerGroup->setStyleSheet("QGroupBox { border-color: #FF6600; color: #FF6600; }");
     QVBoxLayout* dangerLayout = new QVBoxLayout(dangerGroup);
     
-    m_unlockFpsLimit = new QCheckBox("Unlock FPS Limit (May cause instability)");
     m_enableValidationLayers = new QCheckBox("Enable Vulkan Validation Layers (Slower)");
-    m_aggressiveRecompiler = new QCheckBox("Aggressive Shader Recompiler (Experimental)");
     
-    dangerLayout->addWidget(m_unlockFpsLimit);
     dangerLayout->addWidget(m_enableValidationLayers);
-    dangerLayout->addWidget(m_aggressiveRecompiler);
     
     QLabel* warningLabel = new QLabel("These settings may cause crashes or unexpected behavior.");
     warningLabel->setStyleSheet("color: #FF4444; font-weight: bold;");
@@ -321,6 +397,12 @@ void SettingsDialog::loadSettings()
     m_firmwarePathEdit->setText(settings.value("General/FirmwarePath", "").toString());
     m_enableDebugConsole->setChecked(settings.value("General/DebugConsole", true).toBool());
 
+    for (size_t i = 0; i < LOG_CATEGORIES.size(); ++i) {
+        QString key = QString("Logging/%1").arg(getLogCategoryName(LOG_CATEGORIES[i]));
+        int levelIndex = m_logLevelCombos[i]->findData(settings.value(key, "info").toString());
+        if (levelIndex != -1) m_logLevelCombos[i]->setCurrentIndex(levelIndex);
+    }
+
     // Graphics
     int resIndex = m_resolutionScaleCombo->findData(settings.value("Graphics/ResolutionScale", 1).toDouble());
     if (resIndex != -1) m_resolutionScaleCombo->setCurrentIndex(resIndex);
@@ -331,22 +413,28 @@ void SettingsDialog::loadSettings()
     m_aspectRatioCombo->setCurrentText(aspect);
     
     m_enableWeaRGen->setChecked(settings.value("Graphics/WeaRGen", false).toBool());
+    m_showPerfOverlay->setChecked(settings.value("Graphics/PerfOverlay", false).toBool());
 
     // Audio
     int vol = settings.value("Audio/MasterVolume", 100).toInt();
     m_masterVolumeSlider->setValue(vol);
+    
+    int backendIndex = m_audioBackendCombo->findData(settings.value("Audio/Backend", "device").toString());
+    if (backendIndex != -1) m_audioBackendCombo->setCurrentIndex(backendIndex);
 
     // System
     m_languageCombo->setCurrentText(settings.value("System/Language", "English (US)").toString());
     m_regionCombo->setCurrentText(settings.value("System/Region", "NTSC-U (USA)").toString());
+    m_metricsPortSpin->setValue(settings.value("Metrics/HttpPort", 0).toInt());
+    m_metricsRemote->setChecked(settings.value("Metrics/Remote", false).toBool());
+    m_metricsFileEdit->setText(settings.value("Metrics/File", "").toString());
+    m_threadRolesCombo->setCurrentText(settings.value("System/ThreadRoles", "auto").toString());
 
     // Input
     m_inputBackendCombo->setCurrentText(settings.value("Input/Backend", "Auto-Detect").toString());
 
     // Experimental
-    m_unlockFpsLimit->setChecked(settings.value("Experimental/UnlockFPS", false).toBool());
     m_enableValidationLayers->setChecked(settings.value("Experimental/ValidationLayers", false).toBool());
-    m_aggressiveRecompiler->setChecked(settings.value("Experimental/AggressiveRecompiler", false).toBool());
 }
 
 void SettingsDialog::saveSettings()
@@ -357,26 +445,35 @@ void SettingsDialog::saveSettings()
     settings.setValue("General/FirmwarePath", m_firmwarePathEdit->text());
     settings.setValue("General/DebugConsole", m_enableDebugConsole->isChecked());
 
+    for (size_t i = 0; i < LOG_CATEGORIES.size(); ++i) {
+        QString key = QString("Logging/%1").arg(getLogCategoryName(LOG_CATEGORIES[i]));
+        settings.setValue(key, m_logLevelCombos[i]->currentData());
+    }
+
     // Graphics
     settings.setValue("Graphics/ResolutionScale", m_resolutionScaleCombo->currentData());
     settings.setValue("Graphics/VSync", m_enableVSync->isChecked());
     settings.setValue("Graphics/AspectRatio", m_aspectRatioCombo->currentText());
     settings.setValue("Graphics/WeaRGen", m_enableWeaRGen->isChecked());
+    settings.setValue("Graphics/PerfOverlay", m_showPerfOverlay->isChecked());
 
     // Audio
     settings.setValue("Audio/MasterVolume", m_masterVolumeSlider->value());
+    settings.setValue("Audio/Backend", m_audioBackendCombo->currentData());
 
     // System
     settings.setValue("System/Language", m_languageCombo->currentText());
     settings.setValue("System/Region", m_regionCombo->currentText());
+    settings.setValue("Metrics/HttpPort", m_metricsPortSpin->value());
+    settings.setValue("Metrics/Remote", m_metricsRemote->isChecked());
+    settings.setValue("Metrics/File", m_metricsFileEdit->text());
+    settings.setValue("System/ThreadRoles", m_threadRolesCombo->currentText().trimmed());
 
     // Input
     settings.setValue("Input/Backend", m_inputBackendCombo->currentText());
 
     // Experimental
-    settings.setValue("Experimental/UnlockFPS", m_unlockFpsLimit->isChecked());
     settings.setValue("Experimental/ValidationLayers", m_enableValidationLayers->isChecked());
-    settings.setValue("Experimental/AggressiveRecompiler", m_aggressiveRecompiler->isChecked());
 
     accept(); // Close the dialog
 }
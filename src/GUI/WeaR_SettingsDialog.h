@@ -1,14 +1,19 @@
 #pragma once
 
+#include "Core/WeaR_Log.h"
+
 #include <QDialog>
 #include <QSettings>
 #include <QScopedPointer>
 
+#include <array>
+
 class QTabWidget;
 class QLineEdit;
 class QCheckBox;
 class QComboBox;
 class QSlider;
+class QSpinBox;
 class QLabel;
 
 namespace WeaR {
@@ -23,6 +28,13 @@ public:
     // Static helper to get a setting value anywhere in the app
     static QVariant getSetting(const QString& key, const QVariant& defaultValue = QVariant());
 
+    // Categories with a per-category log level in the settings ("Logging/<NAME>")
+    static constexpr std::array<LogCategory, 7> LOG_CATEGORIES = {
+        LogCategory::CPU, LogCategory::Syscall, LogCategory::GNM,
+        LogCategory::VFS, LogCategory::PKG, LogCategory::ELF,
+        LogCategory::Audio
+    };
+
 private slots:
     void applySettings();
     void selectFirmwarePath();
@@ -38,28 +50,33 @@ private:
     // General Tab
     QLineEdit* m_firmwarePathEdit;
     QCheckBox* m_enableDebugConsole;
+    std::array<QComboBox*, LOG_CATEGORIES.size()> m_logLevelCombos{};
 
     // Graphics Tab
     QComboBox* m_resolutionScaleCombo;
     QCheckBox* m_enableVSync;
     QComboBox* m_aspectRatioCombo;
     QCheckBox* m_enableWeaRGen;     // NEW: WeaR-Gen AI Frame Generation
+    QCheckBox* m_showPerfOverlay;
 
     // Audio Tab
     QSlider* m_masterVolumeSlider;
     QLabel* m_volumeLabel;
+    QComboBox* m_audioBackendCombo;
 
     // System Tab
     QComboBox* m_languageCombo;
     QComboBox* m_regionCombo;
+    QSpinBox* m_metricsPortSpin;
+    QCheckBox* m_metricsRemote;
+    QLineEdit* m_metricsFileEdit;
+    QComboBox* m_threadRolesCombo;
 
     // Input Tab (NEW)
     QComboBox* m_inputBackendCombo;
 
     // Experimental Tab (NEW)
-    QCheckBox* m_unlockFpsLimit;
     QCheckBox* m_enableValidationLayers;
-    QCheckBox* m_aggressiveRecompiler;
 };
 
 } // namespace WeaR
@@ -0,0 +1,283 @@
+#include "WeaR_PerfOverlay.h"
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <utility>
+
+namespace WeaR {
+
+// =============================================================================
+// LAYOUT & FONT
+// =============================================================================
+
+namespace {
+
+using Color = std::array<float, 3>;
+
+constexpr Color COLOR_PANEL   = {0.02f, 0.02f, 0.03f};
+constexpr Color COLOR_LABEL   = {0.20f, 1.00f, 0.50f};    // WeaR neon green
+constexpr Color COLOR_TEXT    = {0.90f, 0.90f, 0.90f};
+constexpr Color COLOR_WARN    = {1.00f, 0.80f, 0.20f};
+constexpr Color COLOR_BAD     = {1.00f, 0.30f, 0.30f};
+constexpr Color COLOR_GRID    = {0.25f, 0.25f, 0.30f};
+
+constexpr float PIXEL = 2.0f;                   // Screen pixels per font pixel
+constexpr float GLYPH_ADVANCE = 4.0f * PIXEL;   // 3 columns + 1 spacing
+constexpr float LINE_HEIGHT = 7.0f * PIXEL;     // 5 rows + 2 spacing
+constexpr float PANEL_X = 8.0f;
+constexpr float PANEL_Y = 8.0f;
+constexpr float PADDING = 6.0f;
+constexpr float GRAPH_HEIGHT = 40.0f;
+constexpr float GRAPH_BAR_WIDTH = 2.0f;
+constexpr float GRAPH_MAX_MS = 100.0f / 3.0f;   // Two 60 Hz frames
+constexpr float TARGET_FRAME_MS = 1000.0f / 60.0f;
+
+/**
+ * @brief Pack a 3x5 glyph, one 3-bit row per argument (MSB = left column)
+ */
+constexpr uint16_t glyph(uint16_t r0, uint16_t r1, uint16_t r2, uint16_t r3, uint16_t r4) {
+    return static_cast<uint16_t>((r0 << 12) | (r1 << 9) | (r2 << 6) | (r3 << 3) | r4);
+}
+
+constexpr std::array<uint16_t, 10> DIGIT_GLYPHS = {
+    glyph(0b111, 0b101, 0b101, 0b101, 0b111),   // 0
+    glyph(0b010, 0b110, 0b010, 0b010, 0b111),   // 1
+    glyph(0b111, 0b001, 0b111, 0b100, 0b111),   // 2
+    glyph(0b111, 0b001, 0b111, 0b001, 0b111),   // 3
+    glyph(0b101, 0b101, 0b111, 0b001, 0b001),   // 4
+    glyph(0b111, 0b100, 0b111, 0b001, 0b111),   // 5
+    glyph(0b111, 0b100, 0b111, 0b101, 0b111),   // 6
+    glyph(0b111, 0b001, 0b001, 0b001, 0b001),   // 7
+    glyph(0b111, 0b101, 0b111, 0b101, 0b111),   // 8
+    glyph(0b111, 0b101, 0b111, 0b001, 0b111),   // 9
+};
+
+constexpr std::array<uint16_t, 26> LETTER_GLYPHS = {
+    glyph(0b010, 0b101, 0b111, 0b101, 0b101),   // A
+    glyph(0b110, 0b101, 0b110, 0b101, 0b110),   // B
+    glyph(0b011, 0b100, 0b100, 0b100, 0b011),   // C
+    glyph(0b110, 0b101, 0b101, 0b101, 0b110),   // D
+    glyph(0b111, 0b100, 0b110, 0b100, 0b111),   // E
+    glyph(0b111, 0b100, 0b110, 0b100, 0b100),   // F
+    glyph(0b011, 0b100, 0b101, 0b101, 0b011),   // G
+    glyph(0b101, 0b101, 0b111, 0b101, 0b101),   // H
+    glyph(0b111, 0b010, 0b010, 0b010, 0b111),   // I
+    glyph(0b001, 0b001, 0b001, 0b101, 0b010),   // J
+    glyph(0b101, 0b101, 0b110, 0b101, 0b101),   // K
+    glyph(0b100, 0b100, 0b100, 0b100, 0b111),   // L
+    glyph(0b101, 0b111, 0b111, 0b101, 0b101),   // M
+    glyph(0b110, 0b101, 0b101, 0b101, 0b101),   // N
+    glyph(0b010, 0b101, 0b101, 0b101, 0b010),   // O
+    glyph(0b110, 0b101, 0b110, 0b100, 0b100),   // P
+    glyph(0b010, 0b101, 0b101, 0b110, 0b011),   // Q
+    glyph(0b110, 0b101, 0b110, 0b101, 0b101),   // R
+    glyph(0b011, 0b100, 0b010, 0b001, 0b110),   // S
+    glyph(0b111, 0b010, 0b010, 0b010, 0b010),   // T
+    glyph(0b101, 0b101, 0b101, 0b101, 0b111),   // U
+    glyph(0b101, 0b101, 0b101, 0b101, 0b010),   // V
+    glyph(0b101, 0b101, 0b111, 0b111, 0b101),   // W
+    glyph(0b101, 0b101, 0b010, 0b101, 0b101),   // X
+    glyph(0b101, 0b101, 0b010, 0b010, 0b010),   // Y
+    glyph(0b111, 0b001, 0b010, 0b100, 0b111),   // Z
+};
+
+uint16_t getGlyph(char c) {
+    if (c >= '0' && c <= '9') return DIGIT_GLYPHS[c - '0'];
+    if (c >= 'A' && c <= 'Z') return LETTER_GLYPHS[c - 'A'];
+    if (c >= 'a' && c <= 'z') return LETTER_GLYPHS[c - 'a'];
+    switch (c) {
+        case '.': return glyph(0b000, 0b000, 0b000, 0b000, 0b010);
+        case '/': return glyph(0b001, 0b001, 0b010, 0b100, 0b100);
+        case '%': return glyph(0b101, 0b001, 0b010, 0b100, 0b101);
+        case ':': return glyph(0b000, 0b010, 0b000, 0b010, 0b000);
+        case '-': return glyph(0b000, 0b000, 0b111, 0b000, 0b000);
+        default:  return 0;
+    }
+}
+
+uint64_t counterDelta(uint64_t now, uint64_t before) {
+    return now >= before ? now - before : 0;    // Counters reset on reboot
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// SAMPLING
+// =============================================================================
+
+void WeaR_PerfOverlay::setCounterSource(CounterSource source) {
+    std::lock_guard lock(m_sourceMutex);
+    m_source = std::move(source);
+}
+
+void WeaR_PerfOverlay::recordFrame(float cpuMs, float gpuMs, size_t queueDepth) {
+    m_cpuHistory[m_historyHead] = cpuMs;
+    m_gpuHistory[m_historyHead] = gpuMs;
+    m_historyHead = (m_historyHead + 1) % GRAPH_SAMPLES;
+
+    ++m_windowFrames;
+    m_windowCpuMs += cpuMs;
+    if (gpuMs >= 0.0f) {
+        m_windowGpuMs += gpuMs;
+        ++m_windowGpuFrames;
+    }
+    m_windowMaxDepth = std::max(m_windowMaxDepth, queueDepth);
+}
+
+void WeaR_PerfOverlay::sample(Clock::time_point now) {
+    PerfCounters counters{};
+    {
+        std::lock_guard lock(m_sourceMutex);
+        if (m_source) counters = m_source();
+    }
+
+    if (m_lastSample != Clock::time_point{}) {
+        const double seconds = std::chrono::duration<double>(now - m_lastSample).count();
+        const double frames = static_cast<double>(std::max<uint64_t>(m_windowFrames, 1));
+
+        m_rates.fps = static_cast<float>(m_windowFrames / seconds);
+        m_rates.mips = static_cast<float>(
+            counterDelta(counters.instructions, m_lastCounters.instructions) / seconds / 1e6);
+        m_rates.syscallsPerSec = static_cast<float>(
+            counterDelta(counters.syscalls, m_lastCounters.syscalls) / seconds);
+        m_rates.unimplementedPerSec = static_cast<float>(
+            counterDelta(counters.unimplementedSyscalls, m_lastCounters.unimplementedSyscalls) / seconds);
+        m_rates.pm4PerFrame = static_cast<float>(
+            counterDelta(counters.pm4Packets, m_lastCounters.pm4Packets) / frames);
+        m_rates.drawsPerFrame = static_cast<float>(
+            counterDelta(counters.drawCalls, m_lastCounters.drawCalls) / frames);
+        m_rates.maxQueueDepth = m_windowMaxDepth;
+        m_rates.avgCpuMs = static_cast<float>(m_windowCpuMs / frames);
+        m_rates.avgGpuMs = m_windowGpuFrames > 0
+            ? static_cast<float>(m_windowGpuMs / m_windowGpuFrames) : -1.0f;
+    }
+    m_rates.audioFill = counters.audioFill;
+
+    m_lastSample = now;
+    m_lastCounters = counters;
+    m_windowFrames = 0;
+    m_windowCpuMs = 0.0;
+    m_windowGpuMs = 0.0;
+    m_windowGpuFrames = 0;
+    m_windowMaxDepth = 0;
+}
+
+// =============================================================================
+// GEOMETRY
+// =============================================================================
+
+void WeaR_PerfOverlay::addRect(float x, float y, float w, float h, const Color& color) {
+    if (m_vertices.size() + 6 > MAX_VERTICES) return;
+
+    const float x0 = x * m_scaleX - 1.0f;
+    const float y0 = y * m_scaleY - 1.0f;
+    const float x1 = (x + w) * m_scaleX - 1.0f;
+    const float y1 = (y + h) * m_scaleY - 1.0f;
+    const auto [r, g, b] = color;
+
+    m_vertices.push_back({{x0, y0, 0.0f}, {r, g, b}});
+    m_vertices.push_back({{x1, y0, 0.0f}, {r, g, b}});
+    m_vertices.push_back({{x1, y1, 0.0f}, {r, g, b}});
+    m_vertices.push_back({{x0, y0, 0.0f}, {r, g, b}});
+    m_vertices.push_back({{x1, y1, 0.0f}, {r, g, b}});
+    m_vertices.push_back({{x0, y1, 0.0f}, {r, g, b}});
+}
+
+void WeaR_PerfOverlay::addText(float x, float y, std::string_view text, const Color& color) {
+    for (char c : text) {
+        const uint16_t bits = getGlyph(c);
+        for (int row = 0; row < 5; ++row) {
+            const uint16_t rowBits = (bits >> ((4 - row) * 3)) & 0b111;
+
+            // Merge horizontal runs into one quad
+            int col = 0;
+            while (col < 3) {
+                if (!(rowBits & (0b100 >> col))) { ++col; continue; }
+                int run = col;
+                while (run < 3 && (rowBits & (0b100 >> run))) ++run;
+                addRect(x + col * PIXEL, y + row * PIXEL, (run - col) * PIXEL, PIXEL, color);
+                col = run;
+            }
+        }
+        x += GLYPH_ADVANCE;
+    }
+}
+
+void WeaR_PerfOverlay::addGraph(float x, float y, std::string_view label,
+                                const std::array<float, GRAPH_SAMPLES>& samples) {
+    addText(x, y, label, COLOR_LABEL);
+    y += LINE_HEIGHT;
+
+    const float width = GRAPH_SAMPLES * GRAPH_BAR_WIDTH;
+    addRect(x, y + GRAPH_HEIGHT, width, 1.0f, COLOR_GRID);
+    addRect(x, y + GRAPH_HEIGHT * (1.0f - TARGET_FRAME_MS / GRAPH_MAX_MS), width, 1.0f, COLOR_GRID);
+
+    // Oldest sample on the left
+    for (size_t i = 0; i < GRAPH_SAMPLES; ++i) {
+        const float ms = samples[(m_historyHead + i) % GRAPH_SAMPLES];
+        if (ms <= 0.0f) continue;
+
+        const float h = std::min(ms / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+        const Color& color = ms <= TARGET_FRAME_MS ? COLOR_LABEL
+                           : ms <= GRAPH_MAX_MS   ? COLOR_WARN : COLOR_BAD;
+        addRect(x + i * GRAPH_BAR_WIDTH, y + GRAPH_HEIGHT - h, GRAPH_BAR_WIDTH, h, color);
+    }
+}
+
+const std::vector<OverlayVertex>& WeaR_PerfOverlay::build(uint32_t width, uint32_t height) {
+    m_vertices.clear();
+    if (width == 0 || height == 0) return m_vertices;
+
+    const auto now = Clock::now();
+    if (now - m_lastSample >= SAMPLE_INTERVAL) {
+        sample(now);
+    }
+
+    m_scaleX = 2.0f / static_cast<float>(width);
+    m_scaleY = 2.0f / static_cast<float>(height);
+
+    const std::string gpu = m_rates.avgGpuMs >= 0.0f
+        ? std::format("{:.2f} MS", m_rates.avgGpuMs) : std::string("--");
+    const std::string audio = m_rates.audioFill >= 0.0f
+        ? std::format("{:.0f}%", m_rates.audioFill * 100.0f) : std::string("--");
+
+    struct Line { std::string_view label; std::string value; Color color; };
+    const Line lines[] = {
+        { "FPS",        std::format("{:.1f}", m_rates.fps), COLOR_TEXT },
+        { "CPU",        std::format("{:.2f} MS", m_rates.avgCpuMs),
+                        m_rates.avgCpuMs > TARGET_FRAME_MS ? COLOR_WARN : COLOR_TEXT },
+        { "GPU",        gpu, m_rates.avgGpuMs > TARGET_FRAME_MS ? COLOR_WARN : COLOR_TEXT },
+        { "MIPS",       std::format("{:.1f}", m_rates.mips), COLOR_TEXT },
+        { "SYSCALL/S",  std::format("{:.0f}", m_rates.syscallsPerSec), COLOR_TEXT },
+        { "UNIMPL/S",   std::format("{:.0f}", m_rates.unimplementedPerSec),
+                        m_rates.unimplementedPerSec > 0.0f ? COLOR_WARN : COLOR_TEXT },
+        { "PM4/FRAME",  std::format("{:.0f}", m_rates.pm4PerFrame), COLOR_TEXT },
+        { "DRAW/FRAME", std::format("{:.0f}", m_rates.drawsPerFrame), COLOR_TEXT },
+        { "RENDER Q",   std::format("{}", m_rates.maxQueueDepth), COLOR_TEXT },
+        { "AUDIO",      audio, m_rates.audioFill >= 0.0f && m_rates.audioFill < 0.1f ? COLOR_BAD : COLOR_TEXT },
+    };
+
+    constexpr float VALUE_COLUMN = 11.0f * GLYPH_ADVANCE;
+    const float graphWidth = GRAPH_SAMPLES * GRAPH_BAR_WIDTH;
+    const float textHeight = std::size(lines) * LINE_HEIGHT;
+    const float graphBlock = LINE_HEIGHT + GRAPH_HEIGHT + PADDING;
+    const float panelH = PADDING + textHeight + 2.0f * graphBlock;
+    addRect(PANEL_X, PANEL_Y, graphWidth + 2.0f * PADDING, panelH, COLOR_PANEL);
+
+    float x = PANEL_X + PADDING;
+    float y = PANEL_Y + PADDING;
+    for (const auto& line : lines) {
+        addText(x, y, line.label, COLOR_LABEL);
+        addText(x + VALUE_COLUMN, y, line.value, line.color);
+        y += LINE_HEIGHT;
+    }
+
+    addGraph(x, y, "CPU FRAME MS", m_cpuHistory);
+    y += graphBlock;
+    addGraph(x, y, "GPU FRAME MS", m_gpuHistory);
+
+    return m_vertices;
+}
+
+} // namespace WeaR
@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ * @file WeaR_PerfOverlay.h
+ * @brief In-window performance HUD drawn by WeaR_RenderEngine
+ *
+ * Shows guest MIPS, syscall and unimplemented-call rates, PM4 packets and
+ * draws per presented frame, render queue depth, audio buffer fill and
+ * CPU/GPU frame-time graphs.
+ *
+ * The overlay only builds colored triangles in NDC (same vertex layout as
+ * the engine's test pipeline); the engine uploads and draws them. Counters
+ * come from a source callback installed by the frontend, so the graphics
+ * module does not depend on HLE or audio.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace WeaR {
+
+// =============================================================================
+// COUNTERS
+// =============================================================================
+
+/**
+ * @brief Monotonic emulator counters sampled by the overlay
+ */
+struct PerfCounters {
+    uint64_t instructions = 0;
+    uint64_t syscalls = 0;
+    uint64_t unimplementedSyscalls = 0;
+    uint64_t pm4Packets = 0;
+    uint64_t drawCalls = 0;
+    float audioFill = -1.0f;        // 0.0 - 1.0, negative = no open port
+};
+
+/**
+ * @brief Position + color vertex (layout matches WeaR::Vertex)
+ */
+struct OverlayVertex {
+    float position[3];
+    float color[3];
+};
+
+// =============================================================================
+// OVERLAY
+// =============================================================================
+
+class WeaR_PerfOverlay {
+public:
+    using Clock = std::chrono::steady_clock;
+    using CounterSource = std::function<PerfCounters()>;
+
+    static constexpr size_t GRAPH_SAMPLES = 120;
+    static constexpr size_t MAX_VERTICES = 24576;
+    static constexpr auto SAMPLE_INTERVAL = std::chrono::milliseconds(500);
+
+    /**
+     * @brief Install the counter callback (thread-safe)
+     */
+    void setCounterSource(CounterSource source);
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Record one presented frame (render thread)
+     * @param cpuMs Host CPU time spent recording and submitting
+     * @param gpuMs GPU time from timestamp queries (negative if unavailable)
+     * @param queueDepth Render commands still pending after this frame was submitted
+     */
+    void recordFrame(float cpuMs, float gpuMs, size_t queueDepth);
+
+    /**
+     * @brief Build HUD geometry for a target of the given size (render thread)
+     * @return Vertices to draw as a triangle list (capped at MAX_VERTICES)
+     */
+    [[nodiscard]] const std::vector<OverlayVertex>& build(uint32_t width, uint32_t height);
+
+private:
+    struct Rates {
+        float fps = 0.0f;
+        float mips = 0.0f;
+        float syscallsPerSec = 0.0f;
+        float unimplementedPerSec = 0.0f;
+        float pm4PerFrame = 0.0f;
+        float drawsPerFrame = 0.0f;
+        size_t maxQueueDepth = 0;
+        float audioFill = -1.0f;
+        float avgCpuMs = 0.0f;
+        float avgGpuMs = -1.0f;
+    };
+
+    void sample(Clock::time_point now);
+
+    void addRect(float x, float y, float w, float h, const std::array<float, 3>& color);
+    void addText(float x, float y, std::string_view text, const std::array<float, 3>& color);
+    void addGraph(float x, float y, std::string_view label,
+                  const std::array<float, GRAPH_SAMPLES>& samples);
+
+    std::atomic<bool> m_enabled{false};
+
+    std::mutex m_sourceMutex;
+    CounterSource m_source;
+
+    // Render-thread state
+    std::array<float, GRAPH_SAMPLES> m_cpuHistory{};
+    std::array<float, GRAPH_SAMPLES> m_gpuHistory{};
+    size_t m_historyHead = 0;
+
+    Clock::time_point m_lastSample{};
+    PerfCounters m_lastCounters{};
+    uint64_t m_windowFrames = 0;
+    double m_windowCpuMs = 0.0;
+    double m_windowGpuMs = 0.0;
+    uint64_t m_windowGpuFrames = 0;
+    size_t m_windowMaxDepth = 0;
+    Rates m_rates{};
+
+    std::vector<OverlayVertex> m_vertices;
+    float m_scaleX = 0.0f;
+    float m_scaleY = 0.0f;
+};
+
+} // namespace WeaR
@@ -1,14 +1,17 @@
 #include "WeaR_RenderEngine.h"
 #include "WeaR_RenderQueue.h"
-#include "WeaR_ShaderManager.h"
+#include "Core/WeaR_EmulationContext.h"
+#include "Input/WeaR_InputLatency.h"
+#include "Core/WeaR_Trace.h"
+#include "Core/WeaR_Log.h"
 
 #define VMA_IMPLEMENTATION
 #define VMA_STATIC_VULKAN_FUNCTIONS 0
 #define VMA_DYNAMIC_VULKAN_FUNCTIONS 1
 #include <vk_mem_alloc.h>
 
+#include <filesystem>
 #include <fstream>
-#include <iostream>
 #include <format>
 #include <algorithm>
 #include <set>
@@ -149,7 +152,7 @@ VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
     [[maybe_unused]] void* pUserData)
 {
     if (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
-        std::cerr << std::format("[Vulkan] {}\n", pData->pMessage);
+        WEAR_LOG_ERROR(LogCategory::General, "Vulkan: {}", pData->pMessage);
     }
     return VK_FALSE;
 }
@@ -173,15 +176,24 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::renderFrame
         return std::unexpected("Engine not initialized");
     }
 
+    WEAR_TRACE_SCOPE(TraceCategory::Render, "frame");
+
     // Wait for previous frame
-    vkWaitForFences(m_device, 1, &m_syncObjects[m_currentFrame].inFlight, VK_TRUE, UINT64_MAX);
+    {
+        WEAR_TRACE_SCOPE(TraceCategory::Render, "wait_fence");
+        vkWaitForFences(m_device, 1, &m_syncObjects[m_currentFrame].inFlight, VK_TRUE, UINT64_MAX);
+    }
+    const float gpuFrameMs = readGpuFrameTime();
 
     // Acquire next swapchain image
     uint32_t imageIndex;
+    WeaR_TraceScope acquireTrace(TraceCategory::Render, "acquire_image");
     VkResult result = vkAcquireNextImageKHR(m_device, m_swapchain, UINT64_MAX,
         m_syncObjects[m_currentFrame].imageAvailable, VK_NULL_HANDLE, &imageIndex);
+    acquireTrace.end();
 
     if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+        m_swapchainOutOfDate = true;
         return std::unexpected("Swapchain out of date");
     } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
         return std::unexpected("Failed to acquire swapchain image");
@@ -189,15 +201,16 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::renderFrame
 
     vkResetFences(m_device, 1, &m_syncObjects[m_currentFrame].inFlight);
 
-    // Update frame time
+    // Update frame time (CPU time is measured from here to submit, excluding waits)
     auto now = std::chrono::steady_clock::now();
     float deltaTime = std::chrono::duration<float>(now - m_lastFrameTime).count();
     m_lastFrameTime = now;
     (void)deltaTime;  // Will be used for animation later
 
     // === FETCH DRAW COMMANDS FROM QUEUE ===
-    auto commands = getRenderQueue().popAll();
+    auto commands = m_context->getRenderQueue().popAll();
     bool hasDrawCommands = !commands.empty();
+    WeaR_TraceScope recordTrace(TraceCategory::Render, "record", "commands", commands.size());
 
     // Reset and record command buffer
     VkCommandBuffer cmd = m_graphicsCommandBuffers[m_currentFrame];
@@ -208,6 +221,11 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::renderFrame
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     vkBeginCommandBuffer(cmd, &beginInfo);
 
+    if (m_timestampPool) {
+        vkCmdResetQueryPool(cmd, m_timestampPool, m_currentFrame * 2, 2);
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_timestampPool, m_currentFrame * 2);
+    }
+
     // Transition swapchain image for rendering
     transitionImageLayout(cmd, m_swapchainImages[imageIndex],
         VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
@@ -291,6 +309,10 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::renderFrame
         vkCmdDraw(cmd, 3, 1, 0, 0);  // Idle indicator
     }
 
+    if (m_perfOverlay.isEnabled()) {
+        recordOverlay(cmd);
+    }
+
     vkCmdEndRendering(cmd);
 
     // === WEAR-GEN FRAME INTERPOLATION (if active and has game commands) ===
@@ -306,9 +328,15 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::renderFrame
     transitionImageLayout(cmd, m_swapchainImages[imageIndex],
         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
 
+    if (m_timestampPool) {
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampPool, m_currentFrame * 2 + 1);
+    }
+
     vkEndCommandBuffer(cmd);
+    recordTrace.end();
 
     // Submit
+    WeaR_TraceScope submitTrace(TraceCategory::Render, "submit");
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
@@ -327,6 +355,11 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::renderFrame
     if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, m_syncObjects[m_currentFrame].inFlight) != VK_SUCCESS) {
         return std::unexpected("Failed to submit draw command buffer");
     }
+    m_timestampsPending[m_currentFrame] = m_timestampPool != VK_NULL_HANDLE;
+    submitTrace.end();
+
+    float cpuFrameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - now).count();
+    m_perfOverlay.recordFrame(cpuFrameMs, gpuFrameMs, m_context->getRenderQueue().size());
 
     // Present
     VkPresentInfoKHR presentInfo{};
@@ -337,12 +370,16 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::renderFrame
     presentInfo.pSwapchains = &m_swapchain;
     presentInfo.pImageIndices = &imageIndex;
 
+    WeaR_TraceScope presentTrace(TraceCategory::Render, "present");
     result = vkQueuePresentKHR(m_presentQueue, &presentInfo);
+    presentTrace.end();
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        m_swapchainOutOfDate = true;
         return std::unexpected("Swapchain out of date");
     }
+    m_context->getInputLatency().onPresent();
 
-    m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    m_currentFrame = (m_currentFrame + 1) % m_framesInFlight;
     return {};
 }
 
@@ -397,35 +434,47 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::initVulkan(
     if (m_initialized) {
         return std::unexpected("Engine already initialized");
     }
+    if (!config.context) {
+        return std::unexpected("No emulation context");
+    }
 
+    m_context = config.context;
     m_specs = specs;
     m_validationEnabled = config.enableValidation;
+    m_vsyncEnabled = config.vsyncEnabled;
+    m_framesInFlight = std::clamp(config.framesInFlight, 1u, MAX_FRAMES_IN_FLIGHT);
     m_frameGenCapable = specs.canRunFrameGen;
     m_lastFrameTime = std::chrono::steady_clock::now();
 
-    std::cout << "[RenderEngine] Initializing Vulkan 1.3...\n";
+    WEAR_LOG_INFO(LogCategory::General, "RenderEngine: initializing Vulkan 1.3");
 
     if (auto r = createInstance(config); !r) { return r; }
     if (auto r = createSurface(windowHandle); !r) { shutdown(); return r; }
     if (auto r = selectPhysicalDevice(); !r) { shutdown(); return r; }
     if (auto r = createLogicalDevice(); !r) { shutdown(); return r; }
     if (auto r = createVmaAllocator(); !r) { shutdown(); return r; }
+    createPipelineCache(config);
     if (auto r = createSwapchain(config.windowWidth, config.windowHeight); !r) { shutdown(); return r; }
     if (auto r = createCommandPools(); !r) { shutdown(); return r; }
     if (auto r = createSyncObjects(); !r) { shutdown(); return r; }
     if (auto r = createVertexBuffer(); !r) { shutdown(); return r; }
     if (auto r = createTrianglePipeline(); !r) { shutdown(); return r; }
 
+    if (auto r = createOverlayResources(); !r) {
+        WEAR_LOG_WARN(LogCategory::General, "Performance overlay unavailable: {}", r.error());
+        // Non-fatal, frames render without the HUD
+    }
+
     // Initialize ShaderManager with fallback pipeline
-    if (auto r = getShaderManager().init(m_device, m_swapchainFormat); !r) {
-        std::cerr << "[RenderEngine] ShaderManager failed: " << r.error() << "\n";
+    if (auto r = m_shaderManager.init(m_device, m_swapchainFormat, m_pipelineCache); !r) {
+        WEAR_LOG_ERROR(LogCategory::General, "ShaderManager failed: {}", r.error());
         // Non-fatal, continue without shader manager
     }
 
     if (m_frameGenCapable) {
         auto r = createFrameGenPipeline();
         if (!r) {
-            std::cerr << "[RenderEngine] WeaR-Gen failed: " << r.error() << "\n";
+            WEAR_LOG_ERROR(LogCategory::General, "WeaR-Gen failed: {}", r.error());
             m_frameGenCapable = false;
         } else {
             m_frameGenActive = true;
@@ -433,7 +482,7 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::initVulkan(
     }
 
     m_initialized = true;
-    std::cout << "[RenderEngine] Initialization complete.\n";
+    WEAR_LOG_INFO(LogCategory::General, "RenderEngine initialized");
     return {};
 }
 
@@ -441,9 +490,13 @@ void WeaR_RenderEngine::shutdown() {
     if (m_device) vkDeviceWaitIdle(m_device);
 
     // Shutdown shader manager first
-    getShaderManager().shutdown();
+    m_shaderManager.shutdown();
 
     destroyBuffer(m_vertexBuffer);
+    for (auto& buffer : m_overlayBuffers) destroyBuffer(buffer);
+    m_overlayMapped = {};
+    if (m_timestampPool) vkDestroyQueryPool(m_device, m_timestampPool, nullptr);
+    m_timestampPool = VK_NULL_HANDLE;
     if (m_trianglePipeline) vkDestroyPipeline(m_device, m_trianglePipeline, nullptr);
     if (m_trianglePipelineLayout) vkDestroyPipelineLayout(m_device, m_trianglePipelineLayout, nullptr);
     if (m_triangleVertShader) vkDestroyShaderModule(m_device, m_triangleVertShader, nullptr);
@@ -458,6 +511,12 @@ void WeaR_RenderEngine::shutdown() {
     if (m_computeDescriptorPool) vkDestroyDescriptorPool(m_device, m_computeDescriptorPool, nullptr);
     if (m_frameGenShader) vkDestroyShaderModule(m_device, m_frameGenShader, nullptr);
 
+    if (m_pipelineCache) {
+        savePipelineCache();
+        vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+        m_pipelineCache = VK_NULL_HANDLE;
+    }
+
     for (auto& sync : m_syncObjects) {
         if (sync.imageAvailable) vkDestroySemaphore(m_device, sync.imageAvailable, nullptr);
         if (sync.renderFinished) vkDestroySemaphore(m_device, sync.renderFinished, nullptr);
@@ -481,6 +540,111 @@ void WeaR_RenderEngine::shutdown() {
     m_frameGenActive = false;
 }
 
+// =============================================================================
+// PIPELINE CACHE
+// =============================================================================
+
+std::vector<uint8_t> WeaR_RenderEngine::readPipelineCacheFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return {};
+
+    std::streamsize size = file.tellg();
+    if (size <= 0) return {};
+
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), size)) return {};
+    return data;
+}
+
+void WeaR_RenderEngine::createPipelineCache(const RenderEngineConfig& config) {
+    m_pipelineCachePath = config.pipelineCachePath;
+    setPipelineCachePolicy(config.savePipelineCache, config.pipelineCacheBudgetBytes);
+
+    // Drivers should ignore foreign blobs, but not all do; check the header
+    const void* initialData = nullptr;
+    size_t initialSize = 0;
+    if (config.pipelineCacheData.size() >= sizeof(VkPipelineCacheHeaderVersionOne)) {
+        VkPipelineCacheHeaderVersionOne header{};
+        std::memcpy(&header, config.pipelineCacheData.data(), sizeof(header));
+
+        VkPhysicalDeviceProperties props;
+        vkGetPhysicalDeviceProperties(m_physicalDevice, &props);
+
+        if (header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            header.vendorID == props.vendorID && header.deviceID == props.deviceID &&
+            std::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) == 0) {
+            initialData = config.pipelineCacheData.data();
+            initialSize = config.pipelineCacheData.size();
+        } else {
+            WEAR_LOG_INFO(LogCategory::General, "Pipeline cache is from another GPU or driver, starting empty");
+        }
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = initialSize;
+    cacheInfo.pInitialData = initialData;
+
+    if (vkCreatePipelineCache(m_device, &cacheInfo, nullptr, &m_pipelineCache) != VK_SUCCESS) {
+        // Non-fatal, pipelines are created uncached
+        WEAR_LOG_ERROR(LogCategory::General, "Failed to create pipeline cache");
+        m_pipelineCache = VK_NULL_HANDLE;
+        return;
+    }
+
+    if (initialSize > 0) {
+        WEAR_LOG_INFO(LogCategory::General, "Pipeline cache loaded ({} bytes)", initialSize);
+    }
+}
+
+void WeaR_RenderEngine::setPipelineCachePolicy(bool save, uint64_t budgetBytes) {
+    m_pipelineCacheSave.store(save, std::memory_order_relaxed);
+    m_pipelineCacheBudget.store(budgetBytes, std::memory_order_relaxed);
+}
+
+void WeaR_RenderEngine::savePipelineCache() {
+    if (m_pipelineCachePath.empty() || !m_pipelineCacheSave.load(std::memory_order_relaxed)) return;
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(m_device, m_pipelineCache, &size, nullptr) != VK_SUCCESS || size == 0) {
+        return;
+    }
+    const uint64_t budget = m_pipelineCacheBudget.load(std::memory_order_relaxed);
+    if (budget != 0 && size > budget) {
+        // Keep the previous file rather than letting one title grow it without bound
+        WEAR_LOG_WARN(LogCategory::General, "Pipeline cache ({} MB) exceeds the title budget; not saved",
+                      size / 1024 / 1024);
+        return;
+    }
+    std::vector<uint8_t> data(size);
+    if (vkGetPipelineCacheData(m_device, m_pipelineCache, &size, data.data()) != VK_SUCCESS) {
+        return;
+    }
+
+    std::filesystem::path target(m_pipelineCachePath);
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+    std::error_code ec;
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), ec);
+    }
+
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(reinterpret_cast<const char*>(data.data()),
+                                 static_cast<std::streamsize>(size))) {
+            WEAR_LOG_ERROR(LogCategory::General, "Failed to write pipeline cache: {}", m_pipelineCachePath);
+            return;
+        }
+    }
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        WEAR_LOG_ERROR(LogCategory::General, "Failed to replace pipeline cache: {}", m_pipelineCachePath);
+    }
+}
+
 bool WeaR_RenderEngine::setFrameGenEnabled(bool enabled) {
     if (!m_frameGenCapable) return false;
     m_frameGenActive = enabled;
@@ -708,7 +872,7 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::createSwapc
     info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
     info.preTransform = caps.currentTransform;
     info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-    info.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+    info.presentMode = choosePresentMode();
     info.clipped = VK_TRUE;
 
     if (vkCreateSwapchainKHR(m_device, &info, nullptr, &m_swapchain) != VK_SUCCESS) {
@@ -717,6 +881,7 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::createSwapc
 
     m_swapchainFormat = surfaceFormat.format;
     m_swapchainExtent = extent;
+    m_swapchainOutOfDate = false;
 
     vkGetSwapchainImagesKHR(m_device, m_swapchain, &imageCount, nullptr);
     m_swapchainImages.resize(imageCount);
@@ -793,8 +958,8 @@ uint32_t WeaR_RenderEngine::findMemoryType(uint32_t typeFilter, VkMemoryProperty
     for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
         if ((typeFilter & (1 << i)) && 
             (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            std::cout << "[VULKAN] Found exact memory type " << i 
-                      << " for flags 0x" << std::hex << properties << std::dec << "\n";
+            WEAR_LOG_DEBUG(LogCategory::General, "Found exact memory type {} for flags 0x{:X}", i,
+                           static_cast<uint32_t>(properties));
             return i;
         }
     }
@@ -804,7 +969,7 @@ uint32_t WeaR_RenderEngine::findMemoryType(uint32_t typeFilter, VkMemoryProperty
         for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
             if ((typeFilter & (1 << i)) && 
                 (memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) {
-                std::cout << "[VULKAN] Using fallback memory type " << i << " (HOST_VISIBLE only)\n";
+                WEAR_LOG_WARN(LogCategory::General, "Using fallback memory type {} (HOST_VISIBLE only)", i);
                 return i;
             }
         }
@@ -813,16 +978,16 @@ uint32_t WeaR_RenderEngine::findMemoryType(uint32_t typeFilter, VkMemoryProperty
     // Third pass: any compatible memory
     for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
         if (typeFilter & (1 << i)) {
-            std::cout << "[VULKAN] Using last-resort memory type " << i << "\n";
+            WEAR_LOG_WARN(LogCategory::General, "Using last-resort memory type {}", i);
             return i;
         }
     }
 
-    std::cerr << "[VULKAN] ERROR: No compatible memory type found!\n";
-    std::cerr << "[VULKAN] Available memory types:\n";
+    WEAR_LOG_ERROR(LogCategory::General, "No compatible memory type found");
+    WEAR_LOG_ERROR(LogCategory::General, "Available memory types:");
     for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        std::cerr << "  Type " << i << ": flags=0x" << std::hex 
-                  << memProperties.memoryTypes[i].propertyFlags << std::dec << "\n";
+        WEAR_LOG_ERROR(LogCategory::General, "  Type {}: flags=0x{:X}", i,
+                       static_cast<uint32_t>(memProperties.memoryTypes[i].propertyFlags));
     }
     return UINT32_MAX;
 }
@@ -843,7 +1008,7 @@ AllocatedBuffer WeaR_RenderEngine::createBuffer(VkDeviceSize size, VkBufferUsage
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
     if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &result.buffer) != VK_SUCCESS) {
-        std::cerr << "[VULKAN] Failed to create buffer object\n";
+        WEAR_LOG_ERROR(LogCategory::General, "Failed to create buffer object");
         return result;
     }
 
@@ -858,17 +1023,17 @@ AllocatedBuffer WeaR_RenderEngine::createBuffer(VkDeviceSize size, VkBufferUsage
     uint32_t memTypeIndex = findMemoryType(memReqs.memoryTypeBits, desiredProperties);
     
     if (memTypeIndex == UINT32_MAX) {
-        std::cerr << "[VULKAN] Trying HOST_VISIBLE only...\n";
+        WEAR_LOG_WARN(LogCategory::General, "Trying HOST_VISIBLE only");
         memTypeIndex = findMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
     }
     
     if (memTypeIndex == UINT32_MAX) {
-        std::cerr << "[VULKAN] Trying DEVICE_LOCAL only...\n";
+        WEAR_LOG_WARN(LogCategory::General, "Trying DEVICE_LOCAL only");
         memTypeIndex = findMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     }
 
     if (memTypeIndex == UINT32_MAX) {
-        std::cerr << "[VULKAN] All memory allocation attempts failed!\n";
+        WEAR_LOG_ERROR(LogCategory::General, "All memory allocation attempts failed");
         vkDestroyBuffer(m_device, result.buffer, nullptr);
         result.buffer = VK_NULL_HANDLE;
         return result;
@@ -882,7 +1047,7 @@ AllocatedBuffer WeaR_RenderEngine::createBuffer(VkDeviceSize size, VkBufferUsage
 
     VkDeviceMemory bufferMemory;
     if (vkAllocateMemory(m_device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-        std::cerr << "[VULKAN] Failed to allocate buffer memory\n";
+        WEAR_LOG_ERROR(LogCategory::General, "Failed to allocate buffer memory");
         vkDestroyBuffer(m_device, result.buffer, nullptr);
         result.buffer = VK_NULL_HANDLE;
         return result;
@@ -890,7 +1055,7 @@ AllocatedBuffer WeaR_RenderEngine::createBuffer(VkDeviceSize size, VkBufferUsage
 
     // Bind memory to buffer
     if (vkBindBufferMemory(m_device, result.buffer, bufferMemory, 0) != VK_SUCCESS) {
-        std::cerr << "[VULKAN] Failed to bind buffer memory\n";
+        WEAR_LOG_ERROR(LogCategory::General, "Failed to bind buffer memory");
         vkFreeMemory(m_device, bufferMemory, nullptr);
         vkDestroyBuffer(m_device, result.buffer, nullptr);
         result.buffer = VK_NULL_HANDLE;
@@ -900,7 +1065,7 @@ AllocatedBuffer WeaR_RenderEngine::createBuffer(VkDeviceSize size, VkBufferUsage
     // Store memory handle (abuse allocation field for raw memory handle)
     result.allocation = reinterpret_cast<VmaAllocation>(bufferMemory);
     
-    std::cout << "[VULKAN] Buffer created: size=" << size << ", memType=" << memTypeIndex << "\n";
+    WEAR_LOG_DEBUG(LogCategory::General, "Buffer created: size={}, memType={}", size, memTypeIndex);
     return result;
 }
 
@@ -911,7 +1076,7 @@ AllocatedBuffer WeaR_RenderEngine::createBuffer(VkDeviceSize size, VkBufferUsage
 std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::createVertexBuffer() {
     VkDeviceSize bufferSize = sizeof(Vertex) * TRIANGLE_VERTICES.size();
     
-    std::cout << "[VULKAN] Creating vertex buffer, size=" << bufferSize << " bytes\n";
+    WEAR_LOG_DEBUG(LogCategory::General, "Creating vertex buffer, size={} bytes", bufferSize);
     
     m_vertexBuffer = createBuffer(bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
     
@@ -924,14 +1089,14 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::createVerte
     void* data;
     VkResult mapResult = vkMapMemory(m_device, bufferMemory, 0, bufferSize, 0, &data);
     if (mapResult != VK_SUCCESS) {
-        std::cerr << "[VULKAN] Failed to map vertex buffer memory, result=" << mapResult << "\n";
+        WEAR_LOG_ERROR(LogCategory::General, "Failed to map vertex buffer memory, result={}", static_cast<int>(mapResult));
         return std::unexpected("Failed to map vertex buffer memory");
     }
     
     memcpy(data, TRIANGLE_VERTICES.data(), bufferSize);
     vkUnmapMemory(m_device, bufferMemory);
     
-    std::cout << "[VULKAN] Vertex buffer created successfully\n";
+    WEAR_LOG_INFO(LogCategory::General, "Vertex buffer created successfully");
     return {};
 }
 
@@ -1048,21 +1213,95 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::createTrian
     pipelineInfo.pDynamicState = &dynamicState;
     pipelineInfo.layout = m_trianglePipelineLayout;
 
-    if (vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_trianglePipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(m_device, m_pipelineCache, 1, &pipelineInfo, nullptr, &m_trianglePipeline) != VK_SUCCESS) {
         return std::unexpected("Failed to create graphics pipeline");
     }
 
-    std::cout << "[RenderEngine] Triangle pipeline created\n";
+    WEAR_LOG_INFO(LogCategory::General, "Triangle pipeline created");
+    return {};
+}
+
+// =============================================================================
+// PERFORMANCE OVERLAY
+// =============================================================================
+
+static_assert(sizeof(OverlayVertex) == sizeof(Vertex), "Overlay vertices feed the triangle pipeline");
+
+std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::createOverlayResources() {
+    const VkDeviceSize size = sizeof(OverlayVertex) * WeaR_PerfOverlay::MAX_VERTICES;
+
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+        m_overlayBuffers[i] = createBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        if (!m_overlayBuffers[i].buffer) {
+            return std::unexpected("Failed to create overlay vertex buffer");
+        }
+
+        // Host-visible and written every frame, so keep it mapped
+        VkDeviceMemory memory = reinterpret_cast<VkDeviceMemory>(m_overlayBuffers[i].allocation);
+        if (vkMapMemory(m_device, memory, 0, size, 0, &m_overlayMapped[i]) != VK_SUCCESS) {
+            return std::unexpected("Failed to map overlay vertex buffer");
+        }
+    }
+
+    // GPU frame time needs timestamp support on the graphics queue
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(m_physicalDevice, &props);
+
+    uint32_t count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &count, nullptr);
+    std::vector<VkQueueFamilyProperties> families(count);
+    vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &count, families.data());
+
+    if (m_graphicsQueueFamily < count && families[m_graphicsQueueFamily].timestampValidBits > 0) {
+        VkQueryPoolCreateInfo queryInfo{};
+        queryInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryInfo.queryCount = MAX_FRAMES_IN_FLIGHT * 2;
+        if (vkCreateQueryPool(m_device, &queryInfo, nullptr, &m_timestampPool) == VK_SUCCESS) {
+            m_timestampPeriodNs = props.limits.timestampPeriod;
+        }
+    }
+
     return {};
 }
 
+float WeaR_RenderEngine::readGpuFrameTime() {
+    if (!m_timestampPool || !m_timestampsPending[m_currentFrame]) return -1.0f;
+    m_timestampsPending[m_currentFrame] = false;
+
+    // The frame's fence has signaled, so results are available without waiting
+    uint64_t ticks[2] = {};
+    if (vkGetQueryPoolResults(m_device, m_timestampPool, m_currentFrame * 2, 2, sizeof(ticks), ticks,
+                              sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS) {
+        return -1.0f;
+    }
+    return static_cast<float>(static_cast<double>(ticks[1] - ticks[0]) * m_timestampPeriodNs / 1e6);
+}
+
+void WeaR_RenderEngine::recordOverlay(VkCommandBuffer cmd) {
+    if (!m_overlayMapped[m_currentFrame] || !m_trianglePipeline) return;
+
+    const auto& vertices = m_perfOverlay.build(m_swapchainExtent.width, m_swapchainExtent.height);
+    if (vertices.empty()) return;
+
+    std::memcpy(m_overlayMapped[m_currentFrame], vertices.data(), vertices.size() * sizeof(OverlayVertex));
+
+    // Vertices are already in NDC: zero rotation makes the test shader a passthrough
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_trianglePipeline);
+    float angle = 0.0f;
+    vkCmdPushConstants(cmd, m_trianglePipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(float), &angle);
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(cmd, 0, 1, &m_overlayBuffers[m_currentFrame].buffer, offsets);
+    vkCmdDraw(cmd, static_cast<uint32_t>(vertices.size()), 1, 0, 0);
+}
+
 std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::createFrameGenPipeline() {
     m_frameGenShader = loadShaderModule("shaders/framegen.comp.spv");
     if (!m_frameGenShader) {
         return std::unexpected("framegen.comp.spv not found");
     }
     // ... rest of compute pipeline setup (abbreviated for space)
-    std::cout << "[RenderEngine] WeaR-Gen compute pipeline created\n";
+    WEAR_LOG_INFO(LogCategory::General, "WeaR-Gen compute pipeline created");
     return {};
 }
 
@@ -1077,7 +1316,9 @@ std::expected<void, WeaR_RenderEngine::ErrorType> WeaR_RenderEngine::allocateFra
 // createBuffer is defined earlier in this file with VMA HOST_VISIBLE flags
 
 void WeaR_RenderEngine::destroyBuffer(AllocatedBuffer& buffer) {
-    if (buffer.buffer) vmaDestroyBuffer(m_allocator, buffer.buffer, buffer.allocation);
+    // createBuffer() stores the raw VkDeviceMemory in the allocation field
+    if (buffer.buffer) vkDestroyBuffer(m_device, buffer.buffer, nullptr);
+    if (buffer.allocation) vkFreeMemory(m_device, reinterpret_cast<VkDeviceMemory>(buffer.allocation), nullptr);
     buffer = {};
 }
 
@@ -1142,5 +1383,45 @@ void WeaR_RenderEngine::onWindowResize(uint32_t w, uint32_t h) {
     createSwapchain(w, h);
 }
 
+void WeaR_RenderEngine::setVsyncEnabled(bool enabled) {
+    if (m_vsyncEnabled == enabled) return;
+    m_vsyncEnabled = enabled;
+    if (m_initialized) {
+        onWindowResize(m_swapchainExtent.width, m_swapchainExtent.height);
+    }
+}
+
+void WeaR_RenderEngine::setFramesInFlight(uint32_t count) {
+    count = std::clamp(count, 1u, MAX_FRAMES_IN_FLIGHT);
+    if (m_framesInFlight == count) return;
+
+    // Per-frame fences and timestamps are indexed by m_currentFrame; drain them first
+    if (m_initialized) {
+        vkDeviceWaitIdle(m_device);
+    }
+    m_framesInFlight = count;
+    m_currentFrame = 0;
+    m_timestampsPending.fill(false);
+    WEAR_LOG_INFO(LogCategory::General, "RenderEngine: {} frames in flight", count);
+}
+
+VkPresentModeKHR WeaR_RenderEngine::choosePresentMode() const {
+    // FIFO is always available and blocks present on vblank
+    if (m_vsyncEnabled) return VK_PRESENT_MODE_FIFO_KHR;
+
+    uint32_t count = 0;
+    vkGetPhysicalDeviceSurfacePresentModesKHR(m_physicalDevice, m_surface, &count, nullptr);
+    std::vector<VkPresentModeKHR> modes(count);
+    vkGetPhysicalDeviceSurfacePresentModesKHR(m_physicalDevice, m_surface, &count, modes.data());
+
+    // Prefer MAILBOX (no tearing, newest frame wins), then IMMEDIATE
+    for (VkPresentModeKHR preferred : { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR }) {
+        if (std::find(modes.begin(), modes.end(), preferred) != modes.end()) {
+            return preferred;
+        }
+    }
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
 } // namespace WeaR
 
@@ -21,10 +21,13 @@
 #include <volk.h>
 
 #include "Hardware/HardwareDetector.h"
+#include "WeaR_PerfOverlay.h"
+#include "WeaR_ShaderManager.h"
 
 #include <string>
 #include <vector>
 #include <array>
+#include <atomic>
 #include <optional>
 #include <expected>
 #include <functional>
@@ -45,6 +48,8 @@ typedef HWND__* HWND;
 
 namespace WeaR {
 
+class WeaR_EmulationContext;
+
 // =============================================================================
 // CONFIGURATION STRUCTURES
 // =============================================================================
@@ -79,11 +84,17 @@ struct GraphicsPushConstants {
  * @brief Render engine configuration
  */
 struct RenderEngineConfig {
+    WeaR_EmulationContext* context = nullptr;   // Draw commands come from its queue; required
     std::string appName = "WeaR-emu";
     uint32_t windowWidth = 1920;
     uint32_t windowHeight = 1080;
     bool enableValidation = true;
     bool vsyncEnabled = true;
+    std::string pipelineCachePath;              // Saved on shutdown; empty = not persisted
+    bool savePipelineCache = true;              // Title policy; see setPipelineCachePolicy
+    std::vector<uint8_t> pipelineCacheData;     // Initial contents (see readPipelineCacheFile)
+    uint64_t pipelineCacheBudgetBytes = 0;      // Not saved when larger; 0 = no limit
+    uint32_t framesInFlight = 2;                // 1..MAX_FRAMES_IN_FLIGHT (title profile)
 };
 
 /**
@@ -126,7 +137,7 @@ struct FrameSyncObjects {
 class WeaR_RenderEngine {
 public:
     using ErrorType = std::string;
-    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
 
     WeaR_RenderEngine() = default;
     ~WeaR_RenderEngine();
@@ -145,6 +156,14 @@ public:
 
     void shutdown();
 
+    /**
+     * @brief Read a saved pipeline cache blob (empty if missing)
+     *
+     * Plain file I/O, so startup can load it before the device exists.
+     * Blobs from another GPU or driver are discarded at initVulkan.
+     */
+    [[nodiscard]] static std::vector<uint8_t> readPipelineCacheFile(const std::string& path);
+
     [[nodiscard]] bool isInitialized() const { return m_initialized; }
     [[nodiscard]] bool isFrameGenActive() const { return m_frameGenActive; }
 
@@ -158,6 +177,49 @@ public:
 
     void onWindowResize(uint32_t width, uint32_t height);
 
+    /**
+     * @brief Switch between FIFO (vsync) and MAILBOX/IMMEDIATE presentation
+     * @note Recreates the swapchain; call from the thread that renders
+     */
+    void setVsyncEnabled(bool enabled);
+
+    [[nodiscard]] bool isVsyncEnabled() const { return m_vsyncEnabled; }
+
+    /**
+     * @brief Change how many frames are cycled (clamped to 1..MAX_FRAMES_IN_FLIGHT)
+     * @note Waits for the device to go idle; call from the thread that renders
+     */
+    void setFramesInFlight(uint32_t count);
+
+    [[nodiscard]] uint32_t getFramesInFlight() const { return m_framesInFlight; }
+
+    /**
+     * @brief Whether the pipeline cache is saved at shutdown, and its size limit
+     *
+     * Read when the cache is saved, so a title booted after init still
+     * decides. Thread-safe.
+     */
+    void setPipelineCachePolicy(bool save, uint64_t budgetBytes);
+
+    /**
+     * @brief True after acquire/present reported OUT_OF_DATE or SUBOPTIMAL
+     *
+     * Cleared when the swapchain is recreated by onWindowResize().
+     */
+    [[nodiscard]] bool isSwapchainOutOfDate() const { return m_swapchainOutOfDate; }
+
+    [[nodiscard]] VkExtent2D getSwapchainExtent() const { return m_swapchainExtent; }
+
+    /**
+     * @brief Performance HUD (enable and counter source are thread-safe)
+     */
+    [[nodiscard]] WeaR_PerfOverlay& getPerfOverlay() { return m_perfOverlay; }
+
+    /**
+     * @brief Emulation context this engine draws for (set by initVulkan)
+     */
+    [[nodiscard]] WeaR_EmulationContext& getContext() const { return *m_context; }
+
     [[nodiscard]] VkInstance getInstance() const { return m_instance; }
     [[nodiscard]] VkDevice getDevice() const { return m_device; }
     [[nodiscard]] VkPhysicalDevice getPhysicalDevice() const { return m_physicalDevice; }
@@ -170,6 +232,8 @@ private:
     std::expected<void, ErrorType> createSurface(HWND windowHandle);
     std::expected<void, ErrorType> createLogicalDevice();
     std::expected<void, ErrorType> createVmaAllocator();
+    void createPipelineCache(const RenderEngineConfig& config);
+    void savePipelineCache();
     std::expected<void, ErrorType> createSwapchain(uint32_t width, uint32_t height);
     std::expected<void, ErrorType> createSyncObjects();
     std::expected<void, ErrorType> createCommandPools();
@@ -177,6 +241,7 @@ private:
     std::expected<void, ErrorType> createFrameGenPipeline();
     std::expected<void, ErrorType> allocateFrameGenResources();
     std::expected<void, ErrorType> createVertexBuffer();
+    std::expected<void, ErrorType> createOverlayResources();
 
     // Helpers
     std::optional<uint32_t> findQueueFamily(VkQueueFlags flags, bool dedicated = false);
@@ -188,7 +253,10 @@ private:
     VkShaderModule loadShaderModule(const std::string& path);
     VkShaderModule createShaderModuleFromSpirv(const std::vector<uint32_t>& spirv);
     void cleanupSwapchain();
+    VkPresentModeKHR choosePresentMode() const;
     void recordCommandBuffer(VkCommandBuffer cmd, uint32_t imageIndex);
+    void recordOverlay(VkCommandBuffer cmd);
+    float readGpuFrameTime();
     void transitionImageLayout(VkCommandBuffer cmd, VkImage image, 
                                VkImageLayout oldLayout, VkImageLayout newLayout);
 
@@ -210,12 +278,20 @@ private:
     // VMA
     VmaAllocator m_allocator = nullptr;
 
+    // Pipeline cache (persisted across runs)
+    VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+    std::string m_pipelineCachePath;
+    std::atomic<bool> m_pipelineCacheSave{true};
+    std::atomic<uint64_t> m_pipelineCacheBudget{0};
+
     // Swapchain
     VkSwapchainKHR m_swapchain = VK_NULL_HANDLE;
     std::vector<VkImage> m_swapchainImages;
     std::vector<VkImageView> m_swapchainImageViews;
     VkFormat m_swapchainFormat = VK_FORMAT_UNDEFINED;
     VkExtent2D m_swapchainExtent = {0, 0};
+    bool m_vsyncEnabled = true;
+    bool m_swapchainOutOfDate = false;
 
     // Command pools and buffers
     VkCommandPool m_graphicsCommandPool = VK_NULL_HANDLE;
@@ -226,6 +302,7 @@ private:
     // Synchronization
     std::array<FrameSyncObjects, MAX_FRAMES_IN_FLIGHT> m_syncObjects{};
     uint32_t m_currentFrame = 0;
+    uint32_t m_framesInFlight = 2;          // Frames actually cycled; resources exist for MAX
 
     // Triangle graphics pipeline
     VkPipelineLayout m_trianglePipelineLayout = VK_NULL_HANDLE;
@@ -234,6 +311,19 @@ private:
     VkShaderModule m_triangleFragShader = VK_NULL_HANDLE;
     AllocatedBuffer m_vertexBuffer{};
 
+    // Shaders and guest pipelines (tied to m_device)
+    WeaR_ShaderManager m_shaderManager;
+
+    // Performance overlay (drawn with the triangle pipeline)
+    WeaR_PerfOverlay m_perfOverlay;
+    std::array<AllocatedBuffer, MAX_FRAMES_IN_FLIGHT> m_overlayBuffers{};
+    std::array<void*, MAX_FRAMES_IN_FLIGHT> m_overlayMapped{};
+
+    // GPU timestamps: two queries per frame in flight
+    VkQueryPool m_timestampPool = VK_NULL_HANDLE;
+    float m_timestampPeriodNs = 0.0f;
+    std::array<bool, MAX_FRAMES_IN_FLIGHT> m_timestampsPending{};
+
     // WeaR-Gen compute pipeline
     VkPipelineLayout m_computePipelineLayout = VK_NULL_HANDLE;
     VkPipeline m_computePipeline = VK_NULL_HANDLE;
@@ -254,6 +344,7 @@ private:
     std::chrono::steady_clock::time_point m_lastFrameTime;
 
     // State
+    WeaR_EmulationContext* m_context = nullptr;
     bool m_initialized = false;
     bool m_frameGenActive = false;
     bool m_frameGenCapable = false;
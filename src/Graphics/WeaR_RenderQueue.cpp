@@ -4,15 +4,6 @@
 
 namespace WeaR {
 
-// =============================================================================
-// GLOBAL INSTANCE
-// =============================================================================
-
-WeaR_RenderQueue& getRenderQueue() {
-    static WeaR_RenderQueue instance;
-    return instance;
-}
-
 // =============================================================================
 // PRODUCER INTERFACE
 // =============================================================================
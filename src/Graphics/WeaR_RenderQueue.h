@@ -121,6 +121,9 @@ public:
     WeaR_RenderQueue() = default;
     ~WeaR_RenderQueue() = default;
 
+    WeaR_RenderQueue(const WeaR_RenderQueue&) = delete;
+    WeaR_RenderQueue& operator=(const WeaR_RenderQueue&) = delete;
+
     // =========================================================================
     // Producer Interface (CPU/HLE Thread)
     // =========================================================================
@@ -190,9 +193,4 @@ private:
     std::atomic<uint64_t> m_frameCount{0};
 };
 
-/**
- * @brief Get global render queue instance
- */
-WeaR_RenderQueue& getRenderQueue();
-
 } // namespace WeaR
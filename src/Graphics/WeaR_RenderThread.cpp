@@ -0,0 +1,153 @@
+#include "WeaR_RenderThread.h"
+#include "WeaR_RenderQueue.h"
+#include "Core/WeaR_EmulationContext.h"
+#include "Core/WeaR_Log.h"
+#include "Core/WeaR_ThreadRoles.h"
+#include "Core/WeaR_Trace.h"
+
+#include <chrono>
+#include <utility>
+
+namespace WeaR {
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+void WeaR_RenderThread::start(WeaR_RenderEngine* engine) {
+    if (!engine || !engine->isInitialized() || isRunning()) return;
+
+    m_engine = engine;
+    m_targetExtent = engine->getSwapchainExtent();
+    m_frameCount.store(0, std::memory_order_relaxed);
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::make_unique<std::thread>(&WeaR_RenderThread::threadMain, this);
+}
+
+void WeaR_RenderThread::stop() {
+    m_running.store(false, std::memory_order_release);
+
+    if (m_thread && m_thread->joinable()) {
+        m_thread->join();
+    }
+    m_thread.reset();
+
+    // Frames may still be in flight; the engine is usually destroyed next
+    if (m_engine && m_engine->getDevice()) {
+        vkDeviceWaitIdle(m_engine->getDevice());
+    }
+    m_engine = nullptr;
+}
+
+// =============================================================================
+// MESSAGES
+// =============================================================================
+
+void WeaR_RenderThread::requestResize(uint32_t width, uint32_t height) {
+    std::lock_guard lock(m_messageMutex);
+    m_pending.resize = VkExtent2D{width, height};
+}
+
+void WeaR_RenderThread::setVsyncEnabled(bool enabled) {
+    std::lock_guard lock(m_messageMutex);
+    m_pending.vsync = enabled;
+}
+
+void WeaR_RenderThread::setFrameGenEnabled(bool enabled) {
+    std::lock_guard lock(m_messageMutex);
+    m_pending.frameGen = enabled;
+}
+
+void WeaR_RenderThread::setFrameGenParams(const FrameGenPushConstants& params) {
+    std::lock_guard lock(m_messageMutex);
+    m_pending.frameGenParams = params;
+}
+
+void WeaR_RenderThread::setFramesInFlight(uint32_t count) {
+    std::lock_guard lock(m_messageMutex);
+    m_pending.framesInFlight = count;
+}
+
+void WeaR_RenderThread::applyMessages() {
+    PendingMessages messages;
+    {
+        std::lock_guard lock(m_messageMutex);
+        messages = std::exchange(m_pending, PendingMessages{});
+    }
+
+    if (messages.frameGen) {
+        m_engine->setFrameGenEnabled(*messages.frameGen);
+    }
+    if (messages.frameGenParams) {
+        m_engine->setFrameGenParams(*messages.frameGenParams);
+    }
+    if (messages.framesInFlight) {
+        m_engine->setFramesInFlight(*messages.framesInFlight);
+    }
+
+    bool recreate = m_engine->isSwapchainOutOfDate();
+    if (messages.resize) {
+        m_targetExtent = *messages.resize;
+        recreate = true;
+    }
+
+    // Vsync recreates the swapchain itself at the current extent
+    if (messages.vsync && *messages.vsync != m_engine->isVsyncEnabled()) {
+        m_engine->setVsyncEnabled(*messages.vsync);
+    }
+
+    // Zero extent = minimized; keep the old swapchain until it has a size again
+    if (recreate && m_targetExtent.width > 0 && m_targetExtent.height > 0) {
+        m_engine->onWindowResize(m_targetExtent.width, m_targetExtent.height);
+    }
+}
+
+// =============================================================================
+// RENDER LOOP
+// =============================================================================
+
+void WeaR_RenderThread::threadMain() {
+    using Clock = std::chrono::steady_clock;
+
+    getTracer().setThreadName("Render");
+    ScopedThreadRole threadRole(ThreadRole::Render, "Render");
+    WEAR_LOG_INFO(LogCategory::GNM, "Render thread started (vsync {})",
+                  m_engine->isVsyncEnabled() ? "on" : "off");
+
+    while (m_running.load(std::memory_order_acquire)) {
+        applyMessages();
+
+        if (m_targetExtent.width == 0 || m_targetExtent.height == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(ERROR_BACKOFF_MS));
+            continue;
+        }
+
+        // FIFO present blocks on vblank; otherwise avoid spinning on empty frames
+        if (!m_engine->isVsyncEnabled()) {
+            WEAR_TRACE_SCOPE(TraceCategory::Render, "wait_commands");
+            (void)m_engine->getContext().getRenderQueue().waitForCommands(IDLE_WAIT_MS);
+        }
+
+        auto frameStart = Clock::now();
+        auto result = m_engine->renderFrame();
+
+        if (!result) {
+            // Out-of-date swapchains are recreated by applyMessages() next iteration
+            if (!m_engine->isSwapchainOutOfDate()) {
+                WEAR_LOG_ERROR_LIMITED(LogCategory::GNM, "Render error: {}", result.error());
+                std::this_thread::sleep_for(std::chrono::milliseconds(ERROR_BACKOFF_MS));
+            }
+            continue;
+        }
+
+        auto frameTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - frameStart);
+        m_lastFrameTimeUs.store(static_cast<uint32_t>(frameTime.count()), std::memory_order_relaxed);
+        m_frameTimes.observe(static_cast<double>(frameTime.count()) / 1e6);
+        m_frameCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    WEAR_LOG_INFO(LogCategory::GNM, "Render thread stopped after {} frames",
+                  m_frameCount.load(std::memory_order_relaxed));
+}
+
+} // namespace WeaR
@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file WeaR_RenderThread.h
+ * @brief Dedicated render thread driving WeaR_RenderEngine
+ *
+ * The thread owns all calls into the engine once started. It consumes the
+ * render queue directly and is paced by presentation: with vsync the FIFO
+ * present blocks on vblank, without vsync MAILBOX/IMMEDIATE let it run as
+ * fast as the GPU allows (idle frames wait briefly for new commands).
+ *
+ * Other threads only post messages (resize, vsync, frame generation,
+ * frames in flight).
+ * Messages are coalesced - the latest value of each wins - and applied at
+ * the top of the next frame.
+ */
+
+#include "WeaR_RenderEngine.h"
+#include "Core/WeaR_Metrics.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace WeaR {
+
+class WeaR_RenderThread {
+public:
+    WeaR_RenderThread() = default;
+    ~WeaR_RenderThread() { stop(); }
+
+    WeaR_RenderThread(const WeaR_RenderThread&) = delete;
+    WeaR_RenderThread& operator=(const WeaR_RenderThread&) = delete;
+
+    /**
+     * @brief Start rendering with an initialized engine
+     * @note The engine must outlive the thread (call stop() before destroying it)
+     */
+    void start(WeaR_RenderEngine* engine);
+
+    /**
+     * @brief Stop the thread and wait for the GPU to go idle
+     */
+    void stop();
+
+    [[nodiscard]] bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // =========================================================================
+    // Messages (any thread)
+    // =========================================================================
+
+    void requestResize(uint32_t width, uint32_t height);
+    void setVsyncEnabled(bool enabled);
+    void setFrameGenEnabled(bool enabled);
+    void setFrameGenParams(const FrameGenPushConstants& params);
+    void setFramesInFlight(uint32_t count);
+
+    // =========================================================================
+    // Statistics (any thread)
+    // =========================================================================
+
+    /**
+     * @brief Frames presented since start()
+     */
+    [[nodiscard]] uint64_t getFrameCount() const { return m_frameCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief CPU time of the last frame including present wait (microseconds)
+     */
+    [[nodiscard]] uint32_t getLastFrameTimeUs() const { return m_lastFrameTimeUs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Distribution of the same frame times in seconds (for metrics export)
+     */
+    [[nodiscard]] const WeaR_Histogram& getFrameTimeHistogram() const { return m_frameTimes; }
+
+private:
+    struct PendingMessages {
+        std::optional<VkExtent2D> resize;
+        std::optional<bool> vsync;
+        std::optional<bool> frameGen;
+        std::optional<FrameGenPushConstants> frameGenParams;
+        std::optional<uint32_t> framesInFlight;
+    };
+
+    static constexpr uint32_t IDLE_WAIT_MS = 1;        // Without vsync, wait this long for commands
+    static constexpr uint32_t ERROR_BACKOFF_MS = 10;   // Sleep after a failed frame
+
+    void threadMain();
+    void applyMessages();
+
+    WeaR_RenderEngine* m_engine = nullptr;
+    std::unique_ptr<std::thread> m_thread;
+    std::atomic<bool> m_running{false};
+
+    std::mutex m_messageMutex;
+    PendingMessages m_pending;
+
+    // Render-thread state
+    VkExtent2D m_targetExtent = {0, 0};
+
+    std::atomic<uint64_t> m_frameCount{0};
+    std::atomic<uint32_t> m_lastFrameTimeUs{0};
+    WeaR_Histogram m_frameTimes{{ 0.004, 0.008, 0.0125, 0.0167, 0.025, 0.0333, 0.05, 0.1, 0.25, 1.0 }};
+};
+
+} // namespace WeaR
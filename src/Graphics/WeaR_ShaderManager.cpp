@@ -1,4 +1,5 @@
 #include "WeaR_ShaderManager.h"
+#include "Core/WeaR_Log.h"
 
 // --- VULKAN INCLUDES (ORDER IS CRITICAL) ---
 #if defined(_WIN32)
@@ -12,21 +13,11 @@
 #include <volk.h>
 // -------------------------------------------
 
-#include <iostream>
 #include <format>
 #include <cstring>
 
 namespace WeaR {
 
-// =============================================================================
-// GLOBAL INSTANCE
-// =============================================================================
-
-WeaR_ShaderManager& getShaderManager() {
-    static WeaR_ShaderManager instance;
-    return instance;
-}
-
 // =============================================================================
 // EMBEDDED FALLBACK SHADERS (SPIR-V)
 // =============================================================================
@@ -138,16 +129,18 @@ WeaR_ShaderManager::~WeaR_ShaderManager() {
 
 std::expected<void, WeaR_ShaderManager::ErrorType> WeaR_ShaderManager::init(
     VkDevice device,
-    VkFormat swapchainFormat)
+    VkFormat swapchainFormat,
+    VkPipelineCache pipelineCache)
 {
     if (m_initialized) {
         return std::unexpected("ShaderManager already initialized");
     }
 
     m_device = device;
+    m_vkPipelineCache = pipelineCache;
     m_swapchainFormat = swapchainFormat;
 
-    std::cout << "[ShaderManager] Initializing...\n";
+    WEAR_LOG_INFO(LogCategory::General, "ShaderManager initializing");
 
     if (auto r = createFallbackShaders(); !r) {
         return r;
@@ -171,7 +164,7 @@ std::expected<void, WeaR_ShaderManager::ErrorType> WeaR_ShaderManager::init(
     m_pushConstants.debugColor[3] = 1.0f;  // A
 
     m_initialized = true;
-    std::cout << "[ShaderManager] Initialized with fallback pipeline\n";
+    WEAR_LOG_INFO(LogCategory::General, "ShaderManager initialized with fallback pipeline");
     return {};
 }
 
@@ -192,6 +185,7 @@ void WeaR_ShaderManager::shutdown() {
 
     m_fallbackPipeline = VK_NULL_HANDLE;
     m_fallbackLayout = VK_NULL_HANDLE;
+    m_vkPipelineCache = VK_NULL_HANDLE;
     m_initialized = false;
 }
 
@@ -368,13 +362,13 @@ std::expected<void, WeaR_ShaderManager::ErrorType> WeaR_ShaderManager::createFal
     pipelineInfo.pDynamicState = &dynamicState;
     pipelineInfo.layout = m_fallbackLayout;
 
-    if (vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_fallbackPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(m_device, m_vkPipelineCache, 1, &pipelineInfo, nullptr, &m_fallbackPipeline) != VK_SUCCESS) {
         return std::unexpected("Failed to create fallback pipeline");
     }
 
     // Create wireframe variant
     rasterizer.polygonMode = VK_POLYGON_MODE_LINE;
-    if (vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_wireframePipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(m_device, m_vkPipelineCache, 1, &pipelineInfo, nullptr, &m_wireframePipeline) != VK_SUCCESS) {
         // Non-fatal, wireframe not available on all devices
         m_wireframePipeline = m_fallbackPipeline;
     }
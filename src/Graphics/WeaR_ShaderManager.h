@@ -83,11 +83,13 @@ public:
      * @brief Initialize shader manager
      * @param device Vulkan logical device
      * @param swapchainFormat Swapchain image format
+     * @param pipelineCache Cache used for pipeline creation (owned by the caller)
      * @return Success or error
      */
     [[nodiscard]] std::expected<void, ErrorType> init(
         VkDevice device,
-        VkFormat swapchainFormat
+        VkFormat swapchainFormat,
+        VkPipelineCache pipelineCache = VK_NULL_HANDLE
     );
 
     /**
@@ -146,6 +148,7 @@ private:
     [[nodiscard]] VkShaderModule createShaderModuleFromSpirv(const std::vector<uint32_t>& code);
     
     VkDevice m_device = VK_NULL_HANDLE;
+    VkPipelineCache m_vkPipelineCache = VK_NULL_HANDLE;
     VkFormat m_swapchainFormat = VK_FORMAT_UNDEFINED;
     bool m_initialized = false;
     RenderMode m_renderMode = RenderMode::Solid;
@@ -164,9 +167,4 @@ private:
     FallbackPushConstants m_pushConstants{};
 };
 
-/**
- * @brief Get global shader manager instance
- */
-WeaR_ShaderManager& getShaderManager();
-
 } // namespace WeaR
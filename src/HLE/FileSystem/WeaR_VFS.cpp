@@ -1,26 +1,18 @@
 #include "WeaR_VFS.h"
+#include "Core/WeaR_Log.h"
+#include "Core/WeaR_Trace.h"
 
-#include <iostream>
 #include <format>
 #include <algorithm>
 
 namespace WeaR {
 
-// =============================================================================
-// SINGLETON INSTANCE
-// =============================================================================
-
-WeaR_VFS& WeaR_VFS::get() {
-    static WeaR_VFS instance;
-    return instance;
-}
-
 // =============================================================================
 // CONSTRUCTOR / DESTRUCTOR
 // =============================================================================
 
 WeaR_VFS::WeaR_VFS() {
-    std::cout << "[VFS] Virtual File System initialized\n";
+    WEAR_LOG_INFO(LogCategory::VFS, "Virtual File System initialized");
 }
 
 WeaR_VFS::~WeaR_VFS() {
@@ -39,14 +31,14 @@ bool WeaR_VFS::mount(const std::string& virtualPath, const std::string& hostPath
     
     std::filesystem::path host = hostPath;
     if (!std::filesystem::exists(host)) {
-        std::cerr << std::format("[VFS] Mount failed: host path does not exist: {}\n", hostPath);
+        WEAR_LOG_ERROR(LogCategory::VFS, "Mount failed: host path does not exist: {}", hostPath);
         return false;
     }
     
     std::string normalized = normalizePath(virtualPath);
     m_mountPoints[normalized] = std::filesystem::canonical(host);
     
-    std::cout << std::format("[VFS] Mounted {} -> {}\n", normalized, host.string());
+    WEAR_LOG_INFO(LogCategory::VFS, "Mounted {} -> {}", normalized, host.string());
     return true;
 }
 
@@ -88,7 +80,10 @@ std::string WeaR_VFS::normalizePath(const std::string& path) {
 
 std::filesystem::path WeaR_VFS::resolvePath(const std::string& ps4Path) const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    
+    return resolvePathLocked(ps4Path);
+}
+
+std::filesystem::path WeaR_VFS::resolvePathLocked(const std::string& ps4Path) const {
     std::string normalized = normalizePath(ps4Path);
     
     // Find best matching mount point
@@ -118,7 +113,7 @@ std::filesystem::path WeaR_VFS::resolvePath(const std::string& ps4Path) const {
     
     // Security check: ensure resolved path is within mount point
     if (!isPathSafe(resolved)) {
-        std::cerr << std::format("[VFS] Security: path escape attempt: {}\n", ps4Path);
+        WEAR_LOG_WARN(LogCategory::VFS, "Security: path escape attempt: {}", ps4Path);
         return {};
     }
     
@@ -160,9 +155,9 @@ int32_t WeaR_VFS::openFile(const std::string& ps4Path, int flags, int mode) {
     
     std::lock_guard<std::mutex> lock(m_mutex);
     
-    std::filesystem::path hostPath = resolvePath(ps4Path);
+    std::filesystem::path hostPath = resolvePathLocked(ps4Path);
     if (hostPath.empty()) {
-        std::cerr << std::format("[VFS] Open failed: cannot resolve path: {}\n", ps4Path);
+        WEAR_LOG_WARN(LogCategory::VFS, "Open failed: cannot resolve path: {}", ps4Path);
         return PS4Error::SCE_ERROR_ENOENT;
     }
     
@@ -180,7 +175,7 @@ int32_t WeaR_VFS::openFile(const std::string& ps4Path, int flags, int mode) {
         int fd = allocateFd();
         m_openFiles[fd] = std::move(handle);
         
-        std::cout << std::format("[VFS] Opened directory: {} -> fd={}\n", ps4Path, fd);
+        WEAR_LOG_DEBUG(LogCategory::VFS, "Opened directory: {} -> fd={}", ps4Path, fd);
         return fd;
     }
     
@@ -218,13 +213,14 @@ int32_t WeaR_VFS::openFile(const std::string& ps4Path, int flags, int mode) {
     auto handle = std::make_unique<FileHandle>();
     handle->stream = std::move(stream);
     handle->hostPath = hostPath;
+    handle->openMode = openMode;
     handle->flags = flags;
     handle->isDirectory = false;
     
     int fd = allocateFd();
     m_openFiles[fd] = std::move(handle);
     
-    std::cout << std::format("[VFS] Opened: {} -> fd={}\n", ps4Path, fd);
+    WEAR_LOG_DEBUG(LogCategory::VFS, "Opened: {} -> fd={}", ps4Path, fd);
     return fd;
 }
 
@@ -241,6 +237,7 @@ int32_t WeaR_VFS::closeFile(int fd) {
 }
 
 int64_t WeaR_VFS::readFile(int fd, void* buffer, size_t size) {
+    WEAR_TRACE_SCOPE_ARG(TraceCategory::VFS, "vfs_read", "bytes", size);
     std::lock_guard<std::mutex> lock(m_mutex);
     
     auto it = m_openFiles.find(fd);
@@ -256,7 +253,7 @@ int64_t WeaR_VFS::readFile(int fd, void* buffer, size_t size) {
     handle->stream->read(static_cast<char*>(buffer), size);
     std::streamsize bytesRead = handle->stream->gcount();
     
-    m_totalBytesRead += bytesRead;
+    m_totalBytesRead.fetch_add(static_cast<uint64_t>(bytesRead), std::memory_order_relaxed);
     return static_cast<int64_t>(bytesRead);
 }
 
@@ -278,7 +275,7 @@ int64_t WeaR_VFS::writeFile(int fd, const void* buffer, size_t size) {
         return PS4Error::SCE_ERROR_ENOSPC;
     }
     
-    m_totalBytesWritten += size;
+    m_totalBytesWritten.fetch_add(size, std::memory_order_relaxed);
     return static_cast<int64_t>(size);
 }
 
@@ -350,7 +347,7 @@ int32_t WeaR_VFS::statFile(int fd, PS4Stat& stat) {
 int32_t WeaR_VFS::statPath(const std::string& ps4Path, PS4Stat& stat) {
     std::lock_guard<std::mutex> lock(m_mutex);
     
-    std::filesystem::path hostPath = resolvePath(ps4Path);
+    std::filesystem::path hostPath = resolvePathLocked(ps4Path);
     if (hostPath.empty() || !std::filesystem::exists(hostPath)) {
         return PS4Error::SCE_ERROR_ENOENT;
     }
@@ -396,6 +393,38 @@ bool WeaR_VFS::fileExists(const std::string& ps4Path) const {
     return !hostPath.empty() && std::filesystem::exists(hostPath);
 }
 
+// =============================================================================
+// FORK SUPPORT
+// =============================================================================
+
+void WeaR_VFS::flushFiles() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& [fd, handle] : m_openFiles) {
+        if (handle->stream) handle->stream->flush();
+    }
+}
+
+size_t WeaR_VFS::reopenFiles() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t reopened = 0;
+    for (auto& [fd, handle] : m_openFiles) {
+        if (!handle->stream) continue;
+
+        // Truncating again would wipe what the parent wrote
+        auto stream = std::make_unique<std::fstream>(handle->hostPath, handle->openMode & ~std::ios::trunc);
+        // A filebuf has one position for reading and writing
+        const auto position = handle->stream->rdbuf()->pubseekoff(0, std::ios::cur);
+        if (!stream->is_open() || position < 0 || stream->rdbuf()->pubseekpos(position) != position) {
+            WEAR_LOG_WARN(LogCategory::VFS, "Cannot reopen fd={} ({}); offset stays shared",
+                          fd, handle->hostPath.string());
+            continue;
+        }
+        handle->stream = std::move(stream);
+        ++reopened;
+    }
+    return reopened;
+}
+
 // =============================================================================
 // STATISTICS
 // =============================================================================
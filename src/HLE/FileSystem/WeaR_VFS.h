@@ -8,6 +8,7 @@
  * Provides sandboxed file I/O with proper error handling.
  */
 
+#include <atomic>
 #include <string>
 #include <map>
 #include <unordered_map>
@@ -78,6 +79,7 @@ struct PS4Stat {
 struct FileHandle {
     std::unique_ptr<std::fstream> stream;
     std::filesystem::path hostPath;
+    std::ios_base::openmode openMode{};
     int flags = 0;
     bool isDirectory = false;
 };
@@ -87,14 +89,15 @@ struct FileHandle {
 // =============================================================================
 
 /**
- * @brief Virtual File System singleton
+ * @brief Virtual File System (one per emulation context)
  */
 class WeaR_VFS {
 public:
-    /**
-     * @brief Get singleton instance
-     */
-    static WeaR_VFS& get();
+    WeaR_VFS();
+    ~WeaR_VFS();
+
+    WeaR_VFS(const WeaR_VFS&) = delete;
+    WeaR_VFS& operator=(const WeaR_VFS&) = delete;
 
     // =========================================================================
     // MOUNT MANAGEMENT
@@ -198,19 +201,36 @@ public:
      */
     [[nodiscard]] bool fileExists(const std::string& ps4Path) const;
 
+    // =========================================================================
+    // FORK SUPPORT
+    // =========================================================================
+
+    /**
+     * @brief Write out buffered data of every open file (before fork())
+     */
+    void flushFiles();
+
+    /**
+     * @brief Reopen every host file at its current position (after fork())
+     *
+     * A forked child shares open file descriptions, and so file offsets,
+     * with its parent and siblings; fresh descriptors keep reads apart.
+     * Files that cannot be reopened keep the shared descriptor.
+     * @return Number of files reopened
+     */
+    size_t reopenFiles();
+
     // =========================================================================
     // STATISTICS
     // =========================================================================
 
     [[nodiscard]] size_t getMountCount() const;
     [[nodiscard]] size_t getOpenFileCount() const;
-    [[nodiscard]] uint64_t getTotalBytesRead() const { return m_totalBytesRead; }
-    [[nodiscard]] uint64_t getTotalBytesWritten() const { return m_totalBytesWritten; }
+    [[nodiscard]] uint64_t getTotalBytesRead() const { return m_totalBytesRead.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t getTotalBytesWritten() const { return m_totalBytesWritten.load(std::memory_order_relaxed); }
 
 private:
-    WeaR_VFS();
-    ~WeaR_VFS();
-
+    [[nodiscard]] std::filesystem::path resolvePathLocked(const std::string& ps4Path) const;  // m_mutex held
     [[nodiscard]] bool isPathSafe(const std::filesystem::path& path) const;
     [[nodiscard]] int allocateFd();
 
@@ -219,8 +239,8 @@ private:
     mutable std::mutex m_mutex;
     
     int m_nextFd = 10;  // Start after stdin/stdout/stderr
-    uint64_t m_totalBytesRead = 0;
-    uint64_t m_totalBytesWritten = 0;
+    std::atomic<uint64_t> m_totalBytesRead{0};      // Read lock-free by metrics export
+    std::atomic<uint64_t> m_totalBytesWritten{0};
 };
 
 } // namespace WeaR
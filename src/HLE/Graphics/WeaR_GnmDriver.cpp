@@ -1,42 +1,22 @@
 #include "WeaR_GnmDriver.h"
-#include "GUI/WeaR_Logger.h"
-#include "Graphics/WeaR_RenderEngine.h"
+#include "Core/WeaR_Log.h"
+#include "Core/WeaR_Trace.h"
 #include "Graphics/WeaR_RenderQueue.h"
 
-#include <iostream>
 #include <format>
 
 namespace WeaR {
 
-// =============================================================================
-// GLOBAL INSTANCE
-// =============================================================================
-
-WeaR_GnmDriver& getGnmDriver() {
-    static WeaR_GnmDriver instance;
-    return instance;
-}
-
 // =============================================================================
 // CONSTRUCTOR
 // =============================================================================
 
-WeaR_GnmDriver::WeaR_GnmDriver() {
+WeaR_GnmDriver::WeaR_GnmDriver(WeaR_RenderQueue& renderQueue)
+    : m_renderQueue(renderQueue)
+{
     m_state.reset();
 }
 
-// =============================================================================
-// LOGGING
-// =============================================================================
-
-void WeaR_GnmDriver::log(const std::string& message) {
-    if (m_logger) {
-        m_logger->log(message, LogLevel::Debug);
-    } else {
-        std::cout << "[GNM] " << message << "\n";
-    }
-}
-
 // =============================================================================
 // COMMAND BUFFER SUBMISSION
 // =============================================================================
@@ -47,7 +27,8 @@ int32_t WeaR_GnmDriver::handleSubmitCommandBuffers(
     uint64_t sizesPtr,
     WeaR_Memory& mem)
 {
-    log(std::format("SubmitCommandBuffers: count={}", count));
+    WEAR_TRACE_SCOPE_ARG(TraceCategory::GPU, "pm4_submit", "buffers", count);
+    WEAR_LOG_DEBUG(LogCategory::GNM, "SubmitCommandBuffers: count={}", count);
 
     for (uint32_t i = 0; i < count; ++i) {
         // Read buffer address and size from arrays
@@ -56,8 +37,8 @@ int32_t WeaR_GnmDriver::handleSubmitCommandBuffers(
         uint32_t sizeInDwords = sizeInBytes / 4;
 
         if (m_verbose) {
-            log(std::format("  Buffer[{}]: addr=0x{:X}, size={} DWORDs", 
-                            i, bufferAddr, sizeInDwords));
+            WEAR_LOG_DEBUG(LogCategory::GNM, "  Buffer[{}]: addr=0x{:X}, size={} DWORDs",
+                           i, bufferAddr, sizeInDwords);
         }
 
         processCommandBuffer(bufferAddr, sizeInDwords, mem);
@@ -75,6 +56,7 @@ void WeaR_GnmDriver::processCommandBuffer(
     uint32_t sizeInDwords,
     WeaR_Memory& mem)
 {
+    WEAR_TRACE_SCOPE_ARG(TraceCategory::GPU, "pm4_process", "dwords", sizeInDwords);
     uint32_t offset = 0;
 
     while (offset < sizeInDwords) {
@@ -86,8 +68,8 @@ void WeaR_GnmDriver::processCommandBuffer(
         if (!header.isType3()) {
             // Skip non-Type3 packets
             if (m_verbose) {
-                log(std::format("PM4: Non-Type3 packet (type={}), skipping", 
-                                static_cast<int>(header.type())));
+                WEAR_LOG_DEBUG(LogCategory::GNM, "PM4: Non-Type3 packet (type={}), skipping",
+                               static_cast<int>(header.type()));
             }
             continue;
         }
@@ -97,7 +79,7 @@ void WeaR_GnmDriver::processCommandBuffer(
 
         // Safety check
         if (offset + payloadCount > sizeInDwords) {
-            log(std::format("PM4: Packet overflow at offset {}", offset - 1));
+            WEAR_LOG_DEBUG(LogCategory::GNM, "PM4: Packet overflow at offset {}", offset - 1);
             break;
         }
 
@@ -109,8 +91,8 @@ void WeaR_GnmDriver::processCommandBuffer(
 
         // Log packet if verbose
         if (m_verbose) {
-            log(std::format("PM4: {} (0x{:02X}), count={}", 
-                            PM4::getOpcodeName(opcode), opcode, payloadCount));
+            WEAR_LOG_DEBUG(LogCategory::GNM, "PM4: {} (0x{:02X}), count={}",
+                           PM4::getOpcodeName(opcode), opcode, payloadCount);
         }
 
         // Dispatch to handler
@@ -166,8 +148,8 @@ void WeaR_GnmDriver::processCommandBuffer(
 
             default:
                 if (m_verbose) {
-                    log(std::format("PM4: Unhandled opcode 0x{:02X} ({})", 
-                                    opcode, PM4::getOpcodeName(opcode)));
+                    WEAR_LOG_WARN_LIMITED(LogCategory::GNM, "PM4: Unhandled opcode 0x{:02X} ({})",
+                                          opcode, PM4::getOpcodeName(opcode));
                 }
                 break;
         }
@@ -226,7 +208,7 @@ void WeaR_GnmDriver::handleSetContextReg(const uint32_t* payload, uint32_t count
         // Store in state based on register
         // (Simplified - real implementation would decode all registers)
         if (m_verbose) {
-            log(std::format("  SET_CONTEXT_REG[0x{:04X}] = 0x{:08X}", regIndex, value));
+            WEAR_LOG_DEBUG(LogCategory::GNM, "  SET_CONTEXT_REG[0x{:04X}] = 0x{:08X}", regIndex, value);
         }
     }
 }
@@ -242,7 +224,7 @@ void WeaR_GnmDriver::handleSetShReg(const uint32_t* payload, uint32_t count,
         uint32_t value = payload[i];
 
         if (m_verbose) {
-            log(std::format("  SET_SH_REG[0x{:04X}] = 0x{:08X}", regIndex, value));
+            WEAR_LOG_DEBUG(LogCategory::GNM, "  SET_SH_REG[0x{:04X}] = 0x{:08X}", regIndex, value);
         }
     }
 }
@@ -260,11 +242,11 @@ void WeaR_GnmDriver::handleDrawIndexAuto(const uint32_t* payload, uint32_t count
     cmd.vertexCount = vertexCount;
     cmd.instanceCount = m_state.instanceCount;
 
-    log(std::format("DRAW_INDEX_AUTO: vertices={}, instances={}", 
-                    vertexCount, m_state.instanceCount));
+    WEAR_LOG_DEBUG(LogCategory::GNM, "DRAW_INDEX_AUTO: vertices={}, instances={}",
+                   vertexCount, m_state.instanceCount);
 
     // Push to global render queue
-    getRenderQueue().push(cmd);
+    m_renderQueue.push(cmd);
     m_drawCallsQueued++;
 }
 
@@ -288,10 +270,10 @@ void WeaR_GnmDriver::handleDrawIndex2(const uint32_t* payload, uint32_t count,
     cmd.instanceCount = m_state.instanceCount;
     cmd.indexType = m_state.indexType;
 
-    log(std::format("DRAW_INDEX_2: indices={}, buffer=0x{:X}", 
-                    indexCount, indexBufferAddr));
+    WEAR_LOG_DEBUG(LogCategory::GNM, "DRAW_INDEX_2: indices={}, buffer=0x{:X}",
+                   indexCount, indexBufferAddr);
 
-    getRenderQueue().push(cmd);
+    m_renderQueue.push(cmd);
     m_drawCallsQueued++;
 }
 
@@ -309,10 +291,10 @@ void WeaR_GnmDriver::handleDispatchDirect(const uint32_t* payload, uint32_t coun
     cmd.groupCountY = threadGroupsY;
     cmd.groupCountZ = threadGroupsZ;
 
-    log(std::format("DISPATCH_DIRECT: groups={}x{}x{}", 
-                    threadGroupsX, threadGroupsY, threadGroupsZ));
+    WEAR_LOG_DEBUG(LogCategory::GNM, "DISPATCH_DIRECT: groups={}x{}x{}",
+                   threadGroupsX, threadGroupsY, threadGroupsZ);
 
-    getRenderQueue().push(cmd);
+    m_renderQueue.push(cmd);
 }
 
 void WeaR_GnmDriver::handleEventWrite([[maybe_unused]] const uint32_t* payload,
@@ -349,7 +331,7 @@ void WeaR_GnmDriver::handleIndirectBuffer(const uint32_t* payload, uint32_t coun
                           (static_cast<uint64_t>(payload[1] & 0xFFFF) << 32);
     uint32_t sizeInDwords = payload[2] & 0xFFFFF;
 
-    log(std::format("INDIRECT_BUFFER: addr=0x{:X}, size={}", bufferAddr, sizeInDwords));
+    WEAR_LOG_DEBUG(LogCategory::GNM, "INDIRECT_BUFFER: addr=0x{:X}, size={}", bufferAddr, sizeInDwords);
 
     // Recursively process the indirect buffer
     processCommandBuffer(bufferAddr, sizeInDwords, mem);
@@ -15,12 +15,13 @@
 #include <vector>
 #include <queue>
 #include <mutex>
+#include <atomic>
 
 namespace WeaR {
 
 // Forward declarations
 class WeaR_RenderEngine;
-class WeaR_Logger;
+class WeaR_RenderQueue;
 
 // =============================================================================
 // DRAW COMMAND TYPES
@@ -93,14 +94,19 @@ struct GpuState {
  */
 class WeaR_GnmDriver {
 public:
-    WeaR_GnmDriver();
+    /**
+     * @param renderQueue Receives the draw commands (same emulation context)
+     */
+    explicit WeaR_GnmDriver(WeaR_RenderQueue& renderQueue);
     ~WeaR_GnmDriver() = default;
 
+    WeaR_GnmDriver(const WeaR_GnmDriver&) = delete;
+    WeaR_GnmDriver& operator=(const WeaR_GnmDriver&) = delete;
+
     /**
      * @brief Set dependencies
      */
     void setRenderEngine(WeaR_RenderEngine* engine) { m_renderEngine = engine; }
-    void setLogger(WeaR_Logger* logger) { m_logger = logger; }
 
     /**
      * @brief Handle sceGnmSubmitCommandBuffers syscall
@@ -142,14 +148,12 @@ public:
     [[nodiscard]] const GpuState& getState() const { return m_state; }
 
     /**
-     * @brief Statistics
+     * @brief Statistics (safe to read from other threads)
      */
     [[nodiscard]] uint64_t getPacketsProcessed() const { return m_packetsProcessed; }
     [[nodiscard]] uint64_t getDrawCallsQueued() const { return m_drawCallsQueued; }
 
 private:
-    void log(const std::string& message);
-    
     // PM4 packet handlers
     void handleNOP(const uint32_t* payload, uint32_t count);
     void handleSetContextReg(const uint32_t* payload, uint32_t count, WeaR_Memory& mem);
@@ -166,22 +170,17 @@ private:
 
     void queueDrawCommand(const DrawCommand& cmd);
 
+    WeaR_RenderQueue& m_renderQueue;
     WeaR_RenderEngine* m_renderEngine = nullptr;
-    WeaR_Logger* m_logger = nullptr;
     
     GpuState m_state;
     
     std::queue<DrawCommand> m_commandQueue;
     mutable std::mutex m_queueMutex;
     
-    uint64_t m_packetsProcessed = 0;
-    uint64_t m_drawCallsQueued = 0;
+    std::atomic<uint64_t> m_packetsProcessed{0};
+    std::atomic<uint64_t> m_drawCallsQueued{0};
     bool m_verbose = true;  // Log all packets for debugging
 };
 
-/**
- * @brief Get global GNM driver instance
- */
-WeaR_GnmDriver& getGnmDriver();
-
 } // namespace WeaR
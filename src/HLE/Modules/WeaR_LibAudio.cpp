@@ -1,10 +1,12 @@
 #include "HLE/WeaR_Syscalls.h"
+#include "Core/WeaR_EmulationContext.h"
 #include "Audio/WeaR_AudioManager.h"
-#include "GUI/WeaR_Logger.h"
+#include "Core/WeaR_Log.h"
 
-#include <iostream>
 #include <format>
+#include <functional>
 #include <cstring>
+#include <vector>
 
 /**
  * @file WeaR_LibAudio.cpp
@@ -41,6 +43,7 @@ namespace Syscall {
  * int32_t sceAudioOutInit(void)
  */
 SyscallResult hle_sceAudioOutInit(
+    WeaR_AudioManager& audio,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t, uint64_t, uint64_t,
@@ -49,8 +52,8 @@ SyscallResult hle_sceAudioOutInit(
     (void)ctx;
     (void)mem;
     
-    bool success = WeaR_AudioManager::get().init();
-    getLogger().log(std::string("sceAudioOutInit"), LogLevel::Debug);
+    bool success = audio.init();
+    WEAR_LOG_DEBUG(LogCategory::Audio, "sceAudioOutInit");
     
     return SyscallResult{success ? 0 : -1, success, ""};
 }
@@ -68,6 +71,7 @@ SyscallResult hle_sceAudioOutInit(
  * R9  = param
  */
 SyscallResult hle_sceAudioOutOpen(
+    WeaR_AudioManager& audio,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t userId, 
@@ -81,7 +85,7 @@ SyscallResult hle_sceAudioOutOpen(
     (void)mem;
     (void)userId;
     
-    int32_t handle = WeaR_AudioManager::get().openPort(
+    int32_t handle = audio.openPort(
         static_cast<int32_t>(type),
         static_cast<int32_t>(index),
         static_cast<int32_t>(len),
@@ -89,8 +93,8 @@ SyscallResult hle_sceAudioOutOpen(
         static_cast<uint32_t>(param)
     );
     
-    getLogger().log(std::format("sceAudioOutOpen: type={}, len={}, freq={} -> handle={}",
-                                 type, len, freq, handle), LogLevel::Debug);
+    WEAR_LOG_DEBUG(LogCategory::Audio, "sceAudioOutOpen: type={}, len={}, freq={} -> handle={}",
+                   type, len, freq, handle);
     
     return SyscallResult{handle, handle >= 0, ""};
 }
@@ -101,6 +105,7 @@ SyscallResult hle_sceAudioOutOpen(
  * int32_t sceAudioOutClose(int32_t handle)
  */
 SyscallResult hle_sceAudioOutClose(
+    WeaR_AudioManager& audio,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t handle, 
@@ -110,10 +115,36 @@ SyscallResult hle_sceAudioOutClose(
     (void)ctx;
     (void)mem;
     
-    int32_t result = WeaR_AudioManager::get().closePort(static_cast<int32_t>(handle));
+    int32_t result = audio.closePort(static_cast<int32_t>(handle));
     return SyscallResult{result, result == 0, ""};
 }
 
+// =============================================================================
+// GUEST STRUCTURES
+// =============================================================================
+
+/**
+ * @brief SceAudioOutOutputParam - one entry of sceAudioOutOutputs
+ */
+#pragma pack(push, 1)
+struct SceAudioOutOutputParam {
+    int32_t handle;
+    uint32_t padding;
+    uint64_t ptr;           // Guest pointer to PCM data
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SceAudioOutOutputParam) == 16, "SceAudioOutOutputParam must be 16 bytes");
+
+/**
+ * @brief Size in bytes of one grain for a port (samples * channels * bytes_per_sample)
+ */
+static size_t getPortBufferSize(WeaR_AudioManager& audio, int32_t handle) {
+    int32_t sampleCount = 256;  // Default
+    audio.getPortParam(handle, &sampleCount, nullptr);
+    return static_cast<size_t>(sampleCount) * AudioConstants::CHANNELS * AudioConstants::BYTES_PER_SAMPLE;
+}
+
 /**
  * @brief sceAudioOutOutput - Output audio samples (BLOCKING)
  * 
@@ -122,9 +153,10 @@ SyscallResult hle_sceAudioOutClose(
  * RSI = ptr to PCM data
  * 
  * NOTE: This call blocks until the audio buffer is consumed.
- * We simulate this with sleep_for to prevent chipmunk effect.
+ * We simulate this with the sink's grain deadline to prevent chipmunk effect.
  */
 SyscallResult hle_sceAudioOutOutput(
+    WeaR_AudioManager& audio,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t handle, 
@@ -137,25 +169,18 @@ SyscallResult hle_sceAudioOutOutput(
         return SyscallResult{-1, false, "null pointer"};
     }
     
-    // Get port to find sample count
-    int32_t sampleCount = 256;  // Default
-    WeaR_AudioManager::get().getPortParam(static_cast<int32_t>(handle), &sampleCount, nullptr);
-    
-    // Calculate data size: samples * channels * bytes_per_sample
-    size_t dataSize = static_cast<size_t>(sampleCount) * AudioConstants::CHANNELS * AudioConstants::BYTES_PER_SAMPLE;
+    size_t dataSize = getPortBufferSize(audio, static_cast<int32_t>(handle));
     
     // Read PCM data from game memory
     std::vector<uint8_t> pcmData(dataSize);
     try {
-        for (size_t i = 0; i < dataSize; ++i) {
-            pcmData[i] = mem.read<uint8_t>(ptr + i);
-        }
+        mem.readBlock(ptr, pcmData.data(), dataSize);
     } catch (const std::exception& e) {
         return SyscallResult{-1, false, std::format("memory read failed: {}", e.what())};
     }
     
     // Output audio
-    int32_t result = WeaR_AudioManager::get().output(
+    int32_t result = audio.output(
         static_cast<int32_t>(handle), 
         pcmData.data(), 
         dataSize
@@ -165,17 +190,59 @@ SyscallResult hle_sceAudioOutOutput(
 }
 
 /**
- * @brief sceAudioOutOutputs - Output to multiple ports at once
+ * @brief sceAudioOutOutputs - Output to multiple ports at once (BLOCKING)
+ * 
+ * int32_t sceAudioOutOutputs(SceAudioOutOutputParam* param, uint32_t num)
+ * RDI = param array
+ * RSI = num entries
+ * 
+ * All buffers are queued together and the caller blocks once on the
+ * shared grain boundary instead of once per port.
  */
 SyscallResult hle_sceAudioOutOutputs(
+    WeaR_AudioManager& audio,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
-    uint64_t handle, 
-    uint64_t ptr,
+    uint64_t paramPtr, 
+    uint64_t num,
     uint64_t, uint64_t, uint64_t, uint64_t)
 {
-    // For simplicity, treat as single output
-    return hle_sceAudioOutOutput(ctx, mem, handle, ptr, 0, 0, 0, 0);
+    (void)ctx;
+    
+    if (paramPtr == 0 || num == 0) {
+        return SyscallResult{-1, false, "null param"};
+    }
+    if (num > AudioConstants::MAX_OUTPUTS_PORTS) {
+        return SyscallResult{-1, false, std::format("too many ports: {}", num)};
+    }
+    
+    SceAudioOutOutputParam guestParams[AudioConstants::MAX_OUTPUTS_PORTS];
+    std::vector<uint8_t> pcmData[AudioConstants::MAX_OUTPUTS_PORTS];
+    AudioOutputParam params[AudioConstants::MAX_OUTPUTS_PORTS];
+    
+    try {
+        mem.readBlock(paramPtr, guestParams, num * sizeof(SceAudioOutOutputParam));
+        
+        for (uint64_t i = 0; i < num; ++i) {
+            params[i].handle = guestParams[i].handle;
+            
+            // A null buffer writes nothing, but the port still
+            // participates in the shared wait
+            if (guestParams[i].ptr == 0) continue;
+            
+            size_t dataSize = getPortBufferSize(audio, guestParams[i].handle);
+            pcmData[i].resize(dataSize);
+            mem.readBlock(guestParams[i].ptr, pcmData[i].data(), dataSize);
+            
+            params[i].pcmData = pcmData[i].data();
+            params[i].dataSize = dataSize;
+        }
+    } catch (const std::exception& e) {
+        return SyscallResult{-1, false, std::format("memory read failed: {}", e.what())};
+    }
+    
+    int32_t result = audio.outputs(params, static_cast<size_t>(num));
+    return SyscallResult{result, result == 0, ""};
 }
 
 /**
@@ -184,6 +251,7 @@ SyscallResult hle_sceAudioOutOutputs(
  * int32_t sceAudioOutSetVolume(int32_t handle, int32_t flag, int32_t* vol)
  */
 SyscallResult hle_sceAudioOutSetVolume(
+    WeaR_AudioManager& audio,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t handle, 
@@ -201,7 +269,7 @@ SyscallResult hle_sceAudioOutSetVolume(
         volume = static_cast<float>(vol) / 32767.0f;
     }
     
-    int32_t result = WeaR_AudioManager::get().setVolume(static_cast<int32_t>(handle), volume);
+    int32_t result = audio.setVolume(static_cast<int32_t>(handle), volume);
     return SyscallResult{result, result == 0, ""};
 }
 
@@ -254,16 +322,19 @@ SyscallResult hle_sceAudioOutGetSystemState(
  * @brief Register audio syscall handlers with dispatcher
  */
 void registerLibAudioHandlers(WeaR_Syscalls& dispatcher) {
-    dispatcher.registerHandler(Syscall::SYS_sceAudioOutInit, hle_sceAudioOutInit);
-    dispatcher.registerHandler(Syscall::SYS_sceAudioOutOpen, hle_sceAudioOutOpen);
-    dispatcher.registerHandler(Syscall::SYS_sceAudioOutClose, hle_sceAudioOutClose);
-    dispatcher.registerHandler(Syscall::SYS_sceAudioOutOutput, hle_sceAudioOutOutput);
-    dispatcher.registerHandler(Syscall::SYS_sceAudioOutOutputs, hle_sceAudioOutOutputs);
-    dispatcher.registerHandler(Syscall::SYS_sceAudioOutSetVolume, hle_sceAudioOutSetVolume);
+    auto& audio = dispatcher.getContext().getAudio();
+    auto withAudio = [&audio](auto handler) { return std::bind_front(handler, std::ref(audio)); };
+
+    dispatcher.registerHandler(Syscall::SYS_sceAudioOutInit, withAudio(hle_sceAudioOutInit));
+    dispatcher.registerHandler(Syscall::SYS_sceAudioOutOpen, withAudio(hle_sceAudioOutOpen));
+    dispatcher.registerHandler(Syscall::SYS_sceAudioOutClose, withAudio(hle_sceAudioOutClose));
+    dispatcher.registerHandler(Syscall::SYS_sceAudioOutOutput, withAudio(hle_sceAudioOutOutput));
+    dispatcher.registerHandler(Syscall::SYS_sceAudioOutOutputs, withAudio(hle_sceAudioOutOutputs));
+    dispatcher.registerHandler(Syscall::SYS_sceAudioOutSetVolume, withAudio(hle_sceAudioOutSetVolume));
     dispatcher.registerHandler(Syscall::SYS_sceAudioOutGetPortState, hle_sceAudioOutGetPortState);
     dispatcher.registerHandler(Syscall::SYS_sceAudioOutGetSystemState, hle_sceAudioOutGetSystemState);
     
-    std::cout << "[HLE] libAudio handlers registered\n";
+    WEAR_LOG_INFO(LogCategory::General, "[HLE] libAudio handlers registered");
 }
 
 } // namespace LibAudio
@@ -1,9 +1,10 @@
 #include "HLE/WeaR_Syscalls.h"
+#include "Core/WeaR_EmulationContext.h"
 #include "HLE/FileSystem/WeaR_VFS.h"
-#include "GUI/WeaR_Logger.h"
+#include "Core/WeaR_Log.h"
 
-#include <iostream>
 #include <format>
+#include <functional>
 #include <cstring>
 
 /**
@@ -64,6 +65,7 @@ std::string readCString(WeaR_Memory& mem, uint64_t addr, size_t maxLen = 1024) {
  * Returns: file descriptor or error
  */
 SyscallResult hle_sys_open(
+    WeaR_VFS& vfs,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t pathPtr, 
@@ -78,9 +80,9 @@ SyscallResult hle_sys_open(
     }
     
     std::string path = readCString(mem, pathPtr);
-    getLogger().log(std::format("sys_open: {} flags=0x{:X}", path, flags), LogLevel::Debug);
+    WEAR_LOG_DEBUG(LogCategory::VFS, "sys_open: {} flags=0x{:X}", path, flags);
     
-    int32_t fd = WeaR_VFS::get().openFile(path, static_cast<int>(flags), static_cast<int>(mode));
+    int32_t fd = vfs.openFile(path, static_cast<int>(flags), static_cast<int>(mode));
     
     if (fd < 0) {
         return SyscallResult{fd, false, std::format("open failed: {}", path)};
@@ -99,6 +101,7 @@ SyscallResult hle_sys_open(
  * Returns: bytes read or error
  */
 SyscallResult hle_sys_read(
+    WeaR_VFS& vfs,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t fd, 
@@ -115,7 +118,7 @@ SyscallResult hle_sys_read(
     // Allocate temporary buffer
     std::vector<uint8_t> buffer(count);
     
-    int64_t bytesRead = WeaR_VFS::get().readFile(static_cast<int>(fd), buffer.data(), count);
+    int64_t bytesRead = vfs.readFile(static_cast<int>(fd), buffer.data(), count);
     
     if (bytesRead < 0) {
         return SyscallResult{static_cast<int64_t>(bytesRead), false, "read failed"};
@@ -135,6 +138,7 @@ SyscallResult hle_sys_read(
  * ssize_t write(int fd, const void* buf, size_t count)
  */
 SyscallResult hle_sys_write(
+    WeaR_VFS& vfs,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t fd, 
@@ -152,7 +156,7 @@ SyscallResult hle_sys_write(
             if (c == '\0') break;
             output += c;
         }
-        getLogger().log(std::format("[fd{}] {}", fd, output), LogLevel::Info);
+        WEAR_LOG_INFO(LogCategory::VFS, "[fd{}] {}", fd, output);
         return SyscallResult{static_cast<int64_t>(output.size()), true, ""};
     }
     
@@ -166,7 +170,7 @@ SyscallResult hle_sys_write(
         buffer[i] = mem.read<uint8_t>(bufPtr + i);
     }
     
-    int64_t bytesWritten = WeaR_VFS::get().writeFile(static_cast<int>(fd), buffer.data(), count);
+    int64_t bytesWritten = vfs.writeFile(static_cast<int>(fd), buffer.data(), count);
     
     if (bytesWritten < 0) {
         return SyscallResult{bytesWritten, false, "write failed"};
@@ -181,6 +185,7 @@ SyscallResult hle_sys_write(
  * int close(int fd)
  */
 SyscallResult hle_sys_close(
+    WeaR_VFS& vfs,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t fd, 
@@ -190,7 +195,7 @@ SyscallResult hle_sys_close(
     (void)ctx;
     (void)mem;
     
-    int32_t result = WeaR_VFS::get().closeFile(static_cast<int>(fd));
+    int32_t result = vfs.closeFile(static_cast<int>(fd));
     return SyscallResult{result, result == 0, ""};
 }
 
@@ -200,6 +205,7 @@ SyscallResult hle_sys_close(
  * off_t lseek(int fd, off_t offset, int whence)
  */
 SyscallResult hle_sys_lseek(
+    WeaR_VFS& vfs,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t fd, 
@@ -210,7 +216,7 @@ SyscallResult hle_sys_lseek(
     (void)ctx;
     (void)mem;
     
-    int64_t newPos = WeaR_VFS::get().seekFile(
+    int64_t newPos = vfs.seekFile(
         static_cast<int>(fd), 
         static_cast<int64_t>(offset), 
         static_cast<int>(whence)
@@ -229,6 +235,7 @@ SyscallResult hle_sys_lseek(
  * int fstat(int fd, struct stat* buf)
  */
 SyscallResult hle_sys_fstat(
+    WeaR_VFS& vfs,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t fd, 
@@ -242,7 +249,7 @@ SyscallResult hle_sys_fstat(
     }
     
     PS4Stat stat{};
-    int32_t result = WeaR_VFS::get().statFile(static_cast<int>(fd), stat);
+    int32_t result = vfs.statFile(static_cast<int>(fd), stat);
     
     if (result != PS4Error::SCE_OK) {
         return SyscallResult{result, false, "fstat failed"};
@@ -263,6 +270,7 @@ SyscallResult hle_sys_fstat(
  * int stat(const char* path, struct stat* buf)
  */
 SyscallResult hle_sys_stat(
+    WeaR_VFS& vfs,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t pathPtr, 
@@ -278,7 +286,7 @@ SyscallResult hle_sys_stat(
     std::string path = readCString(mem, pathPtr);
     
     PS4Stat stat{};
-    int32_t result = WeaR_VFS::get().statPath(path, stat);
+    int32_t result = vfs.statPath(path, stat);
     
     if (result != PS4Error::SCE_OK) {
         return SyscallResult{result, false, std::format("stat failed: {}", path)};
@@ -300,15 +308,18 @@ SyscallResult hle_sys_stat(
  * @brief Register file system syscall handlers with dispatcher
  */
 void registerLibFSHandlers(WeaR_Syscalls& dispatcher) {
-    dispatcher.registerHandler(Syscall::SYS_open, hle_sys_open);
-    dispatcher.registerHandler(Syscall::SYS_read, hle_sys_read);
-    dispatcher.registerHandler(Syscall::SYS_write, hle_sys_write);
-    dispatcher.registerHandler(Syscall::SYS_close, hle_sys_close);
-    dispatcher.registerHandler(Syscall::SYS_lseek, hle_sys_lseek);
-    dispatcher.registerHandler(Syscall::SYS_fstat, hle_sys_fstat);
-    dispatcher.registerHandler(Syscall::SYS_stat, hle_sys_stat);
-    
-    std::cout << "[HLE] libFS handlers registered\n";
+    auto& vfs = dispatcher.getContext().getVfs();
+    auto withVfs = [&vfs](auto handler) { return std::bind_front(handler, std::ref(vfs)); };
+
+    dispatcher.registerHandler(Syscall::SYS_open, withVfs(hle_sys_open));
+    dispatcher.registerHandler(Syscall::SYS_read, withVfs(hle_sys_read));
+    dispatcher.registerHandler(Syscall::SYS_write, withVfs(hle_sys_write));
+    dispatcher.registerHandler(Syscall::SYS_close, withVfs(hle_sys_close));
+    dispatcher.registerHandler(Syscall::SYS_lseek, withVfs(hle_sys_lseek));
+    dispatcher.registerHandler(Syscall::SYS_fstat, withVfs(hle_sys_fstat));
+    dispatcher.registerHandler(Syscall::SYS_stat, withVfs(hle_sys_stat));
+    
+    WEAR_LOG_INFO(LogCategory::General, "[HLE] libFS handlers registered");
 }
 
 } // namespace LibFS
@@ -1,9 +1,11 @@
 #include "HLE/WeaR_Syscalls.h"
+#include "Core/WeaR_EmulationContext.h"
 #include "Input/WeaR_Input.h"
-#include "GUI/WeaR_Logger.h"
+#include "Input/WeaR_InputLatency.h"
+#include "Core/WeaR_Log.h"
 
-#include <iostream>
 #include <format>
+#include <functional>
 #include <cstring>
 #include <chrono>
 
@@ -77,11 +79,8 @@ void writePadDataToMemory(WeaR_Memory& mem, uint64_t outputPtr, const WeaR_Contr
     padData.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
         now.time_since_epoch()).count();
     
-    // Write to memory byte by byte (safe method)
-    const uint8_t* dataBytes = reinterpret_cast<const uint8_t*>(&padData);
-    for (size_t i = 0; i < sizeof(ScePadData); ++i) {
-        mem.write<uint8_t>(outputPtr + i, dataBytes[i]);
-    }
+    // Single bounds-checked block copy into guest memory
+    mem.writeBlock(outputPtr, &padData, sizeof(ScePadData));
 }
 
 // =============================================================================
@@ -96,6 +95,7 @@ void writePadDataToMemory(WeaR_Memory& mem, uint64_t outputPtr, const WeaR_Contr
  * RSI = output pointer to ScePadData
  */
 SyscallResult hle_scePadReadState(
+    WeaR_EmulationContext& emulation,
     WeaR_Context& ctx, 
     WeaR_Memory& mem,
     uint64_t handle, 
@@ -110,7 +110,8 @@ SyscallResult hle_scePadReadState(
     }
     
     // Get current input state
-    WeaR_ControllerState state = WeaR_InputManager::get().getPadState();
+    WeaR_ControllerState state = emulation.getInput().getPadState();
+    emulation.getInputLatency().onGuestRead(state.eventTimeUs);
     
     // Write to game memory
     try {
@@ -137,8 +138,8 @@ SyscallResult hle_scePadOpen(
     (void)index;
     
     // Return handle 0 (single controller)
-    getLogger().log(std::format("scePadOpen(user={}, type={}, index={})", 
-                                 userID, type, index), LogLevel::Debug);
+    WEAR_LOG_DEBUG(LogCategory::General, "scePadOpen(user={}, type={}, index={})",
+                   userID, type, index);
     return SyscallResult{0, true, ""};
 }
 
@@ -166,8 +167,8 @@ SyscallResult hle_scePadSetVibration(
     
     // Log vibration request (could trigger Windows haptics/gamepad rumble)
     if (leftMotor > 0 || rightMotor > 0) {
-        getLogger().log(std::format("scePadSetVibration: L={}, R={}", 
-                                     leftMotor, rightMotor), LogLevel::Debug);
+        WEAR_LOG_DEBUG(LogCategory::General, "scePadSetVibration: L={}, R={}",
+                       leftMotor, rightMotor);
     }
     
     return SyscallResult{0, true, ""};
@@ -181,13 +182,15 @@ SyscallResult hle_scePadSetVibration(
  * @brief Register libpad syscall handlers with dispatcher
  */
 void registerLibPadHandlers(WeaR_Syscalls& dispatcher) {
-    dispatcher.registerHandler(Syscall::SYS_scePadReadState, hle_scePadReadState);
-    dispatcher.registerHandler(Syscall::SYS_scePadRead, hle_scePadReadState);  // Alias
+    auto readState = std::bind_front(hle_scePadReadState, std::ref(dispatcher.getContext()));
+
+    dispatcher.registerHandler(Syscall::SYS_scePadReadState, readState);
+    dispatcher.registerHandler(Syscall::SYS_scePadRead, readState);  // Alias
     dispatcher.registerHandler(Syscall::SYS_scePadOpen, hle_scePadOpen);
     dispatcher.registerHandler(Syscall::SYS_scePadClose, hle_scePadClose);
     dispatcher.registerHandler(Syscall::SYS_scePadSetVibration, hle_scePadSetVibration);
     
-    std::cout << "[HLE] libpad handlers registered\n";
+    WEAR_LOG_INFO(LogCategory::General, "[HLE] libpad handlers registered");
 }
 
 } // namespace LibPad
@@ -1,22 +1,15 @@
 #include "WeaR_Syscalls.h"
-#include "GUI/WeaR_Logger.h"
+#include "Core/WeaR_EmulationContext.h"
+#include "Core/WeaR_Log.h"
+#include "Core/WeaR_Trace.h"
 #include "Graphics/WeaR_GnmDriver.h"
+#include "Input/WeaR_InputLatency.h"
 
-#include <iostream>
 #include <format>
 #include <cstring>
 
 namespace WeaR {
 
-// =============================================================================
-// GLOBAL DISPATCHER
-// =============================================================================
-
-WeaR_Syscalls& getSyscallDispatcher() {
-    static WeaR_Syscalls instance;
-    return instance;
-}
-
 // =============================================================================
 // SYSCALL NAMES
 // =============================================================================
@@ -52,27 +45,18 @@ std::string WeaR_Syscalls::getSyscallName(uint64_t num) {
 // CONSTRUCTOR
 // =============================================================================
 
-WeaR_Syscalls::WeaR_Syscalls() {
+WeaR_Syscalls::WeaR_Syscalls(WeaR_EmulationContext& context)
+    : m_context(context)
+{
     registerDefaultHandlers();
 }
 
-// =============================================================================
-// LOGGING
-// =============================================================================
-
-void WeaR_Syscalls::log(const std::string& message) {
-    if (m_logger) {
-        m_logger->log(message);
-    } else {
-        std::cout << "[Syscall] " << message << "\n";
-    }
-}
-
 // =============================================================================
 // DISPATCH
 // =============================================================================
 
 void WeaR_Syscalls::dispatch(WeaR_Context& ctx, WeaR_Memory& mem) {
+    WEAR_TRACE_SCOPE_ARG(TraceCategory::Syscall, "syscall", "number", ctx.RAX);
     m_totalCalls++;
 
     uint64_t syscallNum = ctx.RAX;
@@ -89,13 +73,13 @@ void WeaR_Syscalls::dispatch(WeaR_Context& ctx, WeaR_Memory& mem) {
         ctx.RAX = static_cast<uint64_t>(result.value);
         
         if (!result.success) {
-            log(std::format("{}: {}", getSyscallName(syscallNum), result.error));
+            WEAR_LOG_WARN_LIMITED(LogCategory::Syscall, "{}: {}", getSyscallName(syscallNum), result.error);
         }
     } else {
         // Unimplemented syscall
         m_unimplementedCalls++;
-        log(std::format("Unimplemented syscall: {} ({})", 
-                        getSyscallName(syscallNum), syscallNum));
+        WEAR_LOG_WARN_LIMITED(LogCategory::Syscall, "Unimplemented syscall: {} ({})",
+                              getSyscallName(syscallNum), syscallNum);
         
         // Return 0 (success) to allow game to continue
         ctx.RAX = 0;
@@ -106,6 +90,11 @@ void WeaR_Syscalls::registerHandler(uint64_t syscallNum, HleFunction handler) {
     m_handlers[syscallNum] = std::move(handler);
 }
 
+void WeaR_Syscalls::reset() {
+    m_nextMmapAddress = PS4Memory::Region::HEAP_BASE;
+    m_nextModuleId = FIRST_MODULE_ID;
+}
+
 // =============================================================================
 // DEFAULT HANDLERS
 // =============================================================================
@@ -114,11 +103,11 @@ void WeaR_Syscalls::registerDefaultHandlers() {
     // =========================================================================
     // sys_exit (1)
     // =========================================================================
-    registerHandler(Syscall::SYS_exit, [this](
+    registerHandler(Syscall::SYS_exit, [](
         WeaR_Context& ctx, WeaR_Memory&,
         uint64_t rdi, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t)
     {
-        log(std::format("sys_exit(status={})", static_cast<int>(rdi)));
+        WEAR_LOG_TRACE(LogCategory::Syscall, "sys_exit(status={})", static_cast<int>(rdi));
         // Signal CPU to stop (handled externally)
         ctx.RAX = 0;
         return SyscallResult{0, true, ""};
@@ -127,7 +116,7 @@ void WeaR_Syscalls::registerDefaultHandlers() {
     // =========================================================================
     // sys_write (4)
     // =========================================================================
-    registerHandler(Syscall::SYS_write, [this](
+    registerHandler(Syscall::SYS_write, [](
         WeaR_Context&, WeaR_Memory& mem,
         uint64_t fd, uint64_t buf, uint64_t count, uint64_t, uint64_t, uint64_t)
     {
@@ -147,7 +136,7 @@ void WeaR_Syscalls::registerDefaultHandlers() {
 
         // Log to kernel console
         if (fd == 1 || fd == 2) {  // stdout or stderr
-            log(std::format("[fd{}] {}", fd, output));
+            WEAR_LOG_INFO(LogCategory::Syscall, "[fd{}] {}", fd, output);
         }
 
         return SyscallResult{static_cast<int64_t>(output.size()), true, ""};
@@ -163,16 +152,14 @@ void WeaR_Syscalls::registerDefaultHandlers() {
     {
         (void)prot; (void)flags; (void)fd; (void)offset;
         
-        // Simplified: return a fixed address in heap region
-        static uint64_t nextAlloc = PS4Memory::Region::HEAP_BASE;
-        
-        uint64_t allocAddr = (addr != 0) ? addr : nextAlloc;
+        // Simplified: bump allocator in the heap region
+        uint64_t allocAddr = (addr != 0) ? addr : m_nextMmapAddress;
         uint64_t alignedLen = (length + 0xFFF) & ~0xFFFULL;  // Page align
         
-        nextAlloc += alignedLen;
+        m_nextMmapAddress += alignedLen;
 
-        log(std::format("sys_mmap(addr=0x{:X}, len={}) -> 0x{:X}", 
-                        addr, length, allocAddr));
+        WEAR_LOG_TRACE(LogCategory::Syscall, "sys_mmap(addr=0x{:X}, len={}) -> 0x{:X}",
+                       addr, length, allocAddr);
 
         return SyscallResult{static_cast<int64_t>(allocAddr), true, ""};
     });
@@ -200,7 +187,7 @@ void WeaR_Syscalls::registerDefaultHandlers() {
     // =========================================================================
     // sceKernelDebugOut (602)
     // =========================================================================
-    registerHandler(Syscall::SYS_sceKernelDebugOut, [this](
+    registerHandler(Syscall::SYS_sceKernelDebugOut, [](
         WeaR_Context&, WeaR_Memory& mem,
         uint64_t msgPtr, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t)
     {
@@ -216,7 +203,7 @@ void WeaR_Syscalls::registerDefaultHandlers() {
             return SyscallResult{-14, false, "EFAULT"};
         }
 
-        log(std::format("[DEBUG] {}", message));
+        WEAR_LOG_INFO(LogCategory::Syscall, "[DEBUG] {}", message);
         return SyscallResult{0, true, ""};
     });
 
@@ -261,11 +248,10 @@ void WeaR_Syscalls::registerDefaultHandlers() {
             return SyscallResult{-1, false, "EFAULT"};
         }
 
-        log(std::format("LoadStartModule: {}", path));
+        WEAR_LOG_TRACE(LogCategory::Syscall, "LoadStartModule: {}", path);
         
         // Return fake module handle
-        static int nextModuleId = 100;
-        return SyscallResult{nextModuleId++, true, ""};
+        return SyscallResult{m_nextModuleId++, true, ""};
     });
 
     // =========================================================================
@@ -276,9 +262,9 @@ void WeaR_Syscalls::registerDefaultHandlers() {
         uint64_t count, uint64_t cmdBuffersPtr, uint64_t sizesPtr,
         uint64_t, uint64_t, uint64_t)
     {
-        log(std::format("sceGnmSubmitCommandBuffers: count={}", count));
+        WEAR_LOG_TRACE(LogCategory::Syscall, "sceGnmSubmitCommandBuffers: count={}", count);
         
-        int32_t result = getGnmDriver().handleSubmitCommandBuffers(
+        int32_t result = m_context.getGnmDriver().handleSubmitCommandBuffers(
             static_cast<uint32_t>(count), cmdBuffersPtr, sizesPtr, mem);
         
         return SyscallResult{result, result == 0, ""};
@@ -291,7 +277,9 @@ void WeaR_Syscalls::registerDefaultHandlers() {
         WeaR_Context&, WeaR_Memory&,
         uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t)
     {
-        log("sceGnmSubmitDone");
+        WEAR_LOG_TRACE(LogCategory::Syscall, "sceGnmSubmitDone");
+        m_flips.fetch_add(1, std::memory_order_relaxed);
+        m_context.getInputLatency().onGuestFlip();
         return SyscallResult{0, true, ""};
     });
 
@@ -15,11 +15,11 @@
 #include <functional>
 #include <unordered_map>
 #include <cstdint>
+#include <atomic>
 
 namespace WeaR {
 
-// Forward declaration
-class WeaR_Logger;
+class WeaR_EmulationContext;
 
 // =============================================================================
 // SYSCALL NUMBERS (FreeBSD/PS4)
@@ -88,9 +88,17 @@ using HleFunction = std::function<SyscallResult(
  */
 class WeaR_Syscalls {
 public:
-    WeaR_Syscalls();
+    /**
+     * @param context Owner; handlers reach the GNM driver, VFS etc. through it
+     */
+    explicit WeaR_Syscalls(WeaR_EmulationContext& context);
     ~WeaR_Syscalls() = default;
 
+    WeaR_Syscalls(const WeaR_Syscalls&) = delete;
+    WeaR_Syscalls& operator=(const WeaR_Syscalls&) = delete;
+
+    [[nodiscard]] WeaR_EmulationContext& getContext() { return m_context; }
+
     /**
      * @brief Dispatch a syscall based on context registers
      * @param ctx CPU context (read args, write result)
@@ -99,14 +107,15 @@ public:
     void dispatch(WeaR_Context& ctx, WeaR_Memory& mem);
 
     /**
-     * @brief Set logger for syscall output
+     * @brief Register a custom HLE handler
      */
-    void setLogger(WeaR_Logger* logger) { m_logger = logger; }
+    void registerHandler(uint64_t syscallNum, HleFunction handler);
 
     /**
-     * @brief Register a custom HLE handler
+     * @brief Forget guest allocations and module handles (title stopped);
+     *        the call counters keep running
      */
-    void registerHandler(uint64_t syscallNum, HleFunction handler);
+    void reset();
 
     /**
      * @brief Get syscall name for debugging
@@ -114,28 +123,25 @@ public:
     [[nodiscard]] static std::string getSyscallName(uint64_t num);
 
     /**
-     * @brief Get syscall statistics
+     * @brief Get syscall statistics (safe to read from other threads)
      */
     [[nodiscard]] uint64_t getTotalCalls() const { return m_totalCalls; }
     [[nodiscard]] uint64_t getUnimplementedCalls() const { return m_unimplementedCalls; }
+    [[nodiscard]] uint64_t getFlipCount() const { return m_flips; }     // sceGnmSubmitDone calls
 
 private:
     void registerDefaultHandlers();
-    void log(const std::string& message);
 
+    WeaR_EmulationContext& m_context;
     std::unordered_map<uint64_t, HleFunction> m_handlers;
-    WeaR_Logger* m_logger = nullptr;
-    uint64_t m_totalCalls = 0;
-    uint64_t m_unimplementedCalls = 0;
+    std::atomic<uint64_t> m_totalCalls{0};
+    std::atomic<uint64_t> m_unimplementedCalls{0};
+    std::atomic<uint64_t> m_flips{0};
+
+    // Guest-visible kernel state (CPU thread only)
+    static constexpr int FIRST_MODULE_ID = 100;
+    uint64_t m_nextMmapAddress = PS4Memory::Region::HEAP_BASE;
+    int m_nextModuleId = FIRST_MODULE_ID;
 };
 
-// =============================================================================
-// GLOBAL DISPATCHER ACCESS
-// =============================================================================
-
-/**
- * @brief Get global syscall dispatcher
- */
-WeaR_Syscalls& getSyscallDispatcher();
-
 } // namespace WeaR
@@ -1,9 +1,13 @@
 #include "HardwareDetector.h"
+#include "Core/WeaR_Log.h"
 
 #include <algorithm>
+#include <charconv>
+#include <filesystem>
 #include <format>
-#include <iostream>
+#include <fstream>
 #include <cstring>
+#include <system_error>
 
 namespace WeaR {
 
@@ -182,6 +186,20 @@ public:
         return bestDevice;
     }
 
+    void readIdentity(VkPhysicalDevice device, std::array<uint8_t, 16>& uuid, uint32_t& driverVersion) {
+        VkPhysicalDeviceProperties2 props2{};
+        props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+
+        VkPhysicalDeviceIDProperties idProps{};
+        idProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+        props2.pNext = &idProps;
+
+        vkGetPhysicalDeviceProperties2(device, &props2);
+
+        std::memcpy(uuid.data(), idProps.deviceUUID, uuid.size());
+        driverVersion = props2.properties.driverVersion;
+    }
+
     HardwareCapabilities queryCapabilities(VkPhysicalDevice device) {
         HardwareCapabilities caps{};
 
@@ -195,6 +213,10 @@ public:
         subgroupProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
         props2.pNext = &subgroupProps;
 
+        VkPhysicalDeviceIDProperties idProps{};
+        idProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+        subgroupProps.pNext = &idProps;
+
         vkGetPhysicalDeviceProperties2(device, &props2);
 
         const auto& props = props2.properties;
@@ -202,6 +224,8 @@ public:
         caps.vendorID = props.vendorID;
         caps.deviceID = props.deviceID;
         caps.deviceType = props.deviceType;
+        std::memcpy(caps.deviceUUID.data(), idProps.deviceUUID, caps.deviceUUID.size());
+        caps.driverVersionRaw = props.driverVersion;
 
         // Parse driver version
         uint32_t driverVer = props.driverVersion;
@@ -394,18 +418,15 @@ HardwareDetector::~HardwareDetector() = default;
 HardwareDetector::HardwareDetector(HardwareDetector&&) noexcept = default;
 HardwareDetector& HardwareDetector::operator=(HardwareDetector&&) noexcept = default;
 
-std::expected<WeaR_Specs, HardwareDetector::ErrorType> HardwareDetector::detectCapabilities() {
-    auto result = detectDetailedCapabilities();
-    if (!result) {
-        return std::unexpected(result.error());
-    }
-    
-    // Convert to simpler WeaR_Specs
-    const HardwareCapabilities& caps = result.value();
+namespace {
+
+WeaR_Specs toSpecs(const HardwareCapabilities& caps) {
     WeaR_Specs specs;
     specs.gpuName = caps.gpuName;
     specs.driverVersion = caps.driverVersion;
     specs.vendorID = caps.vendorID;
+    specs.deviceUUID = caps.deviceUUID;
+    specs.driverVersionRaw = caps.driverVersionRaw;
     specs.estimatedTFLOPs = caps.estimatedTFLOPs;
     specs.vramBytes = caps.vramBytes;
     specs.tier = caps.tier;
@@ -413,10 +434,21 @@ std::expected<WeaR_Specs, HardwareDetector::ErrorType> HardwareDetector::detectC
     specs.supportsShaderFloat16Int8 = caps.supportsShaderFloat16Int8;
     specs.canRunFrameGen = caps.canRunFrameGen;
     specs.frameGenDisableReason = caps.frameGenDisableReason;
-    
     return specs;
 }
 
+} // anonymous namespace
+
+std::expected<WeaR_Specs, HardwareDetector::ErrorType> HardwareDetector::detectCapabilities() {
+    auto result = detectDetailedCapabilities();
+    if (!result) {
+        return std::unexpected(result.error());
+    }
+    
+    // Convert to simpler WeaR_Specs
+    return toSpecs(result.value());
+}
+
 std::expected<HardwareCapabilities, HardwareDetector::ErrorType> HardwareDetector::detectDetailedCapabilities() {
     Impl impl;
 
@@ -438,9 +470,181 @@ std::expected<HardwareCapabilities, HardwareDetector::ErrorType> HardwareDetecto
 
     // Query all capabilities
     HardwareCapabilities caps = impl.queryCapabilities(deviceResult.value());
+    caps.hostCpu = getHostCpuInfo();
 
     // Cleanup happens automatically in Impl destructor
     return caps;
 }
 
+// =============================================================================
+// Capability Cache
+// =============================================================================
+//
+// Plain "key=value" lines. The probe itself is cheap next to creating the
+// instance, so the win is taking it off the startup critical path: cached
+// specs are used immediately and revalidated in the background.
+
+namespace {
+
+std::string uuidToHex(const std::array<uint8_t, 16>& uuid) {
+    std::string hex;
+    hex.reserve(uuid.size() * 2);
+    for (uint8_t byte : uuid) {
+        hex += std::format("{:02x}", byte);
+    }
+    return hex;
+}
+
+bool hexToUuid(std::string_view hex, std::array<uint8_t, 16>& uuid) {
+    if (hex.size() != uuid.size() * 2) return false;
+    for (size_t i = 0; i < uuid.size(); ++i) {
+        auto [ptr, ec] = std::from_chars(hex.data() + i * 2, hex.data() + i * 2 + 2, uuid[i], 16);
+        if (ec != std::errc{} || ptr != hex.data() + i * 2 + 2) return false;
+    }
+    return true;
+}
+
+template <typename T>
+bool parseNumber(std::string_view text, T& value) {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+} // anonymous namespace
+
+std::optional<WeaR_Specs> HardwareDetector::loadCapabilityCache(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return std::nullopt;
+
+    WeaR_Specs specs;
+    uint32_t version = 0;
+    uint32_t fieldsSeen = 0;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) return std::nullopt;
+
+        std::string_view key(line.data(), eq);
+        std::string_view value(line.data() + eq + 1, line.size() - eq - 1);
+        bool ok = true;
+        uint32_t flag = 0;
+
+        if (key == "version") {
+            ok = parseNumber(value, version);
+        } else if (key == "device_uuid") {
+            ok = hexToUuid(value, specs.deviceUUID);
+            fieldsSeen |= 1u << 0;
+        } else if (key == "driver_version_raw") {
+            ok = parseNumber(value, specs.driverVersionRaw);
+            fieldsSeen |= 1u << 1;
+        } else if (key == "gpu_name") {
+            specs.gpuName = value;
+        } else if (key == "driver_version") {
+            specs.driverVersion = value;
+        } else if (key == "vendor_id") {
+            ok = parseNumber(value, specs.vendorID);
+        } else if (key == "tflops") {
+            ok = parseNumber(value, specs.estimatedTFLOPs);
+        } else if (key == "vram_bytes") {
+            ok = parseNumber(value, specs.vramBytes);
+        } else if (key == "tier") {
+            uint32_t tier = 0;
+            ok = parseNumber(value, tier) && tier <= static_cast<uint32_t>(GPUTier::Enthusiast);
+            specs.tier = static_cast<GPUTier>(tier);
+        } else if (key == "fp16") {
+            ok = parseNumber(value, flag);
+            specs.supportsFloat16 = flag != 0;
+        } else if (key == "fp16_int8") {
+            ok = parseNumber(value, flag);
+            specs.supportsShaderFloat16Int8 = flag != 0;
+        } else if (key == "frame_gen") {
+            ok = parseNumber(value, flag);
+            specs.canRunFrameGen = flag != 0;
+        } else if (key == "frame_gen_reason") {
+            specs.frameGenDisableReason = value;
+        }
+        // Unknown keys are ignored so older builds can read newer files
+
+        if (!ok) return std::nullopt;
+    }
+
+    if (version != CAPABILITY_CACHE_VERSION || fieldsSeen != 0x3) {
+        return std::nullopt;
+    }
+    return specs;
+}
+
+bool HardwareDetector::saveCapabilityCache(const std::string& path, const WeaR_Specs& specs) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    fs::path target(path);
+    if (target.has_parent_path()) {
+        fs::create_directories(target.parent_path(), ec);
+    }
+
+    fs::path temp = target;
+    temp += ".tmp";
+    {
+        std::ofstream file(temp, std::ios::trunc);
+        if (!file) return false;
+
+        file << "# WeaR-emu GPU capability cache (regenerated when the GPU or driver changes)\n";
+        file << std::format("version={}\n", CAPABILITY_CACHE_VERSION);
+        file << std::format("device_uuid={}\n", uuidToHex(specs.deviceUUID));
+        file << std::format("driver_version_raw={}\n", specs.driverVersionRaw);
+        file << std::format("gpu_name={}\n", specs.gpuName);
+        file << std::format("driver_version={}\n", specs.driverVersion);
+        file << std::format("vendor_id={}\n", specs.vendorID);
+        file << std::format("tflops={}\n", specs.estimatedTFLOPs);
+        file << std::format("vram_bytes={}\n", specs.vramBytes);
+        file << std::format("tier={}\n", static_cast<uint32_t>(specs.tier));
+        file << std::format("fp16={}\n", specs.supportsFloat16 ? 1 : 0);
+        file << std::format("fp16_int8={}\n", specs.supportsShaderFloat16Int8 ? 1 : 0);
+        file << std::format("frame_gen={}\n", specs.canRunFrameGen ? 1 : 0);
+        file << std::format("frame_gen_reason={}\n", specs.frameGenDisableReason);
+        if (!file.flush()) return false;
+    }
+
+    fs::rename(temp, target, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+std::expected<std::optional<WeaR_Specs>, HardwareDetector::ErrorType>
+HardwareDetector::revalidateCapabilityCache(const WeaR_Specs& cached, const std::string& path) {
+    Impl impl;
+
+    if (auto result = impl.initializeVolk(); !result) {
+        return std::unexpected(result.error());
+    }
+    if (auto result = impl.createInstance(); !result) {
+        return std::unexpected(result.error());
+    }
+
+    auto deviceResult = impl.selectBestDevice();
+    if (!deviceResult) {
+        return std::unexpected(deviceResult.error());
+    }
+
+    std::array<uint8_t, 16> uuid{};
+    uint32_t driverVersion = 0;
+    impl.readIdentity(deviceResult.value(), uuid, driverVersion);
+
+    if (uuid == cached.deviceUUID && driverVersion == cached.driverVersionRaw) {
+        return std::optional<WeaR_Specs>{};
+    }
+
+    WeaR_Specs fresh = toSpecs(impl.queryCapabilities(deviceResult.value()));
+    if (!saveCapabilityCache(path, fresh)) {
+        WEAR_LOG_WARN(LogCategory::General, "Failed to update capability cache: {}", path.string());
+    }
+    return std::optional<WeaR_Specs>{std::move(fresh)};
+}
+
 } // namespace WeaR
@@ -18,6 +18,10 @@
 #include <volk.h>
 #include <vk_mem_alloc.h>
 
+#include "HardwareSpecs.h"
+#include "Core/WeaR_HostCpu.h"
+
+#include <array>
 #include <string>
 #include <cstdint>
 #include <optional>
@@ -26,59 +30,6 @@
 
 namespace WeaR {
 
-/**
- * @brief GPU capability tier for adaptive feature selection
- */
-enum class GPUTier : uint8_t {
-    Unknown = 0,
-    LowEnd,      // Integrated/Old discrete - No WeaR-Gen
-    MidRange,    // Entry discrete - Limited WeaR-Gen  
-    HighEnd,     // Modern discrete - Full WeaR-Gen
-    Enthusiast   // Flagship - All features + extras
-};
-
-/**
- * @brief WeaR-Gen capability status
- */
-enum class FrameGenStatus : uint8_t {
-    Unsupported,   // Hardware cannot run WeaR-Gen
-    Disabled,      // Can run but user disabled
-    Active         // Running WeaR-Gen
-};
-
-/**
- * @brief Simplified specs struct for quick capability checks
- * 
- * This is the primary interface for checking if WeaR-Gen can run.
- */
-struct WeaR_Specs {
-    // Device Info
-    std::string gpuName = "Unknown GPU";
-    std::string driverVersion = "Unknown";
-    uint32_t vendorID = 0;
-    
-    // Key Metrics
-    float estimatedTFLOPs = 0.0f;
-    uint64_t vramBytes = 0;
-    GPUTier tier = GPUTier::Unknown;
-    
-    // Feature Support
-    bool supportsFloat16 = false;
-    bool supportsShaderFloat16Int8 = false;
-    
-    // === CRITICAL DECISION ===
-    bool canRunFrameGen = false;
-    std::string frameGenDisableReason;
-    
-    // Convenience methods
-    [[nodiscard]] float vramGB() const { 
-        return static_cast<float>(vramBytes) / (1024.0f * 1024.0f * 1024.0f); 
-    }
-    
-    [[nodiscard]] std::string vramString() const;
-    [[nodiscard]] std::string tierString() const;
-};
-
 /**
  * @brief Detailed hardware capabilities (extended info)
  */
@@ -100,6 +51,9 @@ struct HardwareCapabilities : public WeaR_Specs {
     
     // Memory Details
     uint64_t sharedSystemMemory = 0;
+
+    // Host CPU (features, cores, caches)
+    HostCpuInfo hostCpu;
 };
 
 /**
@@ -138,6 +92,28 @@ public:
      */
     [[nodiscard]] static std::expected<HardwareCapabilities, ErrorType> detectDetailedCapabilities();
 
+    /**
+     * @brief Read specs saved by saveCapabilityCache (no Vulkan calls)
+     * @return std::nullopt if the file is missing, malformed or from another version
+     */
+    [[nodiscard]] static std::optional<WeaR_Specs> loadCapabilityCache(const std::string& path);
+
+    /**
+     * @brief Write specs to the capability cache (replaced atomically)
+     */
+    static bool saveCapabilityCache(const std::string& path, const WeaR_Specs& specs);
+
+    /**
+     * @brief Check cached specs against the installed GPU and driver
+     * 
+     * Only the device UUID and raw driver version are read; on a mismatch
+     * the full probe runs on the same instance and the cache is rewritten.
+     * 
+     * @return std::nullopt if the cache is current, otherwise the fresh specs
+     */
+    [[nodiscard]] static std::expected<std::optional<WeaR_Specs>, ErrorType> revalidateCapabilityCache(
+        const WeaR_Specs& cached, const std::string& path);
+
     /**
      * @brief Get human-readable tier string
      */
@@ -154,6 +130,9 @@ private:
     static constexpr float TFLOP_THRESHOLD = 4.0f;
     static constexpr uint64_t VRAM_THRESHOLD_BYTES = 2ULL * 1024 * 1024 * 1024; // 2GB
 
+    // Bump when the estimation heuristics change so cached specs are re-probed
+    static constexpr uint32_t CAPABILITY_CACHE_VERSION = 1;
+
     // Internal implementation
     class Impl;
 };
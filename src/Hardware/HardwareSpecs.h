@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file HardwareSpecs.h
+ * @brief Vulkan-free GPU capability summary
+ *
+ * Split out of HardwareDetector.h so the core and the headless runner can
+ * pass specs around without the volk and VMA headers. vramString() and
+ * tierString() live in HardwareDetector.cpp with the detector.
+ */
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace WeaR {
+
+/**
+ * @brief GPU capability tier for adaptive feature selection
+ */
+enum class GPUTier : uint8_t {
+    Unknown = 0,
+    LowEnd,      // Integrated/Old discrete - No WeaR-Gen
+    MidRange,    // Entry discrete - Limited WeaR-Gen  
+    HighEnd,     // Modern discrete - Full WeaR-Gen
+    Enthusiast   // Flagship - All features + extras
+};
+
+/**
+ * @brief WeaR-Gen capability status
+ */
+enum class FrameGenStatus : uint8_t {
+    Unsupported,   // Hardware cannot run WeaR-Gen
+    Disabled,      // Can run but user disabled
+    Active         // Running WeaR-Gen
+};
+
+/**
+ * @brief Simplified specs struct for quick capability checks
+ * 
+ * This is the primary interface for checking if WeaR-Gen can run.
+ */
+struct WeaR_Specs {
+    // Device Info
+    std::string gpuName = "Unknown GPU";
+    std::string driverVersion = "Unknown";
+    uint32_t vendorID = 0;
+    
+    // Identity (capability cache key)
+    std::array<uint8_t, 16> deviceUUID{};
+    uint32_t driverVersionRaw = 0;
+    
+    // Key Metrics
+    float estimatedTFLOPs = 0.0f;
+    uint64_t vramBytes = 0;
+    GPUTier tier = GPUTier::Unknown;
+    
+    // Feature Support
+    bool supportsFloat16 = false;
+    bool supportsShaderFloat16Int8 = false;
+    
+    // === CRITICAL DECISION ===
+    bool canRunFrameGen = false;
+    std::string frameGenDisableReason;
+    
+    // Convenience methods
+    [[nodiscard]] float vramGB() const { 
+        return static_cast<float>(vramBytes) / (1024.0f * 1024.0f * 1024.0f); 
+    }
+    
+    [[nodiscard]] std::string vramString() const;
+    [[nodiscard]] std::string tierString() const;
+};
+
+} // namespace WeaR
@@ -1,6 +1,7 @@
 #include "WeaR_Input.h"
+#include "WeaR_InputLatency.h"
+#include "Core/WeaR_Log.h"
 #include <format>
-#include <iostream>
 #include <cstring>
 #include <memory>
 #include <algorithm>
@@ -50,14 +51,14 @@ public:
             if (result == ERROR_SUCCESS) {
                 m_controllerConnected = true;
                 m_controllerIndex = static_cast<int>(i);
-                std::cout << std::format("[INPUT] Controller found on Port {}\n", i);
+                WEAR_LOG_INFO(LogCategory::General, "Controller found on Port {}", i);
                 return;
             }
         }
 #endif
 
         if (!m_controllerConnected) {
-            std::cout << "[INPUT] No controller detected on ports 0-3\n";
+            WEAR_LOG_INFO(LogCategory::General, "No controller detected on ports 0-3");
         }
     }
 
@@ -80,7 +81,7 @@ public:
                 pad.connected = 1;
             } else {
                 // Controller disconnected - will re-scan on next poll
-                std::cout << std::format("[INPUT] Controller on Port {} disconnected\n", m_controllerIndex);
+                WEAR_LOG_WARN(LogCategory::General, "Controller on Port {} disconnected", m_controllerIndex);
                 m_controllerConnected = false;
                 m_controllerIndex = -1;
                 pad.connected = 0;
@@ -189,14 +190,9 @@ void WeaR_Input::detectControllers() {
 }
 
 // ============================================================================
-// WeaR_InputManager Singleton Implementation
+// WeaR_InputManager Implementation
 // ============================================================================
 
-WeaR_InputManager& WeaR_InputManager::get() {
-    static WeaR_InputManager instance;
-    return instance;
-}
-
 WeaR_InputManager::WeaR_InputManager() {
     setupDefaultMappings();
 }
@@ -207,6 +203,7 @@ void WeaR_InputManager::setupDefaultMappings() {
 }
 
 void WeaR_InputManager::handleKeyPress(int qtKey, bool pressed) {
+    const uint64_t eventTime = WeaR_InputLatency::nowUs();
     std::lock_guard<std::mutex> lock(m_mutex);
     if (qtKey >= 0 && qtKey < 512) {
         m_keyStates[qtKey] = pressed;
@@ -253,10 +250,13 @@ void WeaR_InputManager::handleKeyPress(int qtKey, bool pressed) {
     }
     
     applyDigitalToAnalog();
+    m_state.eventTimeUs = eventTime;
+    publish();
     m_inputEventCount++;
 }
 
 void WeaR_InputManager::handleMouseButton(int button, bool pressed) {
+    const uint64_t eventTime = WeaR_InputLatency::nowUs();
     std::lock_guard<std::mutex> lock(m_mutex);
     // Button 1 = L2, Button 2 = R2 (example)
     if (button == 1) {
@@ -268,11 +268,14 @@ void WeaR_InputManager::handleMouseButton(int button, bool pressed) {
         if (pressed) m_state.buttons |= PadButton::R2;
         else m_state.buttons &= ~PadButton::R2;
     }
+    m_state.eventTimeUs = eventTime;
+    publish();
     m_inputEventCount++;
 }
 
 void WeaR_InputManager::handleMouseMove(int deltaX, int deltaY) {
     if (!m_mouseLookEnabled) return;
+    const uint64_t eventTime = WeaR_InputLatency::nowUs();
     std::lock_guard<std::mutex> lock(m_mutex);
     
     // Map mouse movement to right stick
@@ -280,24 +283,35 @@ void WeaR_InputManager::handleMouseMove(int deltaX, int deltaY) {
     int newY = m_state.rightStickY + deltaY;
     m_state.rightStickX = static_cast<uint8_t>(std::clamp(newX, 0, 255));
     m_state.rightStickY = static_cast<uint8_t>(std::clamp(newY, 0, 255));
+    m_state.eventTimeUs = eventTime;
+    publish();
     m_inputEventCount++;
 }
 
-WeaR_ControllerState WeaR_InputManager::getPadState() const {
+void WeaR_InputManager::setPadState(const WeaR_ControllerState& state) {
+    const uint64_t eventTime = WeaR_InputLatency::nowUs();
     std::lock_guard<std::mutex> lock(m_mutex);
-    return m_state;
+    m_state = state;
+    m_state.eventTimeUs = eventTime;
+    publish();
+    m_inputEventCount++;
+}
+
+WeaR_ControllerState WeaR_InputManager::getPadState() const {
+    return m_published.load();
 }
 
 bool WeaR_InputManager::hasInput() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_state.buttons != 0 || 
-           m_state.leftStickX != 128 || m_state.leftStickY != 128 ||
-           m_state.rightStickX != 128 || m_state.rightStickY != 128;
+    WeaR_ControllerState state = m_published.load();
+    return state.buttons != 0 || 
+           state.leftStickX != 128 || state.leftStickY != 128 ||
+           state.rightStickX != 128 || state.rightStickY != 128;
 }
 
 void WeaR_InputManager::reset() {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_state.reset();
+    publish();
 }
 
 void WeaR_InputManager::setKeyMapping(int qtKey, uint32_t padButton) {
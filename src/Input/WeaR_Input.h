@@ -7,9 +7,12 @@
  * Maps host input to PS4 ScePadData format for libpad HLE.
  */
 
+#include "Core/WeaR_SeqLock.h"
+
 #include <cstdint>
 #include <atomic>
 #include <mutex>
+#include <memory>    // WeaR_Input::m_impl
 
 namespace WeaR {
 
@@ -82,6 +85,9 @@ struct WeaR_ControllerState {
     uint16_t touchY = 470;   // Center of 942 touchpad
     bool touchActive = false;
     
+    // Host time of the latest input event (WeaR_InputLatency::nowUs)
+    uint64_t eventTimeUs = 0;
+    
     // Motion (placeholder)
     float accelerometerX = 0;
     float accelerometerY = -1.0f;  // Gravity
@@ -94,6 +100,7 @@ struct WeaR_ControllerState {
         rightStickX = rightStickY = 128;
         l2Analog = r2Analog = 0;
         touchActive = false;
+        eventTimeUs = 0;
     }
 };
 
@@ -117,14 +124,19 @@ struct KeyMapping {
 // =============================================================================
 
 /**
- * @brief Thread-safe input manager singleton
+ * @brief Thread-safe input manager (one per emulation context)
+ * 
+ * Host events (Qt thread) mutate a writer-private state under m_mutex and
+ * publish it through a seqlock. Guest reads (scePadReadState, often from
+ * several threads every frame) never take the mutex.
  */
 class WeaR_InputManager {
 public:
-    /**
-     * @brief Get singleton instance
-     */
-    static WeaR_InputManager& get();
+    WeaR_InputManager();
+    ~WeaR_InputManager() = default;
+
+    WeaR_InputManager(const WeaR_InputManager&) = delete;
+    WeaR_InputManager& operator=(const WeaR_InputManager&) = delete;
 
     /**
      * @brief Handle keyboard key state change
@@ -144,10 +156,20 @@ public:
     void handleMouseMove(int deltaX, int deltaY);
 
     /**
-     * @brief Get current controller state (thread-safe copy)
+     * @brief Replace the whole controller state (input replay, scripted runs)
+     */
+    void setPadState(const WeaR_ControllerState& state);
+
+    /**
+     * @brief Get current controller state (lock-free snapshot)
      */
     [[nodiscard]] WeaR_ControllerState getPadState() const;
 
+    /**
+     * @brief Number of state snapshots published so far
+     */
+    [[nodiscard]] uint64_t getStateVersion() const { return m_published.getVersion(); }
+
     /**
      * @brief Check if any input is active
      */
@@ -175,14 +197,13 @@ public:
     [[nodiscard]] uint64_t getInputEventCount() const { return m_inputEventCount; }
 
 private:
-    WeaR_InputManager();
-    ~WeaR_InputManager() = default;
-
     void setupDefaultMappings();
     void applyDigitalToAnalog();
+    void publish() { m_published.store(m_state); }
 
-    WeaR_ControllerState m_state;
-    mutable std::mutex m_mutex;
+    WeaR_ControllerState m_state;           // Writer-side working copy
+    WeaR_SeqLock<WeaR_ControllerState> m_published;
+    std::mutex m_mutex;                     // Serialises writers only
     
     // Key state tracking for analog simulation
     bool m_keyStates[512] = {};  // Qt key states
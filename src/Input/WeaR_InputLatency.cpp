@@ -0,0 +1,134 @@
+#include "WeaR_InputLatency.h"
+
+#include <chrono>
+#include <format>
+#include <bit>
+#include <cmath>
+#include <algorithm>
+
+namespace WeaR {
+
+// =============================================================================
+// HISTOGRAM
+// =============================================================================
+
+void WeaR_LatencyHistogram::record(uint64_t micros) {
+    size_t bucket = micros == 0 ? 0 : static_cast<size_t>(std::bit_width(micros) - 1);
+    if (bucket >= BUCKET_COUNT) bucket = BUCKET_COUNT - 1;
+
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sumUs.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t prev = m_minUs.load(std::memory_order_relaxed);
+    while (micros < prev && !m_minUs.compare_exchange_weak(prev, micros, std::memory_order_relaxed)) {}
+
+    prev = m_maxUs.load(std::memory_order_relaxed);
+    while (micros > prev && !m_maxUs.compare_exchange_weak(prev, micros, std::memory_order_relaxed)) {}
+}
+
+void WeaR_LatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sumUs.store(0, std::memory_order_relaxed);
+    m_minUs.store(UINT64_MAX, std::memory_order_relaxed);
+    m_maxUs.store(0, std::memory_order_relaxed);
+}
+
+uint64_t WeaR_LatencyHistogram::getMinUs() const {
+    uint64_t value = m_minUs.load(std::memory_order_relaxed);
+    return value == UINT64_MAX ? 0 : value;
+}
+
+double WeaR_LatencyHistogram::getMeanUs() const {
+    uint64_t count = getCount();
+    return count ? static_cast<double>(m_sumUs.load(std::memory_order_relaxed)) / count : 0.0;
+}
+
+uint64_t WeaR_LatencyHistogram::getPercentileUs(double p) const {
+    uint64_t count = getCount();
+    if (count == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(count * (p / 100.0)));
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            // Upper bound of the bucket, never above the observed max
+            uint64_t upper = (2ull << i) - 1;
+            return std::min(upper, getMaxUs());
+        }
+    }
+    return getMaxUs();
+}
+
+std::string WeaR_LatencyHistogram::summary() const {
+    if (getCount() == 0) {
+        return "no samples";
+    }
+    return std::format("n={} mean={:.2f}ms p50={:.2f}ms p95={:.2f}ms p99={:.2f}ms max={:.2f}ms",
+                       getCount(), getMeanUs() / 1000.0,
+                       getPercentileUs(50) / 1000.0, getPercentileUs(95) / 1000.0,
+                       getPercentileUs(99) / 1000.0, getMaxUs() / 1000.0);
+}
+
+// =============================================================================
+// LATENCY TRACKER
+// =============================================================================
+
+uint64_t WeaR_InputLatency::nowUs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void WeaR_InputLatency::onGuestRead(uint64_t eventTimeUs) {
+    if (eventTimeUs == 0) return;
+
+    // Only the first read that observes a new event counts
+    uint64_t last = m_lastObservedUs.load(std::memory_order_relaxed);
+    do {
+        if (eventTimeUs <= last) return;
+    } while (!m_lastObservedUs.compare_exchange_weak(last, eventTimeUs, std::memory_order_relaxed));
+
+    uint64_t now = nowUs();
+    m_inputToGuest.record(now > eventTimeUs ? now - eventTimeUs : 0);
+
+    // Keep the oldest event that is still waiting for a flip
+    uint64_t expected = 0;
+    m_awaitingFlipUs.compare_exchange_strong(expected, eventTimeUs, std::memory_order_relaxed);
+}
+
+void WeaR_InputLatency::onGuestFlip() {
+    uint64_t eventTimeUs = m_awaitingFlipUs.exchange(0, std::memory_order_relaxed);
+    if (eventTimeUs == 0) return;
+
+    uint64_t expected = 0;
+    m_awaitingPresentUs.compare_exchange_strong(expected, eventTimeUs, std::memory_order_relaxed);
+}
+
+void WeaR_InputLatency::onPresent() {
+    uint64_t eventTimeUs = m_awaitingPresentUs.exchange(0, std::memory_order_relaxed);
+    if (eventTimeUs == 0) return;
+
+    uint64_t now = nowUs();
+    m_inputToPhoton.record(now > eventTimeUs ? now - eventTimeUs : 0);
+}
+
+std::string WeaR_InputLatency::report() const {
+    return std::format("input-to-guest:  {}\ninput-to-photon: {}",
+                       m_inputToGuest.summary(), m_inputToPhoton.summary());
+}
+
+void WeaR_InputLatency::reset() {
+    m_lastObservedUs.store(0, std::memory_order_relaxed);
+    m_awaitingFlipUs.store(0, std::memory_order_relaxed);
+    m_awaitingPresentUs.store(0, std::memory_order_relaxed);
+    m_inputToGuest.reset();
+    m_inputToPhoton.reset();
+}
+
+} // namespace WeaR
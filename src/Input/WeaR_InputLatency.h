@@ -0,0 +1,108 @@
+#pragma once
+
+/**
+ * @file WeaR_InputLatency.h
+ * @brief End-to-end input latency instrumentation
+ * 
+ * Every host input event is stamped (WeaR_ControllerState::eventTimeUs)
+ * and followed through the pipeline:
+ *   input-to-guest:  event -> first scePadReadState that observes it
+ *   input-to-photon: event -> first present after the next guest flip
+ * 
+ * Only the oldest outstanding event is tracked per phase, so the numbers
+ * are a conservative (worst-case) view when several events coalesce.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace WeaR {
+
+// =============================================================================
+// HISTOGRAM
+// =============================================================================
+
+/**
+ * @brief Lock-free log2-bucketed latency histogram (microseconds)
+ * 
+ * Bucket i holds samples in [2^i, 2^(i+1)) us; bucket 0 also holds 0 us.
+ */
+class WeaR_LatencyHistogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 32;
+
+    void record(uint64_t micros);
+    void reset();
+
+    [[nodiscard]] uint64_t getCount() const { return m_count.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t getMinUs() const;
+    [[nodiscard]] uint64_t getMaxUs() const { return m_maxUs.load(std::memory_order_relaxed); }
+    [[nodiscard]] double getMeanUs() const;
+
+    /**
+     * @brief Approximate percentile (upper bound of the containing bucket)
+     * @param p Percentile in [0, 100]
+     */
+    [[nodiscard]] uint64_t getPercentileUs(double p) const;
+
+    /**
+     * @brief One-line summary: count, mean, p50/p95/p99, max
+     */
+    [[nodiscard]] std::string summary() const;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sumUs{0};
+    std::atomic<uint64_t> m_minUs{UINT64_MAX};
+    std::atomic<uint64_t> m_maxUs{0};
+};
+
+// =============================================================================
+// LATENCY TRACKER
+// =============================================================================
+
+class WeaR_InputLatency {
+public:
+    /**
+     * @brief Host timestamp used for input events (steady clock, microseconds)
+     */
+    [[nodiscard]] static uint64_t nowUs();
+
+    /**
+     * @brief Guest read the pad state carrying this event timestamp
+     */
+    void onGuestRead(uint64_t eventTimeUs);
+
+    /**
+     * @brief Guest finished a frame (flip / submit done)
+     */
+    void onGuestFlip();
+
+    /**
+     * @brief Host presented a frame
+     */
+    void onPresent();
+
+    [[nodiscard]] const WeaR_LatencyHistogram& getInputToGuest() const { return m_inputToGuest; }
+    [[nodiscard]] const WeaR_LatencyHistogram& getInputToPhoton() const { return m_inputToPhoton; }
+
+    /**
+     * @brief Multi-line report of both phases
+     */
+    [[nodiscard]] std::string report() const;
+
+    void reset();
+
+private:
+    std::atomic<uint64_t> m_lastObservedUs{0};   // Newest event already seen by the guest
+    std::atomic<uint64_t> m_awaitingFlipUs{0};   // Observed, waiting for a guest flip
+    std::atomic<uint64_t> m_awaitingPresentUs{0};// Flipped, waiting for a host present
+
+    WeaR_LatencyHistogram m_inputToGuest;
+    WeaR_LatencyHistogram m_inputToPhoton;
+};
+
+} // namespace WeaR
@@ -0,0 +1,101 @@
+#include "WeaR_InputReplay.h"
+
+#include <array>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+namespace WeaR {
+
+namespace {
+
+/**
+ * @brief Decimal, or hex with an explicit 0x prefix
+ *
+ * No sign, no octal: "-1" and "010" are rejected rather than read as
+ * UINT64_MAX and 8.
+ */
+bool parseUnsigned(std::string_view token, uint64_t max, uint64_t& out) {
+    int base = 10;
+    if (token.size() > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X')) {
+        token.remove_prefix(2);
+        base = 16;
+    }
+    uint64_t value = 0;
+    auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value, base);
+    if (ec != std::errc{} || ptr != token.data() + token.size() || value > max) return false;
+    out = value;
+    return true;
+}
+
+} // anonymous namespace
+
+std::expected<std::vector<InputReplayEvent>, std::string>
+loadInputReplay(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return std::unexpected(std::format("{}: cannot open replay file", path.string()));
+    }
+
+    std::vector<InputReplayEvent> events;
+    std::string line;
+    size_t lineNumber = 0;
+
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        auto fail = [&](std::string_view reason) {
+            return std::unexpected(std::format("{}:{}: {}", path.string(), lineNumber, reason));
+        };
+
+        if (auto comment = line.find('#'); comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        std::vector<std::string> tokens;
+        for (std::string token; fields >> token;) {
+            tokens.push_back(std::move(token));
+        }
+        if (tokens.empty()) continue;
+
+        if (tokens.size() != 2 && tokens.size() != 8) {
+            return fail("expected 'instruction buttons [lx ly rx ry l2 r2]'");
+        }
+
+        InputReplayEvent event;
+        uint64_t buttons = 0;
+        if (!parseUnsigned(tokens[0], UINT64_MAX, event.instruction)) {
+            return fail("invalid instruction count");
+        }
+        if (!parseUnsigned(tokens[1], UINT32_MAX, buttons)) {
+            return fail("invalid button mask");
+        }
+        event.state.buttons = static_cast<uint32_t>(buttons);
+
+        if (tokens.size() == 8) {
+            std::array<uint8_t*, 6> axes = {
+                &event.state.leftStickX, &event.state.leftStickY,
+                &event.state.rightStickX, &event.state.rightStickY,
+                &event.state.l2Analog, &event.state.r2Analog
+            };
+            for (size_t i = 0; i < axes.size(); ++i) {
+                uint64_t value = 0;
+                if (!parseUnsigned(tokens[2 + i], 255, value)) {
+                    return fail("analog values must be 0-255");
+                }
+                *axes[i] = static_cast<uint8_t>(value);
+            }
+        }
+
+        if (!events.empty() && event.instruction < events.back().instruction) {
+            return fail("events must be sorted by instruction count");
+        }
+        events.push_back(event);
+    }
+
+    return events;
+}
+
+} // namespace WeaR
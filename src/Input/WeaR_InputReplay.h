@@ -0,0 +1,42 @@
+#pragma once
+
+/**
+ * @file WeaR_InputReplay.h
+ * @brief Scripted controller input keyed on guest instruction count
+ *
+ * Replay files are plain text, one controller state per line:
+ *
+ *     # instruction  buttons  [lx ly rx ry l2 r2]
+ *     0              0x0000
+ *     25000000       0x4000   128 128 128 128 0 0
+ *
+ * The state applies once the guest has retired that many instructions, so
+ * a replay is deterministic for a given binary regardless of host speed.
+ * Buttons use the PadButton bitmask (decimal, or hex with 0x); omitted analog values
+ * default to centred sticks and released triggers. Lines must be sorted by
+ * instruction count. '#' starts a comment.
+ */
+
+#include "WeaR_Input.h"
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace WeaR {
+
+struct InputReplayEvent {
+    uint64_t instruction = 0;
+    WeaR_ControllerState state{};
+};
+
+/**
+ * @brief Parse a replay file
+ * @return Events sorted by instruction count, or "<file>:<line>: reason"
+ */
+[[nodiscard]] std::expected<std::vector<InputReplayEvent>, std::string>
+loadInputReplay(const std::filesystem::path& path);
+
+} // namespace WeaR
@@ -1,15 +1,42 @@
 #include "WeaR_ElfLoader.h"
+#include "Core/WeaR_JobSystem.h"
+#include "Core/WeaR_Log.h"
 
 #include <fstream>
 #include <iostream>
 #include <format>
+#include <algorithm>
 #include <cstring>
-
-// Qt logging
-#include <QDebug>
+#include <functional>
 
 namespace WeaR {
 
+namespace {
+
+// Below this a copy is cheaper than waking workers
+constexpr size_t PARALLEL_COPY_THRESHOLD = 8 * 1024 * 1024;
+constexpr size_t PARALLEL_COPY_GRAIN = 2 * 1024 * 1024;
+
+/**
+ * @brief Split a large guest memory copy or fill across the job system
+ *
+ * The range is validated up front so a bad segment still throws from the
+ * loading thread instead of inside a job.
+ */
+void forEachChunk(WeaR_Memory& memory, uint64_t address, size_t size,
+                  const std::function<void(uint64_t offset, size_t length)>& body)
+{
+    if (size < PARALLEL_COPY_THRESHOLD || !memory.isValidAddress(address, size)) {
+        body(0, size);
+        return;
+    }
+    getJobSystem().parallelFor(0, size, PARALLEL_COPY_GRAIN, [&](size_t begin, size_t end) {
+        body(begin, end - begin);
+    });
+}
+
+} // anonymous namespace
+
 // =============================================================================
 // SEGMENT TYPE NAMES
 // =============================================================================
@@ -46,38 +73,38 @@ std::string WeaR_ElfLoader::getSegmentFlagsString(uint32_t flags) {
 bool WeaR_ElfLoader::validateHeader(const Elf64::Ehdr& header) const {
     // Check magic bytes
     if (std::memcmp(header.e_ident, Elf64::MAGIC, 4) != 0) {
-        qWarning() << "[ElfLoader] Invalid ELF magic";
+        WEAR_LOG_WARN(LogCategory::ELF, "Invalid ELF magic");
         return false;
     }
 
     // Check 64-bit class
     if (header.e_ident[4] != Elf64::CLASS_64) {
-        qWarning() << "[ElfLoader] Not a 64-bit ELF (PS4 requires ELF64)";
+        WEAR_LOG_WARN(LogCategory::ELF, "Not a 64-bit ELF (PS4 requires ELF64)");
         return false;
     }
 
     // Check little-endian
     if (header.e_ident[5] != Elf64::DATA_LSB) {
-        qWarning() << "[ElfLoader] Not little-endian";
+        WEAR_LOG_WARN(LogCategory::ELF, "Not little-endian");
         return false;
     }
 
     // Check machine type (x86-64)
     if (header.e_machine != Elf64::EM_X86_64) {
-        qWarning() << "[ElfLoader] Not x86-64 architecture";
+        WEAR_LOG_WARN(LogCategory::ELF, "Not x86-64 architecture");
         return false;
     }
 
     // Check type (executable or shared object)
     if (header.e_type != Elf64::ET_EXEC && header.e_type != Elf64::ET_DYN) {
-        qWarning() << "[ElfLoader] Not an executable or shared object";
+        WEAR_LOG_WARN(LogCategory::ELF, "Not an executable or shared object");
         return false;
     }
 
     // OS ABI check (FreeBSD/PS4) - warning only, don't reject
     uint8_t osabi = header.e_ident[7];
     if (osabi != Elf64::OSABI_FREEBSD && osabi != 0) {
-        qWarning() << "[ElfLoader] Warning: OS ABI is" << osabi << "(expected FreeBSD/9)";
+        WEAR_LOG_WARN(LogCategory::ELF, "OS ABI is {} (expected FreeBSD/9)", osabi);
     }
 
     return true;
@@ -116,7 +143,9 @@ std::expected<bool, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::validateElf(
 void WeaR_ElfLoader::loadSegment(const Elf64::Phdr& phdr, 
                                   const std::vector<uint8_t>& fileData,
                                   WeaR_Memory& memory, 
-                                  LoadedSegment& segment)
+                                  LoadedSegment& segment,
+                                  const std::filesystem::path& backingFile,
+                                  const FileStamp& backingStamp)
 {
     segment.virtualAddress = phdr.p_vaddr;
     segment.memorySize = phdr.p_memsz;
@@ -129,17 +158,114 @@ void WeaR_ElfLoader::loadSegment(const Elf64::Phdr& phdr,
 
     // Only load if there's file data
     if (phdr.p_filesz > 0 && phdr.p_offset + phdr.p_filesz <= fileData.size()) {
-        memory.writeBlock(phdr.p_vaddr, fileData.data() + phdr.p_offset, phdr.p_filesz);
+        const uint8_t* src = fileData.data() + phdr.p_offset;
+        auto copy = [&](uint64_t begin, uint64_t end) {
+            forEachChunk(memory, phdr.p_vaddr + begin, end - begin, [&](uint64_t offset, size_t length) {
+                memory.writeBlock(phdr.p_vaddr + begin + offset, src + begin + offset, length);
+            });
+        };
+
+        // Whole pages of a read-only segment come straight from the file;
+        // vaddr and file offset must share the same offset within a page
+        uint64_t sharedBegin = 0;
+        uint64_t sharedEnd = 0;
+        const uint64_t pageSize = WeaR_Memory::hostPageSize();
+        if (!backingFile.empty() && !(phdr.p_flags & Elf64::PF_W) &&
+            phdr.p_vaddr % pageSize == phdr.p_offset % pageSize) {
+            const uint64_t firstPage = (phdr.p_vaddr + pageSize - 1) / pageSize * pageSize;
+            const uint64_t lastPage = (phdr.p_vaddr + phdr.p_filesz) / pageSize * pageSize;
+            sharedBegin = firstPage - phdr.p_vaddr;
+            sharedEnd = std::max(lastPage, firstPage) - phdr.p_vaddr;
+            if (sharedEnd == sharedBegin ||
+                !memory.mapFileShared(phdr.p_vaddr + sharedBegin, backingFile,
+                                      phdr.p_offset + sharedBegin, sharedEnd - sharedBegin,
+                                      backingStamp)) {
+                sharedBegin = sharedEnd = 0;
+            }
+        }
+
+        if (sharedEnd > sharedBegin) {
+            segment.sharedBytes = sharedEnd - sharedBegin;
+            copy(0, sharedBegin);
+            copy(sharedEnd, phdr.p_filesz);
+        } else {
+            copy(0, phdr.p_filesz);
+        }
     }
 
     // Zero-fill BSS (memory size > file size)
     if (phdr.p_memsz > phdr.p_filesz) {
         uint64_t bssStart = phdr.p_vaddr + phdr.p_filesz;
         uint64_t bssSize = phdr.p_memsz - phdr.p_filesz;
-        memory.zero(bssStart, bssSize);
+        forEachChunk(memory, bssStart, bssSize, [&](uint64_t offset, size_t length) {
+            memory.zero(bssStart + offset, length);
+        });
     }
 }
 
+// =============================================================================
+// SYMBOLS
+// =============================================================================
+
+void WeaR_ElfLoader::readSymbols(const std::vector<uint8_t>& fileData, const Elf64::Ehdr& header,
+                                 ElfLoadResult& result) const
+{
+    // Retail executables usually have no section table at all; that is not an error
+    const size_t fileSize = fileData.size();
+    if (header.e_shnum == 0 || header.e_shentsize != sizeof(Elf64::Shdr) ||
+        header.e_shoff > fileSize || header.e_shnum > (fileSize - header.e_shoff) / sizeof(Elf64::Shdr)) {
+        return;
+    }
+
+    std::vector<Elf64::Shdr> sections(header.e_shnum);
+    std::memcpy(sections.data(), fileData.data() + header.e_shoff, header.e_shnum * sizeof(Elf64::Shdr));
+
+    auto inFile = [&](const Elf64::Shdr& section) {
+        return section.sh_offset <= fileSize && section.sh_size <= fileSize - section.sh_offset;
+    };
+    // Names are only trusted when NUL-terminated inside their string table
+    auto stringAt = [&](const Elf64::Shdr& table, uint32_t offset) -> std::string {
+        if (table.sh_type != Elf64::SHT_STRTAB || !inFile(table) || offset >= table.sh_size) return {};
+        const char* begin = reinterpret_cast<const char*>(fileData.data() + table.sh_offset + offset);
+        const size_t length = strnlen(begin, table.sh_size - offset);
+        return length < table.sh_size - offset ? std::string(begin, length) : std::string();
+    };
+
+    const Elf64::Shdr* names = header.e_shstrndx < sections.size() ? &sections[header.e_shstrndx] : nullptr;
+    for (const Elf64::Shdr& section : sections) {
+        const uint64_t codeFlags = Elf64::SHF_ALLOC | Elf64::SHF_EXECINSTR;
+        if ((section.sh_flags & codeFlags) == codeFlags && section.sh_size > 0) {
+            result.codeSections.push_back({ section.sh_addr, section.sh_size,
+                                            names ? stringAt(*names, section.sh_name) : std::string() });
+        }
+    }
+
+    // .symtab has everything .dynsym has, so only read .dynsym without it
+    const bool hasSymtab = std::ranges::any_of(sections, [](const Elf64::Shdr& section) {
+        return section.sh_type == Elf64::SHT_SYMTAB;
+    });
+    const uint32_t symbolType = hasSymtab ? Elf64::SHT_SYMTAB : Elf64::SHT_DYNSYM;
+    for (const Elf64::Shdr& table : sections) {
+        if (table.sh_type != symbolType || !inFile(table) || table.sh_link >= sections.size()) continue;
+        const Elf64::Shdr& strings = sections[table.sh_link];
+        const size_t count = table.sh_size / sizeof(Elf64::Sym);
+        for (size_t i = 0; i < count; ++i) {
+            Elf64::Sym symbol;
+            std::memcpy(&symbol, fileData.data() + table.sh_offset + i * sizeof(Elf64::Sym), sizeof(symbol));
+            if ((symbol.st_info & 0xF) != Elf64::STT_FUNC || symbol.st_value == 0) continue;
+            std::string name = stringAt(strings, symbol.st_name);
+            if (!name.empty()) {
+                result.symbols.push_back({ symbol.st_value, symbol.st_size, std::move(name) });
+            }
+        }
+    }
+
+    std::ranges::sort(result.symbols, {}, &ElfSymbol::address);
+    std::ranges::sort(result.codeSections, {}, &ElfSection::address);
+    WEAR_LOG_DEBUG(LogCategory::ELF, "{} function symbols, {} code sections",
+                   result.symbols.size(), result.codeSections.size());
+}
+
 // =============================================================================
 // MAIN LOAD FUNCTION
 // =============================================================================
@@ -150,13 +276,16 @@ std::expected<ElfLoadResult, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::loadElf(
 {
     ElfLoadResult result;
 
-    qDebug() << "[ElfLoader] Loading:" << QString::fromStdString(filepath.string());
+    WEAR_LOG_INFO(LogCategory::ELF, "Loading: {}", filepath.string());
 
     // Validate file exists
     if (!std::filesystem::exists(filepath)) {
         return std::unexpected(std::format("File not found: {}", filepath.string()));
     }
 
+    // Taken before the read: pages are only shared while the file still matches
+    const std::optional<FileStamp> stamp = WeaR_Memory::getFileStamp(filepath);
+
     // Read entire file
     std::ifstream file(filepath, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
@@ -166,7 +295,7 @@ std::expected<ElfLoadResult, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::loadElf(
     size_t fileSize = static_cast<size_t>(file.tellg());
     file.seekg(0);
 
-    qDebug() << "[ElfLoader] File size:" << fileSize << "bytes";
+    WEAR_LOG_DEBUG(LogCategory::ELF, "File size: {} bytes", fileSize);
 
     if (fileSize < sizeof(Elf64::Ehdr)) {
         return std::unexpected("File too small to contain ELF header");
@@ -186,9 +315,8 @@ std::expected<ElfLoadResult, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::loadElf(
     result.entryPoint = header->e_entry;
     result.elfType = (header->e_type == Elf64::ET_EXEC) ? "Executable" : "Shared Object";
 
-    qDebug() << "[ElfLoader] Type:" << QString::fromStdString(result.elfType);
-    qDebug() << "[ElfLoader] Entry Point: 0x" << QString::number(result.entryPoint, 16).toUpper();
-    qDebug() << "[ElfLoader] Program Headers:" << header->e_phnum;
+    WEAR_LOG_DEBUG(LogCategory::ELF, "Type: {}, entry point 0x{:X}, {} program headers",
+                   result.elfType, result.entryPoint, header->e_phnum);
 
     // Validate program header table
     if (header->e_phoff + header->e_phnum * sizeof(Elf64::Phdr) > fileSize) {
@@ -205,28 +333,28 @@ std::expected<ElfLoadResult, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::loadElf(
     for (uint16_t i = 0; i < header->e_phnum; ++i) {
         const Elf64::Phdr& phdr = phdrs[i];
 
-        qDebug() << "[ElfLoader] Segment" << i << ":"
-                 << QString::fromStdString(getSegmentTypeName(phdr.p_type))
-                 << QString::fromStdString(getSegmentFlagsString(phdr.p_flags))
-                 << "vaddr=0x" << QString::number(phdr.p_vaddr, 16)
-                 << "memsz=" << phdr.p_memsz;
+        WEAR_LOG_DEBUG(LogCategory::ELF, "Segment {}: {} {} vaddr=0x{:x} memsz={}",
+                       i, getSegmentTypeName(phdr.p_type), getSegmentFlagsString(phdr.p_flags),
+                       phdr.p_vaddr, phdr.p_memsz);
 
         // Only load PT_LOAD segments
         if (phdr.p_type == Elf64::PT_LOAD) {
             // Validate segment doesn't exceed file
             if (phdr.p_offset + phdr.p_filesz > fileSize) {
-                qWarning() << "[ElfLoader] Segment" << i << "extends beyond file";
+                WEAR_LOG_WARN(LogCategory::ELF, "Segment {} extends beyond file", i);
                 continue;
             }
 
             // Check memory bounds
             if (!memory.isValidAddress(phdr.p_vaddr, phdr.p_memsz)) {
-                qWarning() << "[ElfLoader] Segment" << i << "exceeds memory bounds, skipping";
+                WEAR_LOG_WARN(LogCategory::ELF, "Segment {} exceeds memory bounds, skipping", i);
                 continue;
             }
 
             LoadedSegment segment;
-            loadSegment(phdr, fileData, memory, segment);
+            loadSegment(phdr, fileData, memory, segment,
+                        stamp ? filepath : std::filesystem::path{}, stamp.value_or(FileStamp{}));
+            result.sharedBytes += segment.sharedBytes;
             result.segments.push_back(segment);
 
             // Track address range
@@ -237,20 +365,22 @@ std::expected<ElfLoadResult, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::loadElf(
                 highestAddr = phdr.p_vaddr + phdr.p_memsz;
             }
 
-            qDebug() << "[ElfLoader]   Loaded" << phdr.p_filesz << "bytes to 0x"
-                     << QString::number(phdr.p_vaddr, 16).toUpper();
+            WEAR_LOG_DEBUG(LogCategory::ELF, "  Loaded {} bytes to 0x{:X}", phdr.p_filesz, phdr.p_vaddr);
         }
     }
 
     result.baseAddress = lowestAddr;
     result.topAddress = highestAddr;
     result.isValid = !result.segments.empty();
+    readSymbols(fileData, *header, result);
 
     if (result.isValid) {
-        qDebug() << "[ElfLoader] Successfully loaded" << result.segments.size() << "segments";
-        qDebug() << "[ElfLoader] Base: 0x" << QString::number(result.baseAddress, 16).toUpper();
-        qDebug() << "[ElfLoader] Top:  0x" << QString::number(result.topAddress, 16).toUpper();
-        qDebug() << "[ElfLoader] Entry: 0x" << QString::number(result.entryPoint, 16).toUpper();
+        WEAR_LOG_INFO(LogCategory::ELF, "Loaded {} segments: base 0x{:X}, top 0x{:X}, entry 0x{:X}",
+                      result.segments.size(), result.baseAddress, result.topAddress, result.entryPoint);
+        if (result.sharedBytes > 0) {
+            WEAR_LOG_INFO(LogCategory::ELF, "{} KB of read-only pages shared with the file",
+                          result.sharedBytes / 1024);
+        }
     } else {
         return std::unexpected("No loadable segments found in ELF");
     }
@@ -269,7 +399,7 @@ std::expected<ElfLoadResult, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::loadElfF
     ElfLoadResult result;
     size_t fileSize = data.size();
 
-    qDebug() << "[ElfLoader] Loading ELF from memory buffer (" << fileSize << "bytes)";
+    WEAR_LOG_INFO(LogCategory::ELF, "Loading ELF from memory buffer ({} bytes)", fileSize);
 
     if (fileSize < sizeof(Elf64::Ehdr)) {
         return std::unexpected("Buffer too small to contain ELF header");
@@ -285,9 +415,8 @@ std::expected<ElfLoadResult, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::loadElfF
     result.entryPoint = header->e_entry;
     result.elfType = (header->e_type == Elf64::ET_EXEC) ? "Executable" : "Shared Object";
 
-    qDebug() << "[ElfLoader] Type:" << QString::fromStdString(result.elfType);
-    qDebug() << "[ElfLoader] Entry Point: 0x" << QString::number(result.entryPoint, 16).toUpper();
-    qDebug() << "[ElfLoader] Program Headers:" << header->e_phnum;
+    WEAR_LOG_DEBUG(LogCategory::ELF, "Type: {}, entry point 0x{:X}, {} program headers",
+                   result.elfType, result.entryPoint, header->e_phnum);
 
     // Validate program header table
     if (header->e_phoff + header->e_phnum * sizeof(Elf64::Phdr) > fileSize) {
@@ -307,12 +436,12 @@ std::expected<ElfLoadResult, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::loadElfF
         // Only load PT_LOAD segments
         if (phdr.p_type == Elf64::PT_LOAD) {
             if (phdr.p_offset + phdr.p_filesz > fileSize) {
-                qWarning() << "[ElfLoader] Segment" << i << "extends beyond buffer";
+                WEAR_LOG_WARN(LogCategory::ELF, "Segment {} extends beyond buffer", i);
                 continue;
             }
 
             if (!memory.isValidAddress(phdr.p_vaddr, phdr.p_memsz)) {
-                qWarning() << "[ElfLoader] Segment" << i << "exceeds memory bounds, skipping";
+                WEAR_LOG_WARN(LogCategory::ELF, "Segment {} exceeds memory bounds, skipping", i);
                 continue;
             }
 
@@ -323,17 +452,17 @@ std::expected<ElfLoadResult, WeaR_ElfLoader::ErrorType> WeaR_ElfLoader::loadElfF
             if (phdr.p_vaddr < lowestAddr) lowestAddr = phdr.p_vaddr;
             if (phdr.p_vaddr + phdr.p_memsz > highestAddr) highestAddr = phdr.p_vaddr + phdr.p_memsz;
 
-            qDebug() << "[ElfLoader]   Loaded" << phdr.p_filesz << "bytes to 0x"
-                     << QString::number(phdr.p_vaddr, 16).toUpper();
+            WEAR_LOG_DEBUG(LogCategory::ELF, "  Loaded {} bytes to 0x{:X}", phdr.p_filesz, phdr.p_vaddr);
         }
     }
 
     result.baseAddress = lowestAddr;
     result.topAddress = highestAddr;
     result.isValid = !result.segments.empty();
+    readSymbols(data, *header, result);
 
     if (result.isValid) {
-        qDebug() << "[ElfLoader] Successfully loaded" << result.segments.size() << "segments from memory";
+        WEAR_LOG_INFO(LogCategory::ELF, "Loaded {} segments from memory", result.segments.size());
     } else {
         return std::unexpected("No loadable segments found in ELF buffer");
     }
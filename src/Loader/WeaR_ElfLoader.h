@@ -64,6 +64,18 @@ constexpr uint32_t PF_X = 0x1;  // Execute
 constexpr uint32_t PF_W = 0x2;  // Write
 constexpr uint32_t PF_R = 0x4;  // Read
 
+// Section header types
+constexpr uint32_t SHT_SYMTAB = 2;    // Full symbol table
+constexpr uint32_t SHT_STRTAB = 3;    // String table
+constexpr uint32_t SHT_DYNSYM = 11;   // Dynamic symbol table
+
+// Section flags
+constexpr uint64_t SHF_ALLOC = 0x2;
+constexpr uint64_t SHF_EXECINSTR = 0x4;
+
+// Symbol types (low nibble of st_info)
+constexpr uint8_t STT_FUNC = 2;
+
 #pragma pack(push, 1)
 
 /**
@@ -100,6 +112,34 @@ struct Phdr {
     uint64_t p_align;        // Alignment
 };
 
+/**
+ * @brief ELF64 Section Header
+ */
+struct Shdr {
+    uint32_t sh_name;        // Name offset in the section name string table
+    uint32_t sh_type;        // Section type
+    uint64_t sh_flags;       // Section flags
+    uint64_t sh_addr;        // Virtual address in memory
+    uint64_t sh_offset;      // Offset in file
+    uint64_t sh_size;        // Size in file
+    uint32_t sh_link;        // Associated section (string table for symbols)
+    uint32_t sh_info;        // Extra information
+    uint64_t sh_addralign;   // Alignment
+    uint64_t sh_entsize;     // Entry size for tables
+};
+
+/**
+ * @brief ELF64 Symbol
+ */
+struct Sym {
+    uint32_t st_name;        // Name offset in the linked string table
+    uint8_t  st_info;        // Type (low nibble) and binding (high nibble)
+    uint8_t  st_other;       // Visibility
+    uint16_t st_shndx;       // Section index
+    uint64_t st_value;       // Address
+    uint64_t st_size;        // Size in bytes
+};
+
 #pragma pack(pop)
 
 } // namespace Elf64
@@ -116,9 +156,28 @@ struct LoadedSegment {
     uint64_t memorySize;
     uint64_t fileSize;
     uint32_t flags;  // PF_R, PF_W, PF_X
+    uint64_t sharedBytes = 0;  // Mapped from the file instead of copied
     std::string description;
 };
 
+/**
+ * @brief Function symbol from .symtab/.dynsym, for profiling and diagnostics
+ */
+struct ElfSymbol {
+    uint64_t address = 0;
+    uint64_t size = 0;           // 0 when the toolchain did not record one
+    std::string name;
+};
+
+/**
+ * @brief Allocated executable section, the fallback for stripped titles
+ */
+struct ElfSection {
+    uint64_t address = 0;
+    uint64_t size = 0;
+    std::string name;
+};
+
 /**
  * @brief Result of loading an ELF
  */
@@ -126,7 +185,10 @@ struct ElfLoadResult {
     uint64_t entryPoint = 0;
     uint64_t baseAddress = 0;
     uint64_t topAddress = 0;
+    uint64_t sharedBytes = 0;  // Sum over segments
     std::vector<LoadedSegment> segments;
+    std::vector<ElfSymbol> symbols;         // Functions, sorted by address
+    std::vector<ElfSection> codeSections;   // Sorted by address
     std::string elfType;
     bool isValid = false;
 };
@@ -146,6 +208,12 @@ public:
 
     /**
      * @brief Load an ELF file into memory
+     *
+     * Whole pages of read-only segments (code, rodata) are mapped from the
+     * file copy-on-write rather than copied, so instances running the same
+     * title share them through the host page cache. Writable segments and
+     * the partial pages at segment edges are copied.
+     *
      * @param filepath Path to the ELF file
      * @param memory Reference to emulator memory
      * @return Load result with entry point, or error
@@ -184,8 +252,12 @@ public:
 
 private:
     bool validateHeader(const Elf64::Ehdr& header) const;
+    void readSymbols(const std::vector<uint8_t>& fileData, const Elf64::Ehdr& header,
+                     ElfLoadResult& result) const;
     void loadSegment(const Elf64::Phdr& phdr, const std::vector<uint8_t>& fileData,
-                     WeaR_Memory& memory, LoadedSegment& segment);
+                     WeaR_Memory& memory, LoadedSegment& segment,
+                     const std::filesystem::path& backingFile = {},
+                     const FileStamp& backingStamp = {});
 };
 
 } // namespace WeaR
@@ -1,5 +1,5 @@
 #include "WeaR_PkgLoader.h"
-#include "GUI/WeaR_Logger.h"
+#include "Core/WeaR_Log.h"
 #include <fstream>
 #include <cstring>
 #include <format>
@@ -7,19 +7,6 @@
 
 namespace WeaR {
 
-// Helper to log to GUI
-static void logInfo(const std::string& msg) {
-    getLogger().log(msg, LogLevel::Info);
-}
-
-static void logWarning(const std::string& msg) {
-    getLogger().log(msg, LogLevel::Warning);
-}
-
-static void logError(const std::string& msg) {
-    getLogger().log(msg, LogLevel::Error);
-}
-
 uint16_t WeaR_PkgLoader::swapEndian16(uint16_t val) {
     return ((val & 0xFF00) >> 8) | ((val & 0x00FF) << 8);
 }
@@ -47,43 +34,43 @@ std::expected<PkgInfo, std::string> WeaR_PkgLoader::loadPackage(const std::files
     m_pkgPath = pkgPath;
     m_entries.clear();
 
-    logInfo("[PKG] ============ X-RAY LOADER ============");
-    logInfo(std::format("[PKG] Opening file: {}", pkgPath.string()));
+    WEAR_LOG_INFO(LogCategory::PKG, "============ X-RAY LOADER ============");
+    WEAR_LOG_INFO(LogCategory::PKG, "Opening file: {}", pkgPath.string());
 
     // Get file size
     std::error_code ec;
     auto fileSize = std::filesystem::file_size(pkgPath, ec);
     if (ec) {
-        logError(std::format("[PKG] Cannot get file size: {}", ec.message()));
+        WEAR_LOG_ERROR(LogCategory::PKG, "Cannot get file size: {}", ec.message());
         return std::unexpected(std::format("Cannot access PKG file: {}", ec.message()));
     }
-    logInfo(std::format("[PKG] File size: {} bytes ({} MB)", fileSize, fileSize / 1024 / 1024));
+    WEAR_LOG_INFO(LogCategory::PKG, "File size: {} bytes ({} MB)", fileSize, fileSize / 1024 / 1024);
 
     // Open file
     std::ifstream file(pkgPath, std::ios::binary);
     if (!file) {
-        logError("[PKG] Failed to open file!");
+        WEAR_LOG_ERROR(LogCategory::PKG, "Failed to open file!");
         return std::unexpected(std::format("Failed to open PKG file: {}", pkgPath.string()));
     }
-    logInfo("[PKG] File opened successfully");
+    WEAR_LOG_INFO(LogCategory::PKG, "File opened successfully");
 
     // Read header
-    logInfo(std::format("[PKG] Reading header ({} bytes)...", sizeof(PkgHeader)));
+    WEAR_LOG_INFO(LogCategory::PKG, "Reading header ({} bytes)...", sizeof(PkgHeader));
     file.read(reinterpret_cast<char*>(&m_header), sizeof(PkgHeader));
     if (!file) {
-        logError("[PKG] Failed to read header (file too small?)");
+        WEAR_LOG_ERROR(LogCategory::PKG, "Failed to read header (file too small?)");
         return std::unexpected("Failed to read PKG header - file may be corrupted or too small");
     }
 
     // Validate magic (PKG uses Big Endian)
     uint32_t magic = swapEndian32(m_header.magic);
-    logInfo(std::format("[PKG] Magic Check: Read 0x{:08X}, Expected 0x{:08X}", magic, PKG_MAGIC));
+    WEAR_LOG_INFO(LogCategory::PKG, "Magic Check: Read 0x{:08X}, Expected 0x{:08X}", magic, PKG_MAGIC);
     if (magic != PKG_MAGIC) {
-        logError("[PKG] Magic mismatch! This is NOT a valid PS4 PKG file.");
+        WEAR_LOG_ERROR(LogCategory::PKG, "Magic mismatch! This is NOT a valid PS4 PKG file.");
         return std::unexpected(std::format("Invalid PKG magic: 0x{:08X} (expected 0x{:08X})", 
                                            magic, PKG_MAGIC));
     }
-    logInfo("[PKG] Magic OK - Valid PS4 PKG signature");
+    WEAR_LOG_INFO(LogCategory::PKG, "Magic OK - Valid PS4 PKG signature");
 
     // Convert header fields from Big Endian
     m_header.revision = swapEndian32(m_header.revision);
@@ -99,22 +86,22 @@ std::expected<PkgInfo, std::string> WeaR_PkgLoader::loadPackage(const std::files
     m_header.drmType = swapEndian32(m_header.drmType);
     m_header.contentType = swapEndian32(m_header.contentType);
 
-    logInfo(std::format("[PKG] Header: Rev={}, Type={}, Flags=0x{:04X}", 
-            m_header.revision, m_header.type, m_header.flags));
-    logInfo(std::format("[PKG] Entries={}, TableOffset=0x{:08X}", 
-            m_header.entryCount, m_header.tableOffset));
-    logInfo(std::format("[PKG] DRM={}, ContentType={}", 
-            m_header.drmType, m_header.contentType));
+    WEAR_LOG_INFO(LogCategory::PKG, "Header: Rev={}, Type={}, Flags=0x{:04X}",
+                  m_header.revision, m_header.type, m_header.flags);
+    WEAR_LOG_INFO(LogCategory::PKG, "Entries={}, TableOffset=0x{:08X}",
+                  m_header.entryCount, m_header.tableOffset);
+    WEAR_LOG_INFO(LogCategory::PKG, "DRM={}, ContentType={}",
+                  m_header.drmType, m_header.contentType);
 
     // Read entry table
-    logInfo(std::format("[PKG] Reading entry table at offset 0x{:08X}...", m_header.tableOffset));
+    WEAR_LOG_INFO(LogCategory::PKG, "Reading entry table at offset 0x{:08X}...", m_header.tableOffset);
     file.seekg(m_header.tableOffset, std::ios::beg);
     m_entries.resize(m_header.entryCount);
     
     for (uint32_t i = 0; i < m_header.entryCount; ++i) {
         file.read(reinterpret_cast<char*>(&m_entries[i]), sizeof(PkgEntry));
         if (!file) {
-            logError(std::format("[PKG] Failed to read entry {}/{}", i, m_header.entryCount));
+            WEAR_LOG_ERROR(LogCategory::PKG, "Failed to read entry {}/{}", i, m_header.entryCount);
             return std::unexpected(std::format("Failed to read entry {} of {}", i, m_header.entryCount));
         }
         
@@ -126,27 +113,27 @@ std::expected<PkgInfo, std::string> WeaR_PkgLoader::loadPackage(const std::files
         m_entries[i].dataOffset = swapEndian32(m_entries[i].dataOffset);
         m_entries[i].dataSize = swapEndian32(m_entries[i].dataSize);
     }
-    logInfo(std::format("[PKG] Read {} entries successfully", m_header.entryCount));
+    WEAR_LOG_INFO(LogCategory::PKG, "Read {} entries successfully", m_header.entryCount);
 
     // Search for EBOOT.BIN
-    logInfo(std::format("[PKG] Searching for EBOOT.BIN (Entry ID 0x{:04X})...", PKG_ENTRY_ID_EBOOT));
+    WEAR_LOG_INFO(LogCategory::PKG, "Searching for EBOOT.BIN (Entry ID 0x{:04X})...", PKG_ENTRY_ID_EBOOT);
     bool ebootFound = false;
     for (const auto& entry : m_entries) {
         if (entry.id == PKG_ENTRY_ID_EBOOT) {
             ebootFound = true;
-            logInfo(std::format("[PKG] EBOOT.BIN FOUND! Offset=0x{:08X}, Size={} bytes", 
-                    entry.dataOffset, entry.dataSize));
+            WEAR_LOG_INFO(LogCategory::PKG, "EBOOT.BIN FOUND! Offset=0x{:08X}, Size={} bytes",
+                          entry.dataOffset, entry.dataSize);
             break;
         }
     }
     if (!ebootFound) {
-        logWarning("[PKG] EBOOT.BIN not found in entry table!");
-        std::string ids = "[PKG] Available IDs: ";
+        WEAR_LOG_WARN(LogCategory::PKG, "EBOOT.BIN not found in entry table!");
+        std::string ids = "Available IDs: ";
         for (size_t i = 0; i < std::min(m_entries.size(), size_t(10)); ++i) {
             ids += std::format("0x{:04X} ", m_entries[i].id);
         }
         if (m_entries.size() > 10) ids += "...";
-        logInfo(ids);
+        WEAR_LOG_INFO(LogCategory::PKG, "{}", ids);
     }
 
     // Populate info
@@ -160,8 +147,8 @@ std::expected<PkgInfo, std::string> WeaR_PkgLoader::loadPackage(const std::files
     m_info.entryCount = m_header.entryCount;
     m_info.sourcePath = pkgPath;
 
-    logInfo(std::format("[PKG] Content ID: {}", m_info.contentId));
-    logInfo("[PKG] ============ LOAD COMPLETE ============");
+    WEAR_LOG_INFO(LogCategory::PKG, "Content ID: {}", m_info.contentId);
+    WEAR_LOG_INFO(LogCategory::PKG, "============ LOAD COMPLETE ============");
 
     m_loaded = true;
     return m_info;
@@ -176,7 +163,7 @@ std::expected<std::vector<uint8_t>, std::string> WeaR_PkgLoader::extractEboot()
     }
     
     // SMART FALLBACK: Standard EBOOT not found (common in PS2 Classics, remasters, etc.)
-    logWarning("[PKG] Standard EBOOT (0x1000) not found - using SMART FALLBACK");
+    WEAR_LOG_WARN(LogCategory::PKG, "Standard EBOOT (0x1000) not found - using SMART FALLBACK");
     
     if (!m_loaded || m_entries.empty()) {
         return std::unexpected("No PKG loaded or no entries found");
@@ -196,8 +183,8 @@ std::expected<std::vector<uint8_t>, std::string> WeaR_PkgLoader::extractEboot()
     for (const auto& entry : m_entries) {
         // CRITICAL: Skip entries with invalid offsets (prevents underflow)
         if (entry.dataOffset >= fileSize) {
-            logWarning(std::format("[PKG] Skipping entry 0x{:08X}: offset {} >= fileSize {}",
-                                  entry.id, entry.dataOffset, fileSize));
+            WEAR_LOG_WARN(LogCategory::PKG, "Skipping entry 0x{:08X}: offset {} >= fileSize {}",
+                          entry.id, entry.dataOffset, fileSize);
             continue;
         }
         
@@ -217,8 +204,8 @@ std::expected<std::vector<uint8_t>, std::string> WeaR_PkgLoader::extractEboot()
     }
     
     // Log fallback decision
-    logWarning(std::format("[PKG] FALLBACK: Loading largest valid entry (ID: 0x{:08X}, Size: {} MB)", 
-                          largestEntry->id, maxSize / 1024 / 1024));
+    WEAR_LOG_WARN(LogCategory::PKG, "FALLBACK: Loading largest valid entry (ID: 0x{:08X}, Size: {} MB)",
+                  largestEntry->id, maxSize / 1024 / 1024);
     
     // Extract the largest entry
     return extractEntry(largestEntry->id);
@@ -251,8 +238,8 @@ std::expected<std::vector<uint8_t>, std::string> WeaR_PkgLoader::extractEntry(ui
 
     // STEP 1: VALIDATE OFFSET FIRST (prevents underflow)
     if (targetEntry->dataOffset >= fileSize) {
-        logError(std::format("[PKG] INVALID OFFSET! Entry 0x{:08X}: offset={} >= fileSize={}",
-                            entryId, targetEntry->dataOffset, fileSize));
+        WEAR_LOG_ERROR(LogCategory::PKG, "INVALID OFFSET! Entry 0x{:08X}: offset={} >= fileSize={}",
+                       entryId, targetEntry->dataOffset, fileSize);
         return std::unexpected(std::format("Entry offset ({}) is beyond file size ({})",
                                           targetEntry->dataOffset, fileSize));
     }
@@ -264,15 +251,15 @@ std::expected<std::vector<uint8_t>, std::string> WeaR_PkgLoader::extractEntry(ui
 
     // Validate and sanitize size
     if (requestedSize == 0) {
-        logError(std::format("[PKG] Entry 0x{:08X} has zero size!", entryId));
+        WEAR_LOG_ERROR(LogCategory::PKG, "Entry 0x{:08X} has zero size!", entryId);
         return std::unexpected("Entry has zero size");
     }
 
     if (requestedSize > maxReadable) {
-        logWarning(std::format("[PKG] Size overflow detected for entry 0x{:08X}", entryId));
-        logWarning(std::format("[PKG] Requested: {} bytes, Max readable: {} bytes", 
-                              requestedSize, maxReadable));
-        logWarning(std::format("[PKG] Sanitizing size: {} -> {} bytes", requestedSize, maxReadable));
+        WEAR_LOG_WARN(LogCategory::PKG, "Size overflow detected for entry 0x{:08X}", entryId);
+        WEAR_LOG_WARN(LogCategory::PKG, "Requested: {} bytes, Max readable: {} bytes",
+                      requestedSize, maxReadable);
+        WEAR_LOG_WARN(LogCategory::PKG, "Sanitizing size: {} -> {} bytes", requestedSize, maxReadable);
         finalSize = maxReadable;
     }
 
@@ -282,8 +269,8 @@ std::expected<std::vector<uint8_t>, std::string> WeaR_PkgLoader::extractEntry(ui
                                           finalSize / 1024 / 1024));
     }
 
-    logInfo(std::format("[PKG] Extracting entry 0x{:08X}: offset={}, size={} MB",
-                        entryId, targetEntry->dataOffset, finalSize / 1024 / 1024));
+    WEAR_LOG_INFO(LogCategory::PKG, "Extracting entry 0x{:08X}: offset={}, size={} MB",
+                  entryId, targetEntry->dataOffset, finalSize / 1024 / 1024);
 
     // Open file and extract
     std::ifstream file(m_pkgPath, std::ios::binary);
@@ -310,13 +297,13 @@ std::expected<std::vector<uint8_t>, std::string> WeaR_PkgLoader::extractEntry(ui
     if (file.eof()) {
         auto actualRead = file.gcount();
         if (actualRead < static_cast<std::streamsize>(finalSize)) {
-            logWarning(std::format("[PKG] Hit EOF early: requested {} bytes, got {} bytes",
-                                  finalSize, actualRead));
+            WEAR_LOG_WARN(LogCategory::PKG, "Hit EOF early: requested {} bytes, got {} bytes",
+                          finalSize, actualRead);
             data.resize(actualRead);
         }
     }
 
-    logInfo(std::format("[PKG] ✓ Successfully extracted {} bytes", data.size()));
+    WEAR_LOG_INFO(LogCategory::PKG, "✓ Successfully extracted {} bytes", data.size());
     return data;
 }
 
@@ -3,21 +3,33 @@
  * @brief WeaR-emu entry point
  * 
  * Initialization sequence:
- * 1. Hardware capability detection (standalone Vulkan probe)
- * 2. Qt application bootstrap
+ * 1. Startup stages on worker threads: GPU capability probe (or validation
+ *    of the cached probe), emulator core bring-up, pipeline cache load
+ * 2. Qt application bootstrap on the main thread, concurrently
  * 3. GUI initialization with detected specs
+ * 4. Join the stages and print per-stage timing
  */
 
 #include "Hardware/HardwareDetector.h"
 #include "GUI/WeaR_GUI.h"
+#include "Graphics/WeaR_RenderEngine.h"
+#include "Core/WeaR_EmulationContext.h"
+#include "Core/WeaR_EmulatorCore.h"
+#include "Core/WeaR_StartupGraph.h"
+#include "Core/WeaR_ThreadRoles.h"
+#include "Core/WeaR_TitleProfile.h"
 
 #include <QApplication>
 #include <QFile>
 #include <QMessageBox>
 #include <QFontDatabase>
+#include <QStandardPaths>
 
 #include <iostream>
 #include <format>
+#include <expected>
+#include <optional>
+#include <stdexcept>
 
 namespace {
 
@@ -49,6 +61,13 @@ void printHardwareReport(const WeaR::WeaR_Specs& specs) {
     std::cout << std::format("│  Tier:      {:<48} │\n", specs.tierString());
     std::cout << std::format("│  TFLOPs:    {:<48.1f} │\n", specs.estimatedTFLOPs);
     std::cout << std::format("│  FP16:      {:<48} │\n", specs.supportsFloat16 ? "Supported" : "Not Supported");
+
+    const auto& cpu = WeaR::getHostCpuInfo();
+    std::cout << "├─────────────────────────────────────────────────────────────┤\n";
+    std::cout << std::format("│  CPU:       {:<48} │\n", (cpu.brand.empty() ? cpu.vendor : cpu.brand).substr(0, 48));
+    std::cout << std::format("│  Cores:     {:<48} │\n", std::format("{} cores / {} threads",
+                                                                    cpu.physicalCores, cpu.logicalProcessors));
+    std::cout << std::format("│  SIMD:      {:<48} │\n", WeaR::getSimdLevelName(cpu.simdLevel));
     std::cout << "├─────────────────────────────────────────────────────────────┤\n";
     
     if (specs.canRunFrameGen) {
@@ -61,36 +80,134 @@ void printHardwareReport(const WeaR::WeaR_Specs& specs) {
     std::cout << "└─────────────────────────────────────────────────────────────┘\n\n";
 }
 
+void showDetectionFailure(const std::string& error) {
+    std::cerr << "[WeaR] ERROR: " << error << "\n";
+
+    QMessageBox::critical(nullptr, "WeaR-emu - Hardware Detection Failed",
+        QString::fromStdString(std::format(
+            "Failed to detect GPU capabilities:\n\n{}\n\n"
+            "Please ensure you have:\n"
+            "• A Vulkan 1.3 compatible GPU\n"
+            "• Up-to-date graphics drivers\n"
+            "• Vulkan Runtime installed",
+            error
+        )));
+}
+
 } // anonymous namespace
 
 int main(int argc, char* argv[]) {
     printBanner();
 
+    // The policy arrives with the main window's settings. On Linux, threads
+    // Qt creates after that inherit the GUI cores, so its audio and helper
+    // threads stay off the guest CPU core
+    WeaR::ScopedThreadRole mainThreadRole(WeaR::ThreadRole::Gui, "Main");
+
+    // Static metadata, so cache paths resolve before QApplication exists
+    QApplication::setApplicationName("WeaR-emu");
+    QApplication::setApplicationVersion("0.1.0-alpha");
+    QApplication::setOrganizationName("WeaR Team");
+
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    const std::string capabilityCachePath = (cacheDir + "/gpu_capabilities.txt").toStdString();
+    const std::string pipelineCachePath = (cacheDir + "/pipeline_cache.bin").toStdString();
+    const QString configDir = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
+    WeaR::getTitleProfiles().setDirectory((configDir + "/profiles").toStdString());
+
+    // =========================================================================
+    // PHASE 1: Startup Stages (worker threads)
+    // =========================================================================
+    std::cout << "[WeaR] Phase 1: Starting hardware detection and core bring-up...\n";
+
+    // A cache hit is used right away and only re-checked in the background;
+    // probeResult then holds fresh specs if the GPU or driver changed
+    const std::optional<WeaR::WeaR_Specs> cachedSpecs =
+        WeaR::HardwareDetector::loadCapabilityCache(capabilityCachePath);
+    std::expected<std::optional<WeaR::WeaR_Specs>, std::string> probeResult;
+    std::vector<uint8_t> pipelineCacheData;
+    const char* gpuStage = cachedSpecs ? "gpu_revalidate" : "gpu_probe";
+
+    // The console the window drives; declared first so it outlives both
+    WeaR::WeaR_EmulationContext emulation;
+
+    // Declared after the results it writes so early returns wait for it first
+    WeaR::WeaR_StartupGraph startup;
+
+    // A stage the graph rejects would never run; collect the first error
+    std::string stageError;
+    auto checkStage = [&stageError](std::expected<void, std::string> added) {
+        if (!added && stageError.empty()) {
+            stageError = added.error();
+        }
+    };
+
+    if (cachedSpecs) {
+        checkStage(startup.addStage(gpuStage, {}, [&] {
+            probeResult = WeaR::HardwareDetector::revalidateCapabilityCache(*cachedSpecs, capabilityCachePath);
+        }));
+    } else {
+        checkStage(startup.addStage(gpuStage, {}, [&] {
+            auto result = WeaR::HardwareDetector::detectCapabilities();
+            if (!result) {
+                probeResult = std::unexpected(result.error());
+                return;
+            }
+            if (!WeaR::HardwareDetector::saveCapabilityCache(capabilityCachePath, *result)) {
+                std::cerr << "[WeaR] Could not write capability cache: " << capabilityCachePath << "\n";
+            }
+            probeResult = std::optional<WeaR::WeaR_Specs>{std::move(*result)};
+        }));
+    }
+
+    checkStage(startup.addStage("pipeline_cache_load", {}, [&] {
+        pipelineCacheData = WeaR::WeaR_RenderEngine::readPipelineCacheFile(pipelineCachePath);
+    }, WeaR::JobPriority::IO));
+
+    checkStage(startup.addStage("emulator_core", {}, [&] {
+        // The core does not use the specs; the render engine gets them later
+        if (!emulation.getCore().initialize(WeaR::WeaR_Specs{})) {
+            throw std::runtime_error("EmulatorCore initialization failed");
+        }
+    }));
+
+    if (!stageError.empty()) {
+        std::cerr << "[WeaR] ERROR: Startup stage rejected: " << stageError << "\n";
+        return 1;
+    }
+
     // =========================================================================
-    // PHASE 1: Hardware Detection (Before Qt)
+    // PHASE 2: Qt Application Initialization
     // =========================================================================
-    std::cout << "[WeaR] Phase 1: Detecting hardware capabilities...\n";
-
-    auto specsResult = WeaR::HardwareDetector::detectCapabilities();
-
-    if (!specsResult) {
-        // Vulkan detection failed - show error dialog
-        std::cerr << "[WeaR] ERROR: " << specsResult.error() << "\n";
-
-        QApplication tempApp(argc, argv);
-        QMessageBox::critical(nullptr, "WeaR-emu - Hardware Detection Failed",
-            QString::fromStdString(std::format(
-                "Failed to detect GPU capabilities:\n\n{}\n\n"
-                "Please ensure you have:\n"
-                "• A Vulkan 1.3 compatible GPU\n"
-                "• Up-to-date graphics drivers\n"
-                "• Vulkan Runtime installed",
-                specsResult.error()
-            )));
+    std::cout << "[WeaR] Phase 2: Initializing Qt application...\n";
+
+    std::optional<QApplication> app;
+    const bool qtReady = startup.runInline("qt_bootstrap", [&] {
+        app.emplace(argc, argv);
+
+        // Use Fusion as base (will be heavily styled by QSS)
+        app->setStyle("Fusion");
+
+        // High DPI support
+        app->setAttribute(Qt::AA_UseHighDpiPixmaps);
+    });
+    if (!qtReady) {
+        std::cerr << "[WeaR] ERROR: Qt application initialization failed\n";
         return 1;
     }
 
-    WeaR::WeaR_Specs specs = specsResult.value();
+    WeaR::WeaR_Specs specs;
+    if (cachedSpecs) {
+        specs = *cachedSpecs;
+    } else {
+        startup.wait(gpuStage);
+        if (!probeResult) {
+            showDetectionFailure(probeResult.error());
+            return 1;
+        }
+        specs = **probeResult;
+    }
+
     printHardwareReport(specs);
 
     // === CRITICAL: Low-spec device warning ===
@@ -101,42 +218,62 @@ int main(int argc, char* argv[]) {
     }
 
     // =========================================================================
-    // PHASE 2: Qt Application Initialization
+    // PHASE 3: Create Main Window
     // =========================================================================
-    std::cout << "[WeaR] Phase 2: Initializing Qt application...\n";
-
-    QApplication app(argc, argv);
-    
-    // Application metadata
-    app.setApplicationName("WeaR-emu");
-    app.setApplicationVersion("0.1.0-alpha");
-    app.setOrganizationName("WeaR Team");
-    
-    // Use Fusion as base (will be heavily styled by QSS)
-    app.setStyle("Fusion");
+    std::cout << "[WeaR] Phase 3: Creating main window...\n";
 
-    // High DPI support
-    app.setAttribute(Qt::AA_UseHighDpiPixmaps);
+    std::optional<WeaR::WeaR_GUI> mainWindow;
+    const bool windowReady = startup.runInline("main_window", [&] {
+        mainWindow.emplace(specs, emulation);
+    });
+    if (!windowReady) {
+        std::cerr << "[WeaR] ERROR: Main window creation failed\n";
+        return 1;
+    }
 
     // =========================================================================
-    // PHASE 3: Create Main Window
+    // PHASE 4: Join Startup Stages
     // =========================================================================
-    std::cout << "[WeaR] Phase 3: Creating main window...\n";
+    startup.waitAll();
+
+    if (startup.wait("emulator_core") != WeaR::StageStatus::Done) {
+        std::cerr << "[WeaR] ERROR: Emulator core initialization failed\n";
+        QMessageBox::critical(nullptr, "WeaR-emu - Startup Failed",
+                              "The emulator core failed to initialize. See the log for details.");
+        return 1;
+    }
+
+    // Collectors read the core, so metrics start only after it is up
+    mainWindow->startMetrics();
+
+    if (cachedSpecs) {
+        if (!probeResult) {
+            showDetectionFailure(probeResult.error());
+            return 1;
+        }
+        if (*probeResult) {
+            std::cout << "[WeaR] GPU or driver changed since the capabilities were cached.\n";
+            printHardwareReport(**probeResult);
+            mainWindow->updateSpecs(**probeResult);
+        }
+    }
 
-    WeaR::WeaR_GUI mainWindow(specs);
-    mainWindow.show();
+    mainWindow->setPipelineCache(pipelineCachePath, std::move(pipelineCacheData));
+    mainWindow->show();
 
+    std::cout << "[WeaR] " << startup.formatReport();
     std::cout << "[WeaR] Initialization complete. Entering event loop.\n\n";
 
     // =========================================================================
-    // PHASE 4: Event Loop
+    // PHASE 5: Event Loop
     // =========================================================================
-    int result = app.exec();
+    int result = app->exec();
 
     // =========================================================================
-    // PHASE 5: Cleanup
+    // PHASE 6: Cleanup
     // =========================================================================
     std::cout << "\n[WeaR] Shutting down...\n";
+    mainWindow.reset();
     std::cout << "[WeaR] Goodbye!\n";
 
     return result;